@@ -223,20 +223,27 @@ class ConsoleView final : public View {
     }
 
     int32_t uartThreadMain() {
-        char byte;
+        const size_t buf_size = 128;
+        char buffer[buf_size];
 
         while (!isUartThreadInterrupted()) {
             assert(uart != nullptr);
-            bool success = uart->readByte(&byte, 50 / portTICK_PERIOD_MS);
+            // Read whatever arrived in one call instead of a call per byte
+            size_t bytes_read = uart->readBytes(buffer, buf_size, 50 / portTICK_PERIOD_MS);
 
             if (isUartThreadInterrupted()) {
                 break;
             }
 
-            if (success) {
-                // Forward to USB if enabled
-                if (usbRelayEnabled) {
+            if (bytes_read == 0) {
+                continue;
+            }
+
+            // Forward to USB if enabled
+            if (usbRelayEnabled) {
+                for (size_t i = 0; i < bytes_read; i++) {
                     // Accumulate into batch and send in chunks
+                    char byte = buffer[i];
                     usbTxBatch[usbTxCount++] = static_cast<uint8_t>(byte);
                     TickType_t now = tt_kernel_get_ticks();
                     bool timeToFlush = (now - usbTxLastFlush) > (20 / portTICK_PERIOD_MS);
@@ -258,14 +265,16 @@ class ConsoleView final : public View {
                         usbTxLastFlush = now;
                     }
                 }
-    
-                // Store in display buffer and log to SD card if enabled
-                mutex.lock();
-                if (sdLoggingEnabled && sdLogFile != nullptr) {
-                    fwrite(&byte, 1, 1, sdLogFile);
-                    // Flush periodically (every 512 bytes handled by circular buffer)
-                }
-                receiveBuffer[receiveBufferPosition++] = byte;
+            }
+
+            // Store in display buffer and log to SD card if enabled
+            mutex.lock();
+            if (sdLoggingEnabled && sdLogFile != nullptr) {
+                fwrite(buffer, 1, bytes_read, sdLogFile);
+                // Flush periodically (every 512 bytes handled by circular buffer)
+            }
+            for (size_t i = 0; i < bytes_read; i++) {
+                receiveBuffer[receiveBufferPosition++] = buffer[i];
                 if (receiveBufferPosition == receiveBufferSize) {
                     receiveBufferPosition = 0;
                     // Flush SD log when buffer wraps
@@ -273,9 +282,8 @@ class ConsoleView final : public View {
                         fflush(sdLogFile);
                     }
                 }
-                mutex.unlock();
             }
-
+            mutex.unlock();
         }
 
         return 0;
@@ -0,0 +1,318 @@
+import os
+import struct
+import sys
+import zlib
+
+# Creates a read-only asset pack from a directory (e.g. Data/system):
+# - PNG files are decoded into LVGL image data with the color format of the target, optionally LZ4-compressed
+# - Other files are stored as-is
+# The runtime counterpart is TactilityCore/Source/file/AssetPack.cpp
+
+if sys.platform == "win32":
+    SHELL_COLOR_RED = ""
+    SHELL_COLOR_RESET = ""
+else:
+    SHELL_COLOR_RED = "\033[91m"
+    SHELL_COLOR_RESET = "\033[m"
+
+PACK_MAGIC = b"TTAP"
+PACK_VERSION = 1
+PACK_HEADER_SIZE = 16
+INDEX_ENTRY_SIZE = 24
+
+ENTRY_TYPE_FILE = 0
+ENTRY_TYPE_IMAGE = 1
+ENTRY_FLAG_LZ4 = 0x01
+
+LV_IMAGE_HEADER_MAGIC = 0x19
+COLOR_FORMATS = {
+    "ARGB8888": 0x10,
+    "RGB565A8": 0x14
+}
+
+def print_error(message):
+    print(f"{SHELL_COLOR_RED}ERROR: {message}{SHELL_COLOR_RESET}")
+
+def exit_with_error(message):
+    print_error(message)
+    sys.exit(1)
+
+def print_help():
+    print("Usage: python asset-pack.py [source_directory] [output_file] [arguments]\n\n")
+    print("\t[source_directory]     the directory with the assets (e.g. Data/system)")
+    print("\t[output_file]          the asset pack to create")
+    print("\n")
+    print("Optional arguments:\n")
+    print("\t--color-format=[name]  the color format of images: ARGB8888 (default) or RGB565A8")
+    print("\t--lz4                  compress images with LZ4")
+
+def fnv1a(text: str):
+    result = 0x811C9DC5
+    for byte in text.encode("utf-8"):
+        result = ((result ^ byte) * 0x01000193) & 0xFFFFFFFF
+    return result
+
+# region PNG
+
+def paeth(left, up, up_left):
+    estimate = left + up - up_left
+    distance_left = abs(estimate - left)
+    distance_up = abs(estimate - up)
+    distance_up_left = abs(estimate - up_left)
+    if distance_left <= distance_up and distance_left <= distance_up_left:
+        return left
+    elif distance_up <= distance_up_left:
+        return up
+    else:
+        return up_left
+
+def unfilter(data: bytes, width: int, height: int, bytes_per_pixel: int):
+    stride = width * bytes_per_pixel
+    result = bytearray(stride * height)
+    previous = bytearray(stride)
+    offset = 0
+    for y in range(height):
+        filter_type = data[offset]
+        line = bytearray(data[offset + 1:offset + 1 + stride])
+        offset += 1 + stride
+        for x in range(stride):
+            left = line[x - bytes_per_pixel] if x >= bytes_per_pixel else 0
+            up = previous[x]
+            up_left = previous[x - bytes_per_pixel] if x >= bytes_per_pixel else 0
+            if filter_type == 1:
+                line[x] = (line[x] + left) & 0xFF
+            elif filter_type == 2:
+                line[x] = (line[x] + up) & 0xFF
+            elif filter_type == 3:
+                line[x] = (line[x] + ((left + up) >> 1)) & 0xFF
+            elif filter_type == 4:
+                line[x] = (line[x] + paeth(left, up, up_left)) & 0xFF
+            elif filter_type != 0:
+                raise ValueError(f"unknown filter type {filter_type}")
+        result[y * stride:(y + 1) * stride] = line
+        previous = line
+    return result
+
+def decode_png(path: str):
+    """:return: width, height and RGBA pixels"""
+    with open(path, "rb") as file:
+        data = file.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+    offset = 8
+    image_data = bytearray()
+    palette = b""
+    transparency = b""
+    width = height = color_type = 0
+    while offset < len(data):
+        length, chunk_type = struct.unpack(">I4s", data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        offset += 12 + length
+        if chunk_type == b"IHDR":
+            width, height, bit_depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            if bit_depth != 8 or interlace != 0:
+                raise ValueError("only non-interlaced PNG files with a bit depth of 8 are supported")
+        elif chunk_type == b"PLTE":
+            palette = chunk
+        elif chunk_type == b"tRNS":
+            transparency = chunk
+        elif chunk_type == b"IDAT":
+            image_data += chunk
+        elif chunk_type == b"IEND":
+            break
+
+    channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }.get(color_type)
+    if channels is None:
+        raise ValueError(f"unsupported color type {color_type}")
+    pixels = unfilter(zlib.decompress(bytes(image_data)), width, height, channels)
+
+    rgba = bytearray(width * height * 4)
+    for index in range(width * height):
+        source = pixels[index * channels:(index + 1) * channels]
+        if color_type == 0:
+            rgba[index * 4:index * 4 + 4] = bytes((source[0], source[0], source[0], 255))
+        elif color_type == 2:
+            rgba[index * 4:index * 4 + 4] = bytes((source[0], source[1], source[2], 255))
+        elif color_type == 3:
+            palette_index = source[0]
+            alpha = transparency[palette_index] if palette_index < len(transparency) else 255
+            rgba[index * 4:index * 4 + 4] = palette[palette_index * 3:palette_index * 3 + 3] + bytes((alpha,))
+        elif color_type == 4:
+            rgba[index * 4:index * 4 + 4] = bytes((source[0], source[0], source[0], source[1]))
+        else:
+            rgba[index * 4:index * 4 + 4] = source
+    return width, height, rgba
+
+# endregion
+
+# region LVGL image
+
+def to_lvgl_image(width: int, height: int, rgba: bytearray, color_format: str):
+    """:return: the lv_image_header_t and the pixel data"""
+    if color_format == "ARGB8888":
+        stride = width * 4
+        pixels = bytearray(width * height * 4)
+        for index in range(width * height):
+            red, green, blue, alpha = rgba[index * 4:index * 4 + 4]
+            pixels[index * 4:index * 4 + 4] = bytes((blue, green, red, alpha))
+    else:
+        # The color plane is followed by the alpha plane
+        stride = width * 2
+        pixels = bytearray(width * height * 3)
+        alpha_offset = width * height * 2
+        for index in range(width * height):
+            red, green, blue, alpha = rgba[index * 4:index * 4 + 4]
+            color = ((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3)
+            struct.pack_into("<H", pixels, index * 2, color)
+            pixels[alpha_offset + index] = alpha
+    header = struct.pack("<BBHHHHH", LV_IMAGE_HEADER_MAGIC, COLOR_FORMATS[color_format], 0, width, height, stride, 0)
+    return header, bytes(pixels)
+
+# endregion
+
+# region LZ4
+
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5
+LZ4_MATCH_FIND_LIMIT = 12
+
+def write_lz4_length(output: bytearray, length: int):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+    output.append(length)
+
+def write_lz4_sequence(output: bytearray, literals: bytes, offset: int, match_length: int):
+    literal_length = len(literals)
+    token = min(literal_length, 15) << 4
+    if match_length > 0:
+        token |= min(match_length - LZ4_MIN_MATCH, 15)
+    output.append(token)
+    if literal_length >= 15:
+        write_lz4_length(output, literal_length - 15)
+    output += literals
+    if match_length > 0:
+        output += struct.pack("<H", offset)
+        if match_length - LZ4_MIN_MATCH >= 15:
+            write_lz4_length(output, match_length - LZ4_MIN_MATCH - 15)
+
+def compress_lz4(data: bytes):
+    """A greedy compressor for the LZ4 block format"""
+    output = bytearray()
+    positions = {}
+    anchor = 0
+    index = 0
+    match_start_limit = len(data) - LZ4_MATCH_FIND_LIMIT
+    while index < match_start_limit:
+        sequence = data[index:index + LZ4_MIN_MATCH]
+        candidate = positions.get(sequence)
+        positions[sequence] = index
+        if candidate is not None and index - candidate <= 0xFFFF:
+            match_length = LZ4_MIN_MATCH
+            match_length_limit = len(data) - LZ4_LAST_LITERALS - index
+            while match_length < match_length_limit and data[candidate + match_length] == data[index + match_length]:
+                match_length += 1
+            write_lz4_sequence(output, data[anchor:index], index - candidate, match_length)
+            index += match_length
+            anchor = index
+        else:
+            index += 1
+    write_lz4_sequence(output, data[anchor:], 0, 0)
+    return bytes(output)
+
+# endregion
+
+def create_entries(source_directory: str, color_format: str, lz4: bool):
+    entries = []
+    for directory, _, file_names in os.walk(source_directory):
+        for file_name in sorted(file_names):
+            path = os.path.join(directory, file_name)
+            name = os.path.relpath(path, source_directory).replace(os.sep, "/")
+            if file_name.lower().endswith(".png"):
+                try:
+                    width, height, rgba = decode_png(path)
+                except ValueError as error:
+                    exit_with_error(f"Failed to decode {path}: {error}")
+                header, pixels = to_lvgl_image(width, height, rgba, color_format)
+                compressed_pixels = compress_lz4(pixels) if lz4 else pixels
+                if lz4 and len(compressed_pixels) < len(pixels):
+                    entries.append((name, ENTRY_TYPE_IMAGE, ENTRY_FLAG_LZ4, header + compressed_pixels, len(header) + len(pixels)))
+                else:
+                    entries.append((name, ENTRY_TYPE_IMAGE, 0, header + pixels, len(header) + len(pixels)))
+            else:
+                with open(path, "rb") as file:
+                    data = file.read()
+                entries.append((name, ENTRY_TYPE_FILE, 0, data, len(data)))
+    # The index is sorted by hash, so the runtime can use a binary search
+    entries.sort(key=lambda entry: (fnv1a(entry[0]), entry[0]))
+    return entries
+
+def align(offset: int):
+    return (offset + 3) & ~3
+
+def write_pack(output_path: str, entries):
+    names_offset = PACK_HEADER_SIZE + INDEX_ENTRY_SIZE * len(entries)
+    names = bytearray()
+    name_offsets = []
+    for name, _, _, _, _ in entries:
+        name_offsets.append(names_offset + len(names))
+        names += name.encode("utf-8")
+
+    # Image data is aligned, so LVGL can use it directly from the memory-mapped pack
+    data_offset = align(names_offset + len(names))
+    index = bytearray()
+    data = bytearray()
+    for (name, entry_type, flags, entry_data, original_size), name_offset in zip(entries, name_offsets):
+        offset = data_offset + len(data)
+        index += struct.pack(
+            "<IIHBBIII",
+            fnv1a(name),
+            name_offset,
+            len(name.encode("utf-8")),
+            entry_type,
+            flags,
+            offset,
+            len(entry_data),
+            original_size
+        )
+        data += entry_data
+        data += bytes(align(len(data)) - len(data))
+
+    header = struct.pack("<4sHHII", PACK_MAGIC, PACK_VERSION, 0, len(entries), names_offset)
+    with open(output_path, "wb") as file:
+        file.write(header)
+        file.write(index)
+        file.write(names)
+        file.write(bytes(data_offset - names_offset - len(names)))
+        file.write(data)
+    return data_offset + len(data)
+
+def main():
+    arguments = [argument for argument in sys.argv[1:] if not argument.startswith("--")]
+    options = [argument for argument in sys.argv[1:] if argument.startswith("--")]
+    if "--help" in options or len(arguments) != 2:
+        print_help()
+        sys.exit(0 if "--help" in options else 1)
+
+    color_format = "ARGB8888"
+    lz4 = False
+    for option in options:
+        if option.startswith("--color-format="):
+            color_format = option.split("=", 1)[1]
+            if color_format not in COLOR_FORMATS:
+                exit_with_error(f"Unsupported color format: {color_format}")
+        elif option == "--lz4":
+            lz4 = True
+        else:
+            exit_with_error(f"Unknown argument: {option}")
+
+    source_directory, output_path = arguments
+    if not os.path.isdir(source_directory):
+        exit_with_error(f"Directory not found: {source_directory}")
+
+    entries = create_entries(source_directory, color_format, lz4)
+    size = write_pack(output_path, entries)
+    print(f"Created {output_path} with {len(entries)} assets ({size // 1024} kB)")
+
+if __name__ == "__main__":
+    main()
@@ -15,3 +15,4 @@ cp version.txt $target_path
 cp $build_path/Firmware/FirmwareSim $target_path/
 cp -r Data/data $target_path/
 cp -r Data/system $target_path/
+python3 Buildscripts/asset-pack.py Data/system $target_path/system.ttpack
@@ -0,0 +1,125 @@
+#include "AssetPackBenchmark.h"
+
+#include <Tactility/Assets.h>
+#include <Tactility/Log.h>
+#include <Tactility/MountPoints.h>
+#include <Tactility/file/AssetPack.h>
+#include <Tactility/file/File.h>
+#include <Tactility/lvgl/AssetPackDecoder.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <iterator>
+
+#define TAG "asset_pack_benchmark"
+
+constexpr uint32_t REPEAT_COUNT = 20;
+constexpr auto* ASSET_PACK_PATH = "system.ttpack";
+
+static const char* boot_files[] = {
+    "timezones.csv",
+    "i18n/core/en-US.i18n",
+    "i18n/core/en-GB.i18n"
+};
+
+static const char* icons[] = {
+    "A:/system/app/Launcher/assets/icon_apps.png",
+    "A:/system/app/Launcher/assets/icon_files.png",
+    "A:/system/app/Launcher/assets/icon_settings.png",
+    TT_ASSETS_APP_ICON_FALLBACK,
+    TT_ASSETS_APP_ICON_FILES,
+    TT_ASSETS_APP_ICON_DISPLAY_SETTINGS,
+    TT_ASSETS_APP_ICON_POWER_SETTINGS,
+    TT_ASSETS_APP_ICON_SETTINGS,
+    TT_ASSETS_APP_ICON_SYSTEM_INFO,
+    TT_ASSETS_APP_ICON_TIME_DATE_SETTINGS
+};
+
+bool asset_pack_benchmark_is_enabled() {
+    const char* value = getenv("TACTILITY_ASSET_PACK_BENCHMARK");
+    return value != nullptr && strcmp(value, "1") == 0;
+}
+
+/** Like TextResources: check that the file exists and read its lines */
+static void read_boot_files() {
+    for (const auto* boot_file : boot_files) {
+        auto path = std::format("{}/{}", tt::file::MOUNT_POINT_SYSTEM, boot_file);
+        uint32_t line_count = 0;
+        if (!tt::file::isFile(path) || !tt::file::readLines(path, true, [&line_count](const char* line) { line_count++; })) {
+            TT_LOG_E(TAG, "Failed to read %s", path.c_str());
+        }
+    }
+}
+
+/** Like the launcher followed by the app list: create the screen, render it and delete it */
+static void open_screen(lv_display_t* display) {
+    auto* screen = lv_obj_create(nullptr);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    for (const auto* icon : icons) {
+        auto* image = lv_image_create(screen);
+        lv_image_set_src(image, icon);
+    }
+    lv_screen_load(screen);
+    lv_refr_now(display);
+    lv_obj_delete(screen);
+}
+
+/** @return the average duration of the function in microseconds */
+template<typename Function>
+static int64_t measure(Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < REPEAT_COUNT; i++) {
+        function();
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / REPEAT_COUNT;
+}
+
+static void log_duration(const char* description, int64_t duration) {
+    TT_LOG_I(TAG, "%s: %lld.%03lld ms", description, (long long)(duration / 1000), (long long)(duration % 1000));
+}
+
+void asset_pack_benchmark_run(lv_display_t* display) {
+    size_t size;
+    auto* data = tt::file::readBinary(ASSET_PACK_PATH, size).release();
+    if (data == nullptr) {
+        TT_LOG_E(TAG, "%s not found: create it with Buildscripts/asset-pack.py", ASSET_PACK_PATH);
+        return;
+    }
+
+    auto pack = std::make_shared<tt::file::AssetPack>(data, size, [data] { delete[] data; });
+    if (!pack->isValid()) {
+        TT_LOG_E(TAG, "Invalid %s", ASSET_PACK_PATH);
+        return;
+    }
+
+    tt::lvgl::initAssetPackDecoder();
+
+    auto* default_display = lv_display_get_default();
+    lv_display_set_default(display);
+    auto* active_screen = lv_display_get_screen_active(display);
+
+    // Measure the decoding: the image cache service isn't running yet
+    lv_image_cache_resize(0, true);
+    lv_image_header_cache_resize(0, true);
+
+    tt::file::setAssetPack(tt::file::MOUNT_POINT_SYSTEM, nullptr);
+    const auto boot_loose = measure(read_boot_files);
+    const auto launcher_loose = measure([display] { open_screen(display); });
+
+    tt::file::setAssetPack(tt::file::MOUNT_POINT_SYSTEM, pack);
+    const auto boot_pack = measure(read_boot_files);
+    const auto launcher_pack = measure([display] { open_screen(display); });
+
+    TT_LOG_I(TAG, "Read %d boot files and opened a screen with %d icons %lu times", (int)std::size(boot_files), (int)std::size(icons), (unsigned long)REPEAT_COUNT);
+    log_duration("Boot files from loose files", boot_loose);
+    log_duration("Boot files from the asset pack", boot_pack);
+    log_duration("Launcher from loose files", launcher_loose);
+    log_duration("Launcher from the asset pack", launcher_pack);
+
+    // The pack stays in use: it has the same content as the system asset pack that was loaded at boot
+    lv_screen_load(active_screen);
+    lv_display_set_default(default_display);
+}
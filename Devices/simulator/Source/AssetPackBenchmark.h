@@ -0,0 +1,14 @@
+#pragma once
+
+#include <lvgl.h>
+
+/** @return true when the asset pack benchmark is enabled with the environment variable TACTILITY_ASSET_PACK_BENCHMARK=1 */
+bool asset_pack_benchmark_is_enabled();
+
+/**
+ * Reads the system files that are used during boot and opens a screen with the launcher and app list icons repeatedly,
+ * first from the loose files in the system directory and then from system.ttpack, and logs the time that it takes.
+ * Create system.ttpack in the working directory with: python3 Buildscripts/asset-pack.py Data/system system.ttpack
+ * Must be called from the LVGL task, with the LVGL lock held and before the image cache service starts.
+ */
+void asset_pack_benchmark_run(lv_display_t* display);
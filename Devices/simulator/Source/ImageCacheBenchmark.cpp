@@ -0,0 +1,91 @@
+#include "ImageCacheBenchmark.h"
+
+#include <Tactility/Assets.h>
+#include <Tactility/Log.h>
+#include <Tactility/service/imagecache/ImageCache.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#define TAG "image_cache_benchmark"
+
+constexpr uint32_t OPEN_COUNT = 20;
+constexpr uint32_t HEADER_CACHE_COUNT = 64;
+
+static const char* launcher_icons[] = {
+    "A:/system/app/Launcher/assets/icon_apps.png",
+    "A:/system/app/Launcher/assets/icon_files.png",
+    "A:/system/app/Launcher/assets/icon_settings.png"
+};
+
+static const char* app_list_icons[] = {
+    TT_ASSETS_APP_ICON_FALLBACK,
+    TT_ASSETS_APP_ICON_FILES,
+    TT_ASSETS_APP_ICON_DISPLAY_SETTINGS,
+    TT_ASSETS_APP_ICON_POWER_SETTINGS,
+    TT_ASSETS_APP_ICON_I2C_SETTINGS,
+    TT_ASSETS_APP_ICON_SETTINGS,
+    TT_ASSETS_APP_ICON_SYSTEM_INFO,
+    TT_ASSETS_APP_ICON_TIME_DATE_SETTINGS,
+    TT_ASSETS_APP_ICON_NOTES,
+    TT_ASSETS_APP_ICON_CHAT,
+    TT_ASSETS_APP_ICON_GPIO
+};
+
+bool image_cache_benchmark_is_enabled() {
+    const char* value = getenv("TACTILITY_IMAGE_CACHE_BENCHMARK");
+    return value != nullptr && strcmp(value, "1") == 0;
+}
+
+/** Like the launcher followed by the app list: create the screen, render it and delete it */
+static void open_screen(lv_display_t* display) {
+    auto* screen = lv_obj_create(nullptr);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    for (const auto* icon : launcher_icons) {
+        auto* image = lv_image_create(screen);
+        lv_image_set_src(image, icon);
+    }
+    for (const auto* icon : app_list_icons) {
+        auto* image = lv_image_create(screen);
+        lv_image_set_src(image, icon);
+    }
+    lv_screen_load(screen);
+    lv_refr_now(display);
+    lv_obj_delete(screen);
+}
+
+/** @return the average time to open the screen in microseconds */
+static int64_t measure(lv_display_t* display, uint32_t budget, uint32_t headerCount) {
+    lv_image_cache_resize(budget, true);
+    lv_image_header_cache_resize(headerCount, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < OPEN_COUNT; i++) {
+        open_screen(display);
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    // Leave the caches like LVGL is configured, for the image cache service
+    lv_image_cache_resize(0, true);
+    lv_image_header_cache_resize(0, true);
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / OPEN_COUNT;
+}
+
+void image_cache_benchmark_run(lv_display_t* display) {
+    auto* default_display = lv_display_get_default();
+    lv_display_set_default(display);
+    auto* active_screen = lv_display_get_screen_active(display);
+
+    const auto budget = tt::service::imagecache::getDefaultBudget();
+    const auto without_cache = measure(display, 0, 0);
+    const auto with_cache = measure(display, budget, HEADER_CACHE_COUNT);
+
+    TT_LOG_I(TAG, "Opened a screen with %d icons %lu times", (int)(std::size(launcher_icons) + std::size(app_list_icons)), (unsigned long)OPEN_COUNT);
+    TT_LOG_I(TAG, "Without cache: %lld.%03lld ms per open", (long long)(without_cache / 1000), (long long)(without_cache % 1000));
+    TT_LOG_I(TAG, "With a %lu kB cache: %lld.%03lld ms per open", (unsigned long)(budget / 1024), (long long)(with_cache / 1000), (long long)(with_cache % 1000));
+
+    lv_screen_load(active_screen);
+    lv_display_set_default(default_display);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <lvgl.h>
+
+/** @return true when the image cache benchmark is enabled with the environment variable TACTILITY_IMAGE_CACHE_BENCHMARK=1 */
+bool image_cache_benchmark_is_enabled();
+
+/**
+ * Opens a screen with the launcher and app list icons repeatedly, first without the image cache and then with the
+ * budget of the image cache service, and logs the time to open it.
+ * Must be called from the LVGL task, with the LVGL lock held and before the image cache service starts.
+ */
+void image_cache_benchmark_run(lv_display_t* display);
@@ -1,10 +1,15 @@
 #include "LvglTask.h"
+#include "AssetPackBenchmark.h"
+#include "ImageCacheBenchmark.h"
+#include "RenderBenchmark.h"
 
 #include <Tactility/Log.h>
 #include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/Mutex.h>
 #include <Tactility/Thread.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <lvgl.h>
 
 #define TAG "lvgl_task"
@@ -18,6 +23,7 @@ static uint32_t task_max_sleep_ms = 10;
 static bool task_running = false;
 
 lv_disp_t* displayHandle = nullptr;
+lv_disp_t* secondaryDisplayHandle = nullptr;
 
 static void lvgl_task(void* arg);
 
@@ -56,6 +62,11 @@ void lvgl_task_interrupt() {
     task_unlock();
 }
 
+bool lvgl_task_has_secondary_display() {
+    const char* value = getenv("TACTILITY_SECONDARY_DISPLAY");
+    return value != nullptr && strcmp(value, "1") == 0;
+}
+
 void lvgl_task_start() {
     TT_LOG_I(TAG, "lvgl task starting");
 
@@ -83,6 +94,29 @@ static void lvgl_task(TT_UNUSED void* arg) {
     displayHandle = lv_sdl_window_create(320, 240);
     lv_sdl_window_set_title(displayHandle, "Tactility");
 
+    // A small status panel, like an SSD1306 next to the main display
+    if (lvgl_task_has_secondary_display()) {
+        secondaryDisplayHandle = lv_sdl_window_create(128, 64);
+        lv_sdl_window_set_title(secondaryDisplayHandle, "Tactility (secondary)");
+        // Keep the main window as the default display
+        lv_display_set_default(displayHandle);
+    }
+
+    if (render_benchmark_is_enabled() && lvgl_lock(1000)) {
+        render_benchmark_run(displayHandle);
+        lvgl_unlock();
+    }
+
+    if (image_cache_benchmark_is_enabled() && lvgl_lock(1000)) {
+        image_cache_benchmark_run(displayHandle);
+        lvgl_unlock();
+    }
+
+    if (asset_pack_benchmark_is_enabled() && lvgl_lock(1000)) {
+        asset_pack_benchmark_run(displayHandle);
+        lvgl_unlock();
+    }
+
     uint32_t task_delay_ms = task_max_sleep_ms;
 
     task_set_running(true);
@@ -100,6 +134,10 @@ static void lvgl_task(TT_UNUSED void* arg) {
         vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
     }
 
+    if (secondaryDisplayHandle != nullptr) {
+        lv_disp_remove(secondaryDisplayHandle);
+        secondaryDisplayHandle = nullptr;
+    }
     lv_disp_remove(displayHandle);
     displayHandle = nullptr;
     vTaskDelete(nullptr);
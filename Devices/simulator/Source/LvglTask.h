@@ -3,3 +3,6 @@
 void lvgl_task_start();
 bool lvgl_task_is_running();
 void lvgl_task_interrupt();
+
+/** @return true when the simulator opens a second window, which is set with the environment variable TACTILITY_SECONDARY_DISPLAY=1 */
+bool lvgl_task_has_secondary_display();
@@ -35,6 +35,8 @@ void freertosMain() {
 
     assert(task_result == pdTRUE);
 
+    tt::startLogThread();
+
     // Blocks forever
     vTaskStartScheduler();
 }
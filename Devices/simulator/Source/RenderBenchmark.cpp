@@ -0,0 +1,139 @@
+#include "RenderBenchmark.h"
+
+#include <Tactility/Log.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#define TAG "render_benchmark"
+
+constexpr uint32_t FRAMES_PER_SCREEN = 50;
+
+constexpr auto* LOREM_IPSUM = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+
+struct BenchmarkScreen {
+    const char* name;
+    void (*create)(lv_obj_t* screen);
+};
+
+static lv_obj_t* create_card(lv_obj_t* parent, int32_t width, int32_t height) {
+    auto* card = lv_obj_create(parent);
+    lv_obj_set_size(card, width, height);
+    lv_obj_set_style_radius(card, 12, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(card, lv_palette_main(LV_PALETTE_BLUE), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_darken(LV_PALETTE_INDIGO, 3), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(card, 16, LV_PART_MAIN);
+    lv_obj_set_style_shadow_spread(card, 2, LV_PART_MAIN);
+    lv_obj_set_style_shadow_color(card, lv_color_black(), LV_PART_MAIN);
+    lv_obj_remove_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+    return card;
+}
+
+/** Gradients, rounded corners and shadows */
+static void create_cards_screen(lv_obj_t* screen) {
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    for (int i = 0; i < 12; i++) {
+        auto* card = create_card(screen, 90, 60);
+        auto* label = lv_label_create(card);
+        lv_label_set_text_fmt(label, "Card %d", i);
+        lv_obj_center(label);
+    }
+}
+
+/** Semi-transparent widgets are rendered in a layer first, and then blended */
+static void create_layers_screen(lv_obj_t* screen) {
+    for (int i = 0; i < 6; i++) {
+        auto* panel = create_card(screen, 200, 140);
+        lv_obj_set_pos(panel, i * 20, i * 16);
+        lv_obj_set_style_opa(panel, LV_OPA_60, LV_PART_MAIN);
+        auto* label = lv_label_create(panel);
+        lv_label_set_text(label, LOREM_IPSUM);
+        lv_obj_set_width(label, LV_PCT(100));
+    }
+}
+
+/** Transformed widgets are rendered in a layer first, and then rotated */
+static void create_rotated_screen(lv_obj_t* screen) {
+    auto* container = create_card(screen, 240, 160);
+    lv_obj_center(container);
+    lv_obj_set_style_transform_rotation(container, 150, LV_PART_MAIN);
+    lv_obj_set_style_transform_pivot_x(container, 120, LV_PART_MAIN);
+    lv_obj_set_style_transform_pivot_y(container, 80, LV_PART_MAIN);
+    for (int i = 0; i < 3; i++) {
+        auto* arc = lv_arc_create(container);
+        lv_obj_set_size(arc, 64, 64);
+        lv_obj_set_pos(arc, i * 72, 0);
+        lv_arc_set_value(arc, 30 * (i + 1));
+    }
+    auto* label = lv_label_create(container);
+    lv_label_set_text(label, LOREM_IPSUM);
+    lv_obj_set_width(label, LV_PCT(100));
+    lv_obj_align(label, LV_ALIGN_BOTTOM_MID, 0, 0);
+}
+
+/** Lots of anti-aliased text */
+static void create_text_screen(lv_obj_t* screen) {
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < 8; i++) {
+        auto* label = lv_label_create(screen);
+        lv_label_set_text(label, LOREM_IPSUM);
+        lv_obj_set_width(label, LV_PCT(100));
+    }
+}
+
+static const BenchmarkScreen benchmark_screens[] = {
+    { .name = "cards", .create = create_cards_screen },
+    { .name = "layers", .create = create_layers_screen },
+    { .name = "rotated", .create = create_rotated_screen },
+    { .name = "text", .create = create_text_screen }
+};
+
+bool render_benchmark_is_enabled() {
+    const char* value = getenv("TACTILITY_RENDER_BENCHMARK");
+    return value != nullptr && strcmp(value, "1") == 0;
+}
+
+/** @return the average render time of a full frame in microseconds */
+static int64_t render_screen(lv_display_t* display, const BenchmarkScreen& benchmarkScreen) {
+    auto* screen = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(screen, lv_palette_darken(LV_PALETTE_GREY, 4), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_color(screen, lv_palette_main(LV_PALETTE_TEAL), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_dir(screen, LV_GRAD_DIR_HOR, LV_PART_MAIN);
+    benchmarkScreen.create(screen);
+    lv_screen_load(screen);
+
+    // The first frame also includes the layout
+    lv_refr_now(display);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAMES_PER_SCREEN; frame++) {
+        lv_obj_invalidate(screen);
+        lv_refr_now(display);
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    lv_obj_delete(screen);
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / FRAMES_PER_SCREEN;
+}
+
+void render_benchmark_run(lv_display_t* display) {
+    auto* default_display = lv_display_get_default();
+    lv_display_set_default(display);
+    auto* active_screen = lv_display_get_screen_active(display);
+
+    TT_LOG_I(TAG, "Rendering %lu frames per screen with %d draw units", (unsigned long)FRAMES_PER_SCREEN, LV_DRAW_SW_DRAW_UNIT_CNT);
+    int64_t total_micros = 0;
+    for (const auto& benchmark_screen : benchmark_screens) {
+        const auto frame_micros = render_screen(display, benchmark_screen);
+        total_micros += frame_micros;
+        TT_LOG_I(TAG, "%s: %lld.%03lld ms per frame", benchmark_screen.name, (long long)(frame_micros / 1000), (long long)(frame_micros % 1000));
+    }
+    const int64_t mean_micros = total_micros / static_cast<int64_t>(std::size(benchmark_screens));
+    TT_LOG_I(TAG, "Mean: %lld.%03lld ms per frame", (long long)(mean_micros / 1000), (long long)(mean_micros % 1000));
+
+    lv_screen_load(active_screen);
+    lv_display_set_default(default_display);
+}
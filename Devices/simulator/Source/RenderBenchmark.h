@@ -0,0 +1,13 @@
+#pragma once
+
+#include <lvgl.h>
+
+/** @return true when the render benchmark is enabled with the environment variable TACTILITY_RENDER_BENCHMARK=1 */
+bool render_benchmark_is_enabled();
+
+/**
+ * Renders a fixed set of heavy screens on the display and logs the render time per frame.
+ * Run it once with the default build and once with -DTACTILITY_LVGL_DRAW_UNIT_COUNT=N to compare the draw units.
+ * Must be called from the LVGL task, with the LVGL lock held. The active screen is restored afterwards.
+ */
+void render_benchmark_run(lv_display_t* display);
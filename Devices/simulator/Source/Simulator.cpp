@@ -28,13 +28,22 @@ TT_UNUSED static void deinitPower() {
 #endif
 }
 
+// Matches the cost of a 128x64 monochrome I2C panel
+constexpr uint32_t SECONDARY_DISPLAY_REFRESH_PERIOD = 100;
+
 static std::vector<std::shared_ptr<Device>> createDevices() {
-    return {
+    std::vector<std::shared_ptr<Device>> devices = {
         std::make_shared<SdlDisplay>(),
         std::make_shared<SdlKeyboard>(),
         std::make_shared<SimulatorPower>(),
         std::make_shared<SimulatorSdCard>()
     };
+
+    if (lvgl_task_has_secondary_display()) {
+        devices.push_back(std::make_shared<SdlDisplay>(&secondaryDisplayHandle, "SDL Secondary Display", SECONDARY_DISPLAY_REFRESH_PERIOD));
+    }
+
+    return devices;
 }
 
 extern const Configuration hardwareConfiguration = {
@@ -2,26 +2,54 @@
 
 #include "SdlTouch.h"
 #include <Tactility/hal/display/DisplayDevice.h>
+#include <Tactility/hal/display/DisplayStatistics.h>
 
-/** Hack: variable comes from LvglTask.cpp */
+/** Hack: variables come from LvglTask.cpp */
 extern lv_disp_t* displayHandle;
+extern lv_disp_t* secondaryDisplayHandle;
 
 class SdlDisplay final : public tt::hal::display::DisplayDevice {
 
+    /** Points to the handle variable, because the LVGL task creates the window after the device is created */
+    lv_disp_t* const* handle;
+    std::string name;
+    uint32_t refreshPeriod;
+    std::shared_ptr<SdlTouch> touch = std::make_shared<SdlTouch>();
+    std::shared_ptr<tt::hal::display::DisplayStatistics> statistics = std::make_shared<tt::hal::display::DisplayStatistics>();
+
 public:
 
-    std::string getName() const override { return "SDL Display"; }
+    /**
+     * @param[in] handle the variable that holds the SDL window display
+     * @param[in] name the device name
+     * @param[in] refreshPeriod the LVGL refresh period in milliseconds, or 0 for the default
+     */
+    explicit SdlDisplay(lv_disp_t* const* handle = &displayHandle, std::string name = "SDL Display", uint32_t refreshPeriod = 0) :
+        handle(handle),
+        name(std::move(name)),
+        refreshPeriod(refreshPeriod)
+    {}
+
+    std::string getName() const override { return name; }
     std::string getDescription() const override { return ""; }
 
     bool start() override { return true; }
     bool stop() override { tt_crash("Not supported"); }
 
     bool supportsLvgl() const override { return true; }
-    bool startLvgl() override { return displayHandle != nullptr; }
+    bool startLvgl() override {
+        if (*handle == nullptr) {
+            return false;
+        }
+        statistics->attach(*handle);
+        return true;
+    }
     bool stopLvgl() override { tt_crash("Not supported"); }
-    lv_display_t* _Nullable getLvglDisplay() const override { return displayHandle; }
+    lv_display_t* _Nullable getLvglDisplay() const override { return *handle; }
+    uint32_t getLvglRefreshPeriod() const override { return refreshPeriod; }
+    std::shared_ptr<tt::hal::display::DisplayStatistics> _Nullable getStatistics() override { return statistics; }
 
-    std::shared_ptr<tt::hal::touch::TouchDevice> _Nullable getTouchDevice() override { return std::make_shared<SdlTouch>(); }
+    std::shared_ptr<tt::hal::touch::TouchDevice> _Nullable getTouchDevice() override { return touch; }
 
     bool supportsDisplayDriver() const override { return false; }
     std::shared_ptr<tt::hal::display::DisplayDriver> _Nullable getDisplayDriver() override { return nullptr; }
@@ -21,7 +21,12 @@ public:
 
     bool startLvgl(lv_display_t* display) override {
         handle = lv_sdl_mouse_create();
-        return handle != nullptr;
+        if (handle == nullptr) {
+            return false;
+        }
+        // SDL mouse events are handled by the indev of the window's display
+        lv_indev_set_display(handle, display);
+        return true;
     }
 
     bool stopLvgl() override { tt_crash("Not supported"); }
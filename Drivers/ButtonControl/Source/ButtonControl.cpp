@@ -4,20 +4,29 @@
 
 #include <esp_lvgl_port.h>
 
+#include <algorithm>
+
 constexpr auto* TAG = "ButtonControl";
+constexpr uint32_t LONG_PRESS_MICROS = 500000;
 
 ButtonControl::ButtonControl(const std::vector<PinConfiguration>& pinConfigurations) : pinConfigurations(pinConfigurations) {
     pinStates.resize(pinConfigurations.size());
+    std::vector<tt::hal::gpio::Pin> pins;
     for (const auto& pinConfiguration : pinConfigurations) {
-        tt::hal::gpio::configure(pinConfiguration.pin, tt::hal::gpio::Mode::Input, false, false);
+        // A pin can have a configuration for both a short and a long press
+        if (std::find(pins.begin(), pins.end(), pinConfiguration.pin) == pins.end()) {
+            tt::hal::gpio::configure(pinConfiguration.pin, tt::hal::gpio::Mode::Input, false, false);
+            gpioInput.addButton(pinConfiguration.pin, {
+                .activeLevel = true,
+                .longPressMicros = LONG_PRESS_MICROS
+            });
+            pins.push_back(pinConfiguration.pin);
+        }
     }
 }
 
 ButtonControl::~ButtonControl() {
-    if (driverThread != nullptr && driverThread->getState() != tt::Thread::State::Stopped) {
-        interruptDriverThread = true;
-        driverThread->join();
-    }
+    gpioInput.stop();
 }
 
 void ButtonControl::readCallback(lv_indev_t* indev, lv_indev_data_t* data) {
@@ -57,80 +66,25 @@ void ButtonControl::readCallback(lv_indev_t* indev, lv_indev_data_t* data) {
     }
 }
 
-void ButtonControl::updatePin(std::vector<PinConfiguration>::const_reference configuration, std::vector<PinState>::reference state) {
-    if (tt::hal::gpio::getLevel(configuration.pin)) { // if pressed
-        if (state.pressState) {
-            // check time for long press trigger
-            auto time_passed = tt::kernel::getMillis() - state.pressStartTime;
-            if (time_passed > 500) {
-                // state.triggerLongPress = true;
-            }
-        } else {
-            state.pressStartTime = tt::kernel::getMillis();
-            state.pressState = true;
-        }
-    } else { // released
-        if (state.pressState) {
-            auto time_passed = tt::kernel::getMillis() - state.pressStartTime;
-            if (time_passed < 500) {
-                TT_LOG_D(TAG, "Trigger short press");
-                state.triggerShortPress = true;
-            }
-            state.pressState = false;
-        }
+void ButtonControl::onButtonEvent(tt::hal::gpio::Pin pin, tt::hal::gpio::ButtonEvent event) {
+    if (event != tt::hal::gpio::ButtonEvent::ShortPress && event != tt::hal::gpio::ButtonEvent::LongPress) {
+        return;
     }
-}
 
-void ButtonControl::driverThreadMain() {
-    while (!shouldInterruptDriverThread()) {
-        if (mutex.lock(100)) {
-            for (int i = 0; i < pinConfigurations.size(); i++) {
-                updatePin(pinConfigurations[i], pinStates[i]);
+    if (mutex.lock(100)) {
+        for (int i = 0; i < pinConfigurations.size(); i++) {
+            if (pinConfigurations[i].pin == pin) {
+                if (event == tt::hal::gpio::ButtonEvent::ShortPress) {
+                    TT_LOG_D(TAG, "Trigger short press");
+                    pinStates[i].triggerShortPress = true;
+                } else {
+                    TT_LOG_D(TAG, "Trigger long press");
+                    pinStates[i].triggerLongPress = true;
+                }
             }
-            mutex.unlock();
         }
-        tt::kernel::delayMillis(5);
-    }
-}
-
-bool ButtonControl::shouldInterruptDriverThread() const {
-    bool interrupt = false;
-    if (mutex.lock(50 / portTICK_PERIOD_MS)) {
-        interrupt = interruptDriverThread;
         mutex.unlock();
     }
-    return interrupt;
-}
-
-void ButtonControl::startThread() {
-    TT_LOG_I(TAG, "Start");
-
-    mutex.lock();
-
-    interruptDriverThread = false;
-
-    driverThread = std::make_shared<tt::Thread>("ButtonControl", 4096, [this] {
-        driverThreadMain();
-        return 0;
-    });
-
-    driverThread->start();
-
-    mutex.unlock();
-}
-
-void ButtonControl::stopThread() {
-    TT_LOG_I(TAG, "Stop");
-
-    mutex.lock();
-    interruptDriverThread = true;
-    mutex.unlock();
-
-    driverThread->join();
-
-    mutex.lock();
-    driverThread = nullptr;
-    mutex.unlock();
 }
 
 bool ButtonControl::startLvgl(lv_display_t* display) {
@@ -138,7 +92,10 @@ bool ButtonControl::startLvgl(lv_display_t* display) {
         return false;
     }
 
-    startThread();
+    TT_LOG_I(TAG, "Start");
+    if (!gpioInput.start([this](auto pin, auto event) { onButtonEvent(pin, event); })) {
+        return false;
+    }
 
     deviceHandle = lv_indev_create();
     lv_indev_set_type(deviceHandle, LV_INDEV_TYPE_ENCODER);
@@ -156,7 +113,8 @@ bool ButtonControl::stopLvgl() {
     lv_indev_delete(deviceHandle);
     deviceHandle = nullptr;
 
-    stopThread();
+    TT_LOG_I(TAG, "Stop");
+    gpioInput.stop();
 
     return true;
 }
@@ -2,6 +2,7 @@
 
 #include <Tactility/hal/encoder/EncoderDevice.h>
 #include <Tactility/hal/gpio/Gpio.h>
+#include <Tactility/hal/gpio/GpioInput.h>
 #include <Tactility/TactilityCore.h>
 
 class ButtonControl final : public tt::hal::encoder::EncoderDevice {
@@ -29,31 +30,20 @@ public:
 private:
 
     struct PinState {
-        long pressStartTime = 0;
-        long pressReleaseTime = 0;
-        bool pressState = false;
         bool triggerShortPress = false;
         bool triggerLongPress = false;
     };
 
     lv_indev_t* _Nullable deviceHandle = nullptr;
-    std::shared_ptr<tt::Thread> driverThread;
-    bool interruptDriverThread = false;
+    tt::hal::gpio::GpioInput gpioInput;
     tt::Mutex mutex;
     std::vector<PinConfiguration> pinConfigurations;
     std::vector<PinState> pinStates;
 
-    bool shouldInterruptDriverThread() const;
-
-    static void updatePin(std::vector<PinConfiguration>::const_reference value, std::vector<PinState>::reference pin_state);
-
-    void driverThreadMain();
+    void onButtonEvent(tt::hal::gpio::Pin pin, tt::hal::gpio::ButtonEvent event);
 
     static void readCallback(lv_indev_t* indev, lv_indev_data_t* data);
 
-    void startThread();
-    void stopThread();
-
 public:
 
     explicit ButtonControl(const std::vector<PinConfiguration>& pinConfigurations);
@@ -2,21 +2,64 @@
 #include "EspLcdDisplayDriver.h"
 
 #include <assert.h>
+#include <esp_heap_caps.h>
 #include <esp_lvgl_port_disp.h>
+#include <soc/soc_caps.h>
 #include <Tactility/Check.h>
 #include <Tactility/LogEsp.h>
 #include <Tactility/hal/touch/TouchDevice.h>
 
+#include <algorithm>
+
 constexpr auto* TAG = "EspLcdDispV2";
 
-inline unsigned int getBufferSize(const std::shared_ptr<EspLcdConfiguration>& configuration) {
+// Memory that is kept free for other drivers (e.g. WiFi) when picking a buffering strategy
+constexpr size_t DMA_MEMORY_RESERVE = 64 * 1024;
+constexpr size_t PSRAM_RESERVE = 1024 * 1024;
+
+#if defined(SOC_PSRAM_DMA_CAPABLE) && SOC_PSRAM_DMA_CAPABLE
+constexpr bool PSRAM_DMA_CAPABLE = true;
+#else
+constexpr bool PSRAM_DMA_CAPABLE = false;
+#endif
+
+static const char* toString(EspLcdBuffering buffering) {
+    using enum EspLcdBuffering;
+    switch (buffering) {
+        case Automatic:
+            return "automatic";
+        case Single:
+            return "single";
+        case Double:
+            return "double";
+        case FullFramePsram:
+            return "full-frame PSRAM";
+    }
+    return "?";
+}
+
+inline unsigned int getPartialBufferSize(const std::shared_ptr<EspLcdConfiguration>& configuration) {
     if (configuration->bufferSize != DEFAULT_BUFFER_SIZE) {
         return configuration->bufferSize;
+    } else if (configuration->bufferLines != 0) {
+        return configuration->horizontalResolution * std::min(configuration->bufferLines, configuration->verticalResolution);
     } else {
         return configuration->horizontalResolution * (configuration->verticalResolution / 10);
     }
 }
 
+inline unsigned int getBufferSize(const std::shared_ptr<EspLcdConfiguration>& configuration, EspLcdBuffering buffering) {
+    if (buffering == EspLcdBuffering::FullFramePsram) {
+        return configuration->horizontalResolution * configuration->verticalResolution;
+    } else {
+        return getPartialBufferSize(configuration);
+    }
+}
+
+inline size_t getBufferByteCount(const std::shared_ptr<EspLcdConfiguration>& configuration, unsigned int pixelCount) {
+    return (static_cast<size_t>(pixelCount) * configuration->bitsPerPixel + 7U) / 8U;
+}
+
 EspLcdDisplayV2::~EspLcdDisplayV2() {
     if (displayDriver != nullptr && displayDriver.use_count() > 1) {
         tt_crash("DisplayDriver is still in use. This will cause memory access violations.");
@@ -70,6 +113,50 @@ bool EspLcdDisplayV2::applyConfiguration() const {
     return true;
 }
 
+EspLcdBuffering EspLcdDisplayV2::resolveBuffering() const {
+    using enum EspLcdBuffering;
+
+    // RGB panels have their own frame buffers, and the monochrome conversion needs a partial buffer
+    bool supports_full_frame = PSRAM_DMA_CAPABLE && !isRgbPanel() && !configuration->monochrome;
+    auto requested = configuration->buffering;
+    if (requested == FullFramePsram && !supports_full_frame) {
+        TT_LOG_W(TAG, "Full-frame PSRAM buffering is not supported by this display: falling back to double buffering");
+        requested = Double;
+    }
+
+    // The monochrome conversion and RGB panels manage their own buffering
+    if (requested == Automatic && (isRgbPanel() || configuration->monochrome)) {
+        requested = Single;
+    }
+
+    auto partial_buffer_bytes = getBufferByteCount(configuration, getPartialBufferSize(configuration));
+    auto free_dma = heap_caps_get_free_size(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    auto largest_dma_block = heap_caps_get_largest_free_block(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    bool fits_double = (free_dma >= 2 * partial_buffer_bytes + DMA_MEMORY_RESERVE) && (largest_dma_block >= partial_buffer_bytes);
+
+    auto frame_bytes = getBufferByteCount(configuration, configuration->horizontalResolution * configuration->verticalResolution);
+    auto free_psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    bool fits_full_frame = supports_full_frame && (free_psram >= 2 * frame_bytes + PSRAM_RESERVE);
+
+    switch (requested) {
+        case Automatic:
+            // Full-frame buffering sends the whole frame for every change, so it's only used on request
+            return fits_double ? Double : Single;
+        case Double:
+            if (!fits_double) {
+                TT_LOG_W(TAG, "Not enough DMA memory for double buffering (%zu bytes free)", free_dma);
+            }
+            return Double;
+        case FullFramePsram:
+            if (!fits_full_frame) {
+                TT_LOG_W(TAG, "Not enough PSRAM for full-frame buffering (%zu bytes free)", free_psram);
+            }
+            return FullFramePsram;
+        default:
+            return requested;
+    }
+}
+
 bool EspLcdDisplayV2::start() {
     if (!createIoHandle(ioHandle)) {
         TT_LOG_E(TAG, "Failed to create IO handle");
@@ -124,7 +211,9 @@ bool EspLcdDisplayV2::startLvgl() {
         TT_LOG_W(TAG, "DisplayDriver is still in use.");
     }
 
+    buffering = resolveBuffering();
     auto lvgl_port_config  = getLvglPortDisplayConfig(configuration, ioHandle, panelHandle);
+    TT_LOG_I(TAG, "Buffering: %s, %lu pixels", toString(buffering), lvgl_port_config.buffer_size);
 
     if (isRgbPanel()) {
         auto rgb_config = getLvglPortDisplayRgbConfig(ioHandle, panelHandle);
@@ -133,12 +222,19 @@ bool EspLcdDisplayV2::startLvgl() {
         lvglDisplay = lvgl_port_add_disp(&lvgl_port_config );
     }
 
+    if (lvglDisplay == nullptr) {
+        TT_LOG_E(TAG, "Failed to add display to LVGL");
+        return false;
+    }
+
+    statistics->attach(lvglDisplay);
+
     auto touch_device = getTouchDevice();
     if (touch_device != nullptr && touch_device->supportsLvgl()) {
         touch_device->startLvgl(lvglDisplay);
     }
 
-    return lvglDisplay != nullptr;
+    return true;
 }
 
 bool EspLcdDisplayV2::stopLvgl() {
@@ -151,6 +247,7 @@ bool EspLcdDisplayV2::stopLvgl() {
         touch_device->stopLvgl();
     }
 
+    statistics->detach();
     lvgl_port_remove_disp(lvglDisplay);
     lvglDisplay = nullptr;
     return true;
@@ -161,8 +258,8 @@ lvgl_port_display_cfg_t EspLcdDisplayV2::getLvglPortDisplayConfig(std::shared_pt
         .io_handle = ioHandle,
         .panel_handle = panelHandle,
         .control_handle = nullptr,
-        .buffer_size = getBufferSize(configuration),
-        .double_buffer = false,
+        .buffer_size = getBufferSize(configuration, buffering),
+        .double_buffer = (buffering == EspLcdBuffering::Double || buffering == EspLcdBuffering::FullFramePsram),
         .trans_size = 0,
         .hres = configuration->horizontalResolution,
         .vres = configuration->verticalResolution,
@@ -175,10 +272,11 @@ lvgl_port_display_cfg_t EspLcdDisplayV2::getLvglPortDisplayConfig(std::shared_pt
         .color_format = configuration->lvglColorFormat,
         .flags = {
             .buff_dma = 1,
-            .buff_spiram = 0,
+            .buff_spiram = (buffering == EspLcdBuffering::FullFramePsram),
             .sw_rotate = 0,
             .swap_bytes = configuration->lvglSwapBytes,
-            .full_refresh = 0,
+            // SPI and I80 panels can't use direct mode: esp_lvgl_port would send the changed areas from the start of the frame
+            .full_refresh = (buffering == EspLcdBuffering::FullFramePsram),
             .direct_mode = 0
         }
     };
@@ -4,12 +4,25 @@
 #include <Tactility/Check.h>
 #include <Tactility/Lock.h>
 #include <Tactility/hal/display/DisplayDevice.h>
+#include <Tactility/hal/display/DisplayStatistics.h>
 
 #include <esp_lcd_types.h>
 #include <esp_lvgl_port_disp.h>
 
 constexpr auto DEFAULT_BUFFER_SIZE = 0;
 
+/** How LVGL renders into memory before the pixels are sent to the display */
+enum class EspLcdBuffering {
+    /** Pick double or single buffering based on the free DMA memory when LVGL starts */
+    Automatic,
+    /** One partial buffer in DMA memory: LVGL waits for every flush to finish before it renders again */
+    Single,
+    /** Two partial buffers in DMA memory: LVGL renders into one buffer while the other one is sent */
+    Double,
+    /** Two full-frame buffers in PSRAM with LVGL full refresh: LVGL renders into one frame while the other one is sent */
+    FullFramePsram
+};
+
 struct EspLcdConfiguration {
     unsigned int horizontalResolution;
     unsigned int verticalResolution;
@@ -20,7 +33,7 @@ struct EspLcdConfiguration {
     bool mirrorX;
     bool mirrorY;
     bool invertColor;
-    uint32_t bufferSize; // Size in pixel count. 0 means default, which is 1/10 of the screen size
+    uint32_t bufferSize; // Size in pixel count. 0 means default, which is bufferLines or 1/10 of the screen size
     std::shared_ptr<tt::hal::touch::TouchDevice> touch;
     std::function<void(uint8_t)> _Nullable backlightDutyFunction;
     gpio_num_t resetPin;
@@ -28,6 +41,8 @@ struct EspLcdConfiguration {
     bool lvglSwapBytes;
     lcd_rgb_element_order_t rgbElementOrder;
     uint32_t bitsPerPixel;
+    EspLcdBuffering buffering = EspLcdBuffering::Automatic;
+    uint32_t bufferLines = 0; // The line count of a partial buffer. 0 means default, which is 1/10 of the screen height
 };
 
 class EspLcdDisplayV2 : public tt::hal::display::DisplayDevice {
@@ -37,9 +52,13 @@ class EspLcdDisplayV2 : public tt::hal::display::DisplayDevice {
     std::shared_ptr<tt::hal::display::DisplayDriver> _Nullable displayDriver;
     std::shared_ptr<tt::Lock> lock;
     std::shared_ptr<EspLcdConfiguration> configuration;
+    EspLcdBuffering buffering = EspLcdBuffering::Single;
+    std::shared_ptr<tt::hal::display::DisplayStatistics> statistics = std::make_shared<tt::hal::display::DisplayStatistics>();
 
     bool applyConfiguration() const;
 
+    EspLcdBuffering resolveBuffering() const;
+
     lvgl_port_display_cfg_t getLvglPortDisplayConfig(std::shared_ptr<EspLcdConfiguration> configuration, esp_lcd_panel_io_handle_t ioHandle, esp_lcd_panel_handle_t panelHandle);
 
 protected:
@@ -86,6 +105,11 @@ public:
 
     lv_display_t* _Nullable getLvglDisplay() const final { return lvglDisplay; }
 
+    /** @return the buffering strategy that is used since startLvgl() */
+    EspLcdBuffering getBuffering() const { return buffering; }
+
+    std::shared_ptr<tt::hal::display::DisplayStatistics> _Nullable getStatistics() final { return statistics; }
+
     // endregion
 
     std::shared_ptr<tt::hal::touch::TouchDevice> _Nullable getTouchDevice() override { return configuration->touch; }
@@ -22,8 +22,9 @@ public:
         size_t transactionQueueDepth = 10;
     };
 
+    /** The Render client is the lock of the DisplayDriver: LVGL flushes take the bus lock directly */
     explicit EspLcdSpiDisplay(const std::shared_ptr<EspLcdConfiguration>& configuration, const std::shared_ptr<SpiConfiguration> spiConfiguration, int gammaCurveCount) :
-        EspLcdDisplayV2(configuration, tt::hal::spi::getLock(spiConfiguration->spiHostDevice)),
+        EspLcdDisplayV2(configuration, tt::hal::spi::getLock(spiConfiguration->spiHostDevice, "display", tt::hal::spi::BusPriority::Render)),
         spiConfiguration(spiConfiguration),
         gammaCurveCount(gammaCurveCount)
     {}
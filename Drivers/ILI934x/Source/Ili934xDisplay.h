@@ -28,6 +28,8 @@ public:
         std::function<void(uint8_t)> _Nullable backlightDutyFunction;
         gpio_num_t resetPin;
         lcd_rgb_element_order_t rgbElementOrder;
+        EspLcdBuffering buffering = EspLcdBuffering::Automatic;
+        uint32_t bufferLines = 0; // Line count of a partial buffer, used when bufferSize is 0. Set to 0 for default (1/10th of display height)
     };
 
 private:
@@ -42,6 +42,7 @@ public:
         uint32_t bufferSize = 0; // Size in pixel count. 0 means default (full screen / 8)
         int gapX = 0; // Column offset
         int gapY = 0; // Not used for SSD1306
+        uint32_t refreshPeriod = 0; // LVGL refresh period in milliseconds. 0 means the LVGL default
     };
 
 private:
@@ -74,6 +75,11 @@ public:
 
     std::shared_ptr<tt::hal::touch::TouchDevice> _Nullable getTouchDevice() override { return configuration->touch; }
 
+    uint32_t getLvglRefreshPeriod() const override { return configuration->refreshPeriod; }
+
+    // Frames are sent over I2C, which takes tens of milliseconds
+    bool isLvglFlushSlow() const override { return true; }
+
     void setBacklightDuty(uint8_t backlightDuty) override {
         // SSD1306 does not have backlight control
     }
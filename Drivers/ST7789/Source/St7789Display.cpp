@@ -21,6 +21,8 @@ std::shared_ptr<EspLcdConfiguration> St7789Display::createEspLcdConfiguration(co
         .lvglSwapBytes = configuration.lvglSwapBytes,
         .rgbElementOrder = configuration.rgbElementOrder,
         .bitsPerPixel = 16,
+        .buffering = configuration.buffering,
+        .bufferLines = configuration.bufferLines
     });
 }
 
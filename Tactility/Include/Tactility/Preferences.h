@@ -1,13 +1,20 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace tt {
 
+class PreferencesNamespace;
+
 /**
  * Settings that persist on NVS flash for ESP32.
- * On simulator, the settings are only in-memory.
+ * On simulator, the settings are stored in a file per namespace.
+ *
+ * All instances with the same namespace share an open storage handle and a cache of the values that were read or written.
+ * Writing a value that didn't change doesn't touch the storage.
+ * Use transaction() to write multiple values with a single commit.
  *
  * Note that on ESP32, there are limitations:
  * - namespace name is limited by NVS_NS_NAME_MAX_SIZE (generally 16 characters)
@@ -18,6 +25,35 @@ class Preferences {
     const char* namespace_;
 
 public:
+
+    struct Statistics {
+        uint32_t reads;
+        /** Reads that were answered from the cache */
+        uint32_t cacheHits;
+        /** Values that were written to the storage */
+        uint32_t writes;
+        /** Writes that were skipped, because the value didn't change */
+        uint32_t skippedWrites;
+        uint32_t commits;
+    };
+
+    /**
+     * Buffers the writes of all Preferences instances with the same namespace.
+     * The changes are committed when the outermost transaction is destroyed.
+     */
+    class Transaction final {
+
+        std::shared_ptr<PreferencesNamespace> storage;
+
+    public:
+
+        explicit Transaction(std::shared_ptr<PreferencesNamespace> storage);
+        ~Transaction();
+
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+    };
+
     explicit Preferences(const char* namespace_) {
         this->namespace_ = namespace_;
     }
@@ -32,10 +68,30 @@ public:
     bool optInt64(const std::string& key, int64_t& out) const;
     bool optString(const std::string& key, std::string& out) const;
 
-    void putBool(const std::string& key, bool value);
-    void putInt32(const std::string& key, int32_t value);
-    void putInt64(const std::string& key, int64_t value);
-    void putString(const std::string& key, const std::string& value);
+    /**
+     * The put functions return false when the value couldn't be persisted.
+     * Such a value is readable, and it's written again with the next commit of the namespace.
+     * Inside a transaction, the value is persisted when the outermost transaction is destroyed.
+     */
+    bool putBool(const std::string& key, bool value);
+    bool putInt32(const std::string& key, int32_t value);
+    bool putInt64(const std::string& key, int64_t value);
+    bool putString(const std::string& key, const std::string& value);
+
+    /**
+     * Start buffering writes, e.g.:
+     * @code
+     * auto transaction = preferences.transaction();
+     * preferences.putString("name", name);
+     * preferences.putString("code", code);
+     * @endcode
+     */
+    [[nodiscard]] Transaction transaction();
+
+    /** @return the statistics of all namespaces */
+    static Statistics getStatistics();
+
+    static void resetStatistics();
 };
 
 } // namespace
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Tactility/crypt/Sha256.h>
+#include <Tactility/file/TarStream.h>
+
+#include <memory>
+#include <string>
+
+namespace tt::app {
+
+/**
+ * Installs an app from a tar stream while it is being received (e.g. from an HTTP request).
+ *
+ * The entries are extracted into a staging directory next to the installed apps.
+ * When the stream is complete and valid, the staging directory replaces the installed version of the app.
+ * An existing installation remains untouched when anything fails.
+ */
+class InstallStream final {
+
+    std::string expectedSha256;
+    std::string stagingPath;
+    std::unique_ptr<file::TarStreamExtractor> extractor;
+    crypt::Sha256 sha256;
+    std::string appId;
+
+    void cleanup();
+
+public:
+
+    /** @param[in] expectedSha256 the optional SHA-256 digest of the whole stream as a hexadecimal string */
+    explicit InstallStream(std::string expectedSha256 = "");
+
+    /** Removes the staging data when the stream wasn't installed */
+    ~InstallStream();
+
+    InstallStream(const InstallStream&) = delete;
+    InstallStream& operator=(const InstallStream&) = delete;
+
+    /** Create the staging directory */
+    bool begin();
+
+    /** Hash and extract the next part of the stream */
+    bool write(const void* data, size_t length);
+
+    /** Verify the stream, then install and register the app */
+    bool finish();
+
+    /** @return the id of the installed app (only valid after a successful finish()) */
+    const std::string& getAppId() const { return appId; }
+};
+
+} // namespace
@@ -20,6 +20,7 @@ class ObjectFileReader {
     uint32_t recordCount = 0;
     uint32_t recordVersion = 0;
     uint32_t recordsRead = 0;
+    uint32_t dataOffset = 0;
 
 public:
 
@@ -34,13 +35,41 @@ public:
     bool hasNext() const { return recordsRead < recordCount; }
     bool readNext(void* output);
 
+    /**
+     * Read multiple records with a single read operation.
+     * @param[out] output the buffer to read into, which must fit maxCount records
+     * @param[in] maxCount the maximum amount of records to read
+     * @return the amount of records that were read
+     */
+    uint32_t readMany(void* output, uint32_t maxCount);
+
+    /**
+     * Move the read position, so that the next read returns the specified record.
+     * @param[in] recordIndex the index of the record, or the record count to move to the end
+     * @return true on success
+     */
+    bool seek(uint32_t recordIndex);
+
     uint32_t getRecordCount() const { return recordCount; }
     uint32_t getRecordSize() const { return recordSize; }
     uint32_t getRecordVersion() const { return recordVersion; }
 };
 
+/**
+ * Writes records through a write-behind buffer, so the file system receives large, aligned writes.
+ * The record count in the file header is checkpointed every time the buffer is written,
+ * so a power loss only loses the records that were written after the last checkpoint.
+ * Appending to existing files continues after the last checkpointed record.
+ */
 class ObjectFileWriter {
 
+public:
+
+    /** The size of the write-behind buffer */
+    static constexpr uint32_t WRITE_BUFFER_SIZE = 4096;
+
+private:
+
     const std::string filePath;
     const uint32_t recordSize;
     const uint32_t recordVersion;
@@ -48,7 +77,20 @@ class ObjectFileWriter {
     const std::shared_ptr<Lock> lock;
 
     std::unique_ptr<FILE, FileCloser> file;
+    std::unique_ptr<uint8_t[]> buffer;
+    uint32_t bufferLength = 0;
+    /** The buffer is written when it reaches this size, so that writes end on an aligned offset */
+    uint32_t bufferLimit = WRITE_BUFFER_SIZE;
+    /** The file offset where the buffer will be written */
+    long writePosition = 0;
+    uint32_t fileVersion = 0;
+    uint32_t dataOffset = 0;
     uint32_t recordsWritten = 0;
+    uint32_t recordsCheckpointed = 0;
+
+    bool writeBuffer();
+
+    bool writeContentHeader();
 
 public:
 
@@ -57,7 +99,7 @@ public:
         recordSize(recordSize),
         recordVersion(recordVersion),
         append(append),
-        lock(getLock(filePath))
+        lock(getLock(this->filePath))
     {}
 
 
@@ -70,7 +112,15 @@ public:
     bool open();
     void close();
 
-    bool write(void* data);
+    bool write(const void* data);
+
+    /**
+     * Write the buffered records and checkpoint the record count, so the records survive a power loss.
+     * @return true on success
+     */
+    bool flush();
+
+    uint32_t getRecordCount() const { return recordsWritten; }
 };
 
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Tactility/file/File.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tt::file {
+
+/**
+ * Extracts a tar (ustar) archive while it is being received, so it doesn't have to be stored first.
+ * The data can be written in pieces of any size.
+ *
+ * File contents are buffered and written in large blocks. The file lock is only held while writing a block,
+ * because SPI SD cards share their lock with the display.
+ *
+ * Regular files and directories are extracted. Other entry types are skipped.
+ * Entries with absolute paths or ".." segments are rejected.
+ */
+class TarStreamExtractor final {
+
+    static constexpr size_t BLOCK_SIZE = 512;
+
+    enum class State {
+        Header,
+        Data,
+        Padding,
+        End,
+        Error
+    };
+
+    enum class EntryType {
+        File,
+        /** GNU long name: the data is the path of the next entry */
+        LongName,
+        /** Data that is ignored */
+        Skip
+    };
+
+    std::string destinationPath;
+    size_t writeBufferSize;
+    std::shared_ptr<Lock> fileLock;
+
+    State state = State::Header;
+    uint8_t header[BLOCK_SIZE] = {};
+    size_t headerLength = 0;
+    int emptyHeaderCount = 0;
+
+    EntryType entryType = EntryType::Skip;
+    std::string entryPath;
+    std::string longName;
+    uint32_t entryMode = 0;
+    size_t entryRemaining = 0;
+    size_t paddingRemaining = 0;
+    size_t entryCount = 0;
+
+    std::unique_ptr<FILE, FileCloser> file;
+    std::unique_ptr<uint8_t[]> writeBuffer;
+    size_t writeBufferLength = 0;
+
+    bool parseHeader();
+
+    bool beginEntry(char typeFlag, const std::string& path, size_t size);
+
+    bool appendEntryData(const uint8_t* data, size_t length);
+
+    bool endEntry();
+
+    bool flushWriteBuffer();
+
+    bool fail();
+
+public:
+
+    /**
+     * @param[in] destinationPath the directory to extract into (it must exist)
+     * @param[in] writeBufferSize the amount of file data that is written at once
+     */
+    explicit TarStreamExtractor(std::string destinationPath, size_t writeBufferSize = 16384);
+
+    ~TarStreamExtractor();
+
+    TarStreamExtractor(const TarStreamExtractor&) = delete;
+    TarStreamExtractor& operator=(const TarStreamExtractor&) = delete;
+
+    /**
+     * Process the next part of the archive.
+     * @return false when the data is invalid or when it can't be extracted
+     */
+    bool write(const void* data, size_t length);
+
+    /** @return true when the archive was complete and extracted without errors */
+    bool finish();
+
+    /** @return the amount of files and directories that were extracted so far */
+    size_t getEntryCount() const { return entryCount; }
+};
+
+} // namespace
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <Tactility/PubSub.h>
+
+#include <array>
 #include <functional>
 #include <memory>
 #include <ranges>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <cassert>
 
@@ -50,6 +54,53 @@ public:
     virtual std::string getDescription() const = 0;
 };
 
+/** The amount of values in Device::Type (update this when adding a new type) */
+constexpr size_t DEVICE_TYPE_COUNT = static_cast<size_t>(Device::Type::Gps) + 1;
+
+/**
+ * An immutable view of the device registry at a specific point in time.
+ * The registry creates a new snapshot whenever a device is registered or deregistered,
+ * so a snapshot can be iterated without locking or copying.
+ */
+class DeviceRegistrySnapshot final {
+
+    uint32_t epoch = 0;
+    std::vector<std::shared_ptr<Device>> devices;
+    std::array<std::vector<std::shared_ptr<Device>>, DEVICE_TYPE_COUNT> devicesByType;
+    std::unordered_map<Device::Id, std::shared_ptr<Device>> devicesById;
+    std::unordered_map<std::string, std::shared_ptr<Device>> devicesByName;
+
+public:
+
+    DeviceRegistrySnapshot() = default;
+
+    DeviceRegistrySnapshot(uint32_t epoch, std::vector<std::shared_ptr<Device>> devices);
+
+    /** @return a value that changes every time a device is registered or deregistered */
+    uint32_t getEpoch() const { return epoch; }
+
+    /** @return all devices in order of registration */
+    const std::vector<std::shared_ptr<Device>>& getDevices() const { return devices; }
+
+    /** @return all devices of the specified type in order of registration */
+    const std::vector<std::shared_ptr<Device>>& getDevices(Device::Type type) const { return devicesByType[static_cast<size_t>(type)]; }
+
+    std::shared_ptr<Device> _Nullable findDevice(Device::Id id) const;
+
+    /** @return the first registered device with the specified name */
+    std::shared_ptr<Device> _Nullable findDevice(const std::string& name) const;
+};
+
+struct DeviceRegistryEvent {
+    enum class Type {
+        Registered,
+        Deregistered
+    };
+
+    Type type;
+    std::shared_ptr<Device> device;
+};
+
 /**
  * Adds a device to the registry.
  * @warning This will leak memory if you want to destroy a device and don't call deregisterDevice()!
@@ -59,6 +110,15 @@ void registerDevice(const std::shared_ptr<Device>& device);
 /** Remove a device from the registry. */
 void deregisterDevice(const std::shared_ptr<Device>& device);
 
+/** @return the current state of the registry (lock-free) */
+std::shared_ptr<const DeviceRegistrySnapshot> getDeviceRegistrySnapshot();
+
+/** @return the epoch of the current registry snapshot, which can be used to invalidate cached lookups */
+uint32_t getDeviceRegistryEpoch();
+
+/** @return the pubsub that publishes DeviceRegistryEvent when a device is registered or deregistered */
+std::shared_ptr<PubSub<DeviceRegistryEvent>> getDeviceRegistryPubsub();
+
 /** Find a single device with a custom filter */
 std::shared_ptr<Device> _Nullable findDevice(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction);
 
@@ -80,7 +140,8 @@ std::vector<std::shared_ptr<Device>> getDevices();
 /** Find devices of a certain type and cast them to the specified class */
 template<class DeviceType>
 std::vector<std::shared_ptr<DeviceType>> findDevices(Device::Type type) {
-    auto devices = findDevices(type);
+    auto snapshot = getDeviceRegistrySnapshot();
+    auto& devices = snapshot->getDevices(type);
     if (devices.empty()) {
         return {};
     } else {
@@ -91,14 +152,14 @@ std::vector<std::shared_ptr<DeviceType>> findDevices(Device::Type type) {
             assert(target_device != nullptr);
             result.push_back(target_device);
         }
-        return std::move(result);
+        return result;
     }
 }
 
 template<class DeviceType>
 void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<DeviceType>&)> onDeviceFound) {
-    auto devices_view = findDevices(type);
-    for (auto& device : devices_view) {
+    auto snapshot = getDeviceRegistrySnapshot();
+    for (auto& device : snapshot->getDevices(type)) {
         auto typed_device = std::static_pointer_cast<DeviceType>(device);
         if (!onDeviceFound(typed_device)) {
             break;
@@ -109,7 +170,8 @@ void findDevices(Device::Type type, std::function<bool(const std::shared_ptr<Dev
 /** Find the first device of the specified type and cast it to the specified class */
 template<class DeviceType>
 std::shared_ptr<DeviceType> findFirstDevice(Device::Type type) {
-    auto devices = findDevices(type);
+    auto snapshot = getDeviceRegistrySnapshot();
+    auto& devices = snapshot->getDevices(type);
     if (devices.empty()) {
         return {};
     } else {
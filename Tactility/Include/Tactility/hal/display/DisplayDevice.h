@@ -8,9 +8,14 @@ namespace tt::hal::touch {
 class TouchDevice;
 }
 
+namespace tt::hal::encoder {
+class EncoderDevice;
+}
+
 namespace tt::hal::display {
 
 class DisplayDriver;
+class DisplayStatistics;
 
 class DisplayDevice : public Device {
 
@@ -28,6 +33,9 @@ public:
 
     virtual std::shared_ptr<touch::TouchDevice> _Nullable getTouchDevice() = 0;
 
+    /** @return an encoder that only controls this display (e.g. buttons next to a secondary display). Other encoders control the primary display. */
+    virtual std::shared_ptr<encoder::EncoderDevice> _Nullable getEncoderDevice() { return nullptr; }
+
     /** Set a value in the range [0, 255] */
     virtual void setBacklightDuty(uint8_t backlightDuty) { /* NO-OP */ }
     virtual bool supportsBacklightDuty() const { return false; }
@@ -42,6 +50,18 @@ public:
 
     virtual lv_display_t* _Nullable getLvglDisplay() const = 0;
 
+    /** @return the LVGL refresh period in milliseconds, or 0 for the LVGL default */
+    virtual uint32_t getLvglRefreshPeriod() const { return 0; }
+
+    /**
+     * @return true when sending a frame takes long (e.g. an I2C panel), so it should happen on a separate thread
+     * instead of blocking the refreshes of other displays. Only works for displays that render full frames.
+     */
+    virtual bool isLvglFlushSlow() const { return false; }
+
+    /** @return the rendering statistics of the LVGL display, if the device measures them */
+    virtual std::shared_ptr<DisplayStatistics> _Nullable getStatistics() { return nullptr; }
+
     virtual bool supportsDisplayDriver() const = 0;
     virtual std::shared_ptr<DisplayDriver> _Nullable getDisplayDriver() = 0;
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <lvgl.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace tt::hal::display {
+
+/**
+ * Measures the rendering performance of an LVGL display, so that buffering strategies can be compared.
+ * The counters are updated from LVGL display events, so the statistics work for any LVGL display driver.
+ */
+class DisplayStatistics final {
+
+public:
+
+    struct Snapshot {
+        /** The amount of rendered frames */
+        uint32_t frames;
+        /** The frames that were rendered during the last full second */
+        uint32_t framesPerSecond;
+        /** The total time in microseconds that LVGL waited for the display to finish flushing a buffer */
+        uint64_t flushWaitTime;
+    };
+
+private:
+
+    lv_display_t* _Nullable display = nullptr;
+    std::atomic<uint32_t> frames = 0;
+    std::atomic<uint32_t> framesPerSecond = 0;
+    std::atomic<uint64_t> flushWaitTime = 0;
+    uint64_t flushWaitStartTime = 0;
+    uint64_t secondStartTime = 0;
+    uint32_t secondStartFrames = 0;
+
+    static void onDisplayEvent(lv_event_t* event);
+
+public:
+
+    DisplayStatistics() = default;
+    DisplayStatistics(const DisplayStatistics&) = delete;
+    DisplayStatistics& operator=(const DisplayStatistics&) = delete;
+
+    ~DisplayStatistics() { detach(); }
+
+    /** Start measuring the specified display. Must be called with the LVGL lock. */
+    void attach(lv_display_t* display);
+
+    /** Stop measuring. Must be called with the LVGL lock. */
+    void detach();
+
+    /** Clear the counters */
+    void reset();
+
+    Snapshot getSnapshot() const {
+        return {
+            .frames = frames.load(std::memory_order_relaxed),
+            .framesPerSecond = framesPerSecond.load(std::memory_order_relaxed),
+            .flushWaitTime = flushWaitTime.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+} // namespace tt::hal::display
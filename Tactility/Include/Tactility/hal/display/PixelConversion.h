@@ -0,0 +1,52 @@
+#pragma once
+
+#include "DisplayDriver.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::hal::display {
+
+/**
+ * Pixel data layouts:
+ * - 565 formats: 2 bytes per pixel. The "Swapped" variants have their 2 bytes in reverse order.
+ * - RGB888: 3 bytes per pixel, in LVGL order: blue, green, red.
+ * - Monochrome: 1 bit per pixel, most significant bit first. A set bit is a lit pixel. Each row starts at a new byte.
+ *
+ * Rows are stored without padding, one after the other.
+ */
+
+enum class Rotation {
+    None,
+    Clockwise90,
+    Clockwise180,
+    Clockwise270
+};
+
+/** @return the size of a row of pixels in bytes */
+size_t getRowSize(ColorFormat format, uint32_t width);
+
+/**
+ * Converts rows of pixels.
+ * @param[in] source the pixels to convert
+ * @param[out] target the converted pixels (may be the same buffer as source when the target pixels aren't bigger than the source pixels)
+ * @param[in] width the amount of pixels in a row
+ * @param[in] height the amount of rows
+ * @param[in] y the vertical position of the first row on the screen, so dithering stays aligned when converting in strips
+ */
+typedef void (*PixelConverter)(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y);
+
+/** @return the converter between the formats, or nullptr when the conversion is not supported */
+PixelConverter findPixelConverter(ColorFormat sourceFormat, ColorFormat targetFormat);
+
+/** @return false when the conversion is not supported */
+bool convertPixels(ColorFormat sourceFormat, const void* source, ColorFormat targetFormat, void* target, uint32_t width, uint32_t height);
+
+/**
+ * Rotate pixels into another buffer.
+ * For 90 and 270 degree rotations, the target has "height" pixels per row and "width" rows.
+ * @return false when the format can't be rotated (Monochrome)
+ */
+bool rotatePixels(ColorFormat format, const void* source, void* target, uint32_t width, uint32_t height, Rotation rotation);
+
+} // namespace tt::hal::display
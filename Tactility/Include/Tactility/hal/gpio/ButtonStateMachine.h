@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace tt::hal::gpio {
+
+enum class ButtonEvent {
+    /** The button was pressed */
+    Pressed,
+    /** The button was released */
+    Released,
+    /** The button was released before a LongPress or Repeat happened */
+    ShortPress,
+    /** The button has been held for longPressMicros */
+    LongPress,
+    /** The button is still held after repeatDelayMicros, then after every repeatIntervalMicros */
+    Repeat
+};
+
+struct ButtonConfiguration {
+    /** The level of the pin while the button is pressed */
+    bool activeLevel = true;
+    /** A new level is accepted when there were no edges for this long */
+    uint32_t debounceMicros = 20000;
+    /** 0 disables LongPress events */
+    uint32_t longPressMicros = 500000;
+    /** 0 disables Repeat events */
+    uint32_t repeatDelayMicros = 0;
+    uint32_t repeatIntervalMicros = 100000;
+};
+
+/**
+ * Turns the edges of a button pin into button events.
+ * The state machine doesn't track time itself: it is driven by the timestamps of the edges and by update() calls,
+ * so it only has to run when an edge happened or when getNextDeadline() passed.
+ */
+class ButtonStateMachine final {
+
+public:
+
+    static constexpr uint64_t NO_DEADLINE = UINT64_MAX;
+
+    typedef std::function<void(ButtonEvent event)> EventCallback;
+
+private:
+
+    ButtonConfiguration configuration;
+    bool level;
+    bool pressed = false;
+    bool settling = false;
+    bool heldEventSent = false;
+    uint64_t firstEdgeTime = 0;
+    uint64_t lastEdgeTime = 0;
+    uint64_t pressTime = 0;
+    uint64_t nextRepeatTime = NO_DEADLINE;
+
+public:
+
+    explicit ButtonStateMachine(const ButtonConfiguration& configuration = {}) :
+        configuration(configuration),
+        level(!configuration.activeLevel)
+    {}
+
+    /** Set the level without generating events, e.g. with the level of the pin when it is first read. */
+    void reset(bool newLevel);
+
+    /** Register an edge. Events are generated by the next update() call. */
+    void onEdge(bool newLevel, uint64_t time);
+
+    /**
+     * Generate the events that are due at the specified time.
+     * @return the time at which update() should be called again, or NO_DEADLINE when it only has to be called after the next edge
+     */
+    uint64_t update(uint64_t time, const EventCallback& callback);
+
+    uint64_t getNextDeadline() const;
+
+    /** @return the debounced state */
+    bool isPressed() const { return pressed; }
+};
+
+} // namespace tt::hal::gpio
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::hal::gpio {
+
+struct GpioEdge {
+    /** The index of the input that the edge belongs to */
+    uint32_t input;
+    bool level;
+    uint64_t time;
+};
+
+/**
+ * A lock-free queue for a single producer and a single consumer.
+ * The producer is the GPIO interrupt: all GPIO interrupt handlers run on the same core, so they don't interleave.
+ * When the queue is full, new edges are dropped. The consumer still reads the correct level from the last queued edge
+ * of a pin when it catches up, except when the final edges of a pin were dropped.
+ */
+class GpioEdgeQueue final {
+
+public:
+
+    static constexpr size_t CAPACITY = 64;
+
+private:
+
+    std::array<GpioEdge, CAPACITY> edges {};
+    std::atomic<size_t> head = 0;
+    std::atomic<size_t> tail = 0;
+    std::atomic<uint32_t> droppedCount = 0;
+
+public:
+
+    /** Can be called from an interrupt */
+    bool push(const GpioEdge& edge) {
+        const auto current_tail = tail.load(std::memory_order_relaxed);
+        const auto next_tail = (current_tail + 1) % CAPACITY;
+        if (next_tail == head.load(std::memory_order_acquire)) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        edges[current_tail] = edge;
+        tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(GpioEdge& edge) {
+        const auto current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        edge = edges[current_head];
+        head.store((current_head + 1) % CAPACITY, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+};
+
+} // namespace tt::hal::gpio
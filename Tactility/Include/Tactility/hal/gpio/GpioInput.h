@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ButtonStateMachine.h"
+#include "GpioEdgeQueue.h"
+#include "GpioInputBackend.h"
+
+#include <Tactility/Semaphore.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace tt::hal::gpio {
+
+/**
+ * Generates button events from GPIO edge interrupts.
+ * The interrupts queue the edges and wake up a thread that debounces them. The thread only wakes up for edges and
+ * for the deadlines of pressed buttons (e.g. a long press), so it uses no CPU while the buttons are idle.
+ */
+class GpioInput final {
+
+public:
+
+    /** Called on the thread of the GpioInput */
+    typedef std::function<void(Pin pin, ButtonEvent event)> Listener;
+
+    struct Statistics {
+        uint32_t edges;
+        uint32_t droppedEdges;
+        uint32_t wakeups;
+    };
+
+private:
+
+    struct Input {
+        GpioInput* owner;
+        uint32_t index;
+        Pin pin;
+        ButtonStateMachine stateMachine;
+    };
+
+    std::shared_ptr<GpioInputBackend> backend;
+    std::vector<std::unique_ptr<Input>> inputs;
+    Listener listener;
+    GpioEdgeQueue edgeQueue;
+    Semaphore wakeup = Semaphore(1, 0);
+    std::unique_ptr<Thread> thread;
+    std::atomic<bool> interruptThread = false;
+    std::atomic<uint32_t> edgeCount = 0;
+    std::atomic<uint32_t> wakeupCount = 0;
+
+    static void onEdge(void* context, bool level, uint64_t time);
+
+    /** @return the next deadline of the state machines */
+    uint64_t processEdges();
+
+    void threadMain();
+
+public:
+
+    explicit GpioInput(std::shared_ptr<GpioInputBackend> backend = getGpioInputBackend()) : backend(std::move(backend)) {}
+
+    ~GpioInput();
+
+    /** Add a button before calling start(). The pin must be configured as input. */
+    void addButton(Pin pin, const ButtonConfiguration& configuration = {});
+
+    /** Enable the interrupts and start the thread */
+    bool start(Listener newListener);
+
+    void stop();
+
+    bool isStarted() const { return thread != nullptr; }
+
+    Statistics getStatistics() const;
+};
+
+} // namespace tt::hal::gpio
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Gpio.h"
+
+#include <memory>
+
+namespace tt::hal::gpio {
+
+/** Reports edges of input pins. The default backend uses GPIO interrupts, tests can provide a synthetic one. */
+class GpioInputBackend {
+
+public:
+
+    /**
+     * Called from an interrupt when the level of a pin changed.
+     * @param[in] context the context that was passed to enableEdgeInterrupt()
+     * @param[in] level the level of the pin after the edge
+     * @param[in] time the time of the edge in microseconds, as returned by getMicros()
+     */
+    typedef void (*EdgeHandler)(void* context, bool level, uint64_t time);
+
+    virtual ~GpioInputBackend() = default;
+
+    virtual bool getLevel(Pin pin) = 0;
+
+    /** @return the current time in microseconds */
+    virtual uint64_t getMicros() = 0;
+
+    /** Call the handler on rising and falling edges of the pin */
+    virtual bool enableEdgeInterrupt(Pin pin, EdgeHandler handler, void* context) = 0;
+
+    virtual void disableEdgeInterrupt(Pin pin) = 0;
+};
+
+/** @return the backend that uses the GPIO interrupts of the device */
+std::shared_ptr<GpioInputBackend> getGpioInputBackend();
+
+} // namespace tt::hal::gpio
@@ -23,8 +23,9 @@ class GpsDevice : public Device {
 
 public:
 
-    typedef int GgaSubscriptionId;
-    typedef int RmcSubscriptionId;
+    typedef int SubscriptionId;
+    typedef SubscriptionId GgaSubscriptionId;
+    typedef SubscriptionId RmcSubscriptionId;
 
     enum class State {
         PendingOn,
@@ -36,24 +37,23 @@ public:
 
 private:
 
-    struct GgaSubscription {
-        GgaSubscriptionId id;
-        std::shared_ptr<std::function<void(Device::Id id, const minmea_sentence_gga&)>> onData;
-    };
-
-    struct RmcSubscription {
-        RmcSubscriptionId id;
-        std::shared_ptr<std::function<void(Device::Id id, const minmea_sentence_rmc&)>> onData;
+    template<typename SentenceType>
+    struct Subscription {
+        SubscriptionId id;
+        std::shared_ptr<std::function<void(Device::Id id, const SentenceType&)>> onData;
     };
 
     const GpsConfiguration configuration;
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     std::unique_ptr<Thread> _Nullable thread;
     bool threadInterrupted = false;
-    std::vector<GgaSubscription> ggaSubscriptions;
-    std::vector<RmcSubscription> rmcSubscriptions;
-    GgaSubscriptionId lastSatelliteSubscriptionId = 0;
-    RmcSubscriptionId lastRmcSubscriptionId = 0;
+    std::vector<Subscription<minmea_sentence_gga>> ggaSubscriptions;
+    std::vector<Subscription<minmea_sentence_rmc>> rmcSubscriptions;
+    std::vector<Subscription<minmea_sentence_gsa>> gsaSubscriptions;
+    std::vector<Subscription<minmea_sentence_gsv>> gsvSubscriptions;
+    std::vector<Subscription<minmea_sentence_vtg>> vtgSubscriptions;
+    std::vector<Subscription<minmea_sentence_zda>> zdaSubscriptions;
+    SubscriptionId lastSubscriptionId = 0;
     GpsModel model = GpsModel::Unknown;
     State state = State::Off;
 
@@ -63,6 +63,33 @@ private:
 
     void setState(State newState);
 
+    template<typename SentenceType>
+    SubscriptionId subscribe(std::vector<Subscription<SentenceType>>& subscriptions, const std::function<void(Device::Id deviceId, const SentenceType&)>& onData) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        subscriptions.push_back({
+            .id = ++lastSubscriptionId,
+            .onData = std::make_shared<std::function<void(Device::Id, const SentenceType&)>>(onData)
+        });
+        return lastSubscriptionId;
+    }
+
+    template<typename SentenceType>
+    void unsubscribe(std::vector<Subscription<SentenceType>>& subscriptions, SubscriptionId subscriptionId) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        std::erase_if(subscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
+    }
+
+    template<typename SentenceType>
+    void publish(const std::vector<Subscription<SentenceType>>& subscriptions, const SentenceType& sentence) {
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        for (auto& subscription : subscriptions) {
+            (*subscription.onData)(getId(), sentence);
+        }
+    }
+
 public:
 
     explicit GpsDevice(GpsConfiguration configuration) : configuration(std::move(configuration)) {}
@@ -84,37 +111,33 @@ public:
     bool start();
     bool stop();
 
-    GgaSubscriptionId subscribeGga(const std::function<void(Device::Id deviceId, const minmea_sentence_gga&)>& onData) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        ggaSubscriptions.push_back({
-            .id = ++lastSatelliteSubscriptionId,
-            .onData = std::make_shared<std::function<void(Device::Id, const minmea_sentence_gga&)>>(onData)
-        });
-        return lastSatelliteSubscriptionId;
-    }
+    GgaSubscriptionId subscribeGga(const std::function<void(Device::Id deviceId, const minmea_sentence_gga&)>& onData) { return subscribe(ggaSubscriptions, onData); }
 
-    void unsubscribeGga(GgaSubscriptionId subscriptionId) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        std::erase_if(ggaSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
-    }
+    void unsubscribeGga(GgaSubscriptionId subscriptionId) { unsubscribe(ggaSubscriptions, subscriptionId); }
 
-    RmcSubscriptionId subscribeRmc(const std::function<void(Device::Id deviceId, const minmea_sentence_rmc&)>& onData) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        rmcSubscriptions.push_back({
-            .id = ++lastRmcSubscriptionId,
-            .onData = std::make_shared<std::function<void(Device::Id, const minmea_sentence_rmc&)>>(onData)
-        });
-        return lastRmcSubscriptionId;
-    }
+    RmcSubscriptionId subscribeRmc(const std::function<void(Device::Id deviceId, const minmea_sentence_rmc&)>& onData) { return subscribe(rmcSubscriptions, onData); }
 
-    void unsubscribeRmc(GgaSubscriptionId subscriptionId) {
-        auto lock = mutex.asScopedLock();
-        lock.lock();
-        std::erase_if(rmcSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
-    }
+    void unsubscribeRmc(RmcSubscriptionId subscriptionId) { unsubscribe(rmcSubscriptions, subscriptionId); }
+
+    /** Subscribe to DOP and active satellites */
+    SubscriptionId subscribeGsa(const std::function<void(Device::Id deviceId, const minmea_sentence_gsa&)>& onData) { return subscribe(gsaSubscriptions, onData); }
+
+    void unsubscribeGsa(SubscriptionId subscriptionId) { unsubscribe(gsaSubscriptions, subscriptionId); }
+
+    /** Subscribe to satellites in view */
+    SubscriptionId subscribeGsv(const std::function<void(Device::Id deviceId, const minmea_sentence_gsv&)>& onData) { return subscribe(gsvSubscriptions, onData); }
+
+    void unsubscribeGsv(SubscriptionId subscriptionId) { unsubscribe(gsvSubscriptions, subscriptionId); }
+
+    /** Subscribe to track made good and ground speed */
+    SubscriptionId subscribeVtg(const std::function<void(Device::Id deviceId, const minmea_sentence_vtg&)>& onData) { return subscribe(vtgSubscriptions, onData); }
+
+    void unsubscribeVtg(SubscriptionId subscriptionId) { unsubscribe(vtgSubscriptions, subscriptionId); }
+
+    /** Subscribe to time and date */
+    SubscriptionId subscribeZda(const std::function<void(Device::Id deviceId, const minmea_sentence_zda&)>& onData) { return subscribe(zdaSubscriptions, onData); }
+
+    void unsubscribeZda(SubscriptionId subscriptionId) { unsubscribe(zdaSubscriptions, subscriptionId); }
 
     GpsModel getModel() const;
 
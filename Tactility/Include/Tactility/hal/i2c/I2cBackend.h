@@ -0,0 +1,50 @@
+#pragma once
+
+#include "I2c.h"
+
+namespace tt::hal::i2c {
+
+/**
+ * Executes I2C transfers on a single bus.
+ * A transaction locks the bus once for all of its transfers, so other users of the bus can't interleave.
+ */
+class I2cBackend {
+
+public:
+
+    virtual ~I2cBackend() = default;
+
+    virtual bool lock(TickType_t timeout) = 0;
+    virtual void unlock() = 0;
+
+    virtual bool read(uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) = 0;
+    virtual bool write(uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) = 0;
+    virtual bool writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout) = 0;
+};
+
+/** Executes transfers with the I2C HAL functions of a port. It locks the same mutex as those functions. */
+class I2cPortBackend final : public I2cBackend {
+
+    i2c_port_t port;
+
+public:
+
+    explicit I2cPortBackend(i2c_port_t port) : port(port) {}
+
+    bool lock(TickType_t timeout) override { return getLock(port).lock(timeout); }
+    void unlock() override { getLock(port).unlock(); }
+
+    bool read(uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) override {
+        return masterRead(port, address, data, dataSize, timeout);
+    }
+
+    bool write(uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) override {
+        return masterWrite(port, address, data, dataSize, timeout);
+    }
+
+    bool writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout) override {
+        return masterWriteRead(port, address, writeData, writeDataSize, readData, readDataSize, timeout);
+    }
+};
+
+} // namespace tt::hal::i2c
@@ -2,6 +2,7 @@
 
 #include "../Device.h"
 #include "I2c.h"
+#include "I2cQueue.h"
 
 namespace tt::hal::i2c {
 
@@ -10,6 +11,7 @@ namespace tt::hal::i2c {
  * It helps to read and write registers.
  *
  * All read and write calls are thread-safe.
+ * Transactions can be submitted to the queue of the port, so the driver doesn't have to wait for the bus.
  */
 class I2cDevice : public Device {
 
@@ -17,6 +19,8 @@ protected:
 
     i2c_port_t port;
     uint8_t address;
+    /** The priority of transactions that are submitted to the queue */
+    I2cQueue::Priority queuePriority = I2cQueue::Priority::Normal;
 
     static constexpr TickType_t DEFAULT_TIMEOUT = 1000 / portTICK_PERIOD_MS;
 
@@ -34,6 +38,28 @@ protected:
     bool bitOnByIndex(uint8_t reg, uint8_t index) const { return bitOn(reg, 1 << index); }
     bool bitOffByIndex(uint8_t reg, uint8_t index) const { return bitOff(reg, 1 << index); }
 
+    /** Read consecutive registers in a single transfer. The device must auto-increment the register address. */
+    bool readRegisters(uint8_t reg, uint8_t* data, size_t dataSize, TickType_t timeout = DEFAULT_TIMEOUT) const;
+
+    /**
+     * Write a batch of registers while the bus is locked once.
+     * @param[in] data pairs of a register and its value
+     * @param[in] dataSize the size of data, which is twice the amount of registers
+     */
+    bool writeRegisterArray(const uint8_t* data, uint16_t dataSize, TickType_t timeout = DEFAULT_TIMEOUT) const;
+
+    I2cTransaction createTransaction(TickType_t timeout = DEFAULT_TIMEOUT) const { return I2cTransaction(address, timeout); }
+
+    /** Execute a transaction on the current thread */
+    bool execute(const I2cTransaction& transaction, std::vector<uint8_t>& readData) const;
+
+    /**
+     * Submit a transaction to the queue of the port with the priority of this device.
+     * @param[in] callback called from the queue thread
+     * @return false when the queue is full
+     */
+    bool submit(I2cTransaction transaction, I2cQueue::Callback callback = nullptr) const;
+
 public:
 
     explicit I2cDevice(i2c_port_t port, uint32_t address) : port(port), address(address) {}
@@ -43,6 +69,9 @@ public:
     i2c_port_t getPort() const { return port; }
 
     uint8_t getAddress() const { return address; }
+
+    /** @return the statistics of the transactions of this device that went through the queue of its port */
+    I2cQueue::DeviceStatistics getBusStatistics() const;
 };
 
 } // namespace tt::hal::i2c
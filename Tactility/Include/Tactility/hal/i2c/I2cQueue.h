@@ -0,0 +1,189 @@
+#pragma once
+
+#include "I2cBackend.h"
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace tt::hal::i2c {
+
+/**
+ * A sequence of transfers to a single device, which are executed while the bus is locked once.
+ * The data that is read by all transfers is concatenated into a single buffer.
+ */
+class I2cTransaction final {
+
+public:
+
+    enum class TransferType {
+        Read,
+        Write,
+        WriteRead
+    };
+
+    struct Transfer {
+        TransferType type;
+        std::vector<uint8_t> writeData;
+        size_t readSize;
+    };
+
+private:
+
+    uint8_t address;
+    TickType_t timeout;
+    std::vector<Transfer> transfers;
+    size_t readSize = 0;
+
+public:
+
+    explicit I2cTransaction(uint8_t address, TickType_t timeout = defaultTimeout) : address(address), timeout(timeout) {}
+
+    I2cTransaction& read(size_t size);
+
+    I2cTransaction& write(std::vector<uint8_t> data);
+
+    I2cTransaction& writeRead(std::vector<uint8_t> data, size_t size);
+
+    /** Read multiple registers in a single transfer, for devices that auto-increment the register address */
+    I2cTransaction& readRegisters(uint8_t reg, size_t size) { return writeRead({ reg }, size); }
+
+    /** Write multiple registers in a single transfer, for devices that auto-increment the register address */
+    I2cTransaction& writeRegisters(uint8_t reg, const uint8_t* data, size_t dataSize);
+
+    /** Write a single register. Subsequent calls are separate transfers, so this works for any device. */
+    I2cTransaction& writeRegister8(uint8_t reg, uint8_t value) { return write({ reg, value }); }
+
+    uint8_t getAddress() const { return address; }
+
+    TickType_t getTimeout() const { return timeout; }
+
+    const std::vector<Transfer>& getTransfers() const { return transfers; }
+
+    /** @return the total amount of bytes that are read by all transfers */
+    size_t getReadSize() const { return readSize; }
+};
+
+/**
+ * Executes the transactions for a single bus on a dedicated thread.
+ * Pending transactions are executed in order of priority, and in the order of submission when the priority is equal.
+ * This allows e.g. touch input to take precedence over a battery gauge that polls the same bus.
+ *
+ * The bus time of each device is recorded, so the devices that keep the bus busy can be found.
+ */
+class I2cQueue final {
+
+public:
+
+    enum class Priority {
+        Low,
+        Normal,
+        High
+    };
+
+    /**
+     * Called from the queue thread when a transaction finished.
+     * @param[in] success false when a transfer failed or the bus wasn't available in time
+     * @param[in] readData the concatenated data of all read transfers
+     */
+    typedef std::function<void(bool success, const std::vector<uint8_t>& readData)> Callback;
+
+    struct DeviceStatistics {
+        uint32_t transactions = 0;
+        uint32_t failures = 0;
+        /** Time that the device held the bus */
+        uint64_t busTimeMicros = 0;
+        /** Time that submitted transactions waited in the queue */
+        uint64_t waitTimeMicros = 0;
+    };
+
+private:
+
+    struct Request {
+        I2cTransaction transaction;
+        Callback callback;
+        uint64_t submitTime;
+    };
+
+    static constexpr uint32_t FlagRequest = 1U;
+    static constexpr uint32_t FlagStop = 2U;
+
+    std::shared_ptr<I2cBackend> backend;
+    size_t maxPendingCount;
+    Mutex mutex;
+    std::array<std::deque<Request>, 3> pending;
+    size_t pendingCount = 0;
+    std::map<uint8_t, DeviceStatistics> statistics;
+    EventFlag eventFlag;
+    std::unique_ptr<Thread> thread;
+
+    std::optional<Request> takeNext();
+
+    bool run(const I2cTransaction& transaction, std::vector<uint8_t>& readData, uint64_t submitTime);
+
+    int32_t threadMain();
+
+public:
+
+    /**
+     * @param[in] backend the bus to execute the transactions on
+     * @param[in] maxPendingCount the amount of transactions that can wait in the queue
+     */
+    explicit I2cQueue(std::shared_ptr<I2cBackend> backend, size_t maxPendingCount = 32) :
+        backend(std::move(backend)),
+        maxPendingCount(maxPendingCount)
+    {}
+
+    ~I2cQueue() { stop(); }
+
+    /** Start the thread that executes submitted transactions */
+    void start();
+
+    /** Stop the thread after it executed the pending transactions */
+    void stop();
+
+    /**
+     * Queue a transaction. This doesn't wait for the bus.
+     * @return false when the queue is full
+     */
+    bool submit(I2cTransaction transaction, Priority priority = Priority::Normal, Callback callback = nullptr);
+
+    /**
+     * Execute a transaction on the current thread. It waits for the transaction that is currently executing,
+     * but it doesn't wait for the pending ones.
+     * @param[in] transaction
+     * @param[out] readData the concatenated data of all read transfers
+     * @return true on success
+     */
+    bool execute(const I2cTransaction& transaction, std::vector<uint8_t>& readData);
+
+    /**
+     * Execute the pending transactions on the current thread. This is used by the queue thread.
+     * @return the amount of executed transactions
+     */
+    size_t processPending();
+
+    size_t getPendingCount() const;
+
+    /** @return the statistics by device address */
+    std::map<uint8_t, DeviceStatistics> getStatistics() const;
+
+    void resetStatistics();
+};
+
+/**
+ * Get the transaction queue of a port. It is created and started when it's first used.
+ * Devices that use the queue can still be used by drivers that call the I2C functions directly:
+ * both lock the same port mutex.
+ */
+std::shared_ptr<I2cQueue> getQueue(i2c_port_t port);
+
+} // namespace tt::hal::i2c
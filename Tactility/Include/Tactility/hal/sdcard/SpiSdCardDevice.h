@@ -64,6 +64,7 @@ private:
     std::string mountPath;
     sdmmc_card_t* card = nullptr;
     std::shared_ptr<Config> config;
+    std::shared_ptr<Lock> lock;
 
     bool applyGpioWorkAround();
     bool mountInternal(const std::string& mountPath);
@@ -72,7 +73,14 @@ public:
 
     explicit SpiSdCardDevice(std::unique_ptr<Config> config) : SdCardDevice(config->mountBehaviourAtBoot),
         config(std::move(config))
-    {}
+    {
+        // Storage has the lowest priority on a bus that is shared with a display
+        if (this->config->customLock == nullptr || this->config->customLock == spi::getLock(this->config->spiHost)) {
+            lock = spi::getLock(this->config->spiHost, "sdcard", spi::BusPriority::Storage);
+        } else {
+            lock = this->config->customLock;
+        }
+    }
 
     std::string getName() const override { return "SD Card"; }
     std::string getDescription() const override { return "SD card via SPI interface"; }
@@ -81,13 +89,7 @@ public:
     bool unmount() override;
     std::string getMountPath() const override { return mountPath; }
 
-    std::shared_ptr<Lock> getLock() const override {
-        if (config->customLock != nullptr) {
-            return config->customLock;
-        } else {
-            return spi::getLock(config->spiHost);
-        }
-    }
+    std::shared_ptr<Lock> getLock() const override { return lock; }
 
     State getState(TickType_t timeout) const override;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SpiArbiter.h"
 #include "SpiCompat.h"
 
 #include <Tactility/Lock.h>
@@ -48,4 +49,17 @@ bool isStarted(spi_host_device_t device);
  */
 std::shared_ptr<Lock> getLock(spi_host_device_t device);
 
+/**
+ * Create a lock for a client of the specified device, which gets the bus before clients with a lower priority.
+ * Use it instead of getLock(device) for drivers that share a bus, e.g. a display (Render) and an SD card (Storage).
+ * @param[in] device the SPI device
+ * @param[in] clientName the name in the statistics of the arbiter
+ * @param[in] priority the priority of the client
+ * @return the lock of the client, or the lock of the device when the device isn't configured
+ */
+std::shared_ptr<Lock> getLock(spi_host_device_t device, const std::string& clientName, BusPriority priority);
+
+/** @return the arbiter of the specified device, or nullptr when the device isn't configured */
+std::shared_ptr<SpiArbiter> _Nullable getArbiter(spi_host_device_t device);
+
 } // namespace tt::hal::spi
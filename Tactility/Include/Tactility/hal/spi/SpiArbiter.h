@@ -0,0 +1,109 @@
+#pragma once
+
+#include "SpiArbitration.h"
+
+#include <Tactility/Lock.h>
+#include <Tactility/Mutex.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::hal::spi {
+
+/**
+ * Gives clients of a shared SPI bus access to its lock in the order of their priority.
+ * The display should render in time, even when the SD card on the same bus is busy with a large file.
+ *
+ * The LVGL task takes the bus lock directly when the bus lock is the LVGL lock, so its flushes don't wait as
+ * a Render client. A Storage client makes room for it by releasing the bus when its hold budget is used.
+ */
+class SpiArbiter final : public std::enable_shared_from_this<SpiArbiter> {
+
+public:
+
+    static constexpr uint32_t DEFAULT_HOLD_BUDGET_MICROS = 8000;
+
+    struct ClientStatistics {
+        std::string name;
+        BusPriority priority;
+        uint32_t acquisitions;
+        uint32_t timeouts;
+        uint32_t yields;
+        uint64_t totalWaitMicros;
+        uint32_t maxWaitMicros;
+        uint64_t totalHoldMicros;
+        uint32_t maxHoldMicros;
+    };
+
+    /** A lock that acquires the bus with the priority of the client. It is recursive for the thread that holds the bus. */
+    class Client final : public Lock {
+
+        std::shared_ptr<SpiArbiter> arbiter;
+        size_t index;
+        BusPriority priority;
+
+    public:
+
+        using Lock::lock;
+
+        Client(std::shared_ptr<SpiArbiter> arbiter, size_t index, BusPriority priority) :
+            arbiter(std::move(arbiter)),
+            index(index),
+            priority(priority)
+        {}
+
+        bool lock(TickType_t timeout) const override { return arbiter->acquire(*this, timeout); }
+
+        bool unlock() const override { return arbiter->release(*this); }
+
+        /** @return true when the client holds the bus and should yield it at the next opportunity */
+        bool shouldYield() const override { return arbiter->shouldYield(*this); }
+
+        /**
+         * A yield point for long transfers: when shouldYield() is true, release the bus and acquire it again after
+         * the others had their turn. The bus must be locked once.
+         * @return true when the bus was yielded
+         */
+        bool yield() const { return arbiter->yield(*this); }
+
+        BusPriority getPriority() const { return priority; }
+
+        friend class SpiArbiter;
+    };
+
+private:
+
+    std::shared_ptr<Lock> busLock;
+    Mutex mutex;
+    SpiArbitration arbitration;
+    TaskHandle_t holderThread = nullptr;
+    uint32_t holdDepth = 0;
+    std::vector<ClientStatistics> statistics;
+
+    bool acquire(const Client& client, TickType_t timeout);
+    bool release(const Client& client);
+    bool shouldYield(const Client& client);
+    bool yield(const Client& client);
+
+public:
+
+    /**
+     * @param[in] busLock the lock of the bus, which can also be used directly by code that doesn't know about the arbiter
+     * @param[in] holdBudgetMicros the time after which a client should yield the bus
+     */
+    explicit SpiArbiter(std::shared_ptr<Lock> busLock, uint32_t holdBudgetMicros = DEFAULT_HOLD_BUDGET_MICROS) :
+        busLock(std::move(busLock)),
+        arbitration(holdBudgetMicros)
+    {}
+
+    std::shared_ptr<Client> createClient(const std::string& name, BusPriority priority);
+
+    std::shared_ptr<Lock> getBusLock() const { return busLock; }
+
+    std::vector<ClientStatistics> getStatistics() const;
+
+    void resetStatistics();
+};
+
+} // namespace tt::hal::spi
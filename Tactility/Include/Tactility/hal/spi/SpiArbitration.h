@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tt::hal::spi {
+
+/** The priority of a bus client: when multiple clients wait for the bus, the highest priority gets it first. */
+enum class BusPriority {
+    Storage,
+    Input,
+    Render
+};
+
+constexpr size_t BUS_PRIORITY_COUNT = 3;
+
+/**
+ * The bus access policy of SpiArbiter, without the locking, so it can be simulated.
+ * A client can acquire the bus when it's free and no client with a higher priority is waiting for it.
+ * The holder should yield when a client with a higher priority is waiting, or when it held the bus for longer than
+ * the hold budget: not all users of the bus are known to the arbiter (e.g. the LVGL task).
+ * Times are in microseconds and are allowed to wrap.
+ */
+class SpiArbitration final {
+
+    uint32_t waiterCounts[BUS_PRIORITY_COUNT] = {};
+    bool held = false;
+    BusPriority holderPriority = BusPriority::Storage;
+    uint32_t holdStartTime = 0;
+    uint32_t holdBudgetMicros;
+
+    static size_t toIndex(BusPriority priority) { return static_cast<size_t>(priority); }
+
+public:
+
+    explicit SpiArbitration(uint32_t holdBudgetMicros) : holdBudgetMicros(holdBudgetMicros) {}
+
+    void addWaiter(BusPriority priority) { waiterCounts[toIndex(priority)]++; }
+
+    void removeWaiter(BusPriority priority) { waiterCounts[toIndex(priority)]--; }
+
+    bool hasWaiterAbove(BusPriority priority) const {
+        for (size_t index = toIndex(priority) + 1; index < BUS_PRIORITY_COUNT; index++) {
+            if (waiterCounts[index] > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool hasWaiters() const {
+        for (auto count : waiterCounts) {
+            if (count > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool canAcquire(BusPriority priority) const { return !held && !hasWaiterAbove(priority); }
+
+    void onAcquired(BusPriority priority, uint32_t time) {
+        held = true;
+        holderPriority = priority;
+        holdStartTime = time;
+    }
+
+    /** @return the time that the bus was held */
+    uint32_t onReleased(uint32_t time) {
+        held = false;
+        return time - holdStartTime;
+    }
+
+    bool isHeld() const { return held; }
+
+    uint32_t getHoldTime(uint32_t time) const { return held ? time - holdStartTime : 0; }
+
+    bool shouldYield(uint32_t time) const {
+        return held && (hasWaiterAbove(holderPriority) || getHoldTime(time) >= holdBudgetMicros);
+    }
+
+    uint32_t getHoldBudgetMicros() const { return holdBudgetMicros; }
+};
+
+} // namespace tt::hal::spi
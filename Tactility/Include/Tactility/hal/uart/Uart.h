@@ -8,6 +8,7 @@
 #include "Tactility/hal/uart/Configuration.h"
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace tt::hal::uart {
@@ -26,12 +27,38 @@ enum class Status {
     Unknown
 };
 
+/** Counters for the buffered receive path (readFrame(), readLine() and readUntil()) */
+struct ReceiveStatistics {
+    /** The amount of bytes that were read into the receive buffer */
+    uint64_t bytesReceived;
+    /** The amount of frames that were returned */
+    uint32_t framesReceived;
+    /** The amount of frames that were discarded because they didn't fit in the receive buffer */
+    uint32_t overruns;
+};
+
 class Uart {
 
     uint32_t id;
 
+    std::unique_ptr<std::byte[]> receiveBuffer;
+    size_t receiveBufferSize = 0;
+    /** Start of the data that wasn't returned yet */
+    size_t receiveReadOffset = 0;
+    /** End of the received data */
+    size_t receiveWriteOffset = 0;
+    /** Start of the data that wasn't searched for a delimiter yet */
+    size_t receiveScanOffset = 0;
+    /** Set after an overrun: the remainder of the dropped frame is skipped */
+    bool receiveDiscarding = false;
+    ReceiveStatistics receiveStatistics = {};
+
+    bool fillReceiveBuffer(TickType_t timeout);
+
 public:
 
+    static constexpr size_t defaultReceiveBufferSize = 1024;
+
     Uart();
     virtual ~Uart();
 
@@ -107,9 +134,38 @@ public:
 
     /**
      * Read a buffer as a byte array until the specified character (the "untilChar" is included in the result)
-     * @return the amount of bytes read from UART
+     * This uses the buffered receive path: see readFrame()
+     * @return the amount of bytes read from UART, excluding the "untilByte"
      */
     size_t readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout = defaultTimeout, bool addNullTerminator = true);
+
+    /**
+     * Set the size of the receive buffer that is used by readFrame(), readLine() and readUntil().
+     * Frames that are larger than this are discarded and counted as overruns.
+     * Any data that is currently buffered is discarded.
+     */
+    void setReceiveBufferSize(size_t size);
+
+    /**
+     * Read data until the specified delimiter is received.
+     * Data is read in bulk from the driver into a receive buffer, so this doesn't do a call per byte.
+     * Data that was received after the delimiter stays buffered for the next call.
+     * @warning Don't mix this with readByte() or readBytes() as those don't see the buffered data.
+     * @warning Not thread-safe: only call this from a single reader thread.
+     * @param[in] delimiter the last byte of the frame
+     * @param[in] timeout the maximum time to wait for a full frame
+     * @return a view into the receive buffer (including the delimiter) that stays valid until the next read call,
+     * or an empty view when the timeout passed: the partial frame then stays buffered
+     */
+    std::string_view readFrame(uint8_t delimiter, TickType_t timeout = defaultTimeout);
+
+    /** @see readFrame() */
+    std::string_view readLine(TickType_t timeout = defaultTimeout) { return readFrame('\n', timeout); }
+
+    /** Discard all data in the receive buffer */
+    void clearReceiveBuffer();
+
+    ReceiveStatistics getReceiveStatistics() const { return receiveStatistics; }
 };
 
 /**
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace tt::lvgl {
+
+/**
+ * Register an image decoder for the pre-decoded images in the system asset pack.
+ * It takes precedence over the other decoders for images in the pack (e.g. "A:/system/spinner.png"),
+ * so Assets.h paths don't have to change.
+ * Must be called with the LVGL lock held.
+ */
+void initAssetPackDecoder();
+
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <Tactility/hal/display/DisplayDevice.h>
+
+#include <memory>
+#include <vector>
+
 namespace tt::lvgl {
 
 #ifdef ESP_PLATFORM
@@ -16,4 +21,10 @@ void start();
 
 void stop();
 
+/**
+ * @return the displays that LVGL renders to. The first one is the primary display: it is the LVGL default display,
+ * which shows the apps and the statusbar. Apps can create widgets on another display via lv_display_get_screen_active().
+ */
+std::vector<std::shared_ptr<hal::display::DisplayDevice>> getDisplays();
+
 }
@@ -0,0 +1,27 @@
+/**
+ * @file LvglOs.h
+ * The types of the LVGL OS abstraction when LVGL is configured with LV_OS_CUSTOM.
+ * This file is included by LVGL itself (LV_OS_CUSTOM_INCLUDE), so it must remain compatible with C.
+ * The implementation uses the TactilityCore Thread, Mutex and Semaphore classes: see LvglOs.cpp
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    void* thread;
+} lv_thread_t;
+
+typedef struct {
+    void* mutex;
+} lv_mutex_t;
+
+typedef struct {
+    void* semaphore;
+} lv_thread_sync_t;
+
+#ifdef __cplusplus
+}
+#endif
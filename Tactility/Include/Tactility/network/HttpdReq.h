@@ -3,6 +3,7 @@
 #ifdef ESP_PLATFORM
 
 #include <esp_http_server.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -26,6 +27,13 @@ bool readAndDiscardOrSendError(httpd_req_t* request, const std::string& toRead);
 
 size_t receiveFile(httpd_req_t* request, size_t length, const std::string& filePath);
 
+/**
+ * Receive data in chunks and pass each chunk on without storing all of it.
+ * @param[in] onChunk called for every received chunk, it can return false to stop receiving
+ * @return the amount of bytes that were received and accepted
+ */
+size_t receiveChunks(httpd_req_t* request, size_t length, size_t chunkSize, const std::function<bool(const void* data, size_t length)>& onChunk);
+
 }
 
 #endif // ESP_PLATFORM
\ No newline at end of file
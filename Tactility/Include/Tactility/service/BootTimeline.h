@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ServiceManifest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tt::service {
+
+/** The start of a system service during boot */
+struct ServiceStartRecord {
+    std::string id;
+    StartPhase phase;
+    /** The time since boot in microseconds */
+    uint64_t startTime;
+    uint64_t endTime;
+    /** false when onStart() failed or when a dependency failed to start */
+    bool success;
+};
+
+/** @return the records of the system services that were started during boot, in the order that they finished */
+std::vector<ServiceStartRecord> getBootTimeline();
+
+/**
+ * Write the boot timeline as CSV with the columns: id, phase, start (us), end (us), duration (us), success
+ * @return true on success
+ */
+bool exportBootTimeline(const std::string& path);
+
+} // namespace
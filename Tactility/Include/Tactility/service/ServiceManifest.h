@@ -3,6 +3,7 @@
 #include <Tactility/service/Service.h>
 
 #include <string>
+#include <vector>
 
 namespace tt::service {
 
@@ -11,6 +12,16 @@ class ServiceContext;
 
 typedef std::shared_ptr<Service>(*CreateService)();
 
+/** The moment at which a system service is started during boot */
+enum class StartPhase {
+    /** Before LVGL is initialized */
+    System,
+    /** After LVGL is initialized, before the boot app is started */
+    Gui,
+    /** After the boot app is started, so the service doesn't delay the first frame */
+    Background
+};
+
 /** A ledger that describes the main parts of a service. */
 struct ServiceManifest {
     /** The identifier by which the app is launched by the system and other apps. */
@@ -18,6 +29,15 @@ struct ServiceManifest {
 
     /** Create the instance of the app */
     CreateService createService = nullptr;
+
+    /**
+     * The ids of the services that must be started before this one.
+     * Services without dependencies between them are started in parallel during boot.
+     */
+    std::vector<std::string> dependencies {};
+
+    /** When the service is started during boot */
+    StartPhase startPhase = StartPhase::System;
 };
 
 } // namespace
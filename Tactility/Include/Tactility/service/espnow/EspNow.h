@@ -11,6 +11,12 @@ namespace tt::service::espnow {
 typedef int ReceiverSubscription;
 constexpr ReceiverSubscription NO_SUBSCRIPTION = -1;
 
+/** Called with the result of sendMessage() */
+typedef std::function<void(bool success)> SendCallback;
+
+/** Called with a message from sendMessage() on another device */
+typedef std::function<void(const uint8_t* address, const uint8_t* data, size_t length)> MessageReceiver;
+
 enum class Mode {
     Station,
     AccessPoint
@@ -43,10 +49,24 @@ bool isEnabled();
 
 bool addPeer(const esp_now_peer_info_t& peer);
 
+/** Send a single frame of up to ESP_NOW_MAX_DATA_LEN bytes, without acknowledgement */
 bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength);
 
+/**
+ * Send a message of up to 7.6 kB reliably: it's fragmented, acknowledged by the receiver and retransmitted when needed.
+ * Broadcast messages are sent once. The message is queued, so this doesn't wait for the radio.
+ * @param[in] callback called from the ESP-NOW thread when the message was acknowledged or when it failed
+ * @return false when the message is too large or when the send queue is full
+ */
+bool sendMessage(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCallback callback = nullptr);
+
+/** Receive the frames of send(). The callback is called from the ESP-NOW thread. */
 ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive);
 
+/** Receive the messages of sendMessage(). The callback is called from the ESP-NOW thread. */
+ReceiverSubscription subscribeMessageReceiver(MessageReceiver onReceive);
+
+/** Unsubscribe from subscribeReceiver() or subscribeMessageReceiver() */
 void unsubscribeReceiver(ReceiverSubscription subscription);
 
 }
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Tactility/DispatcherThread.h>
+#include <Tactility/EventFlag.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+#include <Tactility/service/Service.h>
+
+#include <deque>
+#include <dirent.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+namespace tt::service::fileio {
+
+/**
+ * Performs file operations on a background thread, so the caller (e.g. the GUI) never waits for storage.
+ *
+ * SPI SD cards share their bus lock with the display. Transfers are therefore split into chunks and
+ * the file lock is released between chunks. When the lock was contended or asks to be yielded
+ * (e.g. by the SPI arbiter), the thread backs off for part of a display refresh period,
+ * so the display can finish rendering.
+ *
+ * Consecutive requests for the same file are coalesced: multiple reads result in a single read,
+ * and appends are merged with the preceding write or append into a single transfer.
+ *
+ * Completion callbacks are called on the specified DispatcherThread,
+ * or on the I/O thread when no DispatcherThread is specified.
+ */
+class FileIoService final : public Service {
+
+public:
+
+    typedef std::shared_ptr<std::vector<uint8_t>> Data;
+    typedef std::function<void(bool success, Data data)> ReadCallback;
+    typedef std::function<void(bool success)> WriteCallback;
+    typedef std::function<void(bool success, const struct stat& info)> StatCallback;
+    typedef std::function<void(bool success, const std::vector<dirent>& entries)> ListCallback;
+    /** A custom file operation that returns true on success */
+    typedef std::function<bool()> Job;
+
+    struct Statistics {
+        uint32_t requests;
+        /** Requests that were handled as part of another request */
+        uint32_t coalescedRequests;
+        uint32_t chunks;
+        /** The amount of times that the file lock was busy when we wanted to use it */
+        uint32_t busyLocks;
+        /** The amount of times that the file lock asked to be yielded after a chunk */
+        uint32_t yields;
+    };
+
+    /** The maximum amount of bytes that is transferred while holding the file lock */
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+private:
+
+    enum class RequestType {
+        Read,
+        Write,
+        Append,
+        Stat,
+        List,
+        Execute
+    };
+
+    struct Request {
+        RequestType type;
+        std::string path;
+        /** The data to write or append */
+        Data data;
+        Job job;
+        std::shared_ptr<DispatcherThread> dispatcher;
+        ReadCallback readCallback;
+        WriteCallback writeCallback;
+        StatCallback statCallback;
+        ListCallback listCallback;
+    };
+
+    enum Flag {
+        FlagRequest = 1U,
+        FlagStop = 2U
+    };
+
+    Mutex mutex;
+    std::deque<Request> requests;
+    Statistics statistics = {};
+    TickType_t busyBackoffTime;
+    EventFlag eventFlag;
+    std::unique_ptr<Thread> thread;
+
+    int32_t threadMain();
+
+    void enqueue(Request request);
+
+    /** @return the amount of requests that were handled, starting at the specified index */
+    size_t process(std::vector<Request>& batch, size_t index);
+
+    bool lockChunk(const std::shared_ptr<Lock>& lock);
+
+    void unlockChunk(const std::shared_ptr<Lock>& lock, bool wasBusy);
+
+    bool readFileChunked(const std::string& path, std::vector<uint8_t>& output);
+
+    bool writeFileChunked(const std::string& path, const std::vector<Data>& parts, bool append);
+
+    static void complete(const std::shared_ptr<DispatcherThread>& dispatcher, std::function<void()> function);
+
+public:
+
+    FileIoService();
+
+    bool onStart(ServiceContext& serviceContext) override;
+    void onStop(ServiceContext& serviceContext) override;
+
+    /** Read a whole file */
+    void readFile(const std::string& path, ReadCallback callback, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    /** Create or overwrite a file */
+    void writeFile(const std::string& path, Data data, WriteCallback callback = nullptr, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    /** Append to a file, or create it when it doesn't exist */
+    void appendFile(const std::string& path, Data data, WriteCallback callback = nullptr, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    void stat(const std::string& path, StatCallback callback, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    /** List a directory, without the "." and ".." entries */
+    void listDirectory(const std::string& path, ListCallback callback, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    /**
+     * Run a custom file operation on the I/O thread (e.g. file::loadPropertiesFile() or saving a screenshot).
+     * The job is responsible for its own file locking.
+     */
+    void execute(Job job, WriteCallback callback = nullptr, std::shared_ptr<DispatcherThread> dispatcher = nullptr);
+
+    /** @param[in] time how long to back off after a chunk when another task was waiting for the file lock */
+    void setBusyBackoffTime(TickType_t time);
+
+    /** @return the amount of requests that are waiting */
+    size_t getPendingRequestCount() const;
+
+    Statistics getStatistics() const;
+};
+
+std::shared_ptr<FileIoService> findFileIoService();
+
+} // namespace tt::service::fileio
@@ -6,6 +6,7 @@
 #include "Tactility/service/Service.h"
 #include "Tactility/service/ServiceContext.h"
 #include "Tactility/service/gps/GpsState.h"
+#include "Tactility/service/gps/GpsTrackRecorder.h"
 
 namespace tt::service::gps {
 
@@ -19,6 +20,9 @@ class GpsService final : public Service {
 
     minmea_sentence_rmc rmcRecord;
     TickType_t rmcTime = 0;
+    /** Decimeters, from the last GGA sentence with a fix */
+    int32_t altitude = 0;
+    std::unique_ptr<TrackRecorder> trackRecorder;
 
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     Mutex stateMutex;
@@ -42,6 +46,8 @@ class GpsService final : public Service {
 
     bool getConfigurationFilePath(std::string& output) const;
 
+    bool getTrackFilePath(std::string& output) const;
+
 public:
 
     bool onStart(ServiceContext &serviceContext) override;
@@ -58,6 +64,18 @@ public:
     bool hasCoordinates() const;
     bool getCoordinates(minmea_sentence_rmc& rmc) const;
 
+    /**
+     * Start recording the received positions to a new track file in the user data directory.
+     * Recording continues while receiving is stopped and restarted.
+     * @see GpsTrack.h for reading and exporting the track
+     */
+    bool startRecording();
+    void stopRecording();
+    bool isRecording() const;
+
+    /** @return the path of the track that is being recorded, or an empty string when not recording */
+    std::string getRecordingFilePath() const;
+
     /** @return GPS service pubsub that broadcasts State* objects */
     std::shared_ptr<PubSub<State>> getStatePubsub() const { return statePubSub; }
 };
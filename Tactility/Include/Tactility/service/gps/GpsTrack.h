@@ -0,0 +1,135 @@
+#pragma once
+
+#include <Tactility/file/ObjectFile.h>
+
+#include <minmea.h>
+
+#include <cstdint>
+#include <string>
+
+/**
+ * GPS tracks are stored as an ObjectFile with fixed-size TrackChunk records.
+ * Each chunk holds an absolute start point followed by small deltas, so a chunk of 32 points
+ * takes less than 9 bytes per point.
+ * Chunks are ordered by time, which allows for a binary search when looking up a timestamp.
+ *
+ * @warning The functionality below does NOT safely acquire file locks, unless stated otherwise.
+ */
+namespace tt::service::gps {
+
+/** The record version of the TrackChunk ObjectFile records */
+constexpr uint32_t TRACK_RECORD_VERSION = 1;
+/** The amount of points that fit in a chunk, besides its start point */
+constexpr uint32_t TRACK_CHUNK_DELTA_COUNT = 31;
+
+struct TrackPoint {
+    /** Seconds since the Unix epoch */
+    uint32_t time;
+    /** Degrees, multiplied by 10^7 */
+    int32_t latitude;
+    /** Degrees, multiplied by 10^7 */
+    int32_t longitude;
+    /** Decimeters above mean sea level */
+    int32_t altitude;
+};
+
+/** The difference with the previous point */
+struct TrackDelta {
+    uint16_t time;
+    int16_t latitude;
+    int16_t longitude;
+    int16_t altitude;
+};
+
+struct TrackChunk {
+    TrackPoint start;
+    uint16_t deltaCount;
+    uint16_t reserved;
+    TrackDelta deltas[TRACK_CHUNK_DELTA_COUNT];
+};
+
+/**
+ * Create a track point from the GPS sentences.
+ * @param[in] rmc the sentence that provides the time and position
+ * @param[in] altitude altitude in decimeters (e.g. from the last GGA sentence)
+ * @param[out] point the result
+ * @return false when the sentence does not contain a valid fix
+ */
+bool createTrackPoint(const minmea_sentence_rmc& rmc, int32_t altitude, TrackPoint& point);
+
+/** Reset the chunk so it only contains the specified point */
+void beginTrackChunk(TrackChunk& chunk, const TrackPoint& point);
+
+/**
+ * Add a point to the chunk.
+ * @param[in] chunk the chunk to add to
+ * @param[in] lastPoint the last point that was added to the chunk
+ * @param[in] point the point to add
+ * @return false when the chunk is full, or when the difference with the last point doesn't fit in a delta
+ */
+bool appendTrackChunk(TrackChunk& chunk, const TrackPoint& lastPoint, const TrackPoint& point);
+
+/** @return the amount of points in the chunk */
+inline uint32_t getTrackChunkPointCount(const TrackChunk& chunk) { return chunk.deltaCount + 1; }
+
+/** Reads track points in chronological order */
+class TrackReader final {
+
+    file::ObjectFileReader reader;
+    TrackChunk chunk = {};
+    /** The last decoded point of the current chunk */
+    TrackPoint point = {};
+    /** The index of the next point in the current chunk */
+    uint32_t pointIndex = 0;
+    bool hasChunk = false;
+    /** A point that was read ahead by seek() */
+    TrackPoint pendingPoint = {};
+    bool hasPendingPoint = false;
+
+    bool readChunk();
+
+    bool readChunkAt(uint32_t chunkIndex);
+
+public:
+
+    explicit TrackReader(std::string filePath) : reader(std::move(filePath), sizeof(TrackChunk)) {}
+
+    bool open();
+
+    void close();
+
+    /** @return the amount of TrackChunk records */
+    uint32_t getChunkCount() const { return reader.getRecordCount(); }
+
+    /**
+     * Continue reading at the first point that was recorded at or after the specified time.
+     * Performs a binary search over the chunks, so only a few chunks are read.
+     * @param[in] time seconds since the Unix epoch
+     * @return false when there are no points at or after the specified time
+     */
+    bool seek(uint32_t time);
+
+    bool hasNext() const;
+
+    bool readNext(TrackPoint& output);
+};
+
+/**
+ * Export a track file to GPX 1.1
+ * Acquires the file locks by itself.
+ * @param[in] trackPath the path of the track file
+ * @param[in] outputPath the path of the file to (over)write
+ * @return true on success
+ */
+bool exportTrackToGpx(const std::string& trackPath, const std::string& outputPath);
+
+/**
+ * Export a track file to a GeoJSON LineString feature
+ * Acquires the file locks by itself.
+ * @param[in] trackPath the path of the track file
+ * @param[in] outputPath the path of the file to (over)write
+ * @return true on success
+ */
+bool exportTrackToGeoJson(const std::string& trackPath, const std::string& outputPath);
+
+} // namespace tt::service::gps
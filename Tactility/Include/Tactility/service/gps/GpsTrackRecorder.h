@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Tactility/service/gps/GpsTrack.h"
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+
+#include <memory>
+#include <vector>
+
+namespace tt::service::gps {
+
+/**
+ * Records track points to a track file.
+ * Points are batched into chunks in memory. Full chunks are written by a low priority thread,
+ * which acquires the file lock for one chunk at a time. This keeps the lock hold times short when
+ * the file lives on an SD card that shares its SPI bus with the display.
+ */
+class TrackRecorder final {
+
+public:
+
+    struct Statistics {
+        uint32_t pointsRecorded;
+        uint32_t chunksWritten;
+        /** Points that were lost because the writer thread couldn't keep up or because writing failed */
+        uint32_t pointsDropped;
+    };
+
+    /** The maximum amount of chunks that are kept in memory while waiting to be written */
+    static constexpr size_t MAX_PENDING_CHUNKS = 8;
+
+private:
+
+    enum Flag {
+        FlagFlush = 1U,
+        FlagStop = 2U
+    };
+
+    const std::string filePath;
+    const TickType_t flushInterval;
+
+    /** Guards the current chunk, the pending chunks and the statistics */
+    Mutex mutex;
+    TrackChunk currentChunk = {};
+    TrackPoint lastPoint = {};
+    bool hasCurrentChunk = false;
+    std::vector<TrackChunk> pendingChunks;
+    Statistics statistics = {};
+
+    EventFlag eventFlag;
+    std::unique_ptr<Thread> thread;
+    /** Only used by the writer thread while it runs */
+    std::unique_ptr<file::ObjectFileWriter> writer;
+    /** Only used by the writer thread: the chunks that are being written */
+    std::vector<TrackChunk> writingChunks;
+
+    int32_t threadMain();
+
+    void queueCurrentChunk();
+
+    void writePendingChunks();
+
+public:
+
+    /**
+     * @param[in] filePath the track file to create
+     * @param[in] flushInterval the maximum time that a full chunk waits before it is written
+     */
+    explicit TrackRecorder(std::string filePath, TickType_t flushInterval = kernel::secondsToTicks(5)) :
+        filePath(std::move(filePath)),
+        flushInterval(flushInterval)
+    {}
+
+    ~TrackRecorder();
+
+    /** Create the track file and start the writer thread */
+    bool start();
+
+    /** Write all remaining points and close the track file */
+    void stop();
+
+    bool isStarted() const { return thread != nullptr; }
+
+    /**
+     * Add a point to the track. Never waits for file I/O.
+     * Points that are older than the previous point are ignored.
+     */
+    void addPoint(const TrackPoint& point);
+
+    const std::string& getFilePath() const { return filePath; }
+
+    Statistics getStatistics() const;
+};
+
+} // namespace tt::service::gps
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tt::service::imagecache {
+
+struct Statistics {
+    /** The memory budget for decoded images in bytes */
+    uint32_t budget;
+    /** The memory that is used by decoded images in bytes */
+    uint32_t size;
+    /** Image lookups that found a decoded image in the cache */
+    uint32_t hits;
+    /** Image lookups that had to decode the image */
+    uint32_t misses;
+    /** The amount of times that an image decoder opened an image */
+    uint32_t decodes;
+    uint64_t totalDecodeMicros;
+    uint32_t maxDecodeMicros;
+    size_t pinnedCount;
+};
+
+/** @return the budget that the service starts with: it's larger when PSRAM is available */
+uint32_t getDefaultBudget();
+
+/**
+ * Set the memory budget for decoded images.
+ * The least recently used images are evicted when the budget is exceeded, except for the pinned images.
+ * A budget of 0 disables the cache.
+ */
+void setBudget(uint32_t budget);
+
+/**
+ * Decode an image and keep it in the cache until it is unpinned, e.g. for statusbar and launcher icons.
+ * Images that LVGL doesn't cache (e.g. pre-decoded images in the asset pack) are not pinned.
+ * @param[in] path the LVGL path of the image (e.g. "A:/system/spinner.png")
+ * @return true when the image is pinned, when it was already pinned or when it doesn't need to be cached
+ */
+bool pin(const std::string& path);
+
+/** Allow a pinned image to be evicted again */
+void unpin(const std::string& path);
+
+/** @return the statistics since the service started, or since the last reset */
+Statistics getStatistics();
+
+void resetStatistics();
+
+}
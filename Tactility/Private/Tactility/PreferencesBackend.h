@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <variant>
+
+namespace tt {
+
+typedef std::variant<bool, int32_t, int64_t, std::string> PreferenceValue;
+
+/** The storage of a single Preferences namespace: NVS on ESP32, a file on simulator */
+class PreferencesBackend {
+
+public:
+
+    virtual ~PreferencesBackend() = default;
+
+    /**
+     * @param[in] key the key to read
+     * @param[in,out] value contains the type to read, and receives the value
+     * @return true when a value of this type was found
+     */
+    virtual bool get(const std::string& key, PreferenceValue& value) = 0;
+
+    virtual bool set(const std::string& key, const PreferenceValue& value) = 0;
+
+    /** Persist the values that were set */
+    virtual bool commit() = 0;
+};
+
+/** @return the storage of the namespace, or nullptr when it can't be opened */
+std::unique_ptr<PreferencesBackend> openPreferencesBackend(const std::string& namespace_);
+
+/** Forget all open namespaces and their cached values, so the next access opens the backend again */
+void resetPreferencesCache();
+
+#ifndef ESP_PLATFORM
+/** Set the directory that contains a file for each namespace. This also resets the cache. */
+void setPreferencesDirectory(const std::string& path);
+#endif
+
+} // namespace
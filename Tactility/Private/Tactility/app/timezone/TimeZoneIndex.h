@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tt::app::timezone {
+
+/**
+ * An in-memory index of timezones.csv, which is parsed once when the app starts.
+ * The entries are sorted by name. Names and codes are stored in a single string to avoid an allocation per entry.
+ * Searching is a substring search on a single string with all lowercase names, instead of a search per name.
+ */
+class TimeZoneIndex final {
+
+    struct Entry {
+        uint32_t nameOffset;
+        uint32_t codeOffset;
+    };
+
+    /** The names and codes of all entries, separated by null terminators */
+    std::string strings;
+    /** The lowercase names in the order of the entries, each followed by a newline */
+    std::string searchText;
+    /** The offset of each entry in searchText, followed by the size of searchText */
+    std::vector<uint32_t> searchOffsets;
+    std::vector<Entry> entries;
+
+    std::string_view getSearchName(uint16_t index) const {
+        return std::string_view(searchText).substr(searchOffsets[index], searchOffsets[index + 1] - searchOffsets[index] - 1);
+    }
+
+public:
+
+    /**
+     * Parse CSV lines with a quoted name and code, e.g.: "Europe/Amsterdam","CET-1CEST,M3.5.0,M10.5.0/3"
+     * @return false when no entries were found
+     */
+    bool parse(std::string_view csv);
+
+    /** Load and parse a CSV file */
+    bool load(const std::string& path);
+
+    uint16_t getCount() const { return entries.size(); }
+
+    const char* getName(uint16_t index) const { return strings.data() + entries[index].nameOffset; }
+
+    const char* getCode(uint16_t index) const { return strings.data() + entries[index].codeOffset; }
+
+    /**
+     * Find all entries with a name that contains the query.
+     * @param[in] lowercaseQuery the text to search for (in lowercase)
+     * @param[out] results the indices of the entries, in alphabetical order
+     */
+    void search(std::string_view lowercaseQuery, std::vector<uint16_t>& results) const;
+
+    /**
+     * Remove the entries that don't contain the query. This is faster than a search when the results contain a part of the query.
+     * @param[in] lowercaseQuery the text to search for (in lowercase)
+     * @param[in,out] results the indices of the entries, in alphabetical order
+     */
+    void refine(std::string_view lowercaseQuery, std::vector<uint16_t>& results) const;
+};
+
+/** Searches incrementally while the user types: when the query grows, only the previous results are searched */
+class TimeZoneSearch final {
+
+    const TimeZoneIndex& index;
+    std::string query;
+    std::vector<uint16_t> results;
+
+public:
+
+    explicit TimeZoneSearch(const TimeZoneIndex& index) : index(index) {
+        index.search({}, results);
+    }
+
+    /** @return true when the results changed */
+    bool setQuery(const std::string& newQuery);
+
+    const std::vector<uint16_t>& getResults() const { return results; }
+};
+
+} // namespace
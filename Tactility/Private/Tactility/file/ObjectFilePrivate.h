@@ -1,19 +1,60 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
 namespace tt::file {
 
 constexpr uint32_t OBJECT_FILE_IDENTIFIER = 0x13371337;
-constexpr uint32_t OBJECT_FILE_VERSION = 1;
+/** Version 1: the record count is only written when closing the file */
+constexpr uint32_t OBJECT_FILE_VERSION_1 = 1;
+/** Version 2: the record count is checkpointed while writing and the record data is aligned */
+constexpr uint32_t OBJECT_FILE_VERSION_2 = 2;
+constexpr uint32_t OBJECT_FILE_VERSION = OBJECT_FILE_VERSION_2;
+
+/** The offset of the first record in version 2 files */
+constexpr uint32_t OBJECT_FILE_DATA_ALIGNMENT = 512;
 
 struct FileHeader {
     uint32_t identifier = OBJECT_FILE_IDENTIFIER;
     uint32_t version = OBJECT_FILE_VERSION;
 };
 
+/** The content header of version 1 files */
 struct ContentHeader {
     uint32_t recordVersion = 0;
     uint32_t recordSize = 0;
     uint32_t recordCount = 0;
 };
 
+/** The content header of version 2 files */
+struct ContentHeaderV2 {
+    uint32_t recordVersion = 0;
+    uint32_t recordSize = 0;
+    /** The amount of records that were completely written at the last checkpoint */
+    uint32_t recordCount = 0;
+    /** The file offset of the first record */
+    uint32_t dataOffset = OBJECT_FILE_DATA_ALIGNMENT;
+};
+
+/** The parsed headers of either file version */
+struct ContentInfo {
+    uint32_t fileVersion;
+    uint32_t recordVersion;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t dataOffset;
+};
+
+/**
+ * Read and validate the headers of an object file.
+ * The record count is limited to the amount of records that are completely stored in the file.
+ * @param[in] file a file that is positioned at the start
+ * @param[in] filePath the path of the file (for logging)
+ * @param[out] info the parsed headers
+ * @return true when the headers are valid
+ */
+bool readHeaders(FILE* file, const std::string& filePath, ContentInfo& info);
+
 }
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace tt::file {
+
+/**
+ * Serve the files of the system mount point from the asset pack, when one is available:
+ * - ESP: the memory-mapped "assets" partition
+ * - Simulator: the memory-mapped "system.ttpack" file in the working directory
+ * Without an asset pack, the files are read from the system partition or directory.
+ * @return true when the asset pack was loaded
+ */
+bool loadSystemAssetPack();
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <minmea.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tt::hal::gps {
+
+/** Receives the frames that were decoded by a StreamParser. All data is only valid during the call. */
+class StreamParserListener {
+
+public:
+
+    virtual ~StreamParserListener() = default;
+
+    virtual void onRmc(const minmea_sentence_rmc& rmc) {}
+    virtual void onGga(const minmea_sentence_gga& gga) {}
+    virtual void onGsa(const minmea_sentence_gsa& gsa) {}
+    virtual void onGsv(const minmea_sentence_gsv& gsv) {}
+    virtual void onVtg(const minmea_sentence_vtg& vtg) {}
+    virtual void onZda(const minmea_sentence_zda& zda) {}
+
+    /** Called for every valid NMEA sentence (including the ones above), without the line ending */
+    virtual void onNmeaSentence(std::string_view sentence) {}
+
+    /** Called for every valid UBX frame */
+    virtual void onUbxFrame(uint8_t classId, uint8_t messageId, const uint8_t* payload, uint16_t payloadLength) {}
+};
+
+/**
+ * A byte-driven parser that demultiplexes NMEA sentences and UBX frames from a single stream.
+ * Checksums are validated while bytes come in and no heap memory is used.
+ * Not thread-safe: feed it from a single thread.
+ */
+class StreamParser final {
+
+public:
+
+    struct Statistics {
+        uint32_t nmeaSentences;
+        uint32_t ubxFrames;
+        uint32_t checksumErrors;
+        /** Frames that were longer than the internal buffers */
+        uint32_t overflows;
+    };
+
+    /** Payloads larger than this are dropped (the largest one we use is UBX-MON-VER) */
+    static constexpr size_t UBX_MAX_PAYLOAD_SIZE = 512;
+
+private:
+
+    enum class State {
+        Idle,
+        NmeaBody,
+        NmeaChecksumHigh,
+        NmeaChecksumLow,
+        UbxSync,
+        UbxClass,
+        UbxId,
+        UbxLengthLow,
+        UbxLengthHigh,
+        UbxPayload,
+        UbxChecksumA,
+        UbxChecksumB
+    };
+
+    StreamParserListener& listener;
+    State state = State::Idle;
+    Statistics statistics = {};
+
+    // +1 for the null terminator that minmea needs
+    char nmeaBuffer[MINMEA_MAX_SENTENCE_LENGTH + 1];
+    size_t nmeaLength = 0;
+    uint8_t nmeaChecksum = 0;
+    uint8_t nmeaExpectedChecksum = 0;
+
+    uint8_t ubxClass = 0;
+    uint8_t ubxId = 0;
+    uint16_t ubxLength = 0;
+    uint16_t ubxOffset = 0;
+    uint8_t ubxChecksumA = 0;
+    uint8_t ubxChecksumB = 0;
+    uint8_t ubxPayload[UBX_MAX_PAYLOAD_SIZE];
+
+    void addUbxChecksum(uint8_t byte) {
+        ubxChecksumA += byte;
+        ubxChecksumB += ubxChecksumA;
+    }
+
+    void appendNmea(char character);
+
+    void onNmeaComplete();
+
+    void onUbxComplete();
+
+    void startFrame(uint8_t byte);
+
+public:
+
+    explicit StreamParser(StreamParserListener& listener) : listener(listener) {}
+
+    /** Parse a single byte */
+    void feed(uint8_t byte);
+
+    /** Parse a chunk of bytes */
+    void feed(const uint8_t* data, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            feed(data[i]);
+        }
+    }
+
+    /** Discard any partially received frame */
+    void reset() { state = State::Idle; }
+
+    Statistics getStatistics() const { return statistics; }
+};
+
+} // namespace tt::hal::gps
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Tactility/hal/i2c/I2cBackend.h"
+
+#include <Tactility/Mutex.h>
+
+#include <array>
+#include <map>
+#include <vector>
+
+namespace tt::hal::i2c {
+
+/**
+ * A simulated bus with devices that have 256 registers each.
+ * A write sets the register address with the first byte and writes the registers after it.
+ * A read continues at the current register address. Both auto-increment the register address.
+ *
+ * It doesn't wait: it calculates the time that the transfers would take on a real bus.
+ */
+class I2cMockBackend final : public I2cBackend {
+
+public:
+
+    struct Statistics {
+        /** Transfers from a start to a stop condition */
+        uint32_t transfers = 0;
+        /** Address and data bytes */
+        uint32_t bytes = 0;
+        uint64_t busTimeMicros = 0;
+    };
+
+private:
+
+    struct MockDevice {
+        std::array<uint8_t, 256> registers = {};
+        uint8_t registerAddress = 0;
+    };
+
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+    uint32_t frequency;
+    uint32_t transferOverheadMicros;
+    std::map<uint8_t, MockDevice> devices;
+    /** The device address of every transfer */
+    std::vector<uint8_t> transferLog;
+    Statistics statistics;
+
+    MockDevice* startTransfer(uint8_t address, size_t byteCount, bool repeatedStart);
+
+public:
+
+    /**
+     * @param[in] frequency the SCL frequency in Hz
+     * @param[in] transferOverheadMicros the time that the driver needs to start a transfer
+     */
+    explicit I2cMockBackend(uint32_t frequency = 400000, uint32_t transferOverheadMicros = 0) :
+        frequency(frequency),
+        transferOverheadMicros(transferOverheadMicros)
+    {}
+
+    void addDevice(uint8_t address);
+
+    void setRegister(uint8_t address, uint8_t reg, uint8_t value);
+
+    uint8_t getRegister(uint8_t address, uint8_t reg);
+
+    std::vector<uint8_t> getTransferLog();
+
+    Statistics getStatistics();
+
+    void resetStatistics();
+
+    bool lock(TickType_t timeout) override { return mutex.lock(timeout); }
+    void unlock() override { mutex.unlock(); }
+
+    bool read(uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) override;
+    bool write(uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) override;
+    bool writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout) override;
+};
+
+} // namespace tt::hal::i2c
@@ -12,22 +12,24 @@ namespace tt::hal::uart {
 class UartPosix final : public Uart {
 
 private:
-    struct AutoCloseFileDeleter {
-        void operator()(FILE* file) {
-            fclose(file);
-        }
-    };
 
     Mutex mutex;
     const Configuration& configuration;
-    std::unique_ptr<FILE, AutoCloseFileDeleter> device;
+    /** File descriptor of the opened device, or -1 when not started */
+    int device = -1;
 
-    bool awaitAvailable(TickType_t timeout);
+    /** @return the time that is left of the timeout that started at the specified time */
+    static TickType_t getRemainingTime(TickType_t startTime, TickType_t timeout);
+
+    /** Wait until data can be read (uses poll()) */
+    static bool awaitAvailable(int device, TickType_t timeout);
 
 public:
 
     explicit UartPosix(const Configuration& configuration) : configuration(configuration) {}
 
+    ~UartPosix() override;
+
     bool start() final;
     bool isStarted() const final;
     bool stop() final;
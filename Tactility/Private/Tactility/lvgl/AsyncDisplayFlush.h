@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/Thread.h>
+
+#include <lvgl.h>
+
+#include <atomic>
+#include <memory>
+
+namespace tt::lvgl {
+
+/**
+ * Moves the flushing of an LVGL display to a separate thread, so that a slow display (e.g. a monochrome I2C panel)
+ * doesn't block the LVGL task and the refreshes of the other displays.
+ *
+ * When LVGL calls the flush callback, the rendered frame is copied and LVGL continues immediately.
+ * The thread calls the original flush callback with the copy.
+ * When a frame is rendered while the previous frame is still being sent, the frame is skipped
+ * and the display is redrawn after the transfer is finished.
+ *
+ * Only displays that render full frames are supported, because skipping partial areas would lose them.
+ * The original flush callback must not use LVGL functions other than reading the display properties
+ * and lv_display_flush_ready(), because it doesn't run with the LVGL lock.
+ * It should also send the pixels before it returns (e.g. over I2C): the copy is re-used for the next frame.
+ */
+class AsyncDisplayFlush final {
+
+    static constexpr uint32_t FLAG_FLUSH = 1U;
+    static constexpr uint32_t FLAG_STOP = 2U;
+
+    lv_display_t* display;
+    lv_display_flush_cb_t flushCallback;
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t bufferSize = 0;
+    lv_area_t area = {};
+    std::atomic<bool> busy = false;
+    std::atomic<bool> redrawNeeded = false;
+    lv_timer_t* _Nullable redrawTimer = nullptr;
+    EventFlag eventFlag;
+    std::unique_ptr<Thread> thread;
+
+    static void onFlush(lv_display_t* display, const lv_area_t* area, uint8_t* pixelMap);
+
+    static void onRedrawTimer(lv_timer_t* timer);
+
+    int32_t threadMain();
+
+public:
+
+    /**
+     * Must be called with the LVGL lock.
+     * @param[in] display the display that renders full frames
+     * @param[in] refreshPeriod the refresh period of the display in milliseconds: skipped frames are redrawn with this interval
+     */
+    AsyncDisplayFlush(lv_display_t* display, uint32_t refreshPeriod);
+
+    /** Restores the original flush callback. Must be called with the LVGL lock. */
+    ~AsyncDisplayFlush();
+
+    AsyncDisplayFlush(const AsyncDisplayFlush&) = delete;
+    AsyncDisplayFlush& operator=(const AsyncDisplayFlush&) = delete;
+
+    /** @return false when the display doesn't render full frames */
+    static bool isSupported(lv_display_t* display);
+};
+
+} // namespace
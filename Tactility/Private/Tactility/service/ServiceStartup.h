@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Tactility/service/BootTimeline.h"
+#include "Tactility/service/ServiceManifest.h"
+#include "Tactility/service/ServiceRegistration.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tt::service {
+
+typedef std::function<bool(const std::string& id)> StartServiceFunction;
+typedef std::function<bool(const std::string& id)> IsServiceStartedFunction;
+
+/** @return true when the service is running */
+bool isServiceStarted(const std::string& id);
+
+/**
+ * Start services on multiple threads. A service starts when the services that it depends on have started.
+ * Dependencies that aren't part of the list must be started already (e.g. in an earlier boot phase).
+ * When a service fails to start, the services that depend on it aren't started.
+ * @param[in] manifests the registered services to start
+ * @param[in] workerCount the maximum amount of services that start at the same time
+ * @param[out] outRecords the start and end times of the services, in the order that they finished
+ * @param[in] startFunction starts a service by its id
+ * @param[in] isStartedFunction checks whether a dependency that isn't part of the list is running
+ * @return true when all services started
+ */
+bool startServices(
+    const std::vector<std::shared_ptr<const ServiceManifest>>& manifests,
+    size_t workerCount,
+    std::vector<ServiceStartRecord>& outRecords,
+    const StartServiceFunction& startFunction = startService,
+    const IsServiceStartedFunction& isStartedFunction = isServiceStarted
+);
+
+/** @return the timeline in the CSV format of exportBootTimeline() */
+std::string formatBootTimeline(const std::vector<ServiceStartRecord>& records);
+
+/** Log the timeline as a chart with a row per service */
+void logBootTimeline(const std::vector<ServiceStartRecord>& records);
+
+/** Add records to the timeline of getBootTimeline() */
+void addToBootTimeline(const std::vector<ServiceStartRecord>& records);
+
+} // namespace
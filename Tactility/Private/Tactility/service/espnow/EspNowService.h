@@ -4,9 +4,13 @@
 #include "Tactility/MessageQueue.h"
 #include "Tactility/service/Service.h"
 #include "Tactility/service/espnow/EspNow.h"
+#include "Tactility/service/espnow/Transport.h"
 
+#include <Tactility/EventFlag.h>
 #include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
 
+#include <deque>
 #include <functional>
 
 namespace tt::service::espnow {
@@ -20,16 +24,44 @@ private:
         std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive;
     };
 
-    struct SendCallback {
-        uint8_t macAddress[ESP_NOW_ETH_ALEN];
-        bool success;
+    struct MessageSubscriptionData {
+        ReceiverSubscription id;
+        MessageReceiver onReceive;
+    };
+
+    /** A copy of a frame from the Wi-Fi task */
+    struct ReceivedFrame {
+        uint8_t sourceAddress[ESP_NOW_ETH_ALEN];
+        uint8_t destinationAddress[ESP_NOW_ETH_ALEN];
+        wifi_pkt_rx_ctrl_t rxControl;
+        std::vector<uint8_t> data;
     };
 
+    class EspNowLink final : public TransportLink {
+    public:
+        SendResult sendFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize) override;
+    };
+
+    static constexpr uint32_t FlagReceive = 1U;
+    static constexpr uint32_t FlagSend = 2U;
+    static constexpr uint32_t FlagStop = 4U;
+
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     std::vector<ReceiverSubscriptionData> subscriptions;
+    std::vector<MessageSubscriptionData> messageSubscriptions;
     ReceiverSubscription lastSubscriptionId = 0;
     bool enabled = false;
 
+    /** Guards only the received frames, so the Wi-Fi task never waits for the worker */
+    Mutex receiveMutex;
+    std::deque<ReceivedFrame> receivedFrames;
+
+    EspNowLink link;
+    /** Guarded by mutex */
+    std::unique_ptr<Transport> transport;
+    EventFlag eventFlag;
+    std::unique_ptr<Thread> thread;
+
     // Dispatcher calls this and forwards to non-static function
     void enableFromDispatcher(const EspNowConfig& config);
 
@@ -38,6 +70,11 @@ private:
     static void receiveCallback(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length);
     void onReceive(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length);
 
+    void startThread();
+    void stopThread();
+    int32_t threadMain();
+    void deliverFrame(const ReceivedFrame& frame);
+
 public:
 
     // region Overrides
@@ -59,8 +96,12 @@ public:
 
     bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength);
 
+    bool sendMessage(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCallback callback);
+
     ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive);
 
+    ReceiverSubscription subscribeMessageReceiver(MessageReceiver onReceive);
+
     void unsubscribeReceiver(ReceiverSubscription subscription);
 
     // region Internal API
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace tt::service::espnow {
+
+constexpr size_t PEER_ADDRESS_SIZE = 6;
+
+typedef std::array<uint8_t, PEER_ADDRESS_SIZE> PeerAddress;
+
+enum class SendResult {
+    Sent,
+    /** The frame wasn't accepted now (e.g. the buffers are full), so it can be sent again later */
+    Busy,
+    /** The frame can never be sent to the address (e.g. it isn't a registered peer) */
+    Failed
+};
+
+/** Sends frames to peers. For ESP-NOW a frame is a single esp_now_send() call. */
+class TransportLink {
+
+public:
+
+    virtual ~TransportLink() = default;
+
+    virtual SendResult sendFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize) = 0;
+};
+
+/**
+ * A reliable message protocol on top of a link with small frames that can get lost.
+ *
+ * Messages are split into fragments that fit a frame. The receiver acknowledges all fragments of a message
+ * with a single bitmask, so the sender only retransmits the missing fragments.
+ * Frames are paced with a token bucket, so a large message doesn't flood the radio.
+ * Messages to the broadcast address are sent once and not acknowledged.
+ * Messages are delivered when they are complete, so a message that needs a retransmission doesn't hold back later ones.
+ * A message fails right away when the link can't send to its address, so it doesn't hold back later ones either.
+ *
+ * The transport has no thread and no clock: the owner passes the time to onFrame() and poll(),
+ * which makes it deterministic in tests. It isn't thread-safe.
+ * Received messages and finished sends are collected, so the owner can handle them outside its lock.
+ */
+class Transport final {
+
+public:
+
+    /** The first byte of every frame of the transport, which is never the first byte of UTF-8 text */
+    static constexpr uint8_t FRAME_MAGIC = 0xFE;
+    static constexpr size_t DATA_HEADER_SIZE = 6;
+    static constexpr size_t ACK_SIZE = 9;
+    /** The fragments of a message are acknowledged in a 32 bit mask */
+    static constexpr size_t MAX_FRAGMENTS = 32;
+
+    struct Configuration {
+        /** The maximum frame size of the link: ESP_NOW_MAX_DATA_LEN */
+        size_t maxFrameSize = 250;
+        /** The amount of messages that can wait to be sent or acknowledged */
+        size_t maxPendingMessages = 16;
+        /** The average time between data frames */
+        uint32_t frameIntervalMicros = 2000;
+        /** The amount of data frames that can be sent without waiting for the interval */
+        uint32_t maxBurstFrames = 4;
+        /** The time without new fragments after which a receiver acknowledges an incomplete message */
+        uint32_t ackDelayMicros = 5000;
+        /** The time after the last fragment was sent before missing fragments are sent again */
+        uint32_t retransmitTimeoutMicros = 50000;
+        /** The amount of retransmissions without a newly acknowledged fragment, after which a message fails */
+        uint8_t maxRetransmits = 8;
+        /** The time after which an incomplete message is discarded */
+        uint32_t reassemblyTimeoutMicros = 2000000;
+    };
+
+    typedef std::function<void(bool success)> SendCallback;
+
+    struct ReceivedMessage {
+        PeerAddress address;
+        std::vector<uint8_t> data;
+    };
+
+    struct Completion {
+        SendCallback callback;
+        bool success;
+    };
+
+    struct Statistics {
+        uint32_t messagesSent = 0;
+        uint32_t messagesFailed = 0;
+        uint32_t messagesReceived = 0;
+        uint32_t dataFramesSent = 0;
+        uint32_t retransmittedFrames = 0;
+        uint32_t acksSent = 0;
+        uint32_t duplicateFrames = 0;
+        uint32_t invalidFrames = 0;
+    };
+
+private:
+
+    enum class FrameType : uint8_t {
+        Data = 1,
+        /** Data that isn't acknowledged */
+        Broadcast = 2,
+        Ack = 3
+    };
+
+    struct OutgoingMessage {
+        PeerAddress address;
+        uint16_t id;
+        bool broadcast;
+        std::vector<uint8_t> data;
+        uint8_t fragmentCount;
+        /** The fragments that were sent in the current round */
+        uint32_t sentMask = 0;
+        /** The fragments that were ever sent */
+        uint32_t attemptedMask = 0;
+        uint32_t ackedMask = 0;
+        uint8_t retransmits = 0;
+        uint64_t retransmitTime = 0;
+        SendCallback callback;
+    };
+
+    struct IncomingMessage {
+        std::vector<uint8_t> data;
+        uint8_t fragmentCount;
+        uint32_t receivedMask = 0;
+        size_t lastFragmentSize = 0;
+        bool ackPending = false;
+        uint64_t ackTime = 0;
+        uint64_t expireTime;
+    };
+
+    /** Identifies a received message: a sender numbers its broadcasts and its messages to us separately */
+    struct MessageKey {
+        uint16_t id;
+        bool broadcast;
+
+        auto operator<=>(const MessageKey&) const = default;
+    };
+
+    struct Peer {
+        uint16_t nextMessageId = 0;
+        std::map<MessageKey, IncomingMessage> incoming;
+        /** The keys and times of recently completed messages, to acknowledge retransmissions without delivering them again */
+        std::deque<std::pair<MessageKey, uint64_t>> completedIds;
+    };
+
+    TransportLink& link;
+    Configuration configuration;
+    std::deque<OutgoingMessage> outgoing;
+    std::map<PeerAddress, Peer> peers;
+    std::vector<ReceivedMessage> receivedMessages;
+    std::vector<Completion> completions;
+    uint64_t nextFrameTime = 0;
+    std::vector<uint8_t> frameBuffer;
+    Statistics statistics;
+
+    size_t getFragmentPayloadSize() const { return configuration.maxFrameSize - DATA_HEADER_SIZE; }
+
+    static uint32_t getFullMask(uint8_t fragmentCount) { return (fragmentCount == 32) ? 0xFFFFFFFFU : ((1U << fragmentCount) - 1U); }
+
+    SendResult sendFragment(OutgoingMessage& message, uint8_t index);
+
+    SendResult sendAck(const PeerAddress& address, uint16_t id, uint8_t fragmentCount, uint32_t mask);
+
+    void onData(const PeerAddress& address, const uint8_t* data, size_t dataSize, bool broadcast, uint64_t time);
+
+    void onAck(const PeerAddress& address, const uint8_t* data, size_t dataSize);
+
+    std::deque<OutgoingMessage>::iterator finish(std::deque<OutgoingMessage>::iterator message, bool success);
+
+public:
+
+    Transport(TransportLink& link, const Configuration& configuration) : link(link), configuration(configuration) {}
+
+    /** @return the largest message that fits in MAX_FRAGMENTS */
+    size_t getMaxMessageSize() const { return MAX_FRAGMENTS * getFragmentPayloadSize(); }
+
+    /** @return true when the frame belongs to the transport */
+    static bool isTransportFrame(const uint8_t* data, size_t dataSize) { return dataSize > 0 && data[0] == FRAME_MAGIC; }
+
+    /**
+     * Queue a message. It's sent by poll().
+     * @param[in] callback called with the result through takeEvents()
+     * @return false when the message is too large or the queue is full
+     */
+    bool send(const PeerAddress& address, const uint8_t* data, size_t dataSize, SendCallback callback = nullptr);
+
+    /** Handle a frame that was received from the link */
+    void onFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize, uint64_t time);
+
+    /**
+     * Send the data frames that the pacing allows, retransmit missing fragments, send due acknowledgements and expire old state.
+     * @return the time at which poll() should be called again, or UINT64_MAX when there's nothing to do
+     */
+    uint64_t poll(uint64_t time);
+
+    /** Move out the received messages and finished sends */
+    void takeEvents(std::vector<ReceivedMessage>& outMessages, std::vector<Completion>& outCompletions);
+
+    size_t getPendingCount() const { return outgoing.size(); }
+
+    const Statistics& getStatistics() const { return statistics; }
+};
+
+} // namespace tt::service::espnow
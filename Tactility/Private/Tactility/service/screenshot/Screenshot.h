@@ -14,7 +14,8 @@ namespace tt::service::screenshot {
 enum class Mode {
     None,
     Timed,
-    Apps
+    Apps,
+    Sequence
 };
 
 class ScreenshotService final : public Service {
@@ -34,15 +35,24 @@ public:
 
     /** @brief Start taking screenshot whenever an app is started
      * @param[in] path the path to store the screenshots at
+     * @param[in] format the file format of the screenshots
      */
-    void startApps(const std::string& path);
+    void startApps(const std::string& path, Format format = Format::Png);
 
     /** @brief Start taking screenshots after a certain delay
      * @param[in] path the path to store the screenshots at
      * @param[in] delayInSeconds the delay before starting (and between successive screenshots)
      * @param[in] amount 0 = indefinite, >0 for a specific
+     * @param[in] format the file format of the screenshots
      */
-    void startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount);
+    void startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount, Format format = Format::Png);
+
+    /** @brief Record the changes on the screen into a sequence file
+     * @param[in] path the path to store the sequence file at
+     * @param[in] intervalMillis the target time between frames
+     * @param[in] frameAmount 0 = until stopped, >0 for a specific amount of frames
+     */
+    void startSequence(const std::string& path, uint32_t intervalMillis, uint32_t frameAmount);
 
     /** @brief Stop taking screenshots */
     void stop();
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Tactility/TactilityConfig.h"
+
+#if TT_FEATURE_SCREENSHOT_ENABLED
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace tt::service::screenshot {
+
+enum class Format {
+    /** Slow to encode, but can be opened anywhere */
+    Png,
+    /** "Quite OK Image" format: lossless like PNG, but encodes many times faster */
+    Qoi,
+    /** Header (see RAW_MAGIC) followed by the RGB565 pixels: no encoding at all */
+    Raw
+};
+
+/**
+ * Raw files start with a 12 byte header, followed by the pixels row by row (no padding).
+ * Header: magic (4 bytes), width (uint16), height (uint16), reserved (4 bytes, zero).
+ * All values and pixels are little endian.
+ */
+constexpr char RAW_MAGIC[4] = { 'T', 'R', '6', '5' };
+
+/**
+ * Sequence files start with a 12 byte header: magic (4 bytes), width (uint16), height (uint16), interval in milliseconds (uint32).
+ * The header is followed by frames. A frame has a 12 byte header: time since the start in milliseconds (uint32), x, y, width, height (all uint16).
+ * It is followed by the RGB565 pixels of the changed area, row by row. The first frame contains the full screen.
+ * Frames without changes are not stored.
+ * All values and pixels are little endian.
+ */
+constexpr char SEQUENCE_MAGIC[4] = { 'T', 'S', '6', '5' };
+
+/** A snapshot of the screen in RGB565. The memory is allocated in PSRAM when it's available. */
+class Frame final {
+
+    struct Deleter {
+        void operator()(uint8_t* data) const { free(data); }
+    };
+
+    std::unique_ptr<uint8_t, Deleter> data;
+    size_t capacity = 0;
+
+public:
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    /** The size of a row in bytes */
+    uint32_t stride = 0;
+
+    /** Ensure that the buffer can hold the specified amount of bytes. Existing data is not preserved when the buffer grows. */
+    bool reserve(size_t size);
+
+    uint8_t* getData() const { return data.get(); }
+
+    size_t getCapacity() const { return capacity; }
+
+    const uint16_t* getRow(uint32_t y) const { return reinterpret_cast<const uint16_t*>(data.get() + (y * stride)); }
+};
+
+struct Area {
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    bool isEmpty() const { return width == 0 || height == 0; }
+};
+
+const char* getFileExtension(Format format);
+
+/** Encode a frame into a complete image file. The output is cleared first. */
+bool encode(const Frame& frame, Format format, std::vector<uint8_t>& output);
+
+bool encodePng(const Frame& frame, std::vector<uint8_t>& output);
+
+bool encodeQoi(const Frame& frame, std::vector<uint8_t>& output);
+
+bool encodeRaw(const Frame& frame, std::vector<uint8_t>& output);
+
+/** @return the smallest area that contains all changed pixels, or an empty area when the frames are equal */
+Area findChangedArea(const Frame& previous, const Frame& current);
+
+/** Append a sequence header to the output */
+void encodeSequenceHeader(uint32_t width, uint32_t height, uint32_t intervalMillis, std::vector<uint8_t>& output);
+
+/** Append a sequence frame with the pixels of the specified area to the output */
+void encodeSequenceFrame(const Frame& frame, const Area& area, uint32_t timeMillis, std::vector<uint8_t>& output);
+
+} // namespace
+
+#endif
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "ScreenshotEncoder.h"
+
 #include <Tactility/Thread.h>
 #include <Tactility/Mutex.h>
 
@@ -11,6 +13,7 @@ namespace tt::service::screenshot {
 
 #define TASK_WORK_TYPE_DELAY 1
 #define TASK_WORK_TYPE_APPS 2
+#define TASK_WORK_TYPE_SEQUENCE 3
 
 class ScreenshotTask {
 
@@ -18,14 +21,23 @@ class ScreenshotTask {
         int type = TASK_WORK_TYPE_DELAY ;
         uint8_t delay_in_seconds = 0;
         uint8_t amount = 0;
+        uint32_t interval_millis = 0;
+        uint32_t frame_amount = 0;
+        Format format = Format::Png;
         std::string path;
     };
 
+    /** The maximum amount of files that are waiting to be written: the screenshot is skipped when there are more */
+    static constexpr size_t MAX_PENDING_WRITES = 4;
+
     Thread* thread = nullptr;
     Mutex mutex = Mutex(Mutex::Type::Recursive);
     bool interrupted = false;
     bool finished = false;
     ScreenshotTaskWork work;
+    Frame frame;
+    /** The last frame that was written in sequence mode */
+    Frame previousFrame;
 
 public:
     ScreenshotTask() = default;
@@ -35,13 +47,22 @@ public:
      * @param[in] path the path to store the screenshots at
      * @param[in] delayInSeconds the delay before starting (and between successive screenshots)
      * @param[in] amount 0 = indefinite, >0 for a specific
+     * @param[in] format the file format of the screenshots
      */
-    void startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount);
+    void startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount, Format format = Format::Png);
 
     /** @brief Start taking screenshot whenever an app is started
      * @param[in] path the path to store the screenshots at
+     * @param[in] format the file format of the screenshots
+     */
+    void startApps(const std::string& path, Format format = Format::Png);
+
+    /** @brief Record the screen into a single sequence file (see SEQUENCE_MAGIC) that only stores the changes of each frame
+     * @param[in] path the path to store the sequence file at
+     * @param[in] intervalMillis the target time between frames
+     * @param[in] frameAmount 0 = until stopped, >0 for a specific amount of frames
      */
-    void startApps(const std::string& path);
+    void startSequence(const std::string& path, uint32_t intervalMillis, uint32_t frameAmount);
 
     /** @brief Stop taking screenshots */
     void stop();
@@ -55,6 +76,10 @@ private:
     bool isInterrupted();
     void setFinished();
     void taskStart();
+    /** @return false when the interval was interrupted */
+    bool sleep(uint32_t millis);
+    void makeScreenshot(const std::string& filename);
+    void recordSequence();
 };
 
 }
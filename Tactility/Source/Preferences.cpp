@@ -1,156 +1,267 @@
-#include <Tactility/Preferences.h>
-#ifdef ESP_PLATFORM
-#include <nvs_flash.h>
-#include <nvs.h>
-#include <cstring>
-#include <esp_log.h>
+#include "Tactility/Preferences.h"
+#include "Tactility/PreferencesBackend.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+
+#include <atomic>
+#include <map>
+#include <set>
 
 namespace tt {
 
-// Helper for error logging
-static const char* TAG = "Preferences";
+constexpr auto* TAG = "Preferences";
+
+class PreferencesNamespace final {
+
+public:
+
+    const std::string name;
+    Mutex mutex;
+    std::unique_ptr<PreferencesBackend> backend;
+    /** The values that were read or written */
+    std::map<std::string, PreferenceValue> cache;
+    /** The keys of the cached values that weren't written to the backend yet */
+    std::set<std::string> dirtyKeys;
+    uint32_t transactionDepth = 0;
+
+    PreferencesNamespace(std::string name, std::unique_ptr<PreferencesBackend> backend) :
+        name(std::move(name)),
+        backend(std::move(backend))
+    {}
+};
+
+static std::atomic<uint32_t> readCount = 0;
+static std::atomic<uint32_t> cacheHitCount = 0;
+static std::atomic<uint32_t> writeCount = 0;
+static std::atomic<uint32_t> skippedWriteCount = 0;
+static std::atomic<uint32_t> commitCount = 0;
+
+static Mutex& getNamespacesMutex() {
+    static Mutex mutex;
+    return mutex;
+}
+
+static std::map<std::string, std::shared_ptr<PreferencesNamespace>>& getNamespaces() {
+    static std::map<std::string, std::shared_ptr<PreferencesNamespace>> namespaces;
+    return namespaces;
+}
+
+/** @return the shared state of the namespace, or nullptr when its backend can't be opened */
+static std::shared_ptr<PreferencesNamespace> findNamespace(const char* name) {
+    auto lock = getNamespacesMutex().asScopedLock();
+    lock.lock();
+
+    auto& namespaces = getNamespaces();
+    auto iterator = namespaces.find(name);
+    if (iterator != namespaces.end()) {
+        return iterator->second;
+    }
+
+    auto backend = openPreferencesBackend(name);
+    if (backend == nullptr) {
+        TT_LOG_E(TAG, "Failed to open namespace %s", name);
+        return nullptr;
+    }
+
+    auto result = std::make_shared<PreferencesNamespace>(name, std::move(backend));
+    namespaces[name] = result;
+    return result;
+}
+
+void resetPreferencesCache() {
+    auto lock = getNamespacesMutex().asScopedLock();
+    lock.lock();
+    getNamespaces().clear();
+}
+
+/**
+ * Write the dirty values and commit them. The caller holds the namespace mutex.
+ * Values that weren't persisted stay dirty, so they are written again with the next commit.
+ * @return true when all values were persisted
+ */
+static bool commit(PreferencesNamespace& storage) {
+    if (storage.dirtyKeys.empty()) {
+        return true;
+    }
+
+    std::set<std::string> failed_keys;
+    for (const auto& key : storage.dirtyKeys) {
+        if (!storage.backend->set(key, storage.cache[key])) {
+            TT_LOG_E(TAG, "Failed to set %s:%s", storage.name.c_str(), key.c_str());
+            failed_keys.insert(key);
+        }
+        writeCount++;
+    }
+
+    commitCount++;
+    if (!storage.backend->commit()) {
+        TT_LOG_E(TAG, "Failed to commit %s", storage.name.c_str());
+        return false;
+    }
+
+    storage.dirtyKeys = std::move(failed_keys);
+    return storage.dirtyKeys.empty();
+}
+
+/** Read a value from the cache or the backend. The caller holds the namespace mutex. */
+template<typename T>
+static bool read(PreferencesNamespace& storage, const std::string& key, T& out, bool& cacheHit) {
+    auto iterator = storage.cache.find(key);
+    if (iterator != storage.cache.end() && std::holds_alternative<T>(iterator->second)) {
+        cacheHit = true;
+        out = std::get<T>(iterator->second);
+        return true;
+    }
+
+    cacheHit = false;
+    PreferenceValue value = T();
+    if (!storage.backend->get(key, value)) {
+        return false;
+    }
+
+    out = std::get<T>(value);
+    storage.cache[key] = std::move(value);
+    return true;
+}
+
+template<typename T>
+static bool get(const char* namespace_, const std::string& key, T& out) {
+    auto storage = findNamespace(namespace_);
+    if (storage == nullptr) {
+        return false;
+    }
+
+    auto lock = storage->mutex.asScopedLock();
+    lock.lock();
 
-// Open NVS handle
-static nvs_handle_t open_nvs(const char* ns) {
-    nvs_handle_t handle = 0;
-    esp_err_t err = nvs_open(ns, NVS_READWRITE, &handle);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to open NVS namespace '%s': %s", ns, esp_err_to_name(err));
-        return 0;
+    bool cache_hit;
+    bool result = read(*storage, key, out, cache_hit);
+    readCount++;
+    if (cache_hit) {
+        cacheHitCount++;
+    }
+    return result;
+}
+
+template<typename T>
+static bool put(const char* namespace_, const std::string& key, const T& value) {
+    auto storage = findNamespace(namespace_);
+    if (storage == nullptr) {
+        return false;
+    }
+
+    auto lock = storage->mutex.asScopedLock();
+    lock.lock();
+
+    // Reading is much cheaper than writing, and it doesn't wear the flash.
+    // A dirty value wasn't persisted yet, so writing it again is a retry.
+    T current_value;
+    bool cache_hit;
+    if (!storage->dirtyKeys.contains(key) && read(*storage, key, current_value, cache_hit) && current_value == value) {
+        skippedWriteCount++;
+        return true;
+    }
+
+    storage->cache[key] = value;
+    storage->dirtyKeys.insert(key);
+    if (storage->transactionDepth == 0) {
+        return commit(*storage);
+    }
+    return true;
+}
+
+Preferences::Transaction::Transaction(std::shared_ptr<PreferencesNamespace> storage) : storage(std::move(storage)) {
+    if (this->storage != nullptr) {
+        auto lock = this->storage->mutex.asScopedLock();
+        lock.lock();
+        this->storage->transactionDepth++;
+    }
+}
+
+Preferences::Transaction::~Transaction() {
+    if (storage != nullptr) {
+        auto lock = storage->mutex.asScopedLock();
+        lock.lock();
+        storage->transactionDepth--;
+        if (storage->transactionDepth == 0) {
+            commit(*storage);
+        }
     }
-    return handle;
 }
 
 bool Preferences::hasBool(const std::string& key) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    uint8_t value;
-    esp_err_t err = nvs_get_u8(handle, key.c_str(), &value);
-    nvs_close(handle);
-    return err == ESP_OK;
+    bool temp;
+    return optBool(key, temp);
 }
 
 bool Preferences::hasInt32(const std::string& key) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    int32_t value;
-    esp_err_t err = nvs_get_i32(handle, key.c_str(), &value);
-    nvs_close(handle);
-    return err == ESP_OK;
+    int32_t temp;
+    return optInt32(key, temp);
 }
 
 bool Preferences::hasInt64(const std::string& key) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    int64_t value;
-    esp_err_t err = nvs_get_i64(handle, key.c_str(), &value);
-    nvs_close(handle);
-    return err == ESP_OK;
+    int64_t temp;
+    return optInt64(key, temp);
 }
 
 bool Preferences::hasString(const std::string& key) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    size_t len = 0;
-    esp_err_t err = nvs_get_str(handle, key.c_str(), nullptr, &len);
-    nvs_close(handle);
-    return err == ESP_OK && len > 1;
+    std::string temp;
+    return optString(key, temp);
 }
 
 bool Preferences::optBool(const std::string& key, bool& out) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    uint8_t value;
-    esp_err_t err = nvs_get_u8(handle, key.c_str(), &value);
-    nvs_close(handle);
-    if (err == ESP_OK) {
-        out = value != 0;
-        return true;
-    }
-    return false;
+    return get(namespace_, key, out);
 }
 
 bool Preferences::optInt32(const std::string& key, int32_t& out) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    int32_t value;
-    esp_err_t err = nvs_get_i32(handle, key.c_str(), &value);
-    nvs_close(handle);
-    if (err == ESP_OK) {
-        out = value;
-        return true;
-    }
-    return false;
+    return get(namespace_, key, out);
 }
 
 bool Preferences::optInt64(const std::string& key, int64_t& out) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    int64_t value;
-    esp_err_t err = nvs_get_i64(handle, key.c_str(), &value);
-    nvs_close(handle);
-    if (err == ESP_OK) {
-        out = value;
-        ESP_LOGD(TAG, "optInt64 key=%s value=%lld", key.c_str(), (long long)value);
-        return true;
-    }
-    return false;
+    return get(namespace_, key, out);
 }
 
 bool Preferences::optString(const std::string& key, std::string& out) const {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return false;
-    size_t len = 0;
-    esp_err_t err = nvs_get_str(handle, key.c_str(), nullptr, &len);
-    if (err != ESP_OK || len < 1) {
-        nvs_close(handle);
-        return false;
-    }
-    char* buf = new char[len];
-    err = nvs_get_str(handle, key.c_str(), buf, &len);
-    if (err == ESP_OK) {
-        out.assign(buf);
-        delete[] buf;
-        nvs_close(handle);
-        return true;
-    }
-    delete[] buf;
-    nvs_close(handle);
-    return false;
+    return get(namespace_, key, out);
+}
+
+bool Preferences::putBool(const std::string& key, bool value) {
+    return put(namespace_, key, value);
+}
+
+bool Preferences::putInt32(const std::string& key, int32_t value) {
+    return put(namespace_, key, value);
+}
+
+bool Preferences::putInt64(const std::string& key, int64_t value) {
+    return put(namespace_, key, value);
 }
 
-void Preferences::putBool(const std::string& key, bool value) {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return;
-    nvs_set_u8(handle, key.c_str(), value ? 1 : 0);
-    nvs_commit(handle);
-    nvs_close(handle);
+bool Preferences::putString(const std::string& key, const std::string& value) {
+    return put(namespace_, key, value);
 }
 
-void Preferences::putInt32(const std::string& key, int32_t value) {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return;
-    nvs_set_i32(handle, key.c_str(), value);
-    nvs_commit(handle);
-    nvs_close(handle);
+Preferences::Transaction Preferences::transaction() {
+    return Transaction(findNamespace(namespace_));
 }
 
-void Preferences::putInt64(const std::string& key, int64_t value) {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return;
-    nvs_set_i64(handle, key.c_str(), value);
-    nvs_commit(handle);
-    nvs_close(handle);
-    ESP_LOGD(TAG, "putInt64 key=%s value=%lld", key.c_str(), (long long)value);
+Preferences::Statistics Preferences::getStatistics() {
+    return {
+        .reads = readCount.load(),
+        .cacheHits = cacheHitCount.load(),
+        .writes = writeCount.load(),
+        .skippedWrites = skippedWriteCount.load(),
+        .commits = commitCount.load()
+    };
 }
 
-void Preferences::putString(const std::string& key, const std::string& value) {
-    nvs_handle_t handle = open_nvs(namespace_);
-    if (!handle) return;
-    nvs_set_str(handle, key.c_str(), value.c_str());
-    nvs_commit(handle);
-    nvs_close(handle);
+void Preferences::resetStatistics() {
+    readCount = 0;
+    cacheHitCount = 0;
+    writeCount = 0;
+    skippedWriteCount = 0;
+    commitCount = 0;
 }
 
-} // namespace tt
-#endif
+} // namespace
@@ -1,7 +1,8 @@
 #ifdef ESP_PLATFORM
 
-#include <Tactility/Preferences.h>
-#include <Tactility/TactilityCore.h>
+#include "Tactility/PreferencesBackend.h"
+
+#include <Tactility/Log.h>
 
 #include <nvs_flash.h>
 
@@ -9,138 +10,80 @@ namespace tt {
 
 constexpr auto* TAG = "Preferences";
 
-bool Preferences::optBool(const std::string& key, bool& out) const {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) != ESP_OK) {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
-        return false;
-    } else {
-        uint8_t out_number;
-        bool success = nvs_get_u8(handle, key.c_str(), &out_number) == ESP_OK;
-        nvs_close(handle);
-        if (success) {
-            out = (bool)out_number;
-        }
-        return success;
-    }
-}
+/** Keeps the NVS handle open for the lifetime of the namespace, instead of opening it for every access */
+class NvsPreferencesBackend final : public PreferencesBackend {
 
-bool Preferences::optInt32(const std::string& key, int32_t& out) const {
     nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) != ESP_OK) {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
-        return false;
-    } else {
-        bool success = nvs_get_i32(handle, key.c_str(), &out) == ESP_OK;
-        nvs_close(handle);
-        return success;
-    }
-}
 
-bool Preferences::optInt64(const std::string& key, int64_t& out) const {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) != ESP_OK) {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
-        return false;
-    } else {
-        bool success = nvs_get_i64(handle, key.c_str(), &out) == ESP_OK;
-        nvs_close(handle);
-        return success;
-    }
-}
+public:
 
-bool Preferences::optString(const std::string& key, std::string& out) const {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) != ESP_OK) {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
-        return false;
-    } else {
-        size_t out_size = 256;
-        char* out_data = static_cast<char*>(malloc(out_size));
-        bool success = nvs_get_str(handle, key.c_str(), out_data, &out_size) == ESP_OK;
+    explicit NvsPreferencesBackend(nvs_handle_t handle) : handle(handle) {}
+
+    ~NvsPreferencesBackend() override {
         nvs_close(handle);
-        out = out_data;
-        free(out_data);
-        return success;
     }
-}
-
-bool Preferences::hasBool(const std::string& key) const {
-    bool temp;
-    return optBool(key, temp);
-}
-
-bool Preferences::hasInt32(const std::string& key) const {
-    int32_t temp;
-    return optInt32(key, temp);
-}
-
-bool Preferences::hasInt64(const std::string& key) const {
-    int64_t temp;
-    return optInt64(key, temp);
-}
-
-bool Preferences::hasString(const std::string& key) const {
-    std::string temp;
-    return optString(key, temp);
-}
 
-void Preferences::putBool(const std::string& key, bool value) {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) == ESP_OK) {
-        if (nvs_set_u8(handle, key.c_str(), value) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to set %s:%s", namespace_, key.c_str());
-        } else if (nvs_commit(handle) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to commit %s:%s", namespace_, key.c_str());
+    bool get(const std::string& key, PreferenceValue& value) override {
+        if (std::holds_alternative<bool>(value)) {
+            uint8_t number;
+            if (nvs_get_u8(handle, key.c_str(), &number) != ESP_OK) {
+                return false;
+            }
+            value = number != 0;
+            return true;
+        } else if (std::holds_alternative<int32_t>(value)) {
+            return nvs_get_i32(handle, key.c_str(), &std::get<int32_t>(value)) == ESP_OK;
+        } else if (std::holds_alternative<int64_t>(value)) {
+            return nvs_get_i64(handle, key.c_str(), &std::get<int64_t>(value)) == ESP_OK;
+        } else {
+            size_t size = 0;
+            if (nvs_get_str(handle, key.c_str(), nullptr, &size) != ESP_OK || size == 0) {
+                return false;
+            }
+            // The size includes the null terminator
+            std::string text(size - 1, '\0');
+            if (nvs_get_str(handle, key.c_str(), text.data(), &size) != ESP_OK) {
+                return false;
+            }
+            value = std::move(text);
+            return true;
         }
-        nvs_close(handle);
-    } else {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
     }
-}
 
-void Preferences::putInt32(const std::string& key, int32_t value) {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) == ESP_OK) {
-        if (nvs_set_i32(handle, key.c_str(), value) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to set %s:%s", namespace_, key.c_str());
-        } else if (nvs_commit(handle) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to commit %s:%s", namespace_, key.c_str());
+    bool set(const std::string& key, const PreferenceValue& value) override {
+        esp_err_t result;
+        if (std::holds_alternative<bool>(value)) {
+            result = nvs_set_u8(handle, key.c_str(), std::get<bool>(value) ? 1 : 0);
+        } else if (std::holds_alternative<int32_t>(value)) {
+            result = nvs_set_i32(handle, key.c_str(), std::get<int32_t>(value));
+        } else if (std::holds_alternative<int64_t>(value)) {
+            result = nvs_set_i64(handle, key.c_str(), std::get<int64_t>(value));
+        } else {
+            result = nvs_set_str(handle, key.c_str(), std::get<std::string>(value).c_str());
         }
-        nvs_close(handle);
-    } else {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
-    }
-}
 
-void Preferences::putInt64(const std::string& key, int64_t value) {
-    nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) == ESP_OK) {
-        if (nvs_set_i64(handle, key.c_str(), value) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to set %s:%s", namespace_, key.c_str());
-        } else if (nvs_commit(handle) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to commit %s:%s", namespace_, key.c_str());
+        if (result != ESP_OK) {
+            TT_LOG_E(TAG, "Failed to set %s: %s", key.c_str(), esp_err_to_name(result));
+            return false;
         }
-        nvs_close(handle);
-    } else {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
+        return true;
     }
-}
 
-void Preferences::putString(const std::string& key, const std::string& text) {
+    bool commit() override {
+        return nvs_commit(handle) == ESP_OK;
+    }
+};
+
+std::unique_ptr<PreferencesBackend> openPreferencesBackend(const std::string& namespace_) {
     nvs_handle_t handle;
-    if (nvs_open(namespace_, NVS_READWRITE, &handle) == ESP_OK) {
-        if (nvs_set_str(handle, key.c_str(), text.c_str()) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to set %s:%s", namespace_, key.c_str());
-        } else if (nvs_commit(handle) != ESP_OK) {
-            TT_LOG_E(TAG, "Failed to commit %s:%s", namespace_, key.c_str());
-        }
-        nvs_close(handle);
-    } else {
-        TT_LOG_E(TAG, "Failed to open namespace %s", namespace_);
+    esp_err_t result = nvs_open(namespace_.c_str(), NVS_READWRITE, &handle);
+    if (result != ESP_OK) {
+        TT_LOG_E(TAG, "Failed to open NVS namespace %s: %s", namespace_.c_str(), esp_err_to_name(result));
+        return nullptr;
     }
+    return std::make_unique<NvsPreferencesBackend>(handle);
 }
 
 } // namespace
 
-#endif
\ No newline at end of file
+#endif
@@ -1,85 +1,167 @@
-#ifndef ESP_PLATFOM
+#ifndef ESP_PLATFORM
 
-#include "Tactility/Preferences.h"
+#include "Tactility/PreferencesBackend.h"
 
-#include <Tactility/Bundle.h>
+#include <Tactility/Log.h>
+#include <Tactility/MountPoints.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/file/File.h>
 
-namespace tt {
-
-static Bundle preferences;
-
-/**
- * Creates a string that is effectively "namespace:key" so we can create a single map (bundle)
- * to store all the key/value pairs.
- *
- * @param[in] namespace
- * @param[in] key
- * @param[out] out
- */
-std::string get_bundle_key(const std::string& namespace_, const std::string& key) {
-    return namespace_ + ':' + key;
-}
-
-bool Preferences::hasBool(const std::string& key) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.hasBool(bundle_key);
-}
-
-bool Preferences::hasInt32(const std::string& key) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.hasInt32(bundle_key);
-}
-
-bool Preferences::hasInt64(const std::string& key) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.hasInt64(bundle_key);
-}
+#include <cstdlib>
+#include <format>
+#include <map>
 
-bool Preferences::hasString(const std::string& key) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.hasString(bundle_key);
-}
+namespace tt {
 
-bool Preferences::optBool(const std::string& key, bool& out) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.optBool(bundle_key, out);
-}
+constexpr auto* TAG = "Preferences";
 
-bool Preferences::optInt32(const std::string& key, int32_t& out) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.optInt32(bundle_key, out);
-}
+static Mutex directoryMutex;
+static std::string directory = std::format("{}/preferences", file::MOUNT_POINT_DATA);
 
-bool Preferences::optInt64(const std::string& key, int64_t& out) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.optInt64(bundle_key, out);
+static std::string getDirectory() {
+    auto lock = directoryMutex.asScopedLock();
+    lock.lock();
+    return directory;
 }
 
-bool Preferences::optString(const std::string& key, std::string& out) const {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.optString(bundle_key, out);
+/** Escape the characters that can't be stored on a single line */
+static std::string escape(const std::string& input) {
+    std::string output;
+    output.reserve(input.size());
+    for (char character : input) {
+        if (character == '\\') {
+            output += "\\\\";
+        } else if (character == '\n') {
+            output += "\\n";
+        } else {
+            output += character;
+        }
+    }
+    return output;
 }
 
-void Preferences::putBool(const std::string& key, bool value) {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.putBool(bundle_key, value);
+static std::string unescape(const std::string& input) {
+    std::string output;
+    output.reserve(input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+        if (input[i] == '\\' && (i + 1) < input.size()) {
+            i++;
+            output += (input[i] == 'n') ? '\n' : input[i];
+        } else {
+            output += input[i];
+        }
+    }
+    return output;
 }
 
-void Preferences::putInt32(const std::string& key, int32_t value) {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.putInt32(bundle_key, value);
+/**
+ * Stores a namespace in a file, so the settings of the simulator persist.
+ * Each line contains a key, the type and the value: "key=type:value".
+ * The type is "b" (bool), "i" (int32), "l" (int64) or "s" (string).
+ */
+class FilePreferencesBackend final : public PreferencesBackend {
+
+    std::string filePath;
+    std::map<std::string, PreferenceValue> values;
+
+    void load() {
+        file::readLines(filePath, true, [this](const char* line) {
+            std::string text = line;
+            auto separator = text.find('=');
+            if (separator == std::string::npos || (separator + 3) > text.size() || text[separator + 2] != ':') {
+                TT_LOG_W(TAG, "Invalid line in %s: %s", filePath.c_str(), line);
+                return;
+            }
+
+            auto key = text.substr(0, separator);
+            auto type = text[separator + 1];
+            auto value = text.substr(separator + 3);
+            switch (type) {
+                case 'b':
+                    values[key] = (value == "1");
+                    break;
+                case 'i':
+                    values[key] = static_cast<int32_t>(strtol(value.c_str(), nullptr, 10));
+                    break;
+                case 'l':
+                    values[key] = static_cast<int64_t>(strtoll(value.c_str(), nullptr, 10));
+                    break;
+                case 's':
+                    values[key] = unescape(value);
+                    break;
+                default:
+                    TT_LOG_W(TAG, "Unknown type in %s: %s", filePath.c_str(), line);
+                    break;
+            }
+        });
+    }
+
+public:
+
+    explicit FilePreferencesBackend(std::string filePath) : filePath(std::move(filePath)) {
+        load();
+    }
+
+    bool get(const std::string& key, PreferenceValue& value) override {
+        auto iterator = values.find(key);
+        if (iterator == values.end() || iterator->second.index() != value.index()) {
+            return false;
+        }
+        value = iterator->second;
+        return true;
+    }
+
+    bool set(const std::string& key, const PreferenceValue& value) override {
+        values[key] = value;
+        return true;
+    }
+
+    bool commit() override {
+        auto parent_path = filePath.substr(0, filePath.rfind('/'));
+        if (!file::findOrCreateDirectory(parent_path, 0777)) {
+            TT_LOG_E(TAG, "Failed to create %s", parent_path.c_str());
+            return false;
+        }
+
+        auto lock = file::getLock(filePath)->asScopedLock();
+        lock.lock();
+
+        FILE* file = fopen(filePath.c_str(), "w");
+        if (file == nullptr) {
+            TT_LOG_E(TAG, "Failed to open %s", filePath.c_str());
+            return false;
+        }
+
+        for (const auto& [key, value] : values) {
+            if (std::holds_alternative<bool>(value)) {
+                fprintf(file, "%s=b:%d\n", key.c_str(), std::get<bool>(value) ? 1 : 0);
+            } else if (std::holds_alternative<int32_t>(value)) {
+                fprintf(file, "%s=i:%d\n", key.c_str(), static_cast<int>(std::get<int32_t>(value)));
+            } else if (std::holds_alternative<int64_t>(value)) {
+                fprintf(file, "%s=l:%lld\n", key.c_str(), static_cast<long long>(std::get<int64_t>(value)));
+            } else {
+                fprintf(file, "%s=s:%s\n", key.c_str(), escape(std::get<std::string>(value)).c_str());
+            }
+        }
+
+        fclose(file);
+        return true;
+    }
+};
+
+std::unique_ptr<PreferencesBackend> openPreferencesBackend(const std::string& namespace_) {
+    return std::make_unique<FilePreferencesBackend>(std::format("{}/{}.properties", getDirectory(), namespace_));
 }
 
-void Preferences::putInt64(const std::string& key, int64_t value) {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.putInt64(bundle_key, value);
+void setPreferencesDirectory(const std::string& path) {
+    {
+        auto lock = directoryMutex.asScopedLock();
+        lock.lock();
+        directory = path;
+    }
+    resetPreferencesCache();
 }
 
-void Preferences::putString(const std::string& key, const std::string& value) {
-    std::string bundle_key = get_bundle_key(namespace_, key);
-    return preferences.putString(bundle_key, value);
-}
+} // namespace
 
 #endif
-
-} // namespace
@@ -7,14 +7,17 @@
 #include <Tactility/file/File.h>
 #include <Tactility/file/FileLock.h>
 #include <Tactility/file/PropertiesFile.h>
+#include <Tactility/file/SystemAssetPack.h>
 #include <Tactility/hal/HalPrivate.h>
 #include <Tactility/lvgl/LvglPrivate.h>
 #include <Tactility/MountPoints.h>
 #include <Tactility/network/NtpPrivate.h>
 #include <Tactility/service/ServiceManifest.h>
 #include <Tactility/service/ServiceRegistration.h>
+#include <Tactility/service/ServiceStartup.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/settings/TimePrivate.h>
+#include <Tactility/Thread.h>
 
 #include <map>
 #include <format>
@@ -30,9 +33,15 @@ constexpr auto* TAG = "Tactility";
 static const Configuration* config_instance = nullptr;
 static Dispatcher mainDispatcher;
 
+/** The maximum amount of system services that start at the same time */
+constexpr size_t SERVICE_START_WORKER_COUNT = 3;
+static std::vector<std::shared_ptr<const service::ServiceManifest>> systemServices;
+static std::unique_ptr<Thread> backgroundStartThread;
+
 // region Default services
 namespace service {
     // Primary
+    namespace fileio { extern const ServiceManifest manifest; }
     namespace gps { extern const ServiceManifest manifest; }
     namespace wifi { extern const ServiceManifest manifest; }
     namespace sdcard { extern const ServiceManifest manifest; }
@@ -42,6 +51,7 @@ namespace service {
 #endif
     // Secondary (UI)
     namespace gui { extern const ServiceManifest manifest; }
+    namespace imagecache { extern const ServiceManifest manifest; }
     namespace loader { extern const ServiceManifest manifest; }
     namespace memorychecker { extern const ServiceManifest manifest; }
     namespace statusbar { extern const ServiceManifest manifest; }
@@ -190,6 +200,10 @@ static void registerInstalledApps(const std::string& path) {
     TT_LOG_I(TAG, "Registering apps from %s", path.c_str());
 
     file::listDirectory(path, [&path](const auto& entry) {
+        // Skip the directories of app installations that are in progress
+        if (entry.d_name[0] == '.') {
+            return;
+        }
         auto absolute_path = std::format("{}/{}", path, entry.d_name);
         if (file::isDirectory(absolute_path)) {
             registerInstalledApp(absolute_path);
@@ -215,30 +229,64 @@ static void registerInstalledAppsFromSdCards() {
     }
 }
 
-static void registerAndStartSecondaryServices() {
-    TT_LOG_I(TAG, "Registering and starting system services");
-    addService(service::loader::manifest);
-    addService(service::gui::manifest);
-    addService(service::statusbar::manifest);
-    addService(service::displayidle::manifest);
-    addService(service::keyboardinit::manifest);
-    addService(service::memorychecker::manifest);
-#if TT_FEATURE_SCREENSHOT_ENABLED
-    addService(service::screenshot::manifest);
-#endif
+static void registerSystemService(const service::ServiceManifest& manifest) {
+    auto shared_manifest = std::make_shared<const service::ServiceManifest>(manifest);
+    addService(shared_manifest, false);
+    systemServices.push_back(shared_manifest);
 }
 
-static void registerAndStartPrimaryServices() {
-    TT_LOG_I(TAG, "Registering and starting system services");
-    addService(service::gps::manifest);
+static void registerSystemServices() {
+    TT_LOG_I(TAG, "Registering system services");
+    registerSystemService(service::fileio::manifest);
+    registerSystemService(service::gps::manifest);
     if (hal::hasDevice(hal::Device::Type::SdCard)) {
-        addService(service::sdcard::manifest);
+        registerSystemService(service::sdcard::manifest);
     }
-    addService(service::wifi::manifest);
+    registerSystemService(service::wifi::manifest);
 #ifdef ESP_PLATFORM
-    addService(service::development::manifest);
-    addService(service::espnow::manifest);
+    registerSystemService(service::development::manifest);
+    registerSystemService(service::espnow::manifest);
 #endif
+    registerSystemService(service::loader::manifest);
+    registerSystemService(service::gui::manifest);
+    registerSystemService(service::imagecache::manifest);
+    registerSystemService(service::statusbar::manifest);
+    registerSystemService(service::displayidle::manifest);
+    registerSystemService(service::keyboardinit::manifest);
+    registerSystemService(service::memorychecker::manifest);
+#if TT_FEATURE_SCREENSHOT_ENABLED
+    registerSystemService(service::screenshot::manifest);
+#endif
+}
+
+static void startSystemServices(service::StartPhase phase) {
+    std::vector<std::shared_ptr<const service::ServiceManifest>> manifests;
+    for (const auto& manifest : systemServices) {
+        if (manifest->startPhase == phase) {
+            manifests.push_back(manifest);
+        }
+    }
+
+    std::vector<service::ServiceStartRecord> records;
+    if (!service::startServices(manifests, SERVICE_START_WORKER_COUNT, records)) {
+        TT_LOG_E(TAG, "Not all system services started");
+    }
+    service::addToBootTimeline(records);
+}
+
+/** Start the services that aren't needed for the first frame, while the boot app runs */
+static void startBackgroundServices() {
+    backgroundStartThread = std::make_unique<Thread>(
+        "service_boot",
+        4096,
+        [] {
+            startSystemServices(service::StartPhase::Background);
+            service::logBootTimeline(service::getBootTimeline());
+            return 0;
+        }
+    );
+    backgroundStartThread->setPriority(Thread::Priority::Low);
+    backgroundStartThread->start();
 }
 
 void createTempDirectory(const std::string& rootPath) {
@@ -297,15 +345,17 @@ void run(const Configuration& config) {
     TT_LOG_I(TAG, "Heap after initEsp: %s", heap_caps_check_integrity_all(true) ? "OK" : "CORRUPTED");
 #endif
     file::setFindLockFunction(file::findLock);
+    file::loadSystemAssetPack();
     settings::initTimeZone();
     TT_LOG_I(TAG, "Heap after initTimeZone: %s", heap_caps_check_integrity_all(true) ? "OK" : "CORRUPTED");
     hal::init(*config.hardware);
     TT_LOG_I(TAG, "Heap after hal::init: %s", heap_caps_check_integrity_all(true) ? "OK" : "CORRUPTED");
     network::ntp::init();
 
-    registerAndStartPrimaryServices();
+    registerSystemServices();
+    startSystemServices(service::StartPhase::System);
     lvgl::init(hardware);
-    registerAndStartSecondaryServices();
+    startSystemServices(service::StartPhase::Gui);
 
     TT_LOG_I(TAG, "Core systems ready");
 
@@ -314,6 +364,8 @@ void run(const Configuration& config) {
     addAppManifest(app::boot::manifest);
     app::start(app::boot::manifest.appId);
 
+    startBackgroundServices();
+
     TT_LOG_I(TAG, "Main dispatcher ready");
     while (true) {
         mainDispatcher.consume();
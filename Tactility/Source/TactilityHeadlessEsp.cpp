@@ -30,6 +30,8 @@ static void initNetwork() {
 }
 
 void initEsp() {
+    // Format the log output on a low priority task from now on
+    startLogThread();
     initNvs();
     initPartitionsEsp();
     initNetwork();
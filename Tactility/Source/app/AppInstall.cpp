@@ -1,4 +1,5 @@
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstall.h>
 #include <Tactility/app/AppManifestParsing.h>
 #include <Tactility/app/AppManifest.h>
 #include <Tactility/app/AppRegistration.h>
@@ -8,6 +9,7 @@
 #include <Tactility/hal/Device.h>
 #include <Tactility/hal/sdcard/SdCardDevice.h>
 #include <Tactility/Paths.h>
+#include <Tactility/StringUtils.h>
 
 #include <cerrno>
 #include <cstdio>
@@ -19,139 +21,105 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <minitar.h>
-
 constexpr auto* TAG = "App";
 
 namespace tt::app {
 
-static bool untarFile(minitar mp, const minitar_entry* entry, const std::string& destinationPath) {
-    const auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(destinationPath, 0777)) {
-        TT_LOG_E(TAG, "Can't find or create directory %s", destinationPath.c_str());
-        return false;
-    }
+constexpr auto* STAGING_DIRECTORY = ".staging";
+constexpr auto* PREVIOUS_DIRECTORY = ".previous";
+constexpr size_t INSTALL_READ_BUFFER_SIZE = 4096;
 
-    // minitar_read_contents(&mp, &entry, file_buffer, entry.metadata.size);
-    if (minitar_read_contents_to_file(&mp, entry, absolute_path.c_str()) <= 0) {
-        TT_LOG_E(TAG, "Failed to write data to %s", absolute_path.c_str());
-        return false;
+static void cleanupInstallDirectory(const std::string& path) {
+    if (file::isDirectory(path) && !file::deleteRecursively(path)) {
+        TT_LOG_W(TAG, "Failed to delete %s", path.c_str());
     }
+}
 
-    // Note: fchmod() doesn't exist on ESP-IDF and chmod() does nothing on that platform
-    if (chmod(absolute_path.c_str(), entry->metadata.mode) < 0) {
-        return false;
-    }
+InstallStream::InstallStream(std::string expectedSha256) : expectedSha256(std::move(expectedSha256)) {}
 
-    return true;
+InstallStream::~InstallStream() {
+    cleanup();
 }
 
-static bool untarDirectory(const minitar_entry* entry, const std::string& destinationPath) {
-    auto absolute_path = destinationPath + "/" + entry->metadata.path;
-    if (!file::findOrCreateDirectory(absolute_path, 0777)) return false;
-    return true;
+void InstallStream::cleanup() {
+    extractor = nullptr;
+    if (!stagingPath.empty()) {
+        cleanupInstallDirectory(stagingPath);
+        stagingPath.clear();
+    }
 }
 
-static bool untar(const std::string& tarPath, const std::string& destinationPath) {
-    minitar mp;
-    if (minitar_open(tarPath.c_str(), &mp) != 0) {
-        perror(tarPath.c_str());
-        return 1;
-    }
-    bool success = true;
-    minitar_entry entry;
-
-    do {
-        if (minitar_read_entry(&mp, &entry) == 0) {
-            TT_LOG_I(TAG, "Extracting %s", entry.metadata.path);
-            if (entry.metadata.type == MTAR_DIRECTORY) {
-                if (!strcmp(entry.metadata.name, ".") || !strcmp(entry.metadata.name, "..") || !strcmp(entry.metadata.name, "/")) continue;
-                if (!untarDirectory(&entry, destinationPath)) {
-                    TT_LOG_E(TAG, "Failed to create directory %s/%s: %s", destinationPath.c_str(), entry.metadata.name, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_REGULAR) {
-                if (!untarFile(mp, &entry, destinationPath)) {
-                    TT_LOG_E(TAG, "Failed to extract file %s: %s", entry.metadata.path, strerror(errno));
-                    success = false;
-                    break;
-                }
-            } else if (entry.metadata.type == MTAR_SYMLINK) {
-                TT_LOG_E(TAG, "SYMLINK not supported");
-            } else if (entry.metadata.type == MTAR_HARDLINK) {
-                TT_LOG_E(TAG, "HARDLINK not supported");
-            } else if (entry.metadata.type == MTAR_FIFO) {
-                TT_LOG_E(TAG, "FIFO not supported");
-            } else if (entry.metadata.type == MTAR_BLKDEV) {
-                TT_LOG_E(TAG, "BLKDEV not supported");
-            } else if (entry.metadata.type == MTAR_CHRDEV) {
-                TT_LOG_E(TAG, "CHRDEV not supported");
-            } else {
-                TT_LOG_E(TAG, "Unknown entry type: %d", entry.metadata.type);
-                success = false;
-                break;
-            }
-        } else break;
-    } while (true);
-    minitar_close(&mp);
-    return success;
-}
+bool InstallStream::begin() {
+    auto app_parent_path = getAppInstallPath();
+    stagingPath = std::format("{}/{}", app_parent_path, STAGING_DIRECTORY);
 
-void cleanupInstallDirectory(const std::string& path) {
-    if (!file::deleteRecursively(path)) {
-        TT_LOG_W(TAG, "Failed to delete existing installation at %s", path.c_str());
+    // Remains of an install that was interrupted
+    cleanupInstallDirectory(stagingPath);
+
+    if (!file::findOrCreateDirectory(stagingPath, 0777)) {
+        TT_LOG_E(TAG, "Failed to create directory %s", stagingPath.c_str());
+        stagingPath.clear();
+        return false;
     }
-}
 
-bool install(const std::string& path) {
-    // We lock and unlock frequently because SPI SD card devices share
-    // the lock with the display. We don't want to lock the display for very long.
+    extractor = std::make_unique<file::TarStreamExtractor>(stagingPath);
+    return true;
+}
 
-    auto app_parent_path = getAppInstallPath();
-    TT_LOG_I(TAG, "Installing app %s to %s", path.c_str(), app_parent_path.c_str());
+bool InstallStream::write(const void* data, size_t length) {
+    if (extractor == nullptr) {
+        TT_LOG_E(TAG, "Install stream not started");
+        return false;
+    }
 
-    auto filename = file::getLastPathSegment(path);
-    const std::string app_target_path = std::format("{}/{}", app_parent_path, filename);
-    if (file::isDirectory(app_target_path) && !file::deleteRecursively(app_target_path)) {
-        TT_LOG_W(TAG, "Failed to delete %s", app_target_path.c_str());
+    if (!expectedSha256.empty()) {
+        sha256.update(data, length);
     }
 
-    if (!file::findOrCreateDirectory(app_target_path, 0777)) {
-        TT_LOG_I(TAG, "Failed to create directory %s", app_target_path.c_str());
+    return extractor->write(data, length);
+}
+
+bool InstallStream::finish() {
+    if (extractor == nullptr) {
+        TT_LOG_E(TAG, "Install stream not started");
         return false;
     }
 
-    auto target_path_lock = file::getLock(app_parent_path)->asScopedLock();
-    auto source_path_lock = file::getLock(path)->asScopedLock();
-    target_path_lock.lock();
-    source_path_lock.lock();
-    TT_LOG_I(TAG, "Extracting app from %s to %s", path.c_str(), app_target_path.c_str());
-    if (!untar(path, app_target_path)) {
+    bool extracted = extractor->finish();
+    extractor = nullptr;
+    if (!extracted) {
         TT_LOG_E(TAG, "Failed to extract");
+        cleanup();
         return false;
     }
-    source_path_lock.unlock();
-    target_path_lock.unlock();
 
-    auto manifest_path = app_target_path + "/manifest.properties";
+    if (!expectedSha256.empty()) {
+        auto digest = sha256.finishHex();
+        if (string::lowercase(expectedSha256) != digest) {
+            TT_LOG_E(TAG, "SHA-256 mismatch: expected %s, got %s", expectedSha256.c_str(), digest.c_str());
+            cleanup();
+            return false;
+        }
+    }
+
+    auto manifest_path = stagingPath + "/manifest.properties";
     if (!file::isFile(manifest_path)) {
         TT_LOG_E(TAG, "Manifest not found at %s", manifest_path.c_str());
-        cleanupInstallDirectory(app_target_path);
+        cleanup();
         return false;
     }
 
     std::map<std::string, std::string> properties;
     if (!file::loadPropertiesFile(manifest_path, properties)) {
         TT_LOG_E(TAG, "Failed to load manifest at %s", manifest_path.c_str());
-        cleanupInstallDirectory(app_target_path);
+        cleanup();
         return false;
     }
 
     AppManifest manifest;
     if (!parseManifest(properties, manifest)) {
         TT_LOG_W(TAG, "Invalid manifest");
-        cleanupInstallDirectory(app_target_path);
+        cleanup();
         return false;
     }
 
@@ -160,32 +128,93 @@ bool install(const std::string& path) {
         stopAll(manifest.appId);
     }
 
-    const std::string renamed_target_path = std::format("{}/{}", app_parent_path, manifest.appId);
-    if (file::isDirectory(renamed_target_path)) {
-        if (!file::deleteRecursively(renamed_target_path)) {
-            TT_LOG_W(TAG, "Failed to delete existing installation at %s", renamed_target_path.c_str());
-            cleanupInstallDirectory(app_target_path);
-            return false;
-        }
+    // Move the existing installation aside, so it can be restored when the swap fails
+    auto app_parent_path = getAppInstallPath();
+    const std::string target_path = std::format("{}/{}", app_parent_path, manifest.appId);
+    const std::string previous_path = std::format("{}/{}", app_parent_path, PREVIOUS_DIRECTORY);
+    cleanupInstallDirectory(previous_path);
+
+    auto lock = file::getLock(app_parent_path)->asScopedLock();
+    lock.lock();
+    bool has_previous = file::isDirectory(target_path);
+    if (has_previous && rename(target_path.c_str(), previous_path.c_str()) != 0) {
+        lock.unlock();
+        TT_LOG_E(TAG, "Failed to move existing installation at %s", target_path.c_str());
+        cleanup();
+        return false;
     }
 
-    target_path_lock.lock();
-    bool rename_success = rename(app_target_path.c_str(), renamed_target_path.c_str()) == 0;
-    target_path_lock.unlock();
+    bool rename_success = rename(stagingPath.c_str(), target_path.c_str()) == 0;
+    if (!rename_success && has_previous && rename(previous_path.c_str(), target_path.c_str()) != 0) {
+        TT_LOG_E(TAG, "Failed to restore previous installation of %s", manifest.appId.c_str());
+    }
+    lock.unlock();
 
     if (!rename_success) {
-        TT_LOG_E(TAG, "Failed to rename \"%s\" to \"%s\"", app_target_path.c_str(), manifest.appId.c_str());
-        cleanupInstallDirectory(app_target_path);
+        TT_LOG_E(TAG, "Failed to rename \"%s\" to \"%s\"", stagingPath.c_str(), target_path.c_str());
+        cleanup();
         return false;
     }
 
-    manifest.appLocation = Location::external(renamed_target_path);
+    stagingPath.clear();
+    cleanupInstallDirectory(previous_path);
 
+    manifest.appLocation = Location::external(target_path);
     addAppManifest(manifest);
+    appId = manifest.appId;
 
+    TT_LOG_I(TAG, "Installed %s to %s", appId.c_str(), target_path.c_str());
     return true;
 }
 
+bool install(const std::string& path) {
+    TT_LOG_I(TAG, "Installing app %s", path.c_str());
+
+    InstallStream stream;
+    if (!stream.begin()) {
+        return false;
+    }
+
+    // We lock and unlock frequently because SPI SD card devices share
+    // the lock with the display. We don't want to lock the display for very long.
+    auto lock = file::getLock(path)->asScopedLock();
+    lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), "rb"));
+    lock.unlock();
+
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", path.c_str());
+        return false;
+    }
+
+    auto buffer = std::make_unique<uint8_t[]>(INSTALL_READ_BUFFER_SIZE);
+    while (true) {
+        lock.lock();
+        auto bytes_read = fread(buffer.get(), 1, INSTALL_READ_BUFFER_SIZE, file.get());
+        bool read_error = ferror(file.get()) != 0;
+        lock.unlock();
+
+        if (read_error) {
+            TT_LOG_E(TAG, "Failed to read %s", path.c_str());
+            return false;
+        }
+
+        if (bytes_read == 0) {
+            break;
+        }
+
+        if (!stream.write(buffer.get(), bytes_read)) {
+            return false;
+        }
+    }
+
+    lock.lock();
+    file = nullptr;
+    lock.unlock();
+
+    return stream.finish();
+}
+
 bool uninstall(const std::string& appId) {
     TT_LOG_I(TAG, "Uninstalling app %s", appId.c_str());
 
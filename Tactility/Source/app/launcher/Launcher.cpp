@@ -5,6 +5,7 @@
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/hal/power/PowerDevice.h>
 #include <Tactility/lvgl/Lvgl.h>
+#include <Tactility/service/imagecache/ImageCache.h>
 #include <Tactility/service/loader/Loader.h>
 #include <Tactility/settings/BootSettings.h>
 
@@ -141,6 +142,11 @@ public:
         const auto files_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_files.png");
         const auto settings_icon_path = lvgl::PATH_PREFIX + paths->getAssetsPath("icon_settings.png");
 
+        // The launcher is shown whenever an app closes, so its icons are kept decoded
+        for (const auto& icon_path : { apps_icon_path, files_icon_path, settings_icon_path }) {
+            service::imagecache::pin(icon_path);
+        }
+
         createAppButton(buttons_wrapper, ui_scale, apps_icon_path.c_str(), "AppList", margin, is_landscape_display);
         createAppButton(buttons_wrapper, ui_scale, files_icon_path.c_str(), "Files", margin, is_landscape_display);
         createAppButton(buttons_wrapper, ui_scale, settings_icon_path.c_str(), "Settings", margin, is_landscape_display);
@@ -26,11 +26,18 @@ class ScreenshotApp final : public App {
     lv_obj_t* startStopButtonLabel = nullptr;
     lv_obj_t* timerWrapper = nullptr;
     lv_obj_t* delayTextArea = nullptr;
+    lv_obj_t* formatWrapper = nullptr;
+    lv_obj_t* formatDropdown = nullptr;
+    lv_obj_t* sequenceWrapper = nullptr;
+    lv_obj_t* intervalTextArea = nullptr;
     std::unique_ptr<Timer> updateTimer;
 
     void createTimerSettingsWidgets(lv_obj_t* parent);
+    void createSequenceSettingsWidgets(lv_obj_t* parent);
+    void createFormatSettingWidgets(lv_obj_t* parent);
     void createModeSettingWidgets(lv_obj_t* parent);
     void createFilePathWidgets(lv_obj_t* parent);
+    service::screenshot::Format getSelectedFormat() const;
 
     void updateScreenshotMode();
 
@@ -93,6 +100,17 @@ void ScreenshotApp::onModeSet() {
     updateScreenshotMode();
 }
 
+service::screenshot::Format ScreenshotApp::getSelectedFormat() const {
+    switch (lv_dropdown_get_selected(formatDropdown)) {
+        case 1:
+            return service::screenshot::Format::Qoi;
+        case 2:
+            return service::screenshot::Format::Raw;
+        default:
+            return service::screenshot::Format::Png;
+    }
+}
+
 void ScreenshotApp::onStartPressed() {
     auto service = service::screenshot::optScreenshotService();
     if (service == nullptr) {
@@ -111,13 +129,22 @@ void ScreenshotApp::onStartPressed() {
             const char* delay_text = lv_textarea_get_text(delayTextArea);
             int delay = atoi(delay_text);
             if (delay > 0) {
-                service->startTimed(path, delay, 1);
+                service->startTimed(path, delay, 1, getSelectedFormat());
             } else {
                 TT_LOG_W(TAG, "Ignored screenshot start because delay was 0");
             }
-        } else {
+        } else if (selected == 1) {
             TT_LOG_I(TAG, "Start app screenshots");
-            service->startApps(path);
+            service->startApps(path, getSelectedFormat());
+        } else {
+            TT_LOG_I(TAG, "Start sequence");
+            const char* interval_text = lv_textarea_get_text(intervalTextArea);
+            int interval = atoi(interval_text);
+            if (interval > 0) {
+                service->startSequence(path, interval, 0);
+            } else {
+                TT_LOG_W(TAG, "Ignored sequence start because interval was 0");
+            }
         }
     }
 
@@ -144,6 +171,14 @@ void ScreenshotApp::updateScreenshotMode() {
     } else {
         lv_obj_add_flag(timerWrapper, LV_OBJ_FLAG_HIDDEN);
     }
+
+    if (selected == 2) { // Sequence (always raw)
+        lv_obj_remove_flag(sequenceWrapper, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_flag(formatWrapper, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(sequenceWrapper, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(formatWrapper, LV_OBJ_FLAG_HIDDEN);
+    }
 }
 
 
@@ -164,7 +199,7 @@ void ScreenshotApp::createModeSettingWidgets(lv_obj_t* parent) {
     lv_obj_align(mode_label, LV_ALIGN_LEFT_MID, 0, 0);
 
     modeDropdown = lv_dropdown_create(mode_wrapper);
-    lv_dropdown_set_options(modeDropdown, "Timer\nApp start");
+    lv_dropdown_set_options(modeDropdown, "Timer\nApp start\nSequence");
     lv_obj_align_to(modeDropdown, mode_label, LV_ALIGN_OUT_RIGHT_MID, 8, 0);
     lv_obj_set_style_border_color(modeDropdown, lv_color_hex(0xFAFAFA), LV_PART_MAIN);
     lv_obj_set_style_border_width(modeDropdown, 1, LV_PART_MAIN);
@@ -172,6 +207,8 @@ void ScreenshotApp::createModeSettingWidgets(lv_obj_t* parent) {
     service::screenshot::Mode mode = service->getMode();
     if (mode == service::screenshot::Mode::Apps) {
         lv_dropdown_set_selected(modeDropdown, 1);
+    } else if (mode == service::screenshot::Mode::Sequence) {
+        lv_dropdown_set_selected(modeDropdown, 2);
     }
 
     auto* button = lv_button_create(mode_wrapper);
@@ -181,6 +218,23 @@ void ScreenshotApp::createModeSettingWidgets(lv_obj_t* parent) {
     lv_obj_align(startStopButtonLabel, LV_ALIGN_CENTER, 0, 0);
 }
 
+void ScreenshotApp::createFormatSettingWidgets(lv_obj_t* parent) {
+    formatWrapper = lv_obj_create(parent);
+    lv_obj_set_size(formatWrapper, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(formatWrapper, 0, 0);
+    lv_obj_set_style_border_width(formatWrapper, 0, 0);
+
+    auto* format_label = lv_label_create(formatWrapper);
+    lv_label_set_text(format_label, "Format:");
+    lv_obj_align(format_label, LV_ALIGN_LEFT_MID, 0, 0);
+
+    formatDropdown = lv_dropdown_create(formatWrapper);
+    lv_dropdown_set_options(formatDropdown, "PNG\nQOI\nRaw");
+    lv_obj_align_to(formatDropdown, format_label, LV_ALIGN_OUT_RIGHT_MID, 8, 0);
+    lv_obj_set_style_border_color(formatDropdown, lv_color_hex(0xFAFAFA), LV_PART_MAIN);
+    lv_obj_set_style_border_width(formatDropdown, 1, LV_PART_MAIN);
+}
+
 void ScreenshotApp::createFilePathWidgets(lv_obj_t* parent) {
     auto* path_wrapper = lv_obj_create(parent);
     lv_obj_set_size(path_wrapper, LV_PCT(100), LV_SIZE_CONTENT);
@@ -250,6 +304,36 @@ void ScreenshotApp::createTimerSettingsWidgets(lv_obj_t* parent) {
     lv_label_set_text(delay_unit_label, "seconds");
 }
 
+void ScreenshotApp::createSequenceSettingsWidgets(lv_obj_t* parent) {
+    sequenceWrapper = lv_obj_create(parent);
+    lv_obj_set_size(sequenceWrapper, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(sequenceWrapper, 0, 0);
+    lv_obj_set_style_border_width(sequenceWrapper, 0, 0);
+    lv_obj_set_flex_flow(sequenceWrapper, LV_FLEX_FLOW_ROW);
+
+    auto* interval_label_wrapper = lv_obj_create(sequenceWrapper);
+    lv_obj_set_style_border_width(interval_label_wrapper, 0, 0);
+    lv_obj_set_style_pad_all(interval_label_wrapper, 0, 0);
+    lv_obj_set_size(interval_label_wrapper, LV_SIZE_CONTENT, 36);
+    auto* interval_label = lv_label_create(interval_label_wrapper);
+    lv_label_set_text(interval_label, "Interval:");
+    lv_obj_align(interval_label, LV_ALIGN_LEFT_MID, 0, 0);
+
+    intervalTextArea = lv_textarea_create(sequenceWrapper);
+    lv_textarea_set_one_line(intervalTextArea, true);
+    lv_textarea_set_accepted_chars(intervalTextArea, "0123456789");
+    lv_textarea_set_text(intervalTextArea, "200");
+    lv_obj_set_flex_grow(intervalTextArea, 1);
+
+    auto* interval_unit_label_wrapper = lv_obj_create(sequenceWrapper);
+    lv_obj_set_style_border_width(interval_unit_label_wrapper, 0, 0);
+    lv_obj_set_style_pad_all(interval_unit_label_wrapper, 0, 0);
+    lv_obj_set_size(interval_unit_label_wrapper, LV_SIZE_CONTENT, 36);
+    auto* interval_unit_label = lv_label_create(interval_unit_label_wrapper);
+    lv_obj_align(interval_unit_label, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_label_set_text(interval_unit_label, "ms");
+}
+
 void ScreenshotApp::onShow(AppContext& appContext, lv_obj_t* parent) {
     if (updateTimer->isRunning()) {
         updateTimer->stop();
@@ -269,7 +353,9 @@ void ScreenshotApp::onShow(AppContext& appContext, lv_obj_t* parent) {
 
     createModeSettingWidgets(wrapper);
     createFilePathWidgets(wrapper);
+    createFormatSettingWidgets(wrapper);
     createTimerSettingsWidgets(wrapper);
+    createSequenceSettingsWidgets(wrapper);
 
     updateScreenshotMode();
 
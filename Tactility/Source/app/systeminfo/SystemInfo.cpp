@@ -3,6 +3,8 @@
 
 #include <Tactility/Assets.h>
 #include <Tactility/hal/Device.h>
+#include <Tactility/hal/display/DisplayDevice.h>
+#include <Tactility/hal/display/DisplayStatistics.h>
 #include <Tactility/Tactility.h>
 
 #include <format>
@@ -191,9 +193,24 @@ static void addRtosTasks(lv_obj_t* parent) {
 
 #endif
 
+static void addDisplayStatistics(lv_obj_t* parent, const std::shared_ptr<hal::display::DisplayDevice>& display) {
+    auto statistics = display->getStatistics();
+    if (statistics == nullptr) {
+        return;
+    }
+
+    auto snapshot = statistics->getSnapshot();
+    auto* label = lv_label_create(parent);
+    lv_label_set_text_fmt(label, "  %lu fps, %lu ms flush wait", (unsigned long)snapshot.framesPerSecond, (unsigned long)(snapshot.flushWaitTime / 1000U));
+}
+
 static void addDevice(lv_obj_t* parent, const std::shared_ptr<hal::Device>& device) {
     auto* label = lv_label_create(parent);
     lv_label_set_text(label, device->getName().c_str());
+
+    if (device->getType() == hal::Device::Type::Display) {
+        addDisplayStatistics(parent, std::static_pointer_cast<hal::display::DisplayDevice>(device));
+    }
 }
 
 static void addDevices(lv_obj_t* parent) {
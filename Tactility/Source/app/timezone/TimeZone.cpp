@@ -2,15 +2,14 @@
 #include <Tactility/app/AppManifest.h>
 #include <Tactility/app/AppPaths.h>
 #include <Tactility/app/timezone/TimeZone.h>
+#include <Tactility/app/timezone/TimeZoneIndex.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/lvgl/Toolbar.h>
-#include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/service/loader/Loader.h>
 
 #include <Tactility/MountPoints.h>
-#include <Tactility/StringUtils.h>
-#include <Tactility/Timer.h>
 
+#include <algorithm>
 #include <lvgl.h>
 #include <memory>
 
@@ -22,23 +21,6 @@ constexpr auto* RESULT_BUNDLE_NAME_INDEX = "name";
 
 extern const AppManifest manifest;
 
-struct TimeZoneEntry {
-    std::string name;
-    std::string code;
-};
-
-static bool parseEntry(const std::string& input, std::string& outName, std::string& outCode) {
-    std::string partial_strip = input.substr(1, input.size() - 3);
-    auto first_end_quote = partial_strip.find('"');
-    if (first_end_quote == std::string::npos) {
-        return false;
-    } else {
-        outName = partial_strip.substr(0, first_end_quote);
-        outCode = partial_strip.substr(first_end_quote + 3);
-        return true;
-    }
-}
-
 // region Result
 
 std::string getResultName(const Bundle& bundle) {
@@ -65,10 +47,20 @@ void setResultCode(Bundle& bundle, const std::string& code) {
 
 class TimeZoneApp final : public App {
 
-    Mutex mutex;
-    std::vector<TimeZoneEntry> entries;
-    std::unique_ptr<Timer> updateTimer;
+    struct Row {
+        uint16_t entry;
+        lv_obj_t* button;
+    };
+
+    /** Creating hundreds of list items takes too much time and memory */
+    static constexpr size_t MAX_ROWS = 50;
+
+    TimeZoneIndex index;
+    std::unique_ptr<TimeZoneSearch> search;
+    /** The rows in the list, in the same order as the search results */
+    std::vector<Row> rows;
     lv_obj_t* listWidget = nullptr;
+    lv_obj_t* moreResultsWidget = nullptr;
     lv_obj_t* filterTextareaWidget = nullptr;
 
     static void onTextareaValueChangedCallback(TT_UNUSED lv_event_t* e) {
@@ -77,14 +69,9 @@ class TimeZoneApp final : public App {
     }
 
     void onTextareaValueChanged(TT_UNUSED lv_event_t* e) {
-        if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-            if (updateTimer->isRunning()) {
-                updateTimer->stop();
-            }
-
-            updateTimer->start(500 / portTICK_PERIOD_MS);
-
-            mutex.unlock();
+        // Searching the index is fast enough to do it on every keystroke
+        if (search != nullptr && search->setQuery(lv_textarea_get_text(filterTextareaWidget))) {
+            updateList();
         }
     }
 
@@ -95,89 +82,67 @@ class TimeZoneApp final : public App {
         app->onListItemSelected(index);
     }
 
-    void onListItemSelected(std::size_t index) {
-        TT_LOG_I(TAG, "Selected item at index %zu", index);
-
-        auto& entry = entries[index];
+    void onListItemSelected(std::size_t entry) {
+        TT_LOG_I(TAG, "Selected item at index %zu", entry);
 
         auto bundle = std::make_unique<Bundle>();
-        setResultName(*bundle, entry.name);
-        setResultCode(*bundle, entry.code);
+        setResultName(*bundle, index.getName(entry));
+        setResultCode(*bundle, index.getCode(entry));
 
         setResult(Result::Ok, std::move(bundle));
         stop(manifest.appId);
     }
 
-    static void createListItem(lv_obj_t* list, const std::string& title, size_t index) {
-        auto* btn = lv_list_add_button(list, nullptr, title.c_str());
-        lv_obj_add_event_cb(btn, &onListItemSelectedCallback, LV_EVENT_SHORT_CLICKED, (void*)index);
+    lv_obj_t* createListItem(uint16_t entry) {
+        auto* btn = lv_list_add_button(listWidget, nullptr, index.getName(entry));
+        lv_obj_add_event_cb(btn, &onListItemSelectedCallback, LV_EVENT_SHORT_CLICKED, (void*)(size_t)entry);
+        return btn;
     }
 
-    void readTimeZones(std::string filter) {
-        auto path = std::string(file::MOUNT_POINT_SYSTEM) + "/timezones.csv";
-        auto* file = fopen(path.c_str(), "rb");
-        if (file == nullptr) {
-            TT_LOG_E(TAG, "Failed to open %s", path.c_str());
-            return;
-        }
-        char line[96];
-        std::string name;
-        std::string code;
-        uint32_t count = 0;
-        std::vector<TimeZoneEntry> new_entries;
-        while (fgets(line, 96, file)) {
-            if (parseEntry(line, name, code)) {
-                if (string::lowercase(name).find(filter) != std::string::npos) {
-                    count++;
-                    new_entries.push_back({.name = name, .code = code});
-
-                    // Safety guard
-                    if (count > 50) {
-                        // TODO: Show warning that we're not displaying a complete list
-                        break;
-                    }
-                }
-            } else {
-                TT_LOG_E(TAG, "Parse error at line %lu", count);
+    /**
+     * Update the list with the search results.
+     * Both the rows and the results are in alphabetical order, so they are merged:
+     * rows that are still in the results are kept as-is, and only the differences are created or deleted.
+     */
+    void updateList() {
+        const auto& results = search->getResults();
+        const size_t row_count = std::min(results.size(), MAX_ROWS);
+        std::vector<Row> new_rows;
+        new_rows.reserve(row_count);
+        size_t old_row_index = 0;
+        for (size_t i = 0; i < row_count; i++) {
+            const auto entry = results[i];
+            while (old_row_index < rows.size() && rows[old_row_index].entry < entry) {
+                lv_obj_delete(rows[old_row_index].button);
+                old_row_index++;
             }
-        }
-
-        fclose(file);
 
-        if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-            entries = std::move(new_entries);
-            mutex.unlock();
-        } else {
-            TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+            if (old_row_index < rows.size() && rows[old_row_index].entry == entry) {
+                new_rows.push_back(rows[old_row_index]);
+                old_row_index++;
+            } else {
+                auto* button = createListItem(entry);
+                lv_obj_move_to_index(button, static_cast<int32_t>(new_rows.size()));
+                new_rows.push_back({ .entry = entry, .button = button });
+            }
         }
 
-        TT_LOG_I(TAG, "Processed %lu entries", count);
-    }
-
-    void updateList() {
-        if (lvgl::lock(100 / portTICK_PERIOD_MS)) {
-            std::string filter = string::lowercase(std::string(lv_textarea_get_text(filterTextareaWidget)));
-            readTimeZones(filter);
-            lvgl::unlock();
-        } else {
-            TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
-            return;
+        while (old_row_index < rows.size()) {
+            lv_obj_delete(rows[old_row_index].button);
+            old_row_index++;
         }
 
-        if (lvgl::lock(100 / portTICK_PERIOD_MS)) {
-            if (mutex.lock(100 / portTICK_PERIOD_MS)) {
-                lv_obj_clean(listWidget);
-
-                uint32_t index = 0;
-                for (auto& entry : entries) {
-                    createListItem(listWidget, entry.name, index);
-                    index++;
-                }
+        rows = std::move(new_rows);
 
-                mutex.unlock();
+        if (results.size() > row_count) {
+            if (moreResultsWidget == nullptr) {
+                moreResultsWidget = lv_list_add_text(listWidget, "");
             }
-
-            lvgl::unlock();
+            lv_label_set_text_fmt(moreResultsWidget, "%zu more results: refine your search", results.size() - row_count);
+            lv_obj_move_foreground(moreResultsWidget);
+        } else if (moreResultsWidget != nullptr) {
+            lv_obj_delete(moreResultsWidget);
+            moreResultsWidget = nullptr;
         }
     }
 
@@ -217,12 +182,20 @@ public:
         lv_obj_set_flex_grow(list, 1);
         lv_obj_set_style_border_width(list, 0, 0);
         listWidget = list;
+
+        rows.clear();
+        moreResultsWidget = nullptr;
+        if (search != nullptr) {
+            search->setQuery("");
+            updateList();
+        }
     }
 
     void onCreate(AppContext& app) override {
-        updateTimer = std::make_unique<Timer>(Timer::Type::Once, [this] {
-            updateList();
-        });
+        auto path = std::string(file::MOUNT_POINT_SYSTEM) + "/timezones.csv";
+        if (index.load(path)) {
+            search = std::make_unique<TimeZoneSearch>(index);
+        }
     }
 };
 
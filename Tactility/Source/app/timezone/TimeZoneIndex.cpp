@@ -0,0 +1,138 @@
+#include "Tactility/app/timezone/TimeZoneIndex.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/StringUtils.h>
+#include <Tactility/file/File.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace tt::app::timezone {
+
+constexpr auto* TAG = "TimeZoneIndex";
+
+/** Parse a line like: "Europe/Amsterdam","CET-1CEST,M3.5.0,M10.5.0/3" */
+static bool parseLine(std::string_view line, std::string_view& outName, std::string_view& outCode) {
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+        line.remove_suffix(1);
+    }
+
+    if (line.size() < 7 || line.front() != '"' || line.back() != '"') {
+        return false;
+    }
+
+    auto separator = line.find("\",\"");
+    if (separator == std::string_view::npos) {
+        return false;
+    }
+
+    outName = line.substr(1, separator - 1);
+    outCode = line.substr(separator + 3, line.size() - separator - 4);
+    return !outName.empty();
+}
+
+bool TimeZoneIndex::parse(std::string_view csv) {
+    strings.clear();
+    entries.clear();
+
+    uint32_t line_number = 0;
+    while (!csv.empty()) {
+        line_number++;
+        auto line_end = csv.find('\n');
+        auto line = csv.substr(0, line_end);
+        csv.remove_prefix((line_end == std::string_view::npos) ? csv.size() : line_end + 1);
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+
+        std::string_view name, code;
+        if (parseLine(line, name, code)) {
+            Entry entry = { .nameOffset = static_cast<uint32_t>(strings.size()), .codeOffset = 0 };
+            strings.append(name);
+            strings.push_back('\0');
+            entry.codeOffset = strings.size();
+            strings.append(code);
+            strings.push_back('\0');
+            entries.push_back(entry);
+        } else {
+            TT_LOG_E(TAG, "Parse error at line %lu", line_number);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [this](const Entry& left, const Entry& right) {
+        return strcmp(strings.data() + left.nameOffset, strings.data() + right.nameOffset) < 0;
+    });
+
+    searchText.clear();
+    searchOffsets.clear();
+    searchOffsets.reserve(entries.size() + 1);
+    for (const auto& entry : entries) {
+        searchOffsets.push_back(searchText.size());
+        searchText.append(string::lowercase(std::string(strings.data() + entry.nameOffset)));
+        searchText.push_back('\n');
+    }
+    searchOffsets.push_back(searchText.size());
+
+    return !entries.empty();
+}
+
+bool TimeZoneIndex::load(const std::string& path) {
+    auto data = file::readString(path);
+    if (data == nullptr) {
+        TT_LOG_E(TAG, "Failed to read %s", path.c_str());
+        return false;
+    }
+
+    bool result = parse(reinterpret_cast<const char*>(data.get()));
+    TT_LOG_I(TAG, "Loaded %u entries from %s", getCount(), path.c_str());
+    return result;
+}
+
+void TimeZoneIndex::search(std::string_view lowercaseQuery, std::vector<uint16_t>& results) const {
+    results.clear();
+    if (lowercaseQuery.empty()) {
+        results.resize(entries.size());
+        std::iota(results.begin(), results.end(), 0);
+        return;
+    }
+
+    // A single pass over all names: matches can't span multiple names, because the query has no newlines
+    const std::string_view text = searchText;
+    size_t position = text.find(lowercaseQuery);
+    while (position != std::string_view::npos) {
+        auto next_entry = std::upper_bound(searchOffsets.begin(), searchOffsets.end(), position);
+        const auto index = static_cast<uint16_t>(std::distance(searchOffsets.begin(), next_entry) - 1);
+        results.push_back(index);
+        // Continue at the next entry, so an entry isn't found twice
+        position = text.find(lowercaseQuery, *next_entry);
+    }
+}
+
+void TimeZoneIndex::refine(std::string_view lowercaseQuery, std::vector<uint16_t>& results) const {
+    std::erase_if(results, [this, lowercaseQuery](uint16_t index) {
+        return getSearchName(index).find(lowercaseQuery) == std::string_view::npos;
+    });
+}
+
+bool TimeZoneSearch::setQuery(const std::string& newQuery) {
+    auto lowercase_query = string::lowercase(newQuery);
+    if (lowercase_query == query) {
+        return false;
+    }
+
+    const auto previous_count = results.size();
+    if (lowercase_query.find(query) != std::string::npos) {
+        // All matches of the new query also match the old query
+        index.refine(lowercase_query, results);
+        query = std::move(lowercase_query);
+        return results.size() != previous_count;
+    } else {
+        auto previous_results = std::move(results);
+        index.search(lowercase_query, results);
+        query = std::move(lowercase_query);
+        return results != previous_results;
+    }
+}
+
+} // namespace
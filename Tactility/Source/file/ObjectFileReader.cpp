@@ -1,6 +1,7 @@
 #include "Tactility/file/ObjectFile.h"
 #include "Tactility/file/ObjectFilePrivate.h"
 
+#include <algorithm>
 #include <cstring>
 #include <Tactility/Log.h>
 
@@ -8,15 +9,9 @@ namespace tt::file {
 
 constexpr auto* TAG = "ObjectFileReader";
 
-bool ObjectFileReader::open() {
-    auto opening_file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "r"));
-    if (opening_file == nullptr) {
-        TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
-        return false;
-    }
-
+bool readHeaders(FILE* file, const std::string& filePath, ContentInfo& info) {
     FileHeader file_header;
-    if (fread(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
+    if (fread(&file_header, sizeof(FileHeader), 1, file) != 1) {
         TT_LOG_E(TAG, "Failed to read file header from %s", filePath.c_str());
         return false;
     }
@@ -26,29 +21,92 @@ bool ObjectFileReader::open() {
         return false;
     }
 
-    if (file_header.version != OBJECT_FILE_VERSION) {
-        TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.identifier);
+    if (file_header.version == OBJECT_FILE_VERSION_1) {
+        ContentHeader content_header;
+        if (fread(&content_header, sizeof(ContentHeader), 1, file) != 1) {
+            TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+            return false;
+        }
+
+        info = {
+            .fileVersion = file_header.version,
+            .recordVersion = content_header.recordVersion,
+            .recordSize = content_header.recordSize,
+            .recordCount = content_header.recordCount,
+            .dataOffset = sizeof(FileHeader) + sizeof(ContentHeader)
+        };
+    } else if (file_header.version == OBJECT_FILE_VERSION_2) {
+        ContentHeaderV2 content_header;
+        if (fread(&content_header, sizeof(ContentHeaderV2), 1, file) != 1) {
+            TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+            return false;
+        }
+
+        if (content_header.dataOffset < sizeof(FileHeader) + sizeof(ContentHeaderV2)) {
+            TT_LOG_E(TAG, "Invalid data offset for %s: %lu", filePath.c_str(), content_header.dataOffset);
+            return false;
+        }
+
+        info = {
+            .fileVersion = file_header.version,
+            .recordVersion = content_header.recordVersion,
+            .recordSize = content_header.recordSize,
+            .recordCount = content_header.recordCount,
+            .dataOffset = content_header.dataOffset
+        };
+    } else {
+        TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.version);
+        return false;
+    }
+
+    if (info.recordSize == 0) {
+        TT_LOG_E(TAG, "Invalid record size for %s", filePath.c_str());
+        return false;
+    }
+
+    // Don't trust the header beyond the data that is actually there (e.g. after a power loss)
+    long file_size = getSize(file);
+    long data_size = file_size - static_cast<long>(info.dataOffset);
+    uint32_t stored_record_count = (data_size > 0) ? static_cast<uint32_t>(data_size / info.recordSize) : 0;
+    if (info.recordCount > stored_record_count) {
+        TT_LOG_W(TAG, "%s has %lu records, but only %lu are stored", filePath.c_str(), info.recordCount, stored_record_count);
+        info.recordCount = stored_record_count;
+    }
+
+    return true;
+}
+
+bool ObjectFileReader::open() {
+    auto opening_file = std::unique_ptr<FILE, FileCloser>(fopen(filePath.c_str(), "rb"));
+    if (opening_file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
+        return false;
+    }
+
+    ContentInfo info;
+    if (!readHeaders(opening_file.get(), filePath, info)) {
         return false;
     }
 
-    ContentHeader content_header;
-    if (fread(&content_header, sizeof(ContentHeader), 1, opening_file.get()) != 1) {
-        TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+    if (recordSize != info.recordSize) {
+        TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, info.recordSize);
         return false;
     }
 
-    if (recordSize != content_header.recordSize) {
-        TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
+    if (fseek(opening_file.get(), info.dataOffset, SEEK_SET) != 0) {
+        TT_LOG_E(TAG, "File seek failed: %s", filePath.c_str());
         return false;
     }
 
-    recordCount = content_header.recordCount;
-    recordVersion = content_header.recordVersion;
+    recordCount = info.recordCount;
+    recordVersion = info.recordVersion;
+    dataOffset = info.dataOffset;
+    recordsRead = 0;
 
     file = std::move(opening_file);
 
-    TT_LOG_D(TAG, "File version: %lu", file_header.version);
-    TT_LOG_D(TAG, "Content: version = %lu, size = %lu bytes, count = %lu", content_header.recordVersion, content_header.recordSize, content_header.recordCount);
+    TT_LOG_D(TAG, "File version: %lu", info.fileVersion);
+    TT_LOG_D(TAG, "Content: version = %lu, size = %lu bytes, count = %lu", info.recordVersion, info.recordSize, info.recordCount);
 
     return true;
 }
@@ -57,22 +115,50 @@ void ObjectFileReader::close() {
     recordCount = 0;
     recordVersion = 0;
     recordsRead = 0;
+    dataOffset = 0;
 
     file = nullptr;
 }
 
 bool ObjectFileReader::readNext(void* output) {
+    return readMany(output, 1) == 1;
+}
+
+uint32_t ObjectFileReader::readMany(void* output, uint32_t maxCount) {
     if (file == nullptr) {
         TT_LOG_E(TAG, "File not open");
-        return false;
+        return 0;
     }
 
-    bool result = fread(output, recordSize, 1, file.get()) == 1;
-    if (result) {
-        recordsRead++;
+    auto count = std::min(maxCount, recordCount - recordsRead);
+    if (count == 0) {
+        return 0;
     }
 
+    auto result = static_cast<uint32_t>(fread(output, recordSize, count, file.get()));
+    recordsRead += result;
     return result;
 }
 
-}
\ No newline at end of file
+bool ObjectFileReader::seek(uint32_t recordIndex) {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not open");
+        return false;
+    }
+
+    if (recordIndex > recordCount) {
+        TT_LOG_E(TAG, "Record index %lu out of range for %s", recordIndex, filePath.c_str());
+        return false;
+    }
+
+    long offset = dataOffset + static_cast<long>(recordIndex) * recordSize;
+    if (fseek(file.get(), offset, SEEK_SET) != 0) {
+        TT_LOG_E(TAG, "File seek failed: %s", filePath.c_str());
+        return false;
+    }
+
+    recordsRead = recordIndex;
+    return true;
+}
+
+}
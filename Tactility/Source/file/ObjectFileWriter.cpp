@@ -1,6 +1,7 @@
-#include "../../Include/Tactility/file/ObjectFile.h"
+#include "Tactility/file/ObjectFile.h"
 #include "Tactility/file/ObjectFilePrivate.h"
 
+#include <algorithm>
 #include <cstring>
 #include <Tactility/Log.h>
 #include <unistd.h>
@@ -16,66 +17,63 @@ bool ObjectFileWriter::open() {
     }
 
     // Edit existing or create a new file
-    auto opening_file = std::unique_ptr<FILE, FileCloser>(std::fopen(filePath.c_str(), "wb"));
+    auto opening_file = std::unique_ptr<FILE, FileCloser>(std::fopen(filePath.c_str(), edit_existing ? "r+b" : "w+b"));
     if (opening_file == nullptr) {
         TT_LOG_E(TAG, "Failed to open file %s", filePath.c_str());
         return false;
     }
 
-    auto file_size = getSize(opening_file.get());
-    if (file_size > 0 && edit_existing) {
+    // Records are buffered by the writer itself, so stdio buffering would only add a copy
+    setvbuf(opening_file.get(), nullptr, _IONBF, 0);
 
-        // Read and parse file header
-
-        FileHeader file_header;
-        if (fread(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
-            TT_LOG_E(TAG, "Failed to read file header from %s", filePath.c_str());
-            return false;
-        }
-
-        if (file_header.identifier != OBJECT_FILE_IDENTIFIER) {
-            TT_LOG_E(TAG, "Invalid file type for %s", filePath.c_str());
+    // Empty files get the headers of a new file
+    const bool is_new_file = !edit_existing || getSize(opening_file.get()) == 0;
+    if (!is_new_file) {
+        ContentInfo info;
+        if (!readHeaders(opening_file.get(), filePath, info)) {
             return false;
         }
 
-        if (file_header.version != OBJECT_FILE_VERSION) {
-            TT_LOG_E(TAG, "Unknown version for %s: %lu", filePath.c_str(), file_header.identifier);
-            return false;
-        }
-
-        // Read and parse content header
-
-        ContentHeader content_header;
-        if (fread(&content_header, sizeof(ContentHeader), 1, opening_file.get()) != 1) {
-            TT_LOG_E(TAG, "Failed to read content header from %s", filePath.c_str());
+        if (recordSize != info.recordSize) {
+            TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, info.recordSize);
             return false;
         }
 
-        if (recordSize != content_header.recordSize) {
-            TT_LOG_E(TAG, "Record size mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordSize, content_header.recordSize);
+        if (recordVersion != info.recordVersion) {
+            TT_LOG_E(TAG, "Version mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordVersion, info.recordVersion);
             return false;
         }
 
-        if (recordVersion != content_header.recordVersion) {
-            TT_LOG_E(TAG, "Version mismatch for %s: expected %lu, got %lu", filePath.c_str(), recordVersion, content_header.recordVersion);
-            return false;
-        }
-
-        recordsWritten = content_header.recordCount;
-        fseek(opening_file.get(), 0, SEEK_END);
+        // Existing files keep their version, so older readers can still read them
+        fileVersion = info.fileVersion;
+        dataOffset = info.dataOffset;
+        recordsWritten = info.recordCount;
     } else {
+        fileVersion = OBJECT_FILE_VERSION;
+        dataOffset = OBJECT_FILE_DATA_ALIGNMENT;
+        recordsWritten = 0;
+
         FileHeader file_header;
         if (fwrite(&file_header, sizeof(FileHeader), 1, opening_file.get()) != 1) {
             TT_LOG_E(TAG, "Failed to write file header for %s", filePath.c_str());
             return false;
         }
-
-        // Seek forward (skip ContentHeader that will be written later)
-        fseek(opening_file.get(), sizeof(ContentHeader), SEEK_CUR);
     }
 
-
+    // Records after the last checkpoint might be incomplete, so they are overwritten
+    recordsCheckpointed = recordsWritten;
+    writePosition = dataOffset + static_cast<long>(recordsWritten) * recordSize;
+    bufferLength = 0;
+    bufferLimit = WRITE_BUFFER_SIZE - (writePosition % WRITE_BUFFER_SIZE);
+    buffer = std::make_unique<uint8_t[]>(WRITE_BUFFER_SIZE);
     file = std::move(opening_file);
+
+    // Write the content header of new files immediately, so they're valid even without a close()
+    if (is_new_file && !writeContentHeader()) {
+        file = nullptr;
+        return false;
+    }
+
     return true;
 }
 
@@ -85,40 +83,136 @@ void ObjectFileWriter::close() {
         return;
     }
 
+    flush();
+
+    file = nullptr;
+    buffer = nullptr;
+}
+
+bool ObjectFileWriter::writeBuffer() {
+    if (bufferLength == 0) {
+        return true;
+    }
+
+    if (fseek(file.get(), writePosition, SEEK_SET) != 0) {
+        TT_LOG_E(TAG, "File seek failed: %s", filePath.c_str());
+        return false;
+    }
+
+    if (fwrite(buffer.get(), bufferLength, 1, file.get()) != 1) {
+        TT_LOG_E(TAG, "Failed to write records to %s", filePath.c_str());
+        return false;
+    }
+
+    writePosition += bufferLength;
+    bufferLength = 0;
+    bufferLimit = WRITE_BUFFER_SIZE - (writePosition % WRITE_BUFFER_SIZE);
+    return true;
+}
+
+bool ObjectFileWriter::writeContentHeader() {
+    // Records that are (partially) in the buffer are not part of the checkpoint
+    auto record_count = std::min(recordsWritten, static_cast<uint32_t>((writePosition - dataOffset) / recordSize));
+
+    // The records must reach the file before the header that refers to them
+    if (fflush(file.get()) != 0) {
+        TT_LOG_E(TAG, "Failed to flush %s", filePath.c_str());
+        return false;
+    }
+
     if (fseek(file.get(), sizeof(FileHeader), SEEK_SET) != 0) {
         TT_LOG_E(TAG, "File seek failed: %s", filePath.c_str());
-        return;
+        return false;
     }
 
-    ContentHeader content_header = {
-        .recordVersion = this->recordVersion,
-        .recordSize = this->recordSize,
-        .recordCount = this->recordsWritten
-    };
+    bool written;
+    if (fileVersion == OBJECT_FILE_VERSION_1) {
+        ContentHeader content_header = {
+            .recordVersion = recordVersion,
+            .recordSize = recordSize,
+            .recordCount = record_count
+        };
+        written = fwrite(&content_header, sizeof(ContentHeader), 1, file.get()) == 1;
+    } else {
+        ContentHeaderV2 content_header = {
+            .recordVersion = recordVersion,
+            .recordSize = recordSize,
+            .recordCount = record_count,
+            .dataOffset = dataOffset
+        };
+        written = fwrite(&content_header, sizeof(ContentHeaderV2), 1, file.get()) == 1;
+    }
 
-    if (fwrite(&content_header, sizeof(ContentHeader), 1, file.get()) != 1) {
+    if (!written || fflush(file.get()) != 0) {
         TT_LOG_E(TAG, "Failed to write content header to %s", filePath.c_str());
+        return false;
     }
 
-    file = nullptr;
+    recordsCheckpointed = record_count;
+    return true;
 }
 
-bool ObjectFileWriter::write(void* data) {
+bool ObjectFileWriter::write(const void* data) {
     if (file == nullptr) {
         TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
         return false;
     }
 
-    if (fwrite(data, recordSize, 1, file.get()) != 1) {
-        TT_LOG_E(TAG, "Failed to write record to %s", filePath.c_str());
-        return false;
+    auto record_position = writePosition + bufferLength;
+    bool buffer_written = false;
+    auto* input = static_cast<const uint8_t*>(data);
+    uint32_t remaining = recordSize;
+    while (remaining > 0) {
+        auto copy_size = std::min(remaining, bufferLimit - bufferLength);
+        memcpy(buffer.get() + bufferLength, input, copy_size);
+        bufferLength += copy_size;
+        input += copy_size;
+        remaining -= copy_size;
+
+        if (bufferLength == bufferLimit) {
+            if (!writeBuffer()) {
+                // Forget the partial record, so the next record is written at the right position
+                if (record_position >= writePosition) {
+                    bufferLength = record_position - writePosition;
+                } else {
+                    writePosition = record_position;
+                    bufferLength = 0;
+                    bufferLimit = WRITE_BUFFER_SIZE - (writePosition % WRITE_BUFFER_SIZE);
+                }
+                return false;
+            }
+            buffer_written = true;
+        }
     }
 
     recordsWritten++;
 
+    if (buffer_written && !writeContentHeader()) {
+        return false;
+    }
+
     return true;
 }
 
-// endregion Writer
+bool ObjectFileWriter::flush() {
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "File not opened: %s", filePath.c_str());
+        return false;
+    }
+
+    if (!writeBuffer()) {
+        return false;
+    }
+
+    if (recordsCheckpointed != recordsWritten && !writeContentHeader()) {
+        return false;
+    }
+
+    if (fsync(fileno(file.get())) != 0) {
+        TT_LOG_W(TAG, "fsync() failed for %s: %s", filePath.c_str(), strerror(errno));
+    }
 
-}
\ No newline at end of file
+    return true;
+}
+
+}
@@ -0,0 +1,95 @@
+#include "Tactility/file/SystemAssetPack.h"
+
+#include <Tactility/file/AssetPack.h>
+#include <Tactility/Log.h>
+#include <Tactility/MountPoints.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_partition.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tt::file {
+
+constexpr auto* TAG = "SystemAssetPack";
+
+#ifdef ESP_PLATFORM
+
+constexpr auto* ASSETS_PARTITION_NAME = "assets";
+
+static std::shared_ptr<AssetPack> mapAssetPack() {
+    const auto* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSETS_PARTITION_NAME);
+    if (partition == nullptr) {
+        TT_LOG_I(TAG, "No %s partition", ASSETS_PARTITION_NAME);
+        return nullptr;
+    }
+
+    const void* data;
+    esp_partition_mmap_handle_t handle;
+    auto result = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &data, &handle);
+    if (result != ESP_OK) {
+        TT_LOG_E(TAG, "Failed to map %s partition (%s)", ASSETS_PARTITION_NAME, esp_err_to_name(result));
+        return nullptr;
+    }
+
+    return std::make_shared<AssetPack>(static_cast<const uint8_t*>(data), partition->size, [handle] {
+        esp_partition_munmap(handle);
+    });
+}
+
+#else
+
+constexpr auto* ASSET_PACK_PATH = "system.ttpack";
+
+static std::shared_ptr<AssetPack> mapAssetPack() {
+    int file = open(ASSET_PACK_PATH, O_RDONLY);
+    if (file == -1) {
+        TT_LOG_I(TAG, "No %s", ASSET_PACK_PATH);
+        return nullptr;
+    }
+
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0) {
+        TT_LOG_E(TAG, "Failed to get the size of %s", ASSET_PACK_PATH);
+        close(file);
+        return nullptr;
+    }
+
+    const size_t size = file_stat.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping stays valid after the file is closed
+    close(file);
+    if (data == MAP_FAILED) {
+        TT_LOG_E(TAG, "Failed to map %s", ASSET_PACK_PATH);
+        return nullptr;
+    }
+
+    return std::make_shared<AssetPack>(static_cast<const uint8_t*>(data), size, [data, size] {
+        munmap(data, size);
+    });
+}
+
+#endif
+
+bool loadSystemAssetPack() {
+    auto pack = mapAssetPack();
+    if (pack == nullptr) {
+        return false;
+    }
+
+    if (!pack->isValid()) {
+        // e.g. an erased partition
+        TT_LOG_W(TAG, "Invalid asset pack: using %s", MOUNT_POINT_SYSTEM);
+        return false;
+    }
+
+    TT_LOG_I(TAG, "Loaded %lu assets", static_cast<unsigned long>(pack->getEntryCount()));
+    setAssetPack(MOUNT_POINT_SYSTEM, pack);
+    return true;
+}
+
+}
@@ -0,0 +1,402 @@
+#include "Tactility/file/TarStream.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace tt::file {
+
+constexpr auto* TAG = "TarStream";
+
+// ustar header fields: offset and length
+constexpr size_t HEADER_NAME_OFFSET = 0;
+constexpr size_t HEADER_NAME_LENGTH = 100;
+constexpr size_t HEADER_MODE_OFFSET = 100;
+constexpr size_t HEADER_MODE_LENGTH = 8;
+constexpr size_t HEADER_SIZE_OFFSET = 124;
+constexpr size_t HEADER_SIZE_LENGTH = 12;
+constexpr size_t HEADER_CHECKSUM_OFFSET = 148;
+constexpr size_t HEADER_CHECKSUM_LENGTH = 8;
+constexpr size_t HEADER_TYPE_OFFSET = 156;
+constexpr size_t HEADER_MAGIC_OFFSET = 257;
+constexpr size_t HEADER_PREFIX_OFFSET = 345;
+constexpr size_t HEADER_PREFIX_LENGTH = 155;
+
+/** Long names are only used for paths, so they can't be very long */
+constexpr size_t MAX_LONG_NAME_LENGTH = 1024;
+
+static bool parseOctal(const uint8_t* field, size_t length, uint64_t& output) {
+    size_t index = 0;
+    while (index < length && field[index] == ' ') {
+        index++;
+    }
+
+    bool has_digits = false;
+    output = 0;
+    while (index < length && field[index] >= '0' && field[index] <= '7') {
+        output = (output << 3) | (field[index] - '0');
+        has_digits = true;
+        index++;
+    }
+
+    // The number is terminated by a space, a null character or the end of the field
+    return has_digits && (index == length || field[index] == ' ' || field[index] == '\0');
+}
+
+static std::string getField(const uint8_t* field, size_t length) {
+    auto* characters = reinterpret_cast<const char*>(field);
+    return std::string(characters, strnlen(characters, length));
+}
+
+/** @return false when the path could point outside the destination directory */
+static bool sanitizePath(std::string& path) {
+    while (path.starts_with("./")) {
+        path.erase(0, 2);
+    }
+
+    while (path.ends_with('/')) {
+        path.pop_back();
+    }
+
+    if (path.starts_with('/')) {
+        return false;
+    }
+
+    size_t segment_start = 0;
+    while (segment_start <= path.size()) {
+        auto segment_end = path.find('/', segment_start);
+        if (segment_end == std::string::npos) {
+            segment_end = path.size();
+        }
+        if (path.compare(segment_start, segment_end - segment_start, "..") == 0) {
+            return false;
+        }
+        segment_start = segment_end + 1;
+    }
+
+    return true;
+}
+
+TarStreamExtractor::TarStreamExtractor(std::string destinationPath, size_t writeBufferSize) :
+    destinationPath(std::move(destinationPath)),
+    writeBufferSize(writeBufferSize),
+    // All entries are stored on the same file system
+    fileLock(getLock(this->destinationPath))
+{}
+
+TarStreamExtractor::~TarStreamExtractor() {
+    if (file != nullptr) {
+        auto lock = fileLock->asScopedLock();
+        lock.lock();
+        file = nullptr;
+    }
+}
+
+bool TarStreamExtractor::fail() {
+    if (file != nullptr) {
+        auto lock = fileLock->asScopedLock();
+        lock.lock();
+        file = nullptr;
+    }
+    state = State::Error;
+    return false;
+}
+
+bool TarStreamExtractor::write(const void* data, size_t length) {
+    auto* input = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        switch (state) {
+            case State::Header: {
+                auto copy_size = std::min(length, BLOCK_SIZE - headerLength);
+                memcpy(header + headerLength, input, copy_size);
+                headerLength += copy_size;
+                input += copy_size;
+                length -= copy_size;
+                if (headerLength == BLOCK_SIZE) {
+                    headerLength = 0;
+                    if (!parseHeader()) {
+                        return fail();
+                    }
+                }
+                break;
+            }
+            case State::Data: {
+                auto data_size = std::min(length, entryRemaining);
+                if (!appendEntryData(input, data_size)) {
+                    return fail();
+                }
+                input += data_size;
+                length -= data_size;
+                entryRemaining -= data_size;
+                if (entryRemaining == 0) {
+                    if (!endEntry()) {
+                        return fail();
+                    }
+                    state = (paddingRemaining > 0) ? State::Padding : State::Header;
+                }
+                break;
+            }
+            case State::Padding: {
+                auto skip_size = std::min(length, paddingRemaining);
+                input += skip_size;
+                length -= skip_size;
+                paddingRemaining -= skip_size;
+                if (paddingRemaining == 0) {
+                    state = State::Header;
+                }
+                break;
+            }
+            case State::End:
+                // Archives are often padded to a multiple of the record size
+                return true;
+            case State::Error:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool TarStreamExtractor::finish() {
+    if (state == State::Error) {
+        return false;
+    }
+
+    // Some archivers don't write the end-of-archive blocks
+    bool complete = state == State::End || (state == State::Header && headerLength == 0 && longName.empty());
+    if (!complete) {
+        TT_LOG_E(TAG, "Archive is incomplete");
+        fail();
+    }
+
+    return complete;
+}
+
+bool TarStreamExtractor::parseHeader() {
+    if (std::all_of(header, header + BLOCK_SIZE, [](uint8_t value) { return value == 0; })) {
+        // The archive ends with 2 empty blocks
+        emptyHeaderCount++;
+        if (emptyHeaderCount == 2) {
+            state = State::End;
+        }
+        return true;
+    }
+    emptyHeaderCount = 0;
+
+    uint64_t expected_checksum;
+    if (!parseOctal(header + HEADER_CHECKSUM_OFFSET, HEADER_CHECKSUM_LENGTH, expected_checksum)) {
+        TT_LOG_E(TAG, "Invalid header checksum field");
+        return false;
+    }
+
+    // The checksum is calculated as if the checksum field contains spaces
+    uint64_t checksum = ' ' * HEADER_CHECKSUM_LENGTH;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        if (i < HEADER_CHECKSUM_OFFSET || i >= HEADER_CHECKSUM_OFFSET + HEADER_CHECKSUM_LENGTH) {
+            checksum += header[i];
+        }
+    }
+
+    if (checksum != expected_checksum) {
+        TT_LOG_E(TAG, "Header checksum mismatch");
+        return false;
+    }
+
+    uint64_t size;
+    if (!parseOctal(header + HEADER_SIZE_OFFSET, HEADER_SIZE_LENGTH, size)) {
+        TT_LOG_E(TAG, "Invalid size field");
+        return false;
+    }
+
+    uint64_t mode;
+    if (!parseOctal(header + HEADER_MODE_OFFSET, HEADER_MODE_LENGTH, mode)) {
+        mode = 0644;
+    }
+    entryMode = static_cast<uint32_t>(mode & 0777);
+
+    std::string path;
+    if (!longName.empty()) {
+        path = std::move(longName);
+        longName.clear();
+    } else {
+        path = getField(header + HEADER_NAME_OFFSET, HEADER_NAME_LENGTH);
+        if (memcmp(header + HEADER_MAGIC_OFFSET, "ustar", 5) == 0) {
+            auto prefix = getField(header + HEADER_PREFIX_OFFSET, HEADER_PREFIX_LENGTH);
+            if (!prefix.empty()) {
+                path = prefix + "/" + path;
+            }
+        }
+    }
+
+    return beginEntry(static_cast<char>(header[HEADER_TYPE_OFFSET]), path, size);
+}
+
+bool TarStreamExtractor::beginEntry(char typeFlag, const std::string& path, size_t size) {
+    entryRemaining = size;
+    paddingRemaining = (BLOCK_SIZE - (size % BLOCK_SIZE)) % BLOCK_SIZE;
+    entryType = EntryType::Skip;
+    entryPath = path;
+
+    switch (typeFlag) {
+        case 'L':
+            if (size > MAX_LONG_NAME_LENGTH) {
+                TT_LOG_E(TAG, "Long name too long (%zu)", size);
+                return false;
+            }
+            entryType = EntryType::LongName;
+            break;
+        case '5': {
+            if (!sanitizePath(entryPath)) {
+                TT_LOG_E(TAG, "Invalid path: %s", path.c_str());
+                return false;
+            }
+            if (!entryPath.empty()) {
+                TT_LOG_I(TAG, "Extracting %s", entryPath.c_str());
+                auto directory_path = destinationPath + "/" + entryPath;
+                if (!findOrCreateDirectory(directory_path, 0777)) {
+                    TT_LOG_E(TAG, "Failed to create directory %s", directory_path.c_str());
+                    return false;
+                }
+                entryCount++;
+            }
+            break;
+        }
+        case '0':
+        case '\0':
+        case '7': {
+            if (!sanitizePath(entryPath) || entryPath.empty()) {
+                TT_LOG_E(TAG, "Invalid path: %s", path.c_str());
+                return false;
+            }
+
+            TT_LOG_I(TAG, "Extracting %s", entryPath.c_str());
+
+            // Parent directories don't always have their own entries
+            auto file_path = destinationPath + "/" + entryPath;
+            auto separator_index = file_path.rfind('/');
+            if (!findOrCreateDirectory(file_path.substr(0, separator_index), 0777)) {
+                TT_LOG_E(TAG, "Failed to create parent directory for %s", file_path.c_str());
+                return false;
+            }
+
+            auto lock = fileLock->asScopedLock();
+            lock.lock();
+            file = std::unique_ptr<FILE, FileCloser>(fopen(file_path.c_str(), "wb"));
+            if (file == nullptr) {
+                TT_LOG_E(TAG, "Failed to open %s", file_path.c_str());
+                return false;
+            }
+            // Data is already buffered in large blocks
+            setvbuf(file.get(), nullptr, _IONBF, 0);
+            lock.unlock();
+
+            if (writeBuffer == nullptr) {
+                writeBuffer = std::make_unique<uint8_t[]>(writeBufferSize);
+            }
+            writeBufferLength = 0;
+            entryType = EntryType::File;
+            entryCount++;
+            break;
+        }
+        case 'x':
+        case 'g':
+            // pax headers contain optional metadata
+            break;
+        default:
+            TT_LOG_W(TAG, "Skipping %s: entry type %d is not supported", path.c_str(), typeFlag);
+            break;
+    }
+
+    if (entryRemaining == 0) {
+        if (!endEntry()) {
+            return false;
+        }
+        state = State::Header;
+    } else {
+        state = State::Data;
+    }
+
+    return true;
+}
+
+bool TarStreamExtractor::appendEntryData(const uint8_t* data, size_t length) {
+    switch (entryType) {
+        case EntryType::File:
+            while (length > 0) {
+                auto copy_size = std::min(length, writeBufferSize - writeBufferLength);
+                memcpy(writeBuffer.get() + writeBufferLength, data, copy_size);
+                writeBufferLength += copy_size;
+                data += copy_size;
+                length -= copy_size;
+                if (writeBufferLength == writeBufferSize && !flushWriteBuffer()) {
+                    return false;
+                }
+            }
+            return true;
+        case EntryType::LongName:
+            longName.append(reinterpret_cast<const char*>(data), length);
+            return true;
+        case EntryType::Skip:
+            return true;
+    }
+
+    return true;
+}
+
+bool TarStreamExtractor::flushWriteBuffer() {
+    if (writeBufferLength == 0) {
+        return true;
+    }
+
+    auto lock = fileLock->asScopedLock();
+    lock.lock();
+    bool success = fwrite(writeBuffer.get(), 1, writeBufferLength, file.get()) == writeBufferLength;
+    lock.unlock();
+
+    if (!success) {
+        TT_LOG_E(TAG, "Failed to write %s", entryPath.c_str());
+        return false;
+    }
+
+    writeBufferLength = 0;
+    return true;
+}
+
+bool TarStreamExtractor::endEntry() {
+    switch (entryType) {
+        case EntryType::File: {
+            if (!flushWriteBuffer()) {
+                return false;
+            }
+
+            auto file_path = destinationPath + "/" + entryPath;
+            auto lock = fileLock->asScopedLock();
+            lock.lock();
+            bool closed = fclose(file.release()) == 0;
+            // Note: chmod() does nothing on ESP-IDF
+            if (closed && chmod(file_path.c_str(), entryMode) != 0) {
+                TT_LOG_W(TAG, "Failed to set mode of %s", file_path.c_str());
+            }
+            lock.unlock();
+
+            if (!closed) {
+                TT_LOG_E(TAG, "Failed to close %s", file_path.c_str());
+                return false;
+            }
+            break;
+        }
+        case EntryType::LongName:
+            // The name is null-terminated inside the data
+            longName.resize(strnlen(longName.c_str(), longName.size()));
+            break;
+        case EntryType::Skip:
+            break;
+    }
+
+    entryType = EntryType::Skip;
+    return true;
+}
+
+} // namespace
@@ -2,29 +2,62 @@
 
 #include <Tactility/Mutex.h>
 
+#include <atomic>
+
 namespace tt::hal {
 
-std::vector<std::shared_ptr<Device>> devices;
-Mutex mutex = Mutex(Mutex::Type::Recursive);
+/** Serializes registry mutations: readers only use the snapshot */
+static Mutex mutex = Mutex(Mutex::Type::Recursive);
+static std::atomic<std::shared_ptr<const DeviceRegistrySnapshot>> snapshot = std::make_shared<const DeviceRegistrySnapshot>();
+static std::shared_ptr<PubSub<DeviceRegistryEvent>> pubsub = std::make_shared<PubSub<DeviceRegistryEvent>>();
 static Device::Id nextId = 0;
 
 #define TAG "devices"
 
 Device::Device() : id(nextId++) {}
 
-template <std::ranges::range RangeType>
-auto toVector(RangeType&& range) {
-    auto view = range | std::views::common;
-    return std::vector(view.begin(), view.end());
+DeviceRegistrySnapshot::DeviceRegistrySnapshot(uint32_t epoch, std::vector<std::shared_ptr<Device>> inDevices) :
+    epoch(epoch),
+    devices(std::move(inDevices))
+{
+    devicesById.reserve(devices.size());
+    devicesByName.reserve(devices.size());
+    for (auto& device : devices) {
+        auto type_index = static_cast<size_t>(device->getType());
+        assert(type_index < DEVICE_TYPE_COUNT);
+        devicesByType[type_index].push_back(device);
+        devicesById.emplace(device->getId(), device);
+        // First registered device wins, like the linear search used to do
+        devicesByName.try_emplace(device->getName(), device);
+    }
+}
+
+std::shared_ptr<Device> _Nullable DeviceRegistrySnapshot::findDevice(Device::Id id) const {
+    auto iterator = devicesById.find(id);
+    return (iterator != devicesById.end()) ? iterator->second : nullptr;
+}
+
+std::shared_ptr<Device> _Nullable DeviceRegistrySnapshot::findDevice(const std::string& name) const {
+    auto iterator = devicesByName.find(name);
+    return (iterator != devicesByName.end()) ? iterator->second : nullptr;
 }
 
 void registerDevice(const std::shared_ptr<Device>& device) {
     auto scoped_mutex = mutex.asScopedLock();
     scoped_mutex.lock();
 
-    if (findDevice(device->getId()) == nullptr) {
+    auto current_snapshot = snapshot.load();
+    if (current_snapshot->findDevice(device->getId()) == nullptr) {
+        auto devices = current_snapshot->getDevices();
         devices.push_back(device);
+        snapshot.store(std::make_shared<const DeviceRegistrySnapshot>(current_snapshot->getEpoch() + 1, std::move(devices)));
         TT_LOG_I(TAG, "Registered %s with id %lu", device->getName().c_str(), device->getId());
+        scoped_mutex.unlock();
+
+        pubsub->publish({
+            .type = DeviceRegistryEvent::Type::Registered,
+            .device = device
+        });
     } else {
         TT_LOG_W(TAG, "Device %s with id %lu was already registered", device->getName().c_str(), device->getId());
     }
@@ -34,71 +67,77 @@ void deregisterDevice(const std::shared_ptr<Device>& device) {
     auto scoped_mutex = mutex.asScopedLock();
     scoped_mutex.lock();
 
+    auto current_snapshot = snapshot.load();
     auto id_to_remove = device->getId();
-    auto remove_iterator = std::remove_if(devices.begin(), devices.end(), [id_to_remove](const auto& device) {
-        return device->getId() == id_to_remove;
-    });
-    if (remove_iterator != devices.end()) {
+    if (current_snapshot->findDevice(id_to_remove) != nullptr) {
         TT_LOG_I(TAG, "Deregistering %s with id %lu", device->getName().c_str(), device->getId());
-        devices.erase(remove_iterator);
+        auto devices = current_snapshot->getDevices();
+        std::erase_if(devices, [id_to_remove](const auto& device) {
+            return device->getId() == id_to_remove;
+        });
+        snapshot.store(std::make_shared<const DeviceRegistrySnapshot>(current_snapshot->getEpoch() + 1, std::move(devices)));
+        scoped_mutex.unlock();
+
+        pubsub->publish({
+            .type = DeviceRegistryEvent::Type::Deregistered,
+            .device = device
+        });
     } else {
         TT_LOG_W(TAG, "Deregistering %s with id %lu failed: not found", device->getName().c_str(), device->getId());
     }
 }
 
-std::vector<std::shared_ptr<Device>> findDevices(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
+std::shared_ptr<const DeviceRegistrySnapshot> getDeviceRegistrySnapshot() {
+    return snapshot.load();
+}
 
-    auto devices_view = devices | std::views::filter([&filterFunction](auto& device) {
-        return filterFunction(device);
-    });
-    return toVector(devices_view);
+uint32_t getDeviceRegistryEpoch() {
+    return snapshot.load()->getEpoch();
 }
 
-std::shared_ptr<Device> _Nullable findDevice(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
+std::shared_ptr<PubSub<DeviceRegistryEvent>> getDeviceRegistryPubsub() {
+    return pubsub;
+}
 
-    auto result_set = devices | std::views::filter([&filterFunction](auto& device) {
-         return filterFunction(device);
-    });
-    if (!result_set.empty()) {
-        return result_set.front();
-    } else {
-        return nullptr;
+std::vector<std::shared_ptr<Device>> findDevices(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
+    auto current_snapshot = snapshot.load();
+    std::vector<std::shared_ptr<Device>> result;
+    for (auto& device : current_snapshot->getDevices()) {
+        if (filterFunction(device)) {
+            result.push_back(device);
+        }
     }
+    return result;
+}
+
+std::shared_ptr<Device> _Nullable findDevice(const std::function<bool(const std::shared_ptr<Device>&)>& filterFunction) {
+    auto current_snapshot = snapshot.load();
+    for (auto& device : current_snapshot->getDevices()) {
+        if (filterFunction(device)) {
+            return device;
+        }
+    }
+    return nullptr;
 }
 
 std::shared_ptr<Device> _Nullable findDevice(std::string name) {
-    return findDevice([&name](auto& device){
-        return device->getName() == name;
-    });
+    return snapshot.load()->findDevice(name);
 }
 
 std::shared_ptr<Device> _Nullable findDevice(Device::Id id) {
-    return findDevice([id](auto& device){
-      return device->getId() == id;
-    });
+    return snapshot.load()->findDevice(id);
 }
 
 std::vector<std::shared_ptr<Device>> findDevices(Device::Type type) {
-    return findDevices([type](auto& device) {
-        return device->getType() == type;
-    });
+    return snapshot.load()->getDevices(type);
 }
 
 std::vector<std::shared_ptr<Device>> getDevices() {
-    return devices;
+    return snapshot.load()->getDevices();
 }
 
 bool hasDevice(Device::Type type) {
-    auto scoped_mutex = mutex.asScopedLock();
-    scoped_mutex.lock();
-    auto result_set = devices | std::views::filter([&type](auto& device) {
-         return device->getType() == type;
-    });
-    return !result_set.empty();
+    return !snapshot.load()->getDevices(type).empty();
 }
 
 }
@@ -8,6 +8,7 @@
 #include "Tactility/hal/uart/UartInit.h"
 
 #include <Tactility/hal/display/DisplayDevice.h>
+#include <Tactility/hal/encoder/EncoderDevice.h>
 #include <Tactility/hal/sdcard/SdCardMounting.h>
 #include <Tactility/hal/touch/TouchDevice.h>
 #include <Tactility/kernel/SystemEvents.h>
@@ -31,6 +32,10 @@ void registerDevices(const Configuration& configuration) {
             if (touch != nullptr) {
                 registerDevice(touch);
             }
+            const std::shared_ptr<Device> encoder = display->getEncoderDevice();
+            if (encoder != nullptr) {
+                registerDevice(encoder);
+            }
         }
     }
 }
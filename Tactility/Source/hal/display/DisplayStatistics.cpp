@@ -0,0 +1,57 @@
+#include "Tactility/hal/display/DisplayStatistics.h"
+
+#include <Tactility/kernel/Kernel.h>
+
+namespace tt::hal::display {
+
+constexpr uint64_t MICROS_PER_SECOND = 1'000'000U;
+
+void DisplayStatistics::onDisplayEvent(lv_event_t* event) {
+    auto* statistics = static_cast<DisplayStatistics*>(lv_event_get_user_data(event));
+    switch (lv_event_get_code(event)) {
+        case LV_EVENT_FLUSH_WAIT_START:
+            statistics->flushWaitStartTime = kernel::getMicros();
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            statistics->flushWaitTime.fetch_add(kernel::getMicros() - statistics->flushWaitStartTime, std::memory_order_relaxed);
+            break;
+        case LV_EVENT_RENDER_READY: {
+            auto frame_count = statistics->frames.fetch_add(1, std::memory_order_relaxed) + 1;
+            auto now = kernel::getMicros();
+            if (now - statistics->secondStartTime >= MICROS_PER_SECOND) {
+                statistics->framesPerSecond.store(frame_count - statistics->secondStartFrames, std::memory_order_relaxed);
+                statistics->secondStartTime = now;
+                statistics->secondStartFrames = frame_count;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void DisplayStatistics::attach(lv_display_t* newDisplay) {
+    detach();
+    reset();
+    display = newDisplay;
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_FLUSH_WAIT_START, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_FLUSH_WAIT_FINISH, this);
+    lv_display_add_event_cb(display, onDisplayEvent, LV_EVENT_RENDER_READY, this);
+}
+
+void DisplayStatistics::detach() {
+    if (display != nullptr) {
+        lv_display_remove_event_cb_with_user_data(display, onDisplayEvent, this);
+        display = nullptr;
+    }
+}
+
+void DisplayStatistics::reset() {
+    frames = 0;
+    framesPerSecond = 0;
+    flushWaitTime = 0;
+    secondStartTime = kernel::getMicros();
+    secondStartFrames = 0;
+}
+
+} // namespace tt::hal::display
@@ -0,0 +1,373 @@
+#include "Tactility/hal/display/PixelConversion.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace tt::hal::display {
+
+/** The widest integer that the CPU handles natively: the 565 kernels convert multiple pixels per operation */
+using Word = std::conditional_t<sizeof(uintptr_t) >= sizeof(uint64_t), uint64_t, uint32_t>;
+
+constexpr uint32_t ROTATION_TILE_SIZE = 16;
+
+// 4x4 ordered dithering thresholds
+constexpr uint8_t BAYER_MATRIX[4][4] = {
+    { 0, 8, 2, 10 },
+    { 12, 4, 14, 6 },
+    { 3, 11, 1, 9 },
+    { 15, 7, 13, 5 }
+};
+
+struct Rgb {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+// region Format properties
+
+constexpr bool is565(ColorFormat format) {
+    return format == ColorFormat::RGB565 ||
+        format == ColorFormat::RGB565Swapped ||
+        format == ColorFormat::BGR565 ||
+        format == ColorFormat::BGR565Swapped;
+}
+
+constexpr bool isSwapped(ColorFormat format) {
+    return format == ColorFormat::RGB565Swapped || format == ColorFormat::BGR565Swapped;
+}
+
+constexpr bool isBgr(ColorFormat format) {
+    return format == ColorFormat::BGR565 || format == ColorFormat::BGR565Swapped;
+}
+
+constexpr size_t getPixelSize(ColorFormat format) {
+    if (is565(format)) {
+        return 2;
+    } else if (format == ColorFormat::RGB888) {
+        return 3;
+    } else {
+        return 0;
+    }
+}
+
+size_t getRowSize(ColorFormat format, uint32_t width) {
+    if (format == ColorFormat::Monochrome) {
+        return (width + 7U) / 8U;
+    } else {
+        return width * getPixelSize(format);
+    }
+}
+
+// endregion
+
+// region 565 operations on multiple pixels
+
+/** @return a word with the 16-bit value in every pixel position */
+template <typename T>
+constexpr T repeat16(uint16_t value) {
+    T result = 0;
+    for (size_t i = 0; i < sizeof(T) / sizeof(uint16_t); i++) {
+        result = static_cast<T>((result << 16) | value);
+    }
+    return result;
+}
+
+template <typename T>
+constexpr T swapBytes565(T pixels) {
+    return static_cast<T>(((pixels & repeat16<T>(0x00FF)) << 8) | ((pixels >> 8) & repeat16<T>(0x00FF)));
+}
+
+template <typename T>
+constexpr T swapRedBlue565(T pixels) {
+    return static_cast<T>(
+        (pixels & repeat16<T>(0x07E0)) |
+        ((pixels >> 11) & repeat16<T>(0x001F)) |
+        ((pixels << 11) & repeat16<T>(0xF800))
+    );
+}
+
+template <ColorFormat Source, ColorFormat Target, typename T>
+constexpr T convert565(T pixels) {
+    if constexpr (isSwapped(Source)) {
+        pixels = swapBytes565(pixels);
+    }
+    if constexpr (isBgr(Source) != isBgr(Target)) {
+        pixels = swapRedBlue565(pixels);
+    }
+    if constexpr (isSwapped(Target)) {
+        pixels = swapBytes565(pixels);
+    }
+    return pixels;
+}
+
+// endregion
+
+// region Single pixel access
+
+template <ColorFormat Format>
+static Rgb readPixel(const uint8_t* data) {
+    if constexpr (Format == ColorFormat::RGB888) {
+        return { data[2], data[1], data[0] };
+    } else {
+        uint16_t value;
+        memcpy(&value, data, sizeof(value));
+        value = convert565<Format, ColorFormat::RGB565>(value);
+        uint8_t red = (value >> 11) & 0x1F;
+        uint8_t green = (value >> 5) & 0x3F;
+        uint8_t blue = value & 0x1F;
+        return {
+            static_cast<uint8_t>((red << 3) | (red >> 2)),
+            static_cast<uint8_t>((green << 2) | (green >> 4)),
+            static_cast<uint8_t>((blue << 3) | (blue >> 2))
+        };
+    }
+}
+
+template <ColorFormat Format>
+static void writePixel(uint8_t* data, Rgb color) {
+    if constexpr (Format == ColorFormat::RGB888) {
+        data[0] = color.blue;
+        data[1] = color.green;
+        data[2] = color.red;
+    } else {
+        auto value = static_cast<uint16_t>(((color.red & 0xF8) << 8) | ((color.green & 0xFC) << 3) | (color.blue >> 3));
+        value = convert565<ColorFormat::RGB565, Format>(value);
+        memcpy(data, &value, sizeof(value));
+    }
+}
+
+// endregion
+
+// region Converters
+
+static void copyPixels(const void* source, void* target, size_t size) {
+    if (source != target) {
+        memmove(target, source, size);
+    }
+}
+
+template <ColorFormat Source, ColorFormat Target>
+static void convert565To565(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    const size_t pixel_count = static_cast<size_t>(width) * height;
+    if constexpr (Source == Target) {
+        copyPixels(source, target, pixel_count * 2);
+    } else {
+        auto* input = static_cast<const uint8_t*>(source);
+        auto* output = static_cast<uint8_t*>(target);
+        constexpr size_t pixels_per_word = sizeof(Word) / sizeof(uint16_t);
+        size_t i = 0;
+        for (; i + pixels_per_word <= pixel_count; i += pixels_per_word) {
+            Word pixels;
+            memcpy(&pixels, input + i * 2, sizeof(Word));
+            pixels = convert565<Source, Target>(pixels);
+            memcpy(output + i * 2, &pixels, sizeof(Word));
+        }
+        for (; i < pixel_count; i++) {
+            uint16_t pixel;
+            memcpy(&pixel, input + i * 2, sizeof(uint16_t));
+            pixel = convert565<Source, Target>(pixel);
+            memcpy(output + i * 2, &pixel, sizeof(uint16_t));
+        }
+    }
+}
+
+template <ColorFormat Target>
+static void convert888To565(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    const size_t pixel_count = static_cast<size_t>(width) * height;
+    auto* input = static_cast<const uint8_t*>(source);
+    auto* output = static_cast<uint8_t*>(target);
+    // The output is smaller than the input, so this also works in-place
+    for (size_t i = 0; i < pixel_count; i++) {
+        writePixel<Target>(output + i * 2, readPixel<ColorFormat::RGB888>(input + i * 3));
+    }
+}
+
+template <ColorFormat Source>
+static void convert565To888(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    const size_t pixel_count = static_cast<size_t>(width) * height;
+    auto* input = static_cast<const uint8_t*>(source);
+    auto* output = static_cast<uint8_t*>(target);
+    for (size_t i = 0; i < pixel_count; i++) {
+        writePixel<ColorFormat::RGB888>(output + i * 3, readPixel<Source>(input + i * 2));
+    }
+}
+
+template <ColorFormat Source>
+static void convertToMonochrome(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    constexpr size_t pixel_size = getPixelSize(Source);
+    auto* input = static_cast<const uint8_t*>(source);
+    auto* output = static_cast<uint8_t*>(target);
+    const size_t row_size = getRowSize(ColorFormat::Monochrome, width);
+    for (uint32_t row = 0; row < height; row++) {
+        const uint8_t* thresholds = BAYER_MATRIX[(y + row) % 4];
+        uint8_t* output_row = output + row * row_size;
+        // A byte is stored after its pixels are read, so this also works in-place
+        uint8_t output_byte = 0;
+        for (uint32_t x = 0; x < width; x++) {
+            auto color = readPixel<Source>(input + (static_cast<size_t>(row) * width + x) * pixel_size);
+            // Luminance, weighted like ITU-R BT.601
+            uint32_t luminance = (color.red * 77U + color.green * 150U + color.blue * 29U) >> 8;
+            if (luminance > thresholds[x % 4] * 16U + 8U) {
+                output_byte |= 0x80U >> (x % 8);
+            }
+            if (x % 8 == 7 || x == width - 1) {
+                output_row[x / 8] = output_byte;
+                output_byte = 0;
+            }
+        }
+    }
+}
+
+template <ColorFormat Target>
+static void convertFromMonochrome(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    constexpr size_t pixel_size = getPixelSize(Target);
+    constexpr Rgb white = { 0xFF, 0xFF, 0xFF };
+    constexpr Rgb black = { 0x00, 0x00, 0x00 };
+    auto* input = static_cast<const uint8_t*>(source);
+    auto* output = static_cast<uint8_t*>(target);
+    const size_t row_size = getRowSize(ColorFormat::Monochrome, width);
+    for (uint32_t row = 0; row < height; row++) {
+        const uint8_t* input_row = input + row * row_size;
+        for (uint32_t x = 0; x < width; x++) {
+            bool lit = (input_row[x / 8] & (0x80U >> (x % 8))) != 0;
+            writePixel<Target>(output + (static_cast<size_t>(row) * width + x) * pixel_size, lit ? white : black);
+        }
+    }
+}
+
+static void copyMonochrome(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    copyPixels(source, target, getRowSize(ColorFormat::Monochrome, width) * height);
+}
+
+static void copy888(const void* source, void* target, uint32_t width, uint32_t height, uint32_t y) {
+    copyPixels(source, target, static_cast<size_t>(width) * height * 3);
+}
+
+template <ColorFormat Source, ColorFormat Target>
+static PixelConverter getConverter() {
+    if constexpr (Source == ColorFormat::Monochrome && Target == ColorFormat::Monochrome) {
+        return copyMonochrome;
+    } else if constexpr (Source == ColorFormat::Monochrome) {
+        return convertFromMonochrome<Target>;
+    } else if constexpr (Target == ColorFormat::Monochrome) {
+        return convertToMonochrome<Source>;
+    } else if constexpr (Source == ColorFormat::RGB888 && Target == ColorFormat::RGB888) {
+        return copy888;
+    } else if constexpr (Source == ColorFormat::RGB888) {
+        return convert888To565<Target>;
+    } else if constexpr (Target == ColorFormat::RGB888) {
+        return convert565To888<Source>;
+    } else {
+        return convert565To565<Source, Target>;
+    }
+}
+
+template <ColorFormat Source>
+static PixelConverter findPixelConverterFrom(ColorFormat targetFormat) {
+    switch (targetFormat) {
+        using enum ColorFormat;
+        case Monochrome:
+            return getConverter<Source, Monochrome>();
+        case BGR565:
+            return getConverter<Source, BGR565>();
+        case BGR565Swapped:
+            return getConverter<Source, BGR565Swapped>();
+        case RGB565:
+            return getConverter<Source, RGB565>();
+        case RGB565Swapped:
+            return getConverter<Source, RGB565Swapped>();
+        case RGB888:
+            return getConverter<Source, RGB888>();
+    }
+    return nullptr;
+}
+
+PixelConverter findPixelConverter(ColorFormat sourceFormat, ColorFormat targetFormat) {
+    switch (sourceFormat) {
+        using enum ColorFormat;
+        case Monochrome:
+            return findPixelConverterFrom<Monochrome>(targetFormat);
+        case BGR565:
+            return findPixelConverterFrom<BGR565>(targetFormat);
+        case BGR565Swapped:
+            return findPixelConverterFrom<BGR565Swapped>(targetFormat);
+        case RGB565:
+            return findPixelConverterFrom<RGB565>(targetFormat);
+        case RGB565Swapped:
+            return findPixelConverterFrom<RGB565Swapped>(targetFormat);
+        case RGB888:
+            return findPixelConverterFrom<RGB888>(targetFormat);
+    }
+    return nullptr;
+}
+
+bool convertPixels(ColorFormat sourceFormat, const void* source, ColorFormat targetFormat, void* target, uint32_t width, uint32_t height) {
+    auto converter = findPixelConverter(sourceFormat, targetFormat);
+    if (converter == nullptr) {
+        return false;
+    }
+    converter(source, target, width, height, 0);
+    return true;
+}
+
+// endregion
+
+// region Rotation
+
+/** Rotates in square tiles, so both the reads and writes stay within a few cache lines */
+template <size_t PixelSize>
+static void rotateTiled(const uint8_t* source, uint8_t* target, uint32_t width, uint32_t height, Rotation rotation) {
+    const uint32_t target_width = (rotation == Rotation::Clockwise180) ? width : height;
+    for (uint32_t tile_y = 0; tile_y < height; tile_y += ROTATION_TILE_SIZE) {
+        const uint32_t tile_y_end = std::min(tile_y + ROTATION_TILE_SIZE, height);
+        for (uint32_t tile_x = 0; tile_x < width; tile_x += ROTATION_TILE_SIZE) {
+            const uint32_t tile_x_end = std::min(tile_x + ROTATION_TILE_SIZE, width);
+            for (uint32_t y = tile_y; y < tile_y_end; y++) {
+                const uint8_t* source_row = source + static_cast<size_t>(y) * width * PixelSize;
+                for (uint32_t x = tile_x; x < tile_x_end; x++) {
+                    uint32_t target_x;
+                    uint32_t target_y;
+                    switch (rotation) {
+                        case Rotation::Clockwise90:
+                            target_x = height - 1 - y;
+                            target_y = x;
+                            break;
+                        case Rotation::Clockwise180:
+                            target_x = width - 1 - x;
+                            target_y = height - 1 - y;
+                            break;
+                        default:
+                            target_x = y;
+                            target_y = width - 1 - x;
+                            break;
+                    }
+                    memcpy(target + (static_cast<size_t>(target_y) * target_width + target_x) * PixelSize, source_row + x * PixelSize, PixelSize);
+                }
+            }
+        }
+    }
+}
+
+bool rotatePixels(ColorFormat format, const void* source, void* target, uint32_t width, uint32_t height, Rotation rotation) {
+    auto pixel_size = getPixelSize(format);
+    if (pixel_size == 0) {
+        return false;
+    }
+
+    auto* input = static_cast<const uint8_t*>(source);
+    auto* output = static_cast<uint8_t*>(target);
+    if (rotation == Rotation::None) {
+        copyPixels(input, output, static_cast<size_t>(width) * height * pixel_size);
+    } else if (pixel_size == 2) {
+        rotateTiled<2>(input, output, width, height, rotation);
+    } else {
+        rotateTiled<3>(input, output, width, height, rotation);
+    }
+    return true;
+}
+
+// endregion
+
+} // namespace tt::hal::display
@@ -0,0 +1,77 @@
+#include "Tactility/hal/gpio/ButtonStateMachine.h"
+
+#include <algorithm>
+
+namespace tt::hal::gpio {
+
+void ButtonStateMachine::reset(bool newLevel) {
+    level = newLevel;
+    pressed = (newLevel == configuration.activeLevel);
+    settling = false;
+    heldEventSent = false;
+    nextRepeatTime = NO_DEADLINE;
+}
+
+void ButtonStateMachine::onEdge(bool newLevel, uint64_t time) {
+    if (!settling) {
+        // The press or release started with the first edge of the bounces
+        firstEdgeTime = time;
+        settling = true;
+    }
+    level = newLevel;
+    lastEdgeTime = time;
+}
+
+uint64_t ButtonStateMachine::update(uint64_t time, const EventCallback& callback) {
+    if (settling && time >= lastEdgeTime + configuration.debounceMicros) {
+        settling = false;
+        const bool new_pressed = (level == configuration.activeLevel);
+        if (new_pressed != pressed) {
+            pressed = new_pressed;
+            if (pressed) {
+                pressTime = firstEdgeTime;
+                heldEventSent = false;
+                nextRepeatTime = (configuration.repeatDelayMicros > 0) ? pressTime + configuration.repeatDelayMicros : NO_DEADLINE;
+                callback(ButtonEvent::Pressed);
+            } else {
+                nextRepeatTime = NO_DEADLINE;
+                callback(ButtonEvent::Released);
+                if (!heldEventSent) {
+                    callback(ButtonEvent::ShortPress);
+                }
+            }
+        }
+    }
+
+    if (pressed) {
+        if (configuration.longPressMicros > 0 && !heldEventSent && time >= pressTime + configuration.longPressMicros) {
+            heldEventSent = true;
+            callback(ButtonEvent::LongPress);
+        }
+
+        if (time >= nextRepeatTime) {
+            heldEventSent = true;
+            callback(ButtonEvent::Repeat);
+            // Skip the repeats that were missed instead of sending them all at once
+            nextRepeatTime = std::max(nextRepeatTime + configuration.repeatIntervalMicros, time + 1);
+        }
+    }
+
+    return getNextDeadline();
+}
+
+uint64_t ButtonStateMachine::getNextDeadline() const {
+    uint64_t deadline = NO_DEADLINE;
+    if (settling) {
+        deadline = lastEdgeTime + configuration.debounceMicros;
+    }
+    if (pressed) {
+        if (configuration.longPressMicros > 0 && !heldEventSent) {
+            deadline = std::min(deadline, pressTime + configuration.longPressMicros);
+        }
+        deadline = std::min(deadline, nextRepeatTime);
+    }
+    return deadline;
+}
+
+} // namespace tt::hal::gpio
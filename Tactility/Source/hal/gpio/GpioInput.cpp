@@ -0,0 +1,121 @@
+#include "Tactility/hal/gpio/GpioInput.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+
+namespace tt::hal::gpio {
+
+constexpr auto* TAG = "GpioInput";
+
+GpioInput::~GpioInput() {
+    stop();
+}
+
+void GpioInput::addButton(Pin pin, const ButtonConfiguration& configuration) {
+    assert(!isStarted());
+    inputs.push_back(std::make_unique<Input>(Input {
+        .owner = this,
+        .index = static_cast<uint32_t>(inputs.size()),
+        .pin = pin,
+        .stateMachine = ButtonStateMachine(configuration)
+    }));
+}
+
+void GpioInput::onEdge(void* context, bool level, uint64_t time) {
+    auto* input = static_cast<Input*>(context);
+    auto* self = input->owner;
+    self->edgeQueue.push({ .input = input->index, .level = level, .time = time });
+    self->wakeup.release();
+}
+
+uint64_t GpioInput::processEdges() {
+    GpioEdge edge;
+    while (edgeQueue.pop(edge)) {
+        edgeCount++;
+        inputs[edge.input]->stateMachine.onEdge(edge.level, edge.time);
+    }
+
+    const auto time = backend->getMicros();
+    uint64_t deadline = ButtonStateMachine::NO_DEADLINE;
+    for (auto& input : inputs) {
+        const auto pin = input->pin;
+        const auto input_deadline = input->stateMachine.update(time, [this, pin](ButtonEvent event) {
+            listener(pin, event);
+        });
+        deadline = std::min(deadline, input_deadline);
+    }
+    return deadline;
+}
+
+void GpioInput::threadMain() {
+    uint64_t deadline = ButtonStateMachine::NO_DEADLINE;
+    while (!interruptThread) {
+        TickType_t timeout = portMAX_DELAY;
+        if (deadline != ButtonStateMachine::NO_DEADLINE) {
+            const auto time = backend->getMicros();
+            // Round up, so the deadline has passed when we wake up
+            timeout = (deadline > time) ? kernel::millisToTicks((deadline - time + 999) / 1000) + 1 : 0;
+        }
+        wakeup.acquire(timeout);
+        wakeupCount++;
+        deadline = processEdges();
+    }
+}
+
+bool GpioInput::start(Listener newListener) {
+    if (isStarted()) {
+        TT_LOG_W(TAG, "Already started");
+        return false;
+    }
+
+    listener = std::move(newListener);
+    interruptThread = false;
+
+    for (auto& input : inputs) {
+        input->stateMachine.reset(backend->getLevel(input->pin));
+    }
+
+    thread = std::make_unique<Thread>("gpio_input", 3072, [this] {
+        threadMain();
+        return 0;
+    });
+    thread->setPriority(Thread::Priority::High);
+    thread->start();
+
+    for (auto& input : inputs) {
+        if (!backend->enableEdgeInterrupt(input->pin, onEdge, input.get())) {
+            TT_LOG_E(TAG, "Failed to enable interrupt for pin %u", input->pin);
+            // Disables the interrupts that were enabled
+            stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void GpioInput::stop() {
+    if (!isStarted()) {
+        return;
+    }
+
+    for (auto& input : inputs) {
+        backend->disableEdgeInterrupt(input->pin);
+    }
+
+    interruptThread = true;
+    wakeup.release();
+    thread->join();
+    thread = nullptr;
+}
+
+GpioInput::Statistics GpioInput::getStatistics() const {
+    return {
+        .edges = edgeCount,
+        .droppedEdges = edgeQueue.getDroppedCount(),
+        .wakeups = wakeupCount
+    };
+}
+
+} // namespace tt::hal::gpio
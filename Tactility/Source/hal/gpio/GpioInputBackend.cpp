@@ -0,0 +1,105 @@
+#include "Tactility/hal/gpio/GpioInputBackend.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/kernel/Kernel.h>
+
+#ifdef ESP_PLATFORM
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#endif
+
+namespace tt::hal::gpio {
+
+constexpr auto* TAG = "GpioInputBackend";
+
+#ifdef ESP_PLATFORM
+
+class EspGpioInputBackend final : public GpioInputBackend {
+
+    struct Handler {
+        gpio_num_t pin;
+        EdgeHandler function;
+        void* context;
+    };
+
+    Handler handlers[GPIO_NUM_MAX] = {};
+    bool serviceInstalled = false;
+
+    static void isr(void* argument) {
+        const auto* handler = static_cast<const Handler*>(argument);
+        handler->function(handler->context, gpio_get_level(handler->pin) == 1, esp_timer_get_time());
+    }
+
+public:
+
+    bool getLevel(Pin pin) override { return gpio_get_level(static_cast<gpio_num_t>(pin)) == 1; }
+
+    uint64_t getMicros() override { return esp_timer_get_time(); }
+
+    bool enableEdgeInterrupt(Pin pin, EdgeHandler function, void* context) override {
+        if (pin >= GPIO_NUM_MAX) {
+            return false;
+        }
+
+        if (!serviceInstalled) {
+            // ESP_ERR_INVALID_STATE means that another driver already installed it
+            const auto result = gpio_install_isr_service(0);
+            if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+                TT_LOG_E(TAG, "Failed to install ISR service: %s", esp_err_to_name(result));
+                return false;
+            }
+            serviceInstalled = true;
+        }
+
+        const auto esp_pin = static_cast<gpio_num_t>(pin);
+        handlers[pin] = { .pin = esp_pin, .function = function, .context = context };
+        if (gpio_set_intr_type(esp_pin, GPIO_INTR_ANYEDGE) != ESP_OK) {
+            return false;
+        }
+        if (gpio_isr_handler_add(esp_pin, isr, &handlers[pin]) != ESP_OK) {
+            return false;
+        }
+        return gpio_intr_enable(esp_pin) == ESP_OK;
+    }
+
+    void disableEdgeInterrupt(Pin pin) override {
+        if (pin < GPIO_NUM_MAX) {
+            const auto esp_pin = static_cast<gpio_num_t>(pin);
+            gpio_intr_disable(esp_pin);
+            gpio_isr_handler_remove(esp_pin);
+        }
+    }
+};
+
+std::shared_ptr<GpioInputBackend> getGpioInputBackend() {
+    static auto backend = std::make_shared<EspGpioInputBackend>();
+    return backend;
+}
+
+#else
+
+/** The simulator has no GPIO interrupts */
+class MockGpioInputBackend final : public GpioInputBackend {
+
+public:
+
+    bool getLevel(Pin pin) override { return gpio::getLevel(pin); }
+
+    uint64_t getMicros() override { return kernel::getMicros(); }
+
+    bool enableEdgeInterrupt(Pin pin, EdgeHandler function, void* context) override {
+        TT_LOG_W(TAG, "Edge interrupts are not supported");
+        return false;
+    }
+
+    void disableEdgeInterrupt(Pin pin) override {}
+};
+
+std::shared_ptr<GpioInputBackend> getGpioInputBackend() {
+    static auto backend = std::make_shared<MockGpioInputBackend>();
+    return backend;
+}
+
+#endif
+
+} // namespace tt::hal::gpio
@@ -1,7 +1,9 @@
 #include "Tactility/hal/gps/GpsDevice.h"
 #include "Tactility/hal/gps/GpsInit.h"
 #include "Tactility/hal/gps/Probe.h"
+#include "Tactility/hal/gps/StreamParser.h"
 #include "Tactility/hal/uart/Uart.h"
+#include <algorithm>
 #include <cstring>
 #include <minmea.h>
 
@@ -50,52 +52,48 @@ int32_t GpsDevice::threadMain() {
 
     setState(State::On);
 
+    // Forwards parsed sentences to the subscribers (a local class can access our private members)
+    class Listener final : public StreamParserListener {
+
+        GpsDevice& device;
+
+    public:
+
+        explicit Listener(GpsDevice& device) : device(device) {}
+
+        void onRmc(const minmea_sentence_rmc& rmc) override { device.publish(device.rmcSubscriptions, rmc); }
+        void onGga(const minmea_sentence_gga& gga) override { device.publish(device.ggaSubscriptions, gga); }
+        void onGsa(const minmea_sentence_gsa& gsa) override { device.publish(device.gsaSubscriptions, gsa); }
+        void onGsv(const minmea_sentence_gsv& gsv) override { device.publish(device.gsvSubscriptions, gsv); }
+        void onVtg(const minmea_sentence_vtg& vtg) override { device.publish(device.vtgSubscriptions, vtg); }
+        void onZda(const minmea_sentence_zda& zda) override { device.publish(device.zdaSubscriptions, zda); }
+    };
+
+    Listener listener(*this);
+    StreamParser parser(listener);
+
     // Reference: https://gpsd.gitlab.io/gpsd/NMEA.html
     while (!isThreadInterrupted()) {
-        size_t bytes_read = uart->readUntil(reinterpret_cast<std::byte*>(buffer), GPS_UART_BUFFER_SIZE, '\n', 100 / portTICK_PERIOD_MS);
+        // Read whatever is buffered, or wait for at least 1 byte
+        size_t request_size = std::clamp<size_t>(uart->available(0), 1, GPS_UART_BUFFER_SIZE);
+        size_t bytes_read = uart->readBytes(buffer, request_size, 100 / portTICK_PERIOD_MS);
 
         // Thread might've been interrupted in the meanwhile
         if (isThreadInterrupted()) {
             break;
         }
 
-        if (bytes_read > 0U) {
-
-            TT_LOG_I(TAG, "[%ul] %s", bytes_read, buffer);
-
-            switch (minmea_sentence_id((char*)buffer, false)) {
-                case MINMEA_SENTENCE_RMC:
-                    minmea_sentence_rmc rmc_frame;
-                    if (minmea_parse_rmc(&rmc_frame, (char*)buffer)) {
-                        mutex.lock();
-                        for (auto& subscription : rmcSubscriptions) {
-                            (*subscription.onData)(getId(), rmc_frame);
-                        }
-                        mutex.unlock();
-                        TT_LOG_D(TAG, "RMC %f lat, %f lon, %f m/s", minmea_tocoord(&rmc_frame.latitude), minmea_tocoord(&rmc_frame.longitude), minmea_tofloat(&rmc_frame.speed));
-                    } else {
-                        TT_LOG_W(TAG, "RMC parse error: %s", buffer);
-                    }
-                    break;
-                case MINMEA_SENTENCE_GGA:
-                    minmea_sentence_gga gga_frame;
-                    if (minmea_parse_gga(&gga_frame, (char*)buffer)) {
-                        mutex.lock();
-                        for (auto& subscription : ggaSubscriptions) {
-                            (*subscription.onData)(getId(), gga_frame);
-                        }
-                        mutex.unlock();
-                        TT_LOG_D(TAG, "GGA %f lat, %f lon", minmea_tocoord(&gga_frame.latitude), minmea_tocoord(&gga_frame.longitude));
-                    } else {
-                        TT_LOG_W(TAG, "GGA parse error: %s", buffer);
-                    }
-                    break;
-                default:
-                    break;
-            }
-        }
+        parser.feed(buffer, bytes_read);
     }
 
+    auto statistics = parser.getStatistics();
+    TT_LOG_I(TAG, "Parsed %lu NMEA sentences and %lu UBX frames (%lu checksum errors, %lu overflows)",
+        statistics.nmeaSentences,
+        statistics.ubxFrames,
+        statistics.checksumErrors,
+        statistics.overflows
+    );
+
     if (uart->isStarted() && !uart->stop()) {
         TT_LOG_W(TAG, "Failed to stop UART %s", configuration.uartName);
     }
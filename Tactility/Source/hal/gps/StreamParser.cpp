@@ -0,0 +1,221 @@
+#include "Tactility/hal/gps/StreamParser.h"
+
+namespace tt::hal::gps {
+
+constexpr uint8_t UBX_SYNC_1 = 0xB5U;
+constexpr uint8_t UBX_SYNC_2 = 0x62U;
+
+static int hexToInt(uint8_t character) {
+    if (character >= '0' && character <= '9') {
+        return character - '0';
+    } else if (character >= 'A' && character <= 'F') {
+        return character - 'A' + 10;
+    } else if (character >= 'a' && character <= 'f') {
+        return character - 'a' + 10;
+    } else {
+        return -1;
+    }
+}
+
+void StreamParser::startFrame(uint8_t byte) {
+    if (byte == '$') {
+        nmeaBuffer[0] = '$';
+        nmeaLength = 1;
+        nmeaChecksum = 0;
+        state = State::NmeaBody;
+    } else if (byte == UBX_SYNC_1) {
+        state = State::UbxSync;
+    } else {
+        state = State::Idle;
+    }
+}
+
+void StreamParser::appendNmea(char character) {
+    // Keep room for the null terminator
+    if (nmeaLength < MINMEA_MAX_SENTENCE_LENGTH) {
+        nmeaBuffer[nmeaLength++] = character;
+    } else {
+        statistics.overflows++;
+        state = State::Idle;
+    }
+}
+
+void StreamParser::feed(uint8_t byte) {
+    switch (state) {
+        case State::Idle:
+            startFrame(byte);
+            break;
+        case State::NmeaBody:
+            if (byte == '*') {
+                appendNmea('*');
+                if (state != State::Idle) {
+                    state = State::NmeaChecksumHigh;
+                }
+            } else if (byte == '\r' || byte == '\n') {
+                // Sentence without checksum
+                onNmeaComplete();
+                state = State::Idle;
+            } else if (byte == '$' || byte == UBX_SYNC_1 || byte < 0x20U || byte > 0x7EU) {
+                // Garbage or the start of a new frame: the current sentence is incomplete
+                startFrame(byte);
+            } else {
+                nmeaChecksum ^= byte;
+                appendNmea(static_cast<char>(byte));
+            }
+            break;
+        case State::NmeaChecksumHigh: {
+            int value = hexToInt(byte);
+            if (value >= 0) {
+                nmeaExpectedChecksum = static_cast<uint8_t>(value << 4);
+                appendNmea(static_cast<char>(byte));
+                if (state != State::Idle) {
+                    state = State::NmeaChecksumLow;
+                }
+            } else {
+                startFrame(byte);
+            }
+            break;
+        }
+        case State::NmeaChecksumLow: {
+            int value = hexToInt(byte);
+            if (value >= 0) {
+                nmeaExpectedChecksum |= static_cast<uint8_t>(value);
+                appendNmea(static_cast<char>(byte));
+                if (state != State::Idle) {
+                    if (nmeaExpectedChecksum == nmeaChecksum) {
+                        onNmeaComplete();
+                    } else {
+                        statistics.checksumErrors++;
+                    }
+                    state = State::Idle;
+                }
+            } else {
+                startFrame(byte);
+            }
+            break;
+        }
+        case State::UbxSync:
+            if (byte == UBX_SYNC_2) {
+                ubxChecksumA = 0;
+                ubxChecksumB = 0;
+                state = State::UbxClass;
+            } else {
+                startFrame(byte);
+            }
+            break;
+        case State::UbxClass:
+            ubxClass = byte;
+            addUbxChecksum(byte);
+            state = State::UbxId;
+            break;
+        case State::UbxId:
+            ubxId = byte;
+            addUbxChecksum(byte);
+            state = State::UbxLengthLow;
+            break;
+        case State::UbxLengthLow:
+            ubxLength = byte;
+            addUbxChecksum(byte);
+            state = State::UbxLengthHigh;
+            break;
+        case State::UbxLengthHigh:
+            ubxLength |= static_cast<uint16_t>(byte << 8);
+            addUbxChecksum(byte);
+            ubxOffset = 0;
+            if (ubxLength > UBX_MAX_PAYLOAD_SIZE) {
+                statistics.overflows++;
+                state = State::Idle;
+            } else if (ubxLength == 0) {
+                state = State::UbxChecksumA;
+            } else {
+                state = State::UbxPayload;
+            }
+            break;
+        case State::UbxPayload:
+            ubxPayload[ubxOffset++] = byte;
+            addUbxChecksum(byte);
+            if (ubxOffset == ubxLength) {
+                state = State::UbxChecksumA;
+            }
+            break;
+        case State::UbxChecksumA:
+            if (byte == ubxChecksumA) {
+                state = State::UbxChecksumB;
+            } else {
+                statistics.checksumErrors++;
+                startFrame(byte);
+            }
+            break;
+        case State::UbxChecksumB:
+            if (byte == ubxChecksumB) {
+                onUbxComplete();
+                state = State::Idle;
+            } else {
+                statistics.checksumErrors++;
+                startFrame(byte);
+            }
+            break;
+    }
+}
+
+void StreamParser::onNmeaComplete() {
+    nmeaBuffer[nmeaLength] = '\0';
+    statistics.nmeaSentences++;
+
+    listener.onNmeaSentence(std::string_view(nmeaBuffer, nmeaLength));
+
+    // The checksum was validated already, so we don't use strict mode
+    switch (minmea_sentence_id(nmeaBuffer, false)) {
+        case MINMEA_SENTENCE_RMC: {
+            minmea_sentence_rmc frame;
+            if (minmea_parse_rmc(&frame, nmeaBuffer)) {
+                listener.onRmc(frame);
+            }
+            break;
+        }
+        case MINMEA_SENTENCE_GGA: {
+            minmea_sentence_gga frame;
+            if (minmea_parse_gga(&frame, nmeaBuffer)) {
+                listener.onGga(frame);
+            }
+            break;
+        }
+        case MINMEA_SENTENCE_GSA: {
+            minmea_sentence_gsa frame;
+            if (minmea_parse_gsa(&frame, nmeaBuffer)) {
+                listener.onGsa(frame);
+            }
+            break;
+        }
+        case MINMEA_SENTENCE_GSV: {
+            minmea_sentence_gsv frame;
+            if (minmea_parse_gsv(&frame, nmeaBuffer)) {
+                listener.onGsv(frame);
+            }
+            break;
+        }
+        case MINMEA_SENTENCE_VTG: {
+            minmea_sentence_vtg frame;
+            if (minmea_parse_vtg(&frame, nmeaBuffer)) {
+                listener.onVtg(frame);
+            }
+            break;
+        }
+        case MINMEA_SENTENCE_ZDA: {
+            minmea_sentence_zda frame;
+            if (minmea_parse_zda(&frame, nmeaBuffer)) {
+                listener.onZda(frame);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void StreamParser::onUbxComplete() {
+    statistics.ubxFrames++;
+    listener.onUbxFrame(ubxClass, ubxId, ubxPayload, ubxLength);
+}
+
+} // namespace tt::hal::gps
@@ -1,6 +1,8 @@
 #include "Tactility/hal/gps/Ublox.h"
+#include "Tactility/hal/gps/StreamParser.h"
 #include "Tactility/hal/gps/UbloxMessages.h"
 #include "Tactility/hal/uart/Uart.h"
+#include <algorithm>
 #include <cstring>
 
 #define TAG "ublox"
@@ -53,143 +55,98 @@ uint8_t makePacket(uint8_t classId, uint8_t messageId, const uint8_t* payload, u
     return (payloadSize + 8U);
 }
 
-GpsResponse getAck(uart::Uart& uart, uint8_t class_id, uint8_t msg_id, uint32_t waitMillis) {
-    uint8_t b;
-    uint8_t ack = 0;
-    const uint8_t ackP[2] = {class_id, msg_id};
-    uint8_t buf[10] = {0xB5, 0x62, 0x05, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
-    uint32_t startTime = kernel::getMillis();
-    const char frame_errors[] = "More than 100 frame errors";
-    int sCounter = 0;
-#ifdef GPS_DEBUG
-    std::string debugmsg = "";
-#endif
-
-    for (int j = 2; j < 6; j++) {
-        buf[8] += buf[j];
-        buf[9] += buf[8];
+/** Feeds UART data to the parser until the listener is done or the timeout passes */
+static void parseUntil(uart::Uart& uart, StreamParser& parser, TickType_t timeout, const std::function<bool()>& isDone) {
+    uint8_t buffer[64];
+    auto start_time = kernel::getTicks();
+    while (!isDone() && (kernel::getTicks() - start_time) < timeout) {
+        size_t request_size = std::clamp<size_t>(uart.available(0), 1, sizeof(buffer));
+        size_t bytes_read = uart.readBytes(buffer, request_size, 10 / portTICK_PERIOD_MS);
+        for (size_t i = 0; i < bytes_read && !isDone(); ++i) {
+            parser.feed(buffer[i]);
+        }
     }
+}
 
-    for (int j = 0; j < 2; j++) {
-        buf[6 + j] = ackP[j];
-        buf[8] += buf[6 + j];
-        buf[9] += buf[8];
-    }
+/** Waits for UBX-ACK-ACK or UBX-ACK-NAK for the specified message */
+class AckListener final : public StreamParserListener {
 
-    while (kernel::getTicks() - startTime < waitMillis) {
-        if (ack > 9) {
-#ifdef GPS_DEBUG
-            TT_LOG_I(TAG, "Got ACK for class %02X message %02X in %lums", class_id, msg_id, kernel::getMillis() - startTime);
-#endif
-            return GpsResponse::Ok; // ACK received
+    uint8_t requestedClass;
+    uint8_t requestedId;
+
+public:
+
+    GpsResponse response = GpsResponse::None;
+
+    AckListener(uint8_t requestedClass, uint8_t requestedId) : requestedClass(requestedClass), requestedId(requestedId) {}
+
+    void onUbxFrame(uint8_t classId, uint8_t messageId, const uint8_t* payload, uint16_t payloadLength) override {
+        if (classId == 0x05 && payloadLength >= 2 && payload[0] == requestedClass && payload[1] == requestedId) {
+            response = (messageId == 0x01) ? GpsResponse::Ok : GpsResponse::NotAck;
         }
-        if (uart.available()) {
-            uart.readByte(&b);
-            if (b == frame_errors[sCounter]) {
-                sCounter++;
-                if (sCounter == 26) {
-#ifdef GPS_DEBUG
+    }
 
-                    TT_LOG_I(TAG, "%s", debugmsg.c_str());
-#endif
-                    return GpsResponse::FrameErrors;
-                }
-            } else {
-                sCounter = 0;
-            }
-#ifdef GPS_DEBUG
-            debugmsg += std::format("%02X", b);
-#endif
-            if (b == buf[ack]) {
-                ack++;
-            } else {
-                if (ack == 3 && b == 0x00) { // UBX-ACK-NAK message
-#ifdef GPS_DEBUG
-                    TT_LOG_I(TAG, "%s", debugmsg.c_str());
-#endif
-                    TT_LOG_W(TAG, "Got NAK for class %02X message %02X", class_id, msg_id);
-                    return GpsResponse::NotAck; // NAK received
-                }
-                ack = 0; // Reset the acknowledgement counter
-            }
+    void onNmeaSentence(std::string_view sentence) override {
+        if (sentence.find("More than 100 frame errors") != std::string_view::npos) {
+            response = GpsResponse::FrameErrors;
         }
     }
+};
+
+GpsResponse getAck(uart::Uart& uart, uint8_t class_id, uint8_t msg_id, uint32_t waitMillis) {
+    AckListener listener(class_id, msg_id);
+    StreamParser parser(listener);
+    parseUntil(uart, parser, kernel::millisToTicks(waitMillis), [&listener] {
+        return listener.response != GpsResponse::None;
+    });
+
+    if (listener.response == GpsResponse::NotAck) {
+        TT_LOG_W(TAG, "Got NAK for class %02X message %02X", class_id, msg_id);
+    }
 #ifdef GPS_DEBUG
-    TT_LOG_I(TAG, "%s", debugmsg.c_str());
-    TT_LOG_W(TAG, "No response for class %02X message %02X", class_id, msg_id);
+    else if (listener.response == GpsResponse::None) {
+        TT_LOG_W(TAG, "No response for class %02X message %02X", class_id, msg_id);
+    }
 #endif
-    return GpsResponse::None; // No response received within timeout
+
+    return listener.response;
 }
 
-static int getAck(uart::Uart& uart, uint8_t* buffer, uint16_t size, uint8_t requestedClass, uint8_t requestedId, TickType_t timeout) {
-    uint16_t ubxFrameCounter = 0;
-    uint32_t startTime = kernel::getTicks();
-    uint16_t needRead = 0;
-
-    while (kernel::getTicks() - startTime < timeout) {
-        while (uart.available()) {
-            uint8_t c;
-            uart.readByte(&c);
-
-            switch (ubxFrameCounter) {
-                case 0:
-                    if (c == 0xB5) {
-                        ubxFrameCounter++;
-                    }
-                    break;
-                case 1:
-                    if (c == 0x62) {
-                        ubxFrameCounter++;
-                    } else {
-                        ubxFrameCounter = 0;
-                    }
-                    break;
-                case 2:
-                    if (c == requestedClass) {
-                        ubxFrameCounter++;
-                    } else {
-                        ubxFrameCounter = 0;
-                    }
-                    break;
-                case 3:
-                    if (c == requestedId) {
-                        ubxFrameCounter++;
-                    } else {
-                        ubxFrameCounter = 0;
-                    }
-                    break;
-                case 4:
-                    needRead = c;
-                    ubxFrameCounter++;
-                    break;
-                case 5: {
-                    // Payload length msb
-                    needRead |= (c << 8);
-                    ubxFrameCounter++;
-                    // Check for buffer overflow
-                    if (needRead >= size) {
-                        ubxFrameCounter = 0;
-                        break;
-                    }
-                    auto read_bytes = uart.readBytes(buffer, needRead, 250 / portTICK_PERIOD_MS);
-                    if (read_bytes != needRead) {
-                        ubxFrameCounter = 0;
-                    } else {
-                        // return payload length
-#ifdef GPS_DEBUG
-                        TT_LOG_I(TAG, "Got ACK for class %02X message %02X in %lums", requestedClass, requestedId, kernel::getMillis() - startTime);
-#endif
-                        return needRead;
-                    }
-                    break;
-                }
+/** Copies the payload of the first UBX frame with the requested class and id */
+class PayloadListener final : public StreamParserListener {
 
-                default:
-                    break;
-            }
+    uint8_t* buffer;
+    uint16_t size;
+    uint8_t requestedClass;
+    uint8_t requestedId;
+
+public:
+
+    int payloadLength = 0;
+
+    PayloadListener(uint8_t* buffer, uint16_t size, uint8_t requestedClass, uint8_t requestedId) :
+        buffer(buffer),
+        size(size),
+        requestedClass(requestedClass),
+        requestedId(requestedId)
+    {}
+
+    void onUbxFrame(uint8_t classId, uint8_t messageId, const uint8_t* payload, uint16_t length) override {
+        // Payloads that don't fit are ignored, like frames of other messages
+        if (payloadLength == 0 && classId == requestedClass && messageId == requestedId && length > 0 && length < size) {
+            memcpy(buffer, payload, length);
+            payloadLength = length;
         }
     }
-    return 0;
+};
+
+static int getAck(uart::Uart& uart, uint8_t* buffer, uint16_t size, uint8_t requestedClass, uint8_t requestedId, TickType_t timeout) {
+    PayloadListener listener(buffer, size, requestedClass, requestedId);
+    StreamParser parser(listener);
+    parseUntil(uart, parser, timeout, [&listener] {
+        return listener.payloadLength > 0;
+    });
+    return listener.payloadLength;
 }
 
 #define DETECTED_MESSAGE "%s detected, using %s Module"
@@ -12,7 +12,8 @@
 namespace tt::hal::i2c {
 
 struct Data {
-    Mutex mutex;
+    // Recursive, so a transaction can hold the lock while it calls the functions below
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
     bool isConfigured = false;
     bool isStarted = false;
     Configuration configuration;
@@ -235,6 +236,14 @@ bool masterWriteRegister(i2c_port_t port, uint8_t address, uint8_t reg, const ui
 bool masterWriteRegisterArray(i2c_port_t port, uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
 #ifdef ESP_PLATFORM
     assert(dataSize % 2 == 0);
+
+    // Hold the lock for all writes, so other devices can't interleave
+    auto lock = getLock(port).asScopedLock();
+    if (!lock.lock(timeout)) {
+        TT_LOG_E(TAG, "(%d) Mutex timeout", port);
+        return false;
+    }
+
     bool result = true;
     for (int i = 0; i < dataSize; i += 2) {
         // TODO: We're passing an inaccurate timeout value as we already lost time with locking and previous writes in this loop
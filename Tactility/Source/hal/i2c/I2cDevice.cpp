@@ -1,6 +1,8 @@
 #include "Tactility/hal/i2c/I2cDevice.h"
 
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 
 namespace tt::hal::i2c {
 
@@ -78,4 +80,38 @@ bool I2cDevice::bitOff(uint8_t reg, uint8_t bitmask) const {
     }
 }
 
+bool I2cDevice::readRegisters(uint8_t reg, uint8_t* data, size_t dataSize, TickType_t timeout) const {
+    std::vector<uint8_t> read_data;
+    if (execute(createTransaction(timeout).readRegisters(reg, dataSize), read_data)) {
+        memcpy(data, read_data.data(), dataSize);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool I2cDevice::writeRegisterArray(const uint8_t* data, uint16_t dataSize, TickType_t timeout) const {
+    assert(dataSize % 2 == 0);
+    auto transaction = createTransaction(timeout);
+    for (int i = 0; i < dataSize; i += 2) {
+        transaction.writeRegister8(data[i], data[i + 1]);
+    }
+    std::vector<uint8_t> read_data;
+    return execute(transaction, read_data);
+}
+
+bool I2cDevice::execute(const I2cTransaction& transaction, std::vector<uint8_t>& readData) const {
+    return getQueue(port)->execute(transaction, readData);
+}
+
+bool I2cDevice::submit(I2cTransaction transaction, I2cQueue::Callback callback) const {
+    return getQueue(port)->submit(std::move(transaction), queuePriority, std::move(callback));
+}
+
+I2cQueue::DeviceStatistics I2cDevice::getBusStatistics() const {
+    auto statistics = getQueue(port)->getStatistics();
+    auto device_statistics = statistics.find(address);
+    return (device_statistics != statistics.end()) ? device_statistics->second : I2cQueue::DeviceStatistics();
+}
+
 } // namespace tt::hal::i2c
@@ -0,0 +1,113 @@
+#include "Tactility/hal/i2c/I2cMockBackend.h"
+
+namespace tt::hal::i2c {
+
+/** 8 data bits and an acknowledge bit */
+constexpr uint32_t BITS_PER_BYTE = 9;
+
+void I2cMockBackend::addDevice(uint8_t address) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    devices[address] = {};
+}
+
+void I2cMockBackend::setRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    devices[address].registers[reg] = value;
+}
+
+uint8_t I2cMockBackend::getRegister(uint8_t address, uint8_t reg) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return devices[address].registers[reg];
+}
+
+std::vector<uint8_t> I2cMockBackend::getTransferLog() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return transferLog;
+}
+
+I2cMockBackend::Statistics I2cMockBackend::getStatistics() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+void I2cMockBackend::resetStatistics() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    statistics = {};
+    transferLog.clear();
+}
+
+I2cMockBackend::MockDevice* I2cMockBackend::startTransfer(uint8_t address, size_t byteCount, bool repeatedStart) {
+    // Address byte, data bytes, start and stop condition, and the repeated start with its address byte
+    uint32_t bytes = 1 + byteCount + (repeatedStart ? 1 : 0);
+    uint32_t bits = bytes * BITS_PER_BYTE + 2 + (repeatedStart ? 1 : 0);
+    statistics.transfers++;
+    statistics.bytes += bytes;
+    statistics.busTimeMicros += transferOverheadMicros + (static_cast<uint64_t>(bits) * 1000000U) / frequency;
+    transferLog.push_back(address);
+
+    auto device = devices.find(address);
+    // A missing device doesn't acknowledge its address
+    return (device != devices.end()) ? &device->second : nullptr;
+}
+
+bool I2cMockBackend::read(uint8_t address, uint8_t* data, size_t dataSize, TickType_t timeout) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto* device = startTransfer(address, dataSize, false);
+    if (device == nullptr) {
+        return false;
+    }
+
+    for (size_t i = 0; i < dataSize; i++) {
+        data[i] = device->registers[device->registerAddress++];
+    }
+    return true;
+}
+
+bool I2cMockBackend::write(uint8_t address, const uint8_t* data, uint16_t dataSize, TickType_t timeout) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto* device = startTransfer(address, dataSize, false);
+    if (device == nullptr) {
+        return false;
+    }
+
+    if (dataSize > 0) {
+        device->registerAddress = data[0];
+        for (size_t i = 1; i < dataSize; i++) {
+            device->registers[device->registerAddress++] = data[i];
+        }
+    }
+    return true;
+}
+
+bool I2cMockBackend::writeRead(uint8_t address, const uint8_t* writeData, size_t writeDataSize, uint8_t* readData, size_t readDataSize, TickType_t timeout) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto* device = startTransfer(address, writeDataSize + readDataSize, true);
+    if (device == nullptr) {
+        return false;
+    }
+
+    if (writeDataSize > 0) {
+        device->registerAddress = writeData[0];
+        for (size_t i = 1; i < writeDataSize; i++) {
+            device->registers[device->registerAddress++] = writeData[i];
+        }
+    }
+    for (size_t i = 0; i < readDataSize; i++) {
+        readData[i] = device->registers[device->registerAddress++];
+    }
+    return true;
+}
+
+} // namespace tt::hal::i2c
@@ -0,0 +1,204 @@
+#include "Tactility/hal/i2c/I2cQueue.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/kernel/Kernel.h>
+
+namespace tt::hal::i2c {
+
+constexpr auto* TAG = "I2cQueue";
+
+I2cTransaction& I2cTransaction::read(size_t size) {
+    transfers.push_back({ .type = TransferType::Read, .writeData = {}, .readSize = size });
+    readSize += size;
+    return *this;
+}
+
+I2cTransaction& I2cTransaction::write(std::vector<uint8_t> data) {
+    transfers.push_back({ .type = TransferType::Write, .writeData = std::move(data), .readSize = 0 });
+    return *this;
+}
+
+I2cTransaction& I2cTransaction::writeRead(std::vector<uint8_t> data, size_t size) {
+    transfers.push_back({ .type = TransferType::WriteRead, .writeData = std::move(data), .readSize = size });
+    readSize += size;
+    return *this;
+}
+
+I2cTransaction& I2cTransaction::writeRegisters(uint8_t reg, const uint8_t* data, size_t dataSize) {
+    std::vector<uint8_t> write_data;
+    write_data.reserve(dataSize + 1);
+    write_data.push_back(reg);
+    write_data.insert(write_data.end(), data, data + dataSize);
+    return write(std::move(write_data));
+}
+
+void I2cQueue::start() {
+    if (thread != nullptr) {
+        return;
+    }
+
+    eventFlag.clear(FlagStop);
+    thread = std::make_unique<Thread>(
+        "i2c_queue",
+        3072,
+        [this]() {
+            return this->threadMain();
+        }
+    );
+    // Input devices are on the bus, so transactions shouldn't wait for regular work
+    thread->setPriority(Thread::Priority::High);
+    thread->start();
+}
+
+void I2cQueue::stop() {
+    if (thread != nullptr) {
+        eventFlag.set(FlagStop);
+        thread->join();
+        thread = nullptr;
+    }
+}
+
+bool I2cQueue::submit(I2cTransaction transaction, Priority priority, Callback callback) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (pendingCount >= maxPendingCount) {
+        TT_LOG_W(TAG, "Queue full, dropped transaction for 0x%02X", transaction.getAddress());
+        return false;
+    }
+
+    pending[static_cast<size_t>(priority)].push_back({
+        .transaction = std::move(transaction),
+        .callback = std::move(callback),
+        .submitTime = kernel::getMicros()
+    });
+    pendingCount++;
+    lock.unlock();
+
+    eventFlag.set(FlagRequest);
+    return true;
+}
+
+bool I2cQueue::execute(const I2cTransaction& transaction, std::vector<uint8_t>& readData) {
+    return run(transaction, readData, kernel::getMicros());
+}
+
+std::optional<I2cQueue::Request> I2cQueue::takeNext() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    // Highest priority first
+    for (auto queue = pending.rbegin(); queue != pending.rend(); ++queue) {
+        if (!queue->empty()) {
+            auto request = std::move(queue->front());
+            queue->pop_front();
+            pendingCount--;
+            return request;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool I2cQueue::run(const I2cTransaction& transaction, std::vector<uint8_t>& readData, uint64_t submitTime) {
+    readData.resize(transaction.getReadSize());
+
+    bool success = backend->lock(transaction.getTimeout());
+    const auto start_time = kernel::getMicros();
+    if (success) {
+        const auto address = transaction.getAddress();
+        const auto timeout = transaction.getTimeout();
+        auto* read_position = readData.data();
+        for (const auto& transfer : transaction.getTransfers()) {
+            switch (transfer.type) {
+                case I2cTransaction::TransferType::Read:
+                    success = backend->read(address, read_position, transfer.readSize, timeout);
+                    break;
+                case I2cTransaction::TransferType::Write:
+                    success = backend->write(address, transfer.writeData.data(), transfer.writeData.size(), timeout);
+                    break;
+                case I2cTransaction::TransferType::WriteRead:
+                    success = backend->writeRead(address, transfer.writeData.data(), transfer.writeData.size(), read_position, transfer.readSize, timeout);
+                    break;
+            }
+            if (!success) {
+                break;
+            }
+            read_position += transfer.readSize;
+        }
+        backend->unlock();
+    } else {
+        TT_LOG_E(TAG, "Bus timeout for 0x%02X", transaction.getAddress());
+    }
+    const auto end_time = kernel::getMicros();
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    auto& device_statistics = statistics[transaction.getAddress()];
+    device_statistics.transactions++;
+    device_statistics.busTimeMicros += end_time - start_time;
+    device_statistics.waitTimeMicros += start_time - submitTime;
+    if (!success) {
+        device_statistics.failures++;
+    }
+
+    return success;
+}
+
+size_t I2cQueue::processPending() {
+    size_t count = 0;
+    std::vector<uint8_t> read_data;
+    while (auto request = takeNext()) {
+        bool success = run(request->transaction, read_data, request->submitTime);
+        if (request->callback != nullptr) {
+            request->callback(success, read_data);
+        }
+        count++;
+    }
+    return count;
+}
+
+int32_t I2cQueue::threadMain() {
+    bool stopping = false;
+    while (!stopping) {
+        auto flags = eventFlag.wait(FlagRequest | FlagStop);
+        stopping = (flags & EventFlag::Error) == 0 && (flags & FlagStop) != 0;
+        processPending();
+    }
+    return 0;
+}
+
+size_t I2cQueue::getPendingCount() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return pendingCount;
+}
+
+std::map<uint8_t, I2cQueue::DeviceStatistics> I2cQueue::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+void I2cQueue::resetStatistics() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    statistics.clear();
+}
+
+std::shared_ptr<I2cQueue> getQueue(i2c_port_t port) {
+    static Mutex mutex;
+    static std::array<std::shared_ptr<I2cQueue>, I2C_NUM_MAX> queues;
+
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto& queue = queues[port];
+    if (queue == nullptr) {
+        queue = std::make_shared<I2cQueue>(std::make_shared<I2cPortBackend>(port));
+        queue->start();
+    }
+    return queue;
+}
+
+} // namespace tt::hal::i2c
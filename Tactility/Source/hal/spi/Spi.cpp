@@ -8,6 +8,7 @@ constexpr auto* TAG = "SPI";
 
 struct Data {
     std::shared_ptr<Lock> lock;
+    std::shared_ptr<SpiArbiter> arbiter;
     bool isConfigured = false;
     bool isStarted = false;
     Configuration configuration;
@@ -26,6 +27,7 @@ bool init(const std::vector<Configuration>& configurations) {
         } else {
             data.lock = std::make_shared<Mutex>(Mutex::Type::Recursive);
         }
+        data.arbiter = std::make_shared<SpiArbiter>(data.lock);
     }
 
     for (const auto& config: configurations) {
@@ -142,4 +144,16 @@ std::shared_ptr<Lock> getLock(spi_host_device_t device) {
     return dataArray[device].lock;
 }
 
+std::shared_ptr<Lock> getLock(spi_host_device_t device, const std::string& clientName, BusPriority priority) {
+    auto arbiter = getArbiter(device);
+    if (arbiter == nullptr) {
+        return getLock(device);
+    }
+    return arbiter->createClient(clientName, priority);
+}
+
+std::shared_ptr<SpiArbiter> _Nullable getArbiter(spi_host_device_t device) {
+    return dataArray[device].arbiter;
+}
+
 }
@@ -0,0 +1,151 @@
+#include "Tactility/hal/spi/SpiArbiter.h"
+
+#include <Tactility/RtosCompatTask.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+
+namespace tt::hal::spi {
+
+static uint32_t getTime() {
+    return static_cast<uint32_t>(kernel::getMicros());
+}
+
+std::shared_ptr<SpiArbiter::Client> SpiArbiter::createClient(const std::string& name, BusPriority priority) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    statistics.push_back({ .name = name, .priority = priority });
+    return std::make_shared<Client>(shared_from_this(), statistics.size() - 1, priority);
+}
+
+bool SpiArbiter::acquire(const Client& client, TickType_t timeout) {
+    const auto thread = xTaskGetCurrentTaskHandle();
+
+    mutex.lock();
+    if (holdDepth > 0 && holderThread == thread) {
+        // The bus lock is recursive
+        if (busLock->lock(timeout)) {
+            holdDepth++;
+            mutex.unlock();
+            return true;
+        }
+        mutex.unlock();
+        return false;
+    }
+    arbitration.addWaiter(client.priority);
+    mutex.unlock();
+
+    const auto start_ticks = kernel::getTicks();
+    const auto start_time = getTime();
+    bool acquired = false;
+    while (true) {
+        mutex.lock();
+        const bool may_acquire = !arbitration.hasWaiterAbove(client.priority);
+        mutex.unlock();
+
+        const auto elapsed_ticks = kernel::getTicks() - start_ticks;
+        const auto remaining_ticks = (elapsed_ticks < timeout) ? timeout - elapsed_ticks : 0;
+
+        if (may_acquire) {
+            // Wait briefly, so a client with a higher priority that starts waiting gets the bus first
+            if (busLock->lock(std::min<TickType_t>(remaining_ticks, 1))) {
+                mutex.lock();
+                if (arbitration.canAcquire(client.priority)) {
+                    arbitration.removeWaiter(client.priority);
+                    arbitration.onAcquired(client.priority, getTime());
+                    holderThread = thread;
+                    holdDepth = 1;
+                    acquired = true;
+                }
+                mutex.unlock();
+
+                if (acquired) {
+                    break;
+                }
+                busLock->unlock();
+            }
+        } else if (remaining_ticks > 0) {
+            kernel::delayTicks(1);
+        }
+
+        if (remaining_ticks == 0) {
+            break;
+        }
+    }
+
+    const auto wait_time = getTime() - start_time;
+    mutex.lock();
+    auto& client_statistics = statistics[client.index];
+    if (acquired) {
+        client_statistics.acquisitions++;
+        client_statistics.totalWaitMicros += wait_time;
+        client_statistics.maxWaitMicros = std::max(client_statistics.maxWaitMicros, wait_time);
+    } else {
+        arbitration.removeWaiter(client.priority);
+        client_statistics.timeouts++;
+    }
+    mutex.unlock();
+
+    return acquired;
+}
+
+bool SpiArbiter::release(const Client& client) {
+    mutex.lock();
+    if (holdDepth == 0 || holderThread != xTaskGetCurrentTaskHandle()) {
+        mutex.unlock();
+        return false;
+    }
+
+    holdDepth--;
+    if (holdDepth == 0) {
+        const auto hold_time = arbitration.onReleased(getTime());
+        holderThread = nullptr;
+        auto& client_statistics = statistics[client.index];
+        client_statistics.totalHoldMicros += hold_time;
+        client_statistics.maxHoldMicros = std::max(client_statistics.maxHoldMicros, hold_time);
+    }
+    mutex.unlock();
+
+    return busLock->unlock();
+}
+
+bool SpiArbiter::shouldYield(const Client& client) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return holdDepth > 0 && holderThread == xTaskGetCurrentTaskHandle() && arbitration.shouldYield(getTime());
+}
+
+bool SpiArbiter::yield(const Client& client) {
+    mutex.lock();
+    const bool should_yield = holdDepth == 1 && holderThread == xTaskGetCurrentTaskHandle() && arbitration.shouldYield(getTime());
+    if (should_yield) {
+        statistics[client.index].yields++;
+    }
+    mutex.unlock();
+
+    if (!should_yield) {
+        return false;
+    }
+
+    release(client);
+    // Users of the bus lock that don't use the arbiter (e.g. LVGL) aren't known as waiters, so always give them a chance
+    kernel::delayTicks(1);
+    acquire(client, portMAX_DELAY);
+    return true;
+}
+
+std::vector<SpiArbiter::ClientStatistics> SpiArbiter::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+void SpiArbiter::resetStatistics() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    for (auto& client_statistics : statistics) {
+        client_statistics = { .name = client_statistics.name, .priority = client_statistics.priority };
+    }
+}
+
+} // namespace tt::hal::spi
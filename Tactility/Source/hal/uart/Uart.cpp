@@ -3,6 +3,7 @@
 #include <Tactility/Log.h>
 #include <Tactility/Mutex.h>
 
+#include <algorithm>
 #include <ranges>
 #include <cstring>
 #include <Tactility/Tactility.h>
@@ -48,55 +49,105 @@ bool Uart::writeString(const char* buffer, TickType_t timeout) {
 }
 
 size_t Uart::readUntil(std::byte* buffer, size_t bufferSize, uint8_t untilByte, TickType_t timeout, bool addNullTerminator) {
-    TickType_t start_time = kernel::getTicks();
-    auto* buffer_write_ptr = reinterpret_cast<uint8_t*>(buffer);
-    uint8_t* buffer_limit = buffer_write_ptr + bufferSize - 1; // Keep 1 extra char as mull terminator
-    TickType_t timeout_left = timeout;
-    while (readByte(reinterpret_cast<std::byte*>(buffer_write_ptr), timeout_left) && buffer_write_ptr < buffer_limit) {
-#ifdef DEBUG_READ_UNTIL
-        // If first successful read and we're not receiving an empty response
-        if (buffer_write_ptr == buffer && *buffer_write_ptr != 0x00U && *buffer_write_ptr != untilByte) {
-            printf(">>");
-        }
-#endif
+    auto frame = readFrame(untilByte, timeout);
+    // Keep 1 extra char as null terminator
+    size_t max_size = addNullTerminator ? bufferSize - 1 : bufferSize;
+    size_t size = std::min(frame.size(), max_size);
+    if (size < frame.size()) {
+        TT_LOG_W(TAG, "readUntil() truncated frame of %zu bytes", frame.size());
+    }
 
-        if (*buffer_write_ptr == untilByte) {
-            // TODO: Fix when untilByte is null terminator char already
-            if (addNullTerminator) {
-                buffer_write_ptr++;
-                *buffer_write_ptr = 0x00U;
-            }
-            break;
-        }
+    memcpy(buffer, frame.data(), size);
+    if (addNullTerminator) {
+        buffer[size] = static_cast<std::byte>(0x00U);
+    }
 
-#ifdef DEBUG_READ_UNTIL
-        printf("%c", *buffer_write_ptr);
-#endif
+    // The delimiter is copied, but not counted
+    bool has_delimiter = (size > 0 && size == frame.size());
+    return has_delimiter ? size - 1 : size;
+}
 
-        buffer_write_ptr++;
+void Uart::setReceiveBufferSize(size_t size) {
+    assert(size > 0);
+    receiveBuffer = std::make_unique<std::byte[]>(size);
+    receiveBufferSize = size;
+    clearReceiveBuffer();
+}
 
-        TickType_t now = kernel::getTicks();
-        if (now > (start_time + timeout)) {
-#ifdef DEBUG_READ_UNTIL
-            TT_LOG_W(TAG, "readUntil() timeout");
-#endif
-            break;
+void Uart::clearReceiveBuffer() {
+    receiveDiscarding = false;
+    receiveReadOffset = 0;
+    receiveWriteOffset = 0;
+    receiveScanOffset = 0;
+}
+
+bool Uart::fillReceiveBuffer(TickType_t timeout) {
+    if (receiveReadOffset == receiveWriteOffset) {
+        // Everything was consumed: start at the beginning again
+        receiveReadOffset = 0;
+        receiveWriteOffset = 0;
+        receiveScanOffset = 0;
+    } else if (receiveWriteOffset == receiveBufferSize) {
+        if (receiveReadOffset > 0) {
+            // Move the partial frame to the front to make room
+            auto pending = receiveWriteOffset - receiveReadOffset;
+            memmove(receiveBuffer.get(), receiveBuffer.get() + receiveReadOffset, pending);
+            receiveScanOffset -= receiveReadOffset;
+            receiveReadOffset = 0;
+            receiveWriteOffset = pending;
         } else {
-            timeout_left = timeout - (now - start_time);
+            // The frame doesn't fit: drop it
+            receiveStatistics.overruns++;
+            clearReceiveBuffer();
+            receiveDiscarding = true;
         }
     }
 
-#ifdef DEBUG_READ_UNTIL
-    // If we read data and it's not an empty response
-    if (buffer_write_ptr != buffer && *buffer != 0x00U && *buffer != untilByte) {
-        printf("\n");
+    // Read whatever the driver has buffered, or wait for at least 1 byte
+    size_t free_space = receiveBufferSize - receiveWriteOffset;
+    size_t request_size = std::clamp<size_t>(available(0), 1, free_space);
+    auto bytes_read = readBytes(receiveBuffer.get() + receiveWriteOffset, request_size, timeout);
+    receiveWriteOffset += bytes_read;
+    receiveStatistics.bytesReceived += bytes_read;
+    return bytes_read > 0;
+}
+
+std::string_view Uart::readFrame(uint8_t delimiter, TickType_t timeout) {
+    if (receiveBuffer == nullptr) {
+        setReceiveBufferSize(defaultReceiveBufferSize);
     }
-#endif
 
-    if (addNullTerminator && (buffer_write_ptr > reinterpret_cast<uint8_t*>(buffer))) {
-        return reinterpret_cast<size_t>(buffer_write_ptr) - reinterpret_cast<size_t>(buffer) - 1UL;
-    } else {
-        return reinterpret_cast<size_t>(buffer_write_ptr) - reinterpret_cast<size_t>(buffer);
+    TickType_t start_time = kernel::getTicks();
+    bool filled = false;
+    while (true) {
+        auto* scan_start = receiveBuffer.get() + receiveScanOffset;
+        auto* found = static_cast<std::byte*>(memchr(scan_start, delimiter, receiveWriteOffset - receiveScanOffset));
+        if (found != nullptr) {
+            auto* frame_start = reinterpret_cast<const char*>(receiveBuffer.get() + receiveReadOffset);
+            size_t frame_end = (found - receiveBuffer.get()) + 1;
+            std::string_view frame(frame_start, frame_end - receiveReadOffset);
+            receiveReadOffset = frame_end;
+            receiveScanOffset = frame_end;
+            if (receiveDiscarding) {
+                // This was the end of a frame that overran the buffer
+                receiveDiscarding = false;
+                continue;
+            }
+            receiveStatistics.framesReceived++;
+            return frame;
+        }
+
+        // Don't search the same data again
+        receiveScanOffset = receiveWriteOffset;
+
+        // Always try to read at least once, so a timeout of 0 still polls the driver
+        TickType_t elapsed = kernel::getTicks() - start_time;
+        if (filled && elapsed >= timeout) {
+            return {};
+        }
+
+        fillReceiveBuffer(elapsed < timeout ? timeout - elapsed : 0);
+        filled = true;
     }
 }
 
@@ -127,6 +127,7 @@ size_t UartEsp::available(TickType_t timeout) {
 
 void UartEsp::flushInput() {
     uart_flush_input(configuration.port);
+    clearReceiveBuffer();
 }
 
 uint32_t UartEsp::getBaudRate() {
@@ -5,7 +5,10 @@
 
 #include <Tactility/Log.h>
 
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
+#include <poll.h>
 #include <sstream>
 #include <sys/ioctl.h>
 #include <unistd.h>
@@ -14,34 +17,67 @@
 
 namespace tt::hal::uart {
 
+static speed_t toSpeed(uint32_t baudRate) {
+    switch (baudRate) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default: return (speed_t)baudRate;
+    }
+}
+
+static uint32_t fromSpeed(speed_t speed) {
+    switch (speed) {
+        case B9600: return 9600;
+        case B19200: return 19200;
+        case B38400: return 38400;
+        case B57600: return 57600;
+        case B115200: return 115200;
+        case B230400: return 230400;
+        case B460800: return 460800;
+        case B921600: return 921600;
+        default: return (uint32_t)speed;
+    }
+}
+
+UartPosix::~UartPosix() {
+    if (device != -1) {
+        ::close(device);
+    }
+}
+
 bool UartPosix::start() {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
-    if (device != nullptr) {
+    if (device != -1) {
         TT_LOG_E(TAG, "[%s] Starting: Already started", configuration.name.c_str());
         return false;
     }
 
-    auto file = fopen(configuration.name.c_str(), "w");
-    if (file == nullptr) {
-        TT_LOG_E(TAG, "[%s] Open device failed", configuration.name.c_str());
+    int new_device = ::open(configuration.name.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (new_device == -1) {
+        TT_LOG_E(TAG, "[%s] Open device failed: %s", configuration.name.c_str(), strerror(errno));
         return false;
     }
 
-    auto new_device = std::unique_ptr<FILE, AutoCloseFileDeleter>(file);
-
     struct termios tty;
-    if (tcgetattr(fileno(file), &tty) < 0) {
-        printf("[%s] tcgetattr failed: %s\n", configuration.name.c_str(), strerror(errno));
+    if (tcgetattr(new_device, &tty) < 0) {
+        TT_LOG_E(TAG, "[%s] tcgetattr failed: %s", configuration.name.c_str(), strerror(errno));
+        ::close(new_device);
         return false;
     }
 
-    if (cfsetospeed(&tty, (speed_t)configuration.baudRate) == -1) {
+    if (cfsetospeed(&tty, toSpeed(configuration.baudRate)) == -1) {
         TT_LOG_E(TAG, "[%s] Setting output speed failed", configuration.name.c_str());
     }
 
-    if (cfsetispeed(&tty, (speed_t)configuration.baudRate) == -1) {
+    if (cfsetispeed(&tty, toSpeed(configuration.baudRate)) == -1) {
         TT_LOG_E(TAG, "[%s] Setting input speed failed", configuration.name.c_str());
     }
 
@@ -56,16 +92,17 @@ bool UartPosix::start() {
     tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
     tty.c_oflag &= ~OPOST;
 
-    /* fetch bytes as they become available */
-    tty.c_cc[VMIN] = 1;
-    tty.c_cc[VTIME] = 1;
+    /* reads return immediately with whatever is available: waiting is done with poll() */
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
 
-    if (tcsetattr(fileno(file), TCSANOW, &tty) != 0) {
-        printf("[%s] tcsetattr failed: %s\n", configuration.name.c_str(), strerror(errno));
+    if (tcsetattr(new_device, TCSANOW, &tty) != 0) {
+        TT_LOG_E(TAG, "[%s] tcsetattr failed: %s", configuration.name.c_str(), strerror(errno));
+        ::close(new_device);
         return false;
     }
 
-    device = std::move(new_device);
+    device = new_device;
 
     TT_LOG_I(TAG, "[%s] Started", configuration.name.c_str());
     return true;
@@ -75,12 +112,13 @@ bool UartPosix::stop() {
     auto lock = mutex.asScopedLock();
     lock.lock();
 
-    if (device == nullptr) {
+    if (device == -1) {
         TT_LOG_E(TAG, "[%s] Stopping: Not started", configuration.name.c_str());
         return false;
     }
 
-    device = nullptr;
+    ::close(device);
+    device = -1;
 
     TT_LOG_I(TAG, "[%s] Stopped", configuration.name.c_str());
     return true;
@@ -89,60 +127,78 @@ bool UartPosix::stop() {
 bool UartPosix::isStarted() const {
     auto lock = mutex.asScopedLock();
     lock.lock();
-    return device != nullptr;
+    return device != -1;
 }
 
 size_t UartPosix::readBytes(std::byte* buffer, size_t bufferSize, TickType_t timeout) {
+    TickType_t start_time = kernel::getTicks();
     auto lock = mutex.asScopedLock();
     if (!lock.lock(timeout)) {
-        return false;
+        return 0;
     }
 
-    if (awaitAvailable(timeout)) {
-        return read(fileno(device.get()), buffer, bufferSize);
-    } else {
+    // Wait without the lock, so writes aren't blocked while there's no data
+    int awaited_device = device;
+    lock.unlock();
+    if (awaited_device == -1 || !awaitAvailable(awaited_device, getRemainingTime(start_time, timeout))) {
+        return 0;
+    }
+
+    if (!lock.lock(getRemainingTime(start_time, timeout)) || device != awaited_device) {
+        // Stopped while waiting
         return 0;
     }
+
+    auto result = read(device, buffer, bufferSize);
+    return (result > 0) ? (size_t)result : 0;
 }
 
 bool UartPosix::readByte(std::byte* output, TickType_t timeout) {
-    if (awaitAvailable(timeout)) {
-        return read(fileno(device.get()), output, 1) == 1;
-    } else {
-        return false;
-    }
+    return readBytes(output, 1, timeout) == 1;
 }
 
 size_t UartPosix::writeBytes(const std::byte* buffer, size_t bufferSize, TickType_t timeout) {
-    if (!mutex.lock(timeout)) {
-        return false;
+    auto lock = mutex.asScopedLock();
+    if (!lock.lock(timeout) || device == -1) {
+        return 0;
     }
 
-    return write(fileno(device.get()), buffer, bufferSize);
+    auto result = write(device, buffer, bufferSize);
+    return (result > 0) ? (size_t)result : 0;
 }
 
 size_t UartPosix::available(TickType_t timeout) {
     auto lock = mutex.asScopedLock();
-    if (!lock.lock(timeout)) {
-        return false;
+    if (!lock.lock(timeout) || device == -1) {
+        return 0;
     }
 
-    uint32_t bytes_available = 0;
-    ioctl(fileno(device.get()), FIONREAD, bytes_available);
-    return bytes_available;
+    int bytes_available = 0;
+    if (ioctl(device, FIONREAD, &bytes_available) != 0) {
+        return 0;
+    }
+    return (size_t)bytes_available;
 }
 
 void UartPosix::flushInput() {
-    // TODO
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    if (device != -1) {
+        tcflush(device, TCIFLUSH);
+    }
+    clearReceiveBuffer();
 }
 
 uint32_t UartPosix::getBaudRate() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
     struct termios tty;
-    if (tcgetattr(fileno(device.get()), &tty) < 0) {
-        printf("[%s] tcgetattr failed: %s\n", configuration.name.c_str(), strerror(errno));
-        return false;
+    if (device == -1 || tcgetattr(device, &tty) < 0) {
+        TT_LOG_E(TAG, "[%s] tcgetattr failed: %s", configuration.name.c_str(), strerror(errno));
+        return 0;
     } else {
-        return (uint32_t)cfgetispeed(&tty);
+        return fromSpeed(cfgetispeed(&tty));
     }
 }
 
@@ -153,33 +209,55 @@ bool UartPosix::setBaudRate(uint32_t baudRate, TickType_t timeout) {
     }
 
     struct termios tty;
-    if (tcgetattr(fileno(device.get()), &tty) < 0) {
-        printf("[%s] tcgetattr failed: %s\n", configuration.name.c_str(), strerror(errno));
+    if (device == -1 || tcgetattr(device, &tty) < 0) {
+        TT_LOG_E(TAG, "[%s] tcgetattr failed: %s", configuration.name.c_str(), strerror(errno));
         return false;
     }
 
-    if (cfsetospeed(&tty, (speed_t)configuration.baudRate) == -1) {
+    if (cfsetospeed(&tty, toSpeed(baudRate)) == -1) {
         TT_LOG_E(TAG, "[%s] Failed to set output speed", configuration.name.c_str());
         return false;
     }
 
-    if (cfsetispeed(&tty, (speed_t)configuration.baudRate) == -1) {
+    if (cfsetispeed(&tty, toSpeed(baudRate)) == -1) {
         TT_LOG_E(TAG, "[%s] Failed to set input speed", configuration.name.c_str());
         return false;
     }
 
+    if (tcsetattr(device, TCSANOW, &tty) != 0) {
+        TT_LOG_E(TAG, "[%s] tcsetattr failed: %s", configuration.name.c_str(), strerror(errno));
+        return false;
+    }
+
     return true;
 }
 
-bool UartPosix::awaitAvailable(TickType_t timeout) {
-    auto start_time = kernel::getTicks();
-    do {
-        if (available(timeout) > 0) {
-            return true;
+TickType_t UartPosix::getRemainingTime(TickType_t startTime, TickType_t timeout) {
+    if (timeout == portMAX_DELAY) {
+        return portMAX_DELAY;
+    }
+    TickType_t elapsed = kernel::getTicks() - startTime;
+    return (elapsed < timeout) ? timeout - elapsed : 0;
+}
+
+bool UartPosix::awaitAvailable(int device, TickType_t timeout) {
+    TickType_t start_time = kernel::getTicks();
+    pollfd poll_descriptor = {
+        .fd = device,
+        .events = POLLIN,
+        .revents = 0
+    };
+
+    while (true) {
+        TickType_t remaining_time = getRemainingTime(start_time, timeout);
+        int timeout_millis = (remaining_time == portMAX_DELAY) ? -1 : (int)(remaining_time * portTICK_PERIOD_MS);
+        int result = poll(&poll_descriptor, 1, timeout_millis);
+        if (result == -1 && errno == EINTR) {
+            // Interrupted by a signal: wait for the rest of the time
+            continue;
         }
-        kernel::delayTicks(timeout / 10);
-    } while ((kernel::getTicks() - start()) < timeout);
-    return false;
+        return result > 0 && (poll_descriptor.revents & POLLIN) != 0;
+    }
 }
 
 std::unique_ptr<Uart> create(const Configuration& configuration) {
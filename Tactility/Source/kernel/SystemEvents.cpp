@@ -1,21 +1,12 @@
 #include "Tactility/kernel/SystemEvents.h"
 
-#include <Tactility/Mutex.h>
-#include <list>
+#include <Tactility/PubSub.h>
 
 namespace tt::kernel {
 
 constexpr auto* TAG = "SystemEvents";
 
-struct SubscriptionData {
-    SystemEventSubscription id;
-    SystemEvent event;
-    OnSystemEvent handler;
-};
-
-static Mutex mutex;
-static SystemEventSubscription subscriptionCounter = 0;
-static std::list<SubscriptionData> subscriptions;
+static PubSub<SystemEvent> pubsub;
 
 static const char* getEventName(SystemEvent event) {
     switch (event) {
@@ -55,42 +46,23 @@ static const char* getEventName(SystemEvent event) {
 
 void publishSystemEvent(SystemEvent event) {
     TT_LOG_I(TAG, "%s", getEventName(event));
-
-    if (mutex.lock(portMAX_DELAY)) {
-        for (auto& subscription : subscriptions) {
-            if (subscription.event == event) {
-                subscription.handler(event);
-            }
-        }
-
-        mutex.unlock();
-    }
+    pubsub.publish(event);
 }
 
 SystemEventSubscription subscribeSystemEvent(SystemEvent event, OnSystemEvent handler) {
-    if (mutex.lock(portMAX_DELAY)) {
-        auto id = ++subscriptionCounter;
-
-        subscriptions.push_back({
-            .id = id,
-            .event = event,
-            .handler = handler
-        });
-
-        mutex.unlock();
-        return id;
-    } else {
-        tt_crash();
-    }
+    auto handle = pubsub.subscribe([event, handler = std::move(handler)](SystemEvent publishedEvent) {
+        if (publishedEvent == event) {
+            handler(publishedEvent);
+        }
+    });
+    return static_cast<SystemEventSubscription>(reinterpret_cast<uintptr_t>(handle));
 }
 
 void unsubscribeSystemEvent(SystemEventSubscription subscription) {
-    if (mutex.lock(portMAX_DELAY)) {
-        std::erase_if(subscriptions, [subscription](auto& item) {
-            return (item.id == subscription);
-        });
-        mutex.unlock();
+    if (subscription == NoSystemEventSubscription) {
+        return;
     }
+    pubsub.unsubscribe(reinterpret_cast<PubSub<SystemEvent>::SubscriptionHandle>(static_cast<uintptr_t>(subscription)));
 }
 
 }
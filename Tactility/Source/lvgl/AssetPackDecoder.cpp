@@ -0,0 +1,184 @@
+#include "Tactility/lvgl/AssetPackDecoder.h"
+
+#include <Tactility/file/AssetPack.h>
+#include <Tactility/Log.h>
+
+#include <lvgl.h>
+#include <src/draw/lv_draw_buf_private.h>
+#include <src/draw/lv_image_decoder_private.h>
+
+#include <cstring>
+
+namespace tt::lvgl {
+
+constexpr auto* TAG = "AssetPackDecoder";
+
+static_assert(sizeof(lv_image_header_t) == 12);
+
+/** A decoding session */
+struct DecoderData {
+    /** Keeps the pack data available */
+    std::shared_ptr<file::AssetPack> pack;
+    /** Refers to the pixels in the pack */
+    lv_draw_buf_t mappedBuffer;
+    /** Set when the buffer is allocated (e.g. for compressed images) */
+    lv_draw_buf_t* allocatedBuffer = nullptr;
+};
+
+/**
+ * @param[in] dsc the decoder session
+ * @param[out] outPack the pack that contains the image
+ * @param[out] outEntry the image entry
+ * @return true when the source is a file in the asset pack
+ */
+static bool findImage(const lv_image_decoder_dsc_t* dsc, std::shared_ptr<file::AssetPack>& outPack, file::AssetPack::Entry& outEntry) {
+    if (dsc->src_type != LV_IMAGE_SRC_FILE) {
+        return false;
+    }
+
+    // Assets.h paths are on the stdio drive (e.g. "A:/system/spinner.png")
+    const auto* source = static_cast<const char*>(dsc->src);
+    if (strncmp(source, "A:", 2) != 0) {
+        return false;
+    }
+
+#ifdef ESP_PLATFORM
+    std::string path = source + 2;
+#else
+    // The stdio drive is the working directory, which contains the "system" directory
+    std::string path = (source[2] == '/') ? source + 3 : source + 2;
+#endif
+
+    return file::findAsset(path, outPack, outEntry) &&
+        outEntry.type == file::AssetPack::EntryType::Image &&
+        outEntry.size >= sizeof(lv_image_header_t) &&
+        outEntry.originalSize >= sizeof(lv_image_header_t);
+}
+
+static lv_result_t getInfo(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc, lv_image_header_t* header) {
+    std::shared_ptr<file::AssetPack> pack;
+    file::AssetPack::Entry entry;
+    if (!findImage(dsc, pack, entry)) {
+        return LV_RESULT_INVALID;
+    }
+
+    memcpy(header, entry.data, sizeof(lv_image_header_t));
+    return LV_RESULT_OK;
+}
+
+static lv_draw_buf_t* decompress(const lv_image_header_t& header, const file::AssetPack::Entry& entry) {
+    auto* buffer = lv_draw_buf_create(header.w, header.h, static_cast<lv_color_format_t>(header.cf), header.stride);
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+
+    const auto pixels_size = entry.originalSize - sizeof(lv_image_header_t);
+    if (buffer->data_size < pixels_size || !file::AssetPack::decompress(
+        entry.data + sizeof(lv_image_header_t),
+        entry.size - sizeof(lv_image_header_t),
+        buffer->data,
+        pixels_size
+    )) {
+        lv_draw_buf_destroy(buffer);
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+static lv_result_t openImage(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc) {
+    std::shared_ptr<file::AssetPack> pack;
+    file::AssetPack::Entry entry;
+    if (!findImage(dsc, pack, entry)) {
+        return LV_RESULT_INVALID;
+    }
+
+    memcpy(&dsc->header, entry.data, sizeof(lv_image_header_t));
+    const auto& header = dsc->header;
+    auto* data = new DecoderData();
+    data->pack = pack;
+
+    if (entry.compressed) {
+        data->allocatedBuffer = decompress(header, entry);
+        if (data->allocatedBuffer == nullptr) {
+            TT_LOG_E(TAG, "Failed to decompress %s", static_cast<const char*>(dsc->src));
+            delete data;
+            return LV_RESULT_INVALID;
+        }
+        dsc->decoded = data->allocatedBuffer;
+    } else {
+        // Use the pixels in the pack without copying them
+        auto* pixels = const_cast<uint8_t*>(entry.data + sizeof(lv_image_header_t));
+        const auto pixels_size = entry.size - sizeof(lv_image_header_t);
+        auto* mapped_buffer = &data->mappedBuffer;
+        if (
+            lv_draw_buf_init(mapped_buffer, header.w, header.h, static_cast<lv_color_format_t>(header.cf), header.stride, pixels, pixels_size) != LV_RESULT_OK ||
+            mapped_buffer->data != pixels
+        ) {
+            // The pixels don't meet the buffer alignment of LVGL
+            data->allocatedBuffer = lv_draw_buf_create(header.w, header.h, static_cast<lv_color_format_t>(header.cf), header.stride);
+            if (data->allocatedBuffer == nullptr || data->allocatedBuffer->data_size < pixels_size) {
+                if (data->allocatedBuffer != nullptr) {
+                    lv_draw_buf_destroy(data->allocatedBuffer);
+                }
+                delete data;
+                return LV_RESULT_INVALID;
+            }
+            memcpy(data->allocatedBuffer->data, pixels, pixels_size);
+            dsc->decoded = data->allocatedBuffer;
+        } else {
+            dsc->decoded = mapped_buffer;
+        }
+    }
+
+    dsc->user_data = data;
+
+    // Like LVGL's own decoders: cache the images that had to be decompressed, and don't cache the ones in the pack
+    if (data->allocatedBuffer != nullptr && !dsc->args.no_cache && lv_image_cache_is_enabled()) {
+        lv_image_cache_data_t search_key;
+        search_key.src_type = dsc->src_type;
+        search_key.src = dsc->src;
+        dsc->cache_entry = lv_image_decoder_add_to_cache(decoder, &search_key, data->allocatedBuffer, nullptr);
+        if (dsc->cache_entry == nullptr) {
+            lv_draw_buf_destroy(data->allocatedBuffer);
+            delete data;
+            dsc->user_data = nullptr;
+            return LV_RESULT_INVALID;
+        }
+        // The cache owns the buffer now
+        data->allocatedBuffer = nullptr;
+    }
+
+    return LV_RESULT_OK;
+}
+
+static void closeImage(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc) {
+    auto* data = static_cast<DecoderData*>(dsc->user_data);
+    if (data == nullptr) {
+        return;
+    }
+
+    if (data->allocatedBuffer != nullptr) {
+        lv_draw_buf_destroy(data->allocatedBuffer);
+    }
+
+    delete data;
+    dsc->user_data = nullptr;
+}
+
+void initAssetPackDecoder() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+
+    // New decoders are tried first, so this one takes precedence over the PNG decoder
+    auto* decoder = lv_image_decoder_create();
+    lv_image_decoder_set_info_cb(decoder, getInfo);
+    lv_image_decoder_set_open_cb(decoder, openImage);
+    lv_image_decoder_set_close_cb(decoder, closeImage);
+    decoder->name = "ASSET_PACK";
+    initialized = true;
+}
+
+}
@@ -0,0 +1,128 @@
+#include "Tactility/lvgl/AsyncDisplayFlush.h"
+
+#include <Tactility/Log.h>
+
+#include <src/display/lv_display_private.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace tt::lvgl {
+
+constexpr auto* TAG = "AsyncDisplayFlush";
+
+// Only accessed with the LVGL lock
+static std::vector<AsyncDisplayFlush*> instances;
+static std::vector<lv_display_t*> instanceDisplays;
+
+static AsyncDisplayFlush* _Nullable findInstance(lv_display_t* display) {
+    auto iterator = std::ranges::find(instanceDisplays, display);
+    if (iterator == instanceDisplays.end()) {
+        return nullptr;
+    }
+    return instances[iterator - instanceDisplays.begin()];
+}
+
+bool AsyncDisplayFlush::isSupported(lv_display_t* display) {
+    return display->render_mode == LV_DISPLAY_RENDER_MODE_FULL && display->flush_cb != nullptr;
+}
+
+AsyncDisplayFlush::AsyncDisplayFlush(lv_display_t* display, uint32_t refreshPeriod) :
+    display(display),
+    flushCallback(display->flush_cb)
+{
+    assert(isSupported(display));
+
+    instances.push_back(this);
+    instanceDisplays.push_back(display);
+    lv_display_set_flush_cb(display, onFlush);
+
+    redrawTimer = lv_timer_create(onRedrawTimer, refreshPeriod, this);
+
+    thread = std::make_unique<Thread>(
+        "display_flush",
+        4096,
+        [this]() {
+            return this->threadMain();
+        }
+    );
+    // Same as the LVGL task, so transfers aren't delayed by apps
+    thread->setPriority(Thread::Priority::High);
+    thread->start();
+}
+
+AsyncDisplayFlush::~AsyncDisplayFlush() {
+    eventFlag.set(FLAG_STOP);
+    thread->join();
+
+    lv_timer_delete(redrawTimer);
+    lv_display_set_flush_cb(display, flushCallback);
+
+    auto iterator = std::ranges::find(instances, this);
+    if (iterator != instances.end()) {
+        auto index = iterator - instances.begin();
+        instances.erase(iterator);
+        instanceDisplays.erase(instanceDisplays.begin() + index);
+    }
+}
+
+void AsyncDisplayFlush::onFlush(lv_display_t* display, const lv_area_t* area, uint8_t* pixelMap) {
+    auto* instance = findInstance(display);
+    if (instance == nullptr) {
+        lv_display_flush_ready(display);
+        return;
+    }
+
+    if (instance->busy) {
+        instance->redrawNeeded = true;
+        lv_display_flush_ready(display);
+        return;
+    }
+
+    // The pixel map starts in the active draw buffer
+    auto* draw_buffer = lv_display_get_buf_active(display);
+    size_t size = draw_buffer->data_size - (pixelMap - draw_buffer->data);
+    if (instance->bufferSize < size) {
+        instance->buffer = std::make_unique<uint8_t[]>(size);
+        instance->bufferSize = size;
+    }
+    memcpy(instance->buffer.get(), pixelMap, size);
+    instance->area = *area;
+    instance->busy = true;
+    instance->eventFlag.set(FLAG_FLUSH);
+
+    lv_display_flush_ready(display);
+}
+
+void AsyncDisplayFlush::onRedrawTimer(lv_timer_t* timer) {
+    auto* instance = static_cast<AsyncDisplayFlush*>(lv_timer_get_user_data(timer));
+    if (instance->redrawNeeded && !instance->busy) {
+        instance->redrawNeeded = false;
+        lv_obj_invalidate(lv_display_get_screen_active(instance->display));
+    }
+}
+
+int32_t AsyncDisplayFlush::threadMain() {
+    while (true) {
+        auto flags = eventFlag.wait(FLAG_FLUSH | FLAG_STOP);
+        if ((flags & EventFlag::Error) != 0) {
+            continue;
+        }
+
+        if ((flags & FLAG_FLUSH) != 0) {
+            // The original callback might also call lv_display_flush_ready(): that has no effect,
+            // because onFlush() already marked the frame as flushed.
+            flushCallback(display, &area, buffer.get());
+            busy = false;
+        }
+
+        if ((flags & FLAG_STOP) != 0) {
+            TT_LOG_D(TAG, "Stopped");
+            return 0;
+        }
+    }
+}
+
+} // namespace
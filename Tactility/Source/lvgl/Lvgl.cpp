@@ -3,12 +3,15 @@
 #include <Tactility/hal/display/DisplayDevice.h>
 #include <Tactility/hal/keyboard/KeyboardDevice.h>
 #include <Tactility/hal/touch/TouchDevice.h>
+#include <Tactility/lvgl/AssetPackDecoder.h>
+#include <Tactility/lvgl/AsyncDisplayFlush.h>
 #include <Tactility/lvgl/Keyboard.h>
 #include <Tactility/lvgl/Lvgl.h>
 #include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/kernel/SystemEvents.h>
 #include <Tactility/service/ServiceRegistration.h>
 #include <Tactility/settings/DisplaySettings.h>
+#include <Tactility/Mutex.h>
 
 #ifdef ESP_PLATFORM
 #include <Tactility/lvgl/EspLvglPort.h>
@@ -22,6 +25,66 @@ constexpr auto* TAG = "Lvgl";
 
 static bool started = false;
 
+static Mutex displaysMutex;
+static std::vector<std::shared_ptr<hal::display::DisplayDevice>> lvglDisplays;
+// Only accessed with the LVGL lock
+static std::vector<std::unique_ptr<AsyncDisplayFlush>> asyncDisplayFlushes;
+
+static void configureDisplay(hal::display::DisplayDevice& display, bool isPrimary) {
+    auto* lvgl_display = display.getLvglDisplay();
+
+    // The display settings are for the primary display
+    if (isPrimary) {
+        auto settings = settings::display::loadOrGetDefault();
+        lv_display_rotation_t rotation = settings::display::toLvglDisplayRotation(settings.orientation);
+        if (rotation != lv_display_get_rotation(lvgl_display)) {
+            lv_display_set_rotation(lvgl_display, rotation);
+        }
+    }
+
+    auto refresh_period = display.getLvglRefreshPeriod();
+    if (refresh_period != 0) {
+        lv_timer_set_period(lv_display_get_refr_timer(lvgl_display), refresh_period);
+    } else {
+        refresh_period = LV_DEF_REFR_PERIOD;
+    }
+
+    if (display.isLvglFlushSlow()) {
+        if (AsyncDisplayFlush::isSupported(lvgl_display)) {
+            asyncDisplayFlushes.push_back(std::make_unique<AsyncDisplayFlush>(lvgl_display, refresh_period));
+        } else {
+            TT_LOG_W(TAG, "%s doesn't render full frames: flushing stays synchronous", display.getName().c_str());
+        }
+    }
+}
+
+static void startTouch(hal::touch::TouchDevice& touchDevice, lv_display_t* display) {
+    // Skip touch devices that were started already (e.g. by their display)
+    if (touchDevice.supportsLvgl() && touchDevice.getLvglIndev() == nullptr) {
+        if (touchDevice.startLvgl(display)) {
+            TT_LOG_I(TAG, "Started %s", touchDevice.getName().c_str());
+        } else {
+            TT_LOG_E(TAG, "Start failed for %s", touchDevice.getName().c_str());
+        }
+    }
+}
+
+static void startEncoder(hal::encoder::EncoderDevice& encoder, lv_display_t* display) {
+    if (encoder.getLvglIndev() == nullptr) {
+        if (encoder.startLvgl(display)) {
+            TT_LOG_I(TAG, "Started %s", encoder.getName().c_str());
+        } else {
+            TT_LOG_E(TAG, "Start failed for %s", encoder.getName().c_str());
+        }
+    }
+}
+
+std::vector<std::shared_ptr<hal::display::DisplayDevice>> getDisplays() {
+    auto lock = displaysMutex.asScopedLock();
+    lock.lock();
+    return lvglDisplays;
+}
+
 void init(const hal::Configuration& config) {
     TT_LOG_I(TAG, "Init started");
 
@@ -51,45 +114,47 @@ void start() {
     auto lock = getSyncLock()->asScopedLock();
     lock.lock();
 
+    initAssetPackDecoder();
+
     // Start displays (their related touch devices start automatically within)
 
     TT_LOG_I(TAG, "Start displays");
     auto displays = hal::findDevices<hal::display::DisplayDevice>(hal::Device::Type::Display);
+    std::vector<std::shared_ptr<hal::display::DisplayDevice>> started_displays;
     for (auto display : displays) {
         if (display->supportsLvgl()) {
             if (display->startLvgl()) {
                 TT_LOG_I(TAG, "Started %s", display->getName().c_str());
                 auto lvgl_display = display->getLvglDisplay();
                 assert(lvgl_display != nullptr);
-                auto settings = settings::display::loadOrGetDefault();
-                lv_display_rotation_t rotation = settings::display::toLvglDisplayRotation(settings.orientation);
-                if (rotation != lv_display_get_rotation(lvgl_display)) {
-                    lv_display_set_rotation(lvgl_display, rotation);
-                }
+                configureDisplay(*display, started_displays.empty());
+                started_displays.push_back(display);
             } else {
                 TT_LOG_E(TAG, "Start failed for %s", display->getName().c_str());
             }
         }
     }
 
-    // Start touch
-
-    // TODO: Consider implementing support for multiple displays
-    auto primary_display = !displays.empty() ? displays[0] : nullptr;
+    displaysMutex.lock();
+    lvglDisplays = started_displays;
+    displaysMutex.unlock();
 
     // Start display-related peripherals
+    auto primary_display = !started_displays.empty() ? started_displays[0] : nullptr;
     if (primary_display != nullptr) {
+        lv_display_set_default(primary_display->getLvglDisplay());
+
         TT_LOG_I(TAG, "Start touch devices");
+        // Touch devices that belong to a display control that display
+        for (auto display : started_displays) {
+            auto touch_device = display->getTouchDevice();
+            if (touch_device != nullptr) {
+                startTouch(*touch_device, display->getLvglDisplay());
+            }
+        }
         auto touch_devices = hal::findDevices<hal::touch::TouchDevice>(hal::Device::Type::Touch);
         for (auto touch_device : touch_devices) {
-            // Start any touch devices that haven't been started yet
-            if (touch_device->supportsLvgl() && touch_device->getLvglIndev() == nullptr) {
-                if (touch_device->startLvgl(primary_display->getLvglDisplay())) {
-                    TT_LOG_I(TAG, "Started %s", touch_device->getName().c_str());
-                } else {
-                    TT_LOG_E(TAG, "Start failed for %s", touch_device->getName().c_str());
-                }
-            }
+            startTouch(*touch_device, primary_display->getLvglDisplay());
         }
 
         // Start keyboards
@@ -109,13 +174,16 @@ void start() {
 
         // Start encoders
         TT_LOG_I(TAG, "Start encoders");
+        // Encoders that belong to a display control that display
+        for (auto display : started_displays) {
+            auto encoder = display->getEncoderDevice();
+            if (encoder != nullptr) {
+                startEncoder(*encoder, display->getLvglDisplay());
+            }
+        }
         auto encoders = hal::findDevices<hal::encoder::EncoderDevice>(hal::Device::Type::Encoder);
         for (auto encoder : encoders) {
-            if (encoder->startLvgl(primary_display->getLvglDisplay())) {
-                TT_LOG_I(TAG, "Started %s", encoder->getName().c_str());
-            } else {
-                TT_LOG_E(TAG, "Start failed for %s", encoder->getName().c_str());
-            }
+            startEncoder(*encoder, primary_display->getLvglDisplay());
         }
     }
 
@@ -198,6 +266,12 @@ void stop() {
     // Stop displays (and their touch devices)
 
     TT_LOG_I(TAG, "Stopping displays");
+    asyncDisplayFlushes.clear();
+
+    displaysMutex.lock();
+    lvglDisplays.clear();
+    displaysMutex.unlock();
+
     auto displays = hal::findDevices<hal::display::DisplayDevice>(hal::Device::Type::Display);
     for (auto display : displays) {
         if (display->supportsLvgl() && display->getLvglDisplay() != nullptr && !display->stopLvgl()) {
@@ -0,0 +1,145 @@
+#include <lvgl.h>
+
+#if LV_USE_OS == LV_OS_CUSTOM
+
+#include <Tactility/CpuAffinity.h>
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Semaphore.h>
+#include <Tactility/Thread.h>
+
+#include <atomic>
+
+namespace tt::lvgl {
+
+constexpr auto* TAG = "LvglOs";
+
+static Thread::Priority toThreadPriority(lv_thread_prio_t priority) {
+    switch (priority) {
+        case LV_THREAD_PRIO_LOWEST:
+            return Thread::Priority::Low;
+        case LV_THREAD_PRIO_LOW:
+            return Thread::Priority::Normal;
+        case LV_THREAD_PRIO_MID:
+            return Thread::Priority::High;
+        case LV_THREAD_PRIO_HIGH:
+            return THREAD_PRIORITY_RENDER;
+        case LV_THREAD_PRIO_HIGHEST:
+        default:
+            return Thread::Priority::Critical;
+    }
+}
+
+/**
+ * LVGL only creates threads for its draw units.
+ * The first one runs on the graphics core (next to the LVGL task, which waits while the draw units render)
+ * and the next ones alternate over the other cores.
+ */
+static CpuAffinity getNextThreadAffinity() {
+    static std::atomic<uint32_t> thread_count = 0;
+    const auto index = thread_count++;
+    const auto graphics = getCpuAffinityConfiguration().graphics;
+#if defined(ESP_PLATFORM) && CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+    if (graphics != None) {
+        return static_cast<CpuAffinity>((graphics + index) % CONFIG_FREERTOS_NUMBER_OF_CORES);
+    }
+#endif
+    return graphics;
+}
+
+} // namespace tt::lvgl
+
+using namespace tt;
+
+extern "C" {
+
+lv_result_t lv_thread_init(lv_thread_t* thread, const char* const name, lv_thread_prio_t prio, void (*callback)(void*), size_t stack_size, void* user_data) {
+    const auto affinity = lvgl::getNextThreadAffinity();
+    auto* lvgl_thread = new Thread(
+        name,
+        stack_size,
+        [callback, user_data] {
+            callback(user_data);
+            return 0;
+        },
+        affinity
+    );
+    lvgl_thread->setPriority(lvgl::toThreadPriority(prio));
+    lvgl_thread->start();
+    TT_LOG_I(lvgl::TAG, "Started %s on core %d", name, static_cast<int>(affinity));
+    thread->thread = lvgl_thread;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_delete(lv_thread_t* thread) {
+    auto* lvgl_thread = static_cast<Thread*>(thread->thread);
+    if (lvgl_thread == nullptr) {
+        return LV_RESULT_INVALID;
+    }
+    // LVGL asks the thread to exit before deleting it
+    lvgl_thread->join();
+    delete lvgl_thread;
+    thread->thread = nullptr;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_init(lv_mutex_t* mutex) {
+    mutex->mutex = new Mutex(Mutex::Type::Recursive);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_lock(lv_mutex_t* mutex) {
+    return static_cast<Mutex*>(mutex->mutex)->lock(portMAX_DELAY) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_lock_isr(lv_mutex_t* mutex) {
+    // Mutex cannot be used from an ISR
+    if (kernel::isIsr()) {
+        return LV_RESULT_INVALID;
+    }
+    return lv_mutex_lock(mutex);
+}
+
+lv_result_t lv_mutex_unlock(lv_mutex_t* mutex) {
+    return static_cast<Mutex*>(mutex->mutex)->unlock() ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_delete(lv_mutex_t* mutex) {
+    delete static_cast<Mutex*>(mutex->mutex);
+    mutex->mutex = nullptr;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_init(lv_thread_sync_t* sync) {
+    // A binary semaphore: signals that arrive before the wait are not lost
+    sync->semaphore = new Semaphore(1, 0);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t* sync) {
+    return static_cast<Semaphore*>(sync->semaphore)->acquire(portMAX_DELAY) ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t* sync) {
+    // Releasing fails when the semaphore was already signalled, which is fine
+    static_cast<Semaphore*>(sync->semaphore)->release();
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal_isr(lv_thread_sync_t* sync) {
+    return lv_thread_sync_signal(sync);
+}
+
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t* sync) {
+    delete static_cast<Semaphore*>(sync->semaphore);
+    sync->semaphore = nullptr;
+    return LV_RESULT_OK;
+}
+
+uint32_t lv_os_get_idle_percent() {
+    return lv_timer_get_idle();
+}
+
+} // extern "C"
+
+#endif // LV_USE_OS == LV_OS_CUSTOM
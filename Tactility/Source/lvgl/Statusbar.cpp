@@ -15,6 +15,8 @@
 #include <lvgl.h>
 #include <Tactility/Tactility.h>
 
+#include <vector>
+
 namespace tt::lvgl {
 
 #define TAG "statusbar"
@@ -36,6 +38,10 @@ struct StatusbarData {
     uint8_t time_minutes = 0;
     bool time_set = false;
     kernel::SystemEventSubscription systemEventSubscription = 0;
+    /** Never unsubscribed: the callback only uses the statusbars that exist when it holds the LVGL lock */
+    PubSub<void*>::SubscriptionHandle pubsubSubscription = nullptr;
+    /** The statusbars that are alive (guarded by the LVGL lock) */
+    std::vector<lv_obj_t*> statusbars;
 };
 
 static StatusbarData statusbar_data;
@@ -45,7 +51,6 @@ typedef struct {
     lv_obj_t* time;
     lv_obj_t* icons[STATUSBAR_ICON_LIMIT];
     lv_obj_t* battery_icon;
-    PubSub<void*>::SubscriptionHandle pubsub_subscription;
 } Statusbar;
 
 static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj);
@@ -101,11 +106,13 @@ static const lv_obj_class_t statusbar_class = {
     .theme_inheritable = false
 };
 
-static void statusbar_pubsub_event(Statusbar* statusbar) {
+static void statusbar_pubsub_event() {
     TT_LOG_D(TAG, "Update event");
     if (lock(defaultLockTime)) {
-        update_main(statusbar);
-        lv_obj_invalidate(&statusbar->obj);
+        for (auto* obj : statusbar_data.statusbars) {
+            update_main((Statusbar*)obj);
+            lv_obj_invalidate(obj);
+        }
         unlock();
     } else {
         TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "Statusbar");
@@ -126,10 +133,13 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
     LV_TRACE_OBJ_CREATE("begin");
     lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
     LV_TRACE_OBJ_CREATE("finished");
-    auto* statusbar = (Statusbar*)obj;
-    statusbar->pubsub_subscription = statusbar_data.pubsub->subscribe([statusbar](auto) {
-        statusbar_pubsub_event(statusbar);
-    });
+    // The constructor and destructor are called while holding the LVGL lock
+    statusbar_data.statusbars.push_back(obj);
+    if (statusbar_data.pubsubSubscription == nullptr) {
+        statusbar_data.pubsubSubscription = statusbar_data.pubsub->subscribe([](auto) {
+            statusbar_pubsub_event();
+        });
+    }
 
     if (!statusbar_data.time_update_timer->isRunning()) {
         statusbar_data.time_update_timer->start(200 / portTICK_PERIOD_MS);
@@ -141,8 +151,7 @@ static void statusbar_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj)
 }
 
 static void statusbar_destructor(TT_UNUSED const lv_obj_class_t* class_p, lv_obj_t* obj) {
-    auto* statusbar = (Statusbar*)obj;
-    statusbar_data.pubsub->unsubscribe(statusbar->pubsub_subscription);
+    std::erase(statusbar_data.statusbars, obj);
 }
 
 static void update_icon(lv_obj_t* image, const StatusbarIcon* icon) {
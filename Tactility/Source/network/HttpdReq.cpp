@@ -167,10 +167,12 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
     char buffer[BUFFER_SIZE];
     size_t bytes_received = 0;
 
-    auto lock = file::getLock(filePath)->asScopedLock();
-    lock.lock();
+    // The lock is only held while writing, so the display (which can share the SPI bus) isn't blocked by the network
+    auto lock = file::getLock(filePath);
 
+    lock->lock(portMAX_DELAY);
     auto* file = fopen(filePath.c_str(), "wb");
+    lock->unlock();
     if (file == nullptr) {
         TT_LOG_E(TAG, "Failed to open file for writing: %s", filePath.c_str());
         return 0;
@@ -183,7 +185,10 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
             TT_LOG_E(TAG, "Receive failed");
             break;
         }
-        if (fwrite(buffer, 1, receive_chunk_size, file) != receive_chunk_size) {
+        lock->lock(portMAX_DELAY);
+        auto bytes_written = fwrite(buffer, 1, receive_chunk_size, file);
+        lock->unlock();
+        if (bytes_written != receive_chunk_size) {
             TT_LOG_E(TAG, "Failed to write all bytes");
             break;
         }
@@ -191,7 +196,34 @@ size_t receiveFile(httpd_req_t* request, size_t length, const std::string& fileP
     }
 
     // Write file
+    lock->lock(portMAX_DELAY);
     fclose(file);
+    lock->unlock();
+    return bytes_received;
+}
+
+size_t receiveChunks(httpd_req_t* request, size_t length, size_t chunkSize, const std::function<bool(const void* data, size_t length)>& onChunk) {
+    auto* buffer = static_cast<char*>(malloc(chunkSize));
+    if (buffer == nullptr) {
+        TT_LOG_E(TAG, LOG_MESSAGE_ALLOC_FAILED_FMT, chunkSize);
+        return 0;
+    }
+
+    size_t bytes_received = 0;
+    while (bytes_received < length) {
+        auto expected_chunk_size = std::min<size_t>(chunkSize, length - bytes_received);
+        int receive_chunk_size = httpd_req_recv(request, buffer, expected_chunk_size);
+        if (receive_chunk_size <= 0) {
+            TT_LOG_E(TAG, "Receive failed");
+            break;
+        }
+        if (!onChunk(buffer, receive_chunk_size)) {
+            break;
+        }
+        bytes_received += receive_chunk_size;
+    }
+
+    free(buffer);
     return bytes_received;
 }
 
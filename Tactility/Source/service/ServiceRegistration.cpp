@@ -53,10 +53,10 @@ std::shared_ptr<const ServiceManifest> _Nullable findManifestById(const std::str
 }
 
 static std::shared_ptr<ServiceInstance> _Nullable findServiceInstanceById(const std::string& id) {
-    manifest_mutex.lock();
+    instance_mutex.lock();
     auto iterator = service_instance_map.find(id);
     auto service = iterator != service_instance_map.end() ? iterator->second : nullptr;
-    manifest_mutex.unlock();
+    instance_mutex.unlock();
     return service;
 }
 
@@ -77,16 +77,16 @@ bool startService(const std::string& id) {
     instance_mutex.unlock();
 
     service_instance->setState(State::Starting);
-    if (service_instance->getService()->onStart(*service_instance)) {
-        service_instance->setState(State::Started);
-    } else {
+    if (!service_instance->getService()->onStart(*service_instance)) {
         TT_LOG_E(TAG, "Starting %s failed", id.c_str());
         service_instance->setState(State::Stopped);
         instance_mutex.lock();
         service_instance_map.erase(manifest->id);
         instance_mutex.unlock();
+        return false;
     }
 
+    service_instance->setState(State::Started);
     TT_LOG_I(TAG, "Started %s", id.c_str());
 
     return true;
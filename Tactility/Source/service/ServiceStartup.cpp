@@ -0,0 +1,287 @@
+#include "Tactility/service/ServiceStartup.h"
+
+#include <Tactility/EventFlag.h>
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/Thread.h>
+#include <Tactility/file/File.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+#include <format>
+#include <map>
+
+namespace tt::service {
+
+constexpr auto* TAG = "ServiceStartup";
+
+/** Services start on these threads instead of the main task, so they need a similar stack */
+constexpr configSTACK_DEPTH_TYPE START_THREAD_STACK_SIZE = 8192;
+constexpr uint32_t FLAG_FINISHED = 1U;
+constexpr size_t CHART_WIDTH = 32;
+
+static Mutex timelineMutex;
+static std::vector<ServiceStartRecord> timeline;
+
+static const char* toString(StartPhase phase) {
+    switch (phase) {
+        using enum StartPhase;
+        case System:
+            return "System";
+        case Gui:
+            return "Gui";
+        case Background:
+            return "Background";
+    }
+    return "?";
+}
+
+namespace {
+
+enum class NodeState {
+    Waiting,
+    Running,
+    Finished
+};
+
+struct Node {
+    std::shared_ptr<const ServiceManifest> manifest;
+    std::vector<size_t> dependents;
+    size_t remainingDependencies = 0;
+    NodeState state = NodeState::Waiting;
+};
+
+/** The shared state of the threads that start the services */
+class Startup {
+
+    Mutex mutex;
+    EventFlag eventFlag;
+    std::vector<Node> nodes;
+    size_t runningCount = 0;
+    size_t finishedCount = 0;
+    bool allStarted = true;
+    std::vector<ServiceStartRecord>& records;
+    const StartServiceFunction& startFunction;
+    std::vector<std::unique_ptr<Thread>> threads;
+
+    /** Finish a node and the nodes that depend on it, which can't start when it failed */
+    void finish(size_t index, uint64_t startTime, uint64_t endTime, bool success) {
+        auto& node = nodes[index];
+        node.state = NodeState::Finished;
+        finishedCount++;
+        records.push_back({
+            .id = node.manifest->id,
+            .phase = node.manifest->startPhase,
+            .startTime = startTime,
+            .endTime = endTime,
+            .success = success
+        });
+
+        if (!success) {
+            allStarted = false;
+        }
+
+        for (auto dependent_index : node.dependents) {
+            auto& dependent = nodes[dependent_index];
+            if (success) {
+                dependent.remainingDependencies--;
+            } else if (dependent.state == NodeState::Waiting) {
+                TT_LOG_E(TAG, "Not starting %s: dependency %s failed", dependent.manifest->id.c_str(), node.manifest->id.c_str());
+                finish(dependent_index, endTime, endTime, false);
+            }
+        }
+    }
+
+    void startNode(size_t index) {
+        const auto& id = nodes[index].manifest->id;
+        const auto start_time = static_cast<uint64_t>(kernel::getMicros());
+        bool success = startFunction(id);
+        const auto end_time = static_cast<uint64_t>(kernel::getMicros());
+
+        mutex.lock();
+        finish(index, start_time, end_time, success);
+        runningCount--;
+        mutex.unlock();
+
+        eventFlag.set(FLAG_FINISHED);
+    }
+
+    /** @return false when nothing is running and nothing can start */
+    bool launchReadyNodes(size_t workerCount) {
+        for (size_t index = 0; index < nodes.size() && runningCount < workerCount; index++) {
+            auto& node = nodes[index];
+            if (node.state == NodeState::Waiting && node.remainingDependencies == 0) {
+                node.state = NodeState::Running;
+                runningCount++;
+                auto thread = std::make_unique<Thread>(
+                    "service_start",
+                    START_THREAD_STACK_SIZE,
+                    [this, index]() {
+                        startNode(index);
+                        return 0;
+                    }
+                );
+                thread->start();
+                threads.push_back(std::move(thread));
+            }
+        }
+        return runningCount > 0;
+    }
+
+public:
+
+    Startup(
+        const std::vector<std::shared_ptr<const ServiceManifest>>& manifests,
+        std::vector<ServiceStartRecord>& records,
+        const StartServiceFunction& startFunction,
+        const IsServiceStartedFunction& isStartedFunction
+    ) :
+        records(records),
+        startFunction(startFunction)
+    {
+        std::map<std::string, size_t> indices;
+        nodes.reserve(manifests.size());
+        for (const auto& manifest : manifests) {
+            indices[manifest->id] = nodes.size();
+            nodes.push_back({ .manifest = manifest });
+        }
+
+        std::vector<std::pair<size_t, std::string>> missing_dependencies;
+        for (size_t index = 0; index < nodes.size(); index++) {
+            for (const auto& dependency : nodes[index].manifest->dependencies) {
+                auto dependency_index = indices.find(dependency);
+                if (dependency_index != indices.end()) {
+                    nodes[dependency_index->second].dependents.push_back(index);
+                    nodes[index].remainingDependencies++;
+                } else if (!isStartedFunction(dependency)) {
+                    missing_dependencies.emplace_back(index, dependency);
+                }
+            }
+        }
+
+        // Fail these after the dependents are known, so the services that depend on them fail too
+        const auto time = static_cast<uint64_t>(kernel::getMicros());
+        for (const auto& [index, dependency] : missing_dependencies) {
+            if (nodes[index].state == NodeState::Waiting) {
+                TT_LOG_E(TAG, "Not starting %s: dependency %s isn't running", nodes[index].manifest->id.c_str(), dependency.c_str());
+                finish(index, time, time, false);
+            }
+        }
+    }
+
+    bool run(size_t workerCount) {
+        while (true) {
+            mutex.lock();
+            bool done = finishedCount == nodes.size();
+            if (!done && !launchReadyNodes(workerCount)) {
+                // Nothing runs, so the remaining nodes depend on each other
+                const auto time = static_cast<uint64_t>(kernel::getMicros());
+                for (size_t index = 0; index < nodes.size(); index++) {
+                    if (nodes[index].state == NodeState::Waiting) {
+                        TT_LOG_E(TAG, "Not starting %s: circular dependency", nodes[index].manifest->id.c_str());
+                        finish(index, time, time, false);
+                    }
+                }
+                done = true;
+            }
+            mutex.unlock();
+
+            if (done) {
+                break;
+            }
+
+            eventFlag.wait(FLAG_FINISHED);
+        }
+
+        for (auto& thread : threads) {
+            thread->join();
+        }
+
+        return allStarted;
+    }
+};
+
+} // namespace
+
+bool isServiceStarted(const std::string& id) {
+    return getState(id) == State::Started;
+}
+
+bool startServices(
+    const std::vector<std::shared_ptr<const ServiceManifest>>& manifests,
+    size_t workerCount,
+    std::vector<ServiceStartRecord>& outRecords,
+    const StartServiceFunction& startFunction,
+    const IsServiceStartedFunction& isStartedFunction
+) {
+    assert(workerCount > 0);
+    Startup startup(manifests, outRecords, startFunction, isStartedFunction);
+    return startup.run(workerCount);
+}
+
+std::string formatBootTimeline(const std::vector<ServiceStartRecord>& records) {
+    std::string csv = "id,phase,start_us,end_us,duration_us,success\n";
+    for (const auto& record : records) {
+        csv += std::format(
+            "{},{},{},{},{},{}\n",
+            record.id,
+            toString(record.phase),
+            record.startTime,
+            record.endTime,
+            record.endTime - record.startTime,
+            record.success ? 1 : 0
+        );
+    }
+    return csv;
+}
+
+void logBootTimeline(const std::vector<ServiceStartRecord>& records) {
+    if (records.empty()) {
+        return;
+    }
+
+    auto first_start = std::min_element(records.begin(), records.end(), [](const auto& left, const auto& right) {
+        return left.startTime < right.startTime;
+    })->startTime;
+    auto last_end = std::max_element(records.begin(), records.end(), [](const auto& left, const auto& right) {
+        return left.endTime < right.endTime;
+    })->endTime;
+    const auto total_time = std::max<uint64_t>(1, last_end - first_start);
+
+    TT_LOG_I(TAG, "Boot timeline: %llu ms", static_cast<unsigned long long>(total_time / 1000));
+    for (const auto& record : records) {
+        // A bar that shows when the service started, relative to the whole timeline
+        const auto bar_start = (record.startTime - first_start) * CHART_WIDTH / total_time;
+        const auto bar_end = std::max(bar_start + 1, (record.endTime - first_start) * CHART_WIDTH / total_time);
+        std::string bar(CHART_WIDTH, ' ');
+        std::fill(bar.begin() + bar_start, bar.begin() + std::min<uint64_t>(bar_end, CHART_WIDTH), '#');
+        TT_LOG_I(
+            TAG,
+            "|%s| %-14s %-10s %6llu ms %6llu ms%s",
+            bar.c_str(),
+            record.id.c_str(),
+            toString(record.phase),
+            static_cast<unsigned long long>((record.startTime - first_start) / 1000),
+            static_cast<unsigned long long>((record.endTime - record.startTime) / 1000),
+            record.success ? "" : " (failed)"
+        );
+    }
+}
+
+void addToBootTimeline(const std::vector<ServiceStartRecord>& records) {
+    auto lock = timelineMutex.asScopedLock();
+    lock.lock();
+    timeline.insert(timeline.end(), records.begin(), records.end());
+}
+
+std::vector<ServiceStartRecord> getBootTimeline() {
+    auto lock = timelineMutex.asScopedLock();
+    lock.lock();
+    return timeline;
+}
+
+bool exportBootTimeline(const std::string& path) {
+    return file::writeString(path, formatBootTimeline(getBootTimeline()));
+}
+
+} // namespace
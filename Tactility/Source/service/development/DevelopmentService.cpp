@@ -3,6 +3,7 @@
 #include <Tactility/service/development/DevelopmentService.h>
 
 #include <Tactility/app/App.h>
+#include <Tactility/app/AppInstall.h>
 #include <Tactility/app/AppRegistration.h>
 #include <Tactility/file/File.h>
 #include <Tactility/network/HttpdReq.h>
@@ -20,6 +21,7 @@ namespace tt::service::development {
 extern const ServiceManifest manifest;
 
 constexpr const char* TAG = "DevService";
+constexpr size_t INSTALL_CHUNK_SIZE = 4096;
 
 bool DevelopmentService::onStart(ServiceContext& service) {
     std::stringstream stream;
@@ -115,6 +117,20 @@ esp_err_t DevelopmentService::handleAppRun(httpd_req_t* request) {
 esp_err_t DevelopmentService::handleAppInstall(httpd_req_t* request) {
     TT_LOG_I(TAG, "PUT /app/install");
 
+    // Optional digest of the uploaded file
+    std::string sha256;
+    if (httpd_req_get_url_query_len(request) > 0) {
+        std::string query;
+        if (!network::getQueryOrSendError(request, query)) {
+            return ESP_FAIL;
+        }
+        auto parameters = network::parseUrlQuery(query);
+        auto sha256_entry = parameters.find("sha256");
+        if (sha256_entry != parameters.end()) {
+            sha256 = sha256_entry->second;
+        }
+    }
+
     std::string boundary;
     if (!network::getMultiPartBoundaryOrSendError(request, boundary)) {
         return false;
@@ -152,16 +168,19 @@ esp_err_t DevelopmentService::handleAppInstall(httpd_req_t* request) {
     auto boundary_and_newlines_after_file = std::format("\r\n--{}--\r\n", boundary);
     auto file_size = content_left - boundary_and_newlines_after_file.length();
 
-    // Create tmp directory
-    const std::string tmp_path = getTempPath();
-    if (!file::findOrCreateDirectory(tmp_path, 0777)) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
+    // The app is extracted while it is received
+    app::InstallStream install_stream(sha256);
+    if (!install_stream.begin()) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
 
-    auto file_path = std::format("{}/{}", tmp_path, filename_entry->second);
-    if (network::receiveFile(request, file_size, file_path) != file_size) {
-        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to save file");
+    auto bytes_received = network::receiveChunks(request, file_size, INSTALL_CHUNK_SIZE, [&install_stream](const void* data, size_t length) {
+        return install_stream.write(data, length);
+    });
+
+    if (bytes_received != file_size) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
 
@@ -177,16 +196,12 @@ esp_err_t DevelopmentService::handleAppInstall(httpd_req_t* request) {
         TT_LOG_W(TAG, "We have more bytes at the end of the request parsing?!");
     }
 
-    if (!app::install(file_path)) {
+    if (!install_stream.finish()) {
         httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "Failed to install");
         return ESP_FAIL;
     }
 
-    if (!file::deleteFile(file_path.c_str())) {
-        TT_LOG_W(TAG, "Failed to delete %s", file_path.c_str());
-    }
-
-    TT_LOG_I(TAG, "[200] /app/install -> %s", file_path.c_str());
+    TT_LOG_I(TAG, "[200] /app/install -> %s", install_stream.getAppId().c_str());
 
     httpd_resp_send(request, nullptr, 0);
 
@@ -236,7 +251,9 @@ std::shared_ptr<DevelopmentService> findService() {
 
 extern const ServiceManifest manifest = {
     .id = "Development",
-    .createService = create<DevelopmentService>
+    .createService = create<DevelopmentService>,
+    .dependencies = { "Wifi" },
+    .startPhase = StartPhase::Background
 };
 
 }
@@ -128,7 +128,8 @@ public:
 
 extern const ServiceManifest manifest = {
     .id = "DisplayIdle",
-    .createService = create<DisplayIdleService>
+    .createService = create<DisplayIdleService>,
+    .startPhase = StartPhase::Gui
 };
 
 }
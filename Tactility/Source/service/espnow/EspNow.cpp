@@ -56,6 +56,16 @@ bool send(const uint8_t* address, const uint8_t* buffer, size_t bufferLength) {
     }
 }
 
+bool sendMessage(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCallback callback) {
+    auto service = findService();
+    if (service != nullptr) {
+        return service->sendMessage(address, buffer, bufferLength, std::move(callback));
+    } else {
+        TT_LOG_E(TAG, "Service not found");
+        return false;
+    }
+}
+
 ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive) {
     auto service = findService();
     if (service != nullptr) {
@@ -66,6 +76,16 @@ ReceiverSubscription subscribeReceiver(std::function<void(const esp_now_recv_inf
     }
 }
 
+ReceiverSubscription subscribeMessageReceiver(MessageReceiver onReceive) {
+    auto service = findService();
+    if (service != nullptr) {
+        return service->subscribeMessageReceiver(std::move(onReceive));
+    } else {
+        TT_LOG_E(TAG, "Service not found");
+        return NO_SUBSCRIPTION;
+    }
+}
+
 void unsubscribeReceiver(ReceiverSubscription subscription) {
     auto service = findService();
     if (service != nullptr) {
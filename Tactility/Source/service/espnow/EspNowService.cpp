@@ -6,9 +6,11 @@
 #include <Tactility/service/ServiceRegistration.h>
 #include <Tactility/service/espnow/EspNowWifi.h>
 
+#include <algorithm>
 #include <cstring>
 #include <esp_now.h>
 #include <esp_random.h>
+#include <esp_timer.h>
 
 namespace tt::service::espnow {
 
@@ -16,8 +18,13 @@ extern const ServiceManifest manifest;
 
 constexpr const char* TAG = "EspNowService";
 constexpr TickType_t MAX_DELAY = 1000U / portTICK_PERIOD_MS;
+/** Frames that arrive while the worker thread is busy. Later frames are dropped. */
+constexpr size_t MAX_RECEIVED_FRAMES = 32;
 static uint8_t BROADCAST_MAC[ESP_NOW_ETH_ALEN];
 
+/** The 64 bit time since boot: kernel::getMicros() overflows */
+static uint64_t getTime() { return static_cast<uint64_t>(esp_timer_get_time()); }
+
 constexpr bool isBroadcastAddress(uint8_t address[ESP_NOW_ETH_ALEN]) { return memcmp(address, BROADCAST_MAC, ESP_NOW_ETH_ALEN) == 0; }
 
 bool EspNowService::onStart(ServiceContext& service) {
@@ -30,6 +37,9 @@ bool EspNowService::onStart(ServiceContext& service) {
 }
 
 void EspNowService::onStop(ServiceContext& service) {
+    // The thread refers to this service, which doesn't outlive this call
+    stopThread();
+
     auto lock = mutex.asScopedLock();
     lock.lock();
 
@@ -85,6 +95,9 @@ void EspNowService::enableFromDispatcher(const EspNowConfig& config) {
     memcpy(broadcast_peer.peer_addr, BROADCAST_MAC, sizeof(BROADCAST_MAC));
     service::espnow::addPeer(broadcast_peer);
 
+    transport = std::make_unique<Transport>(link, Transport::Configuration());
+    startThread();
+
     enabled = true;
 }
 
@@ -99,6 +112,9 @@ void EspNowService::disable() {
 }
 
 void EspNowService::disableFromDispatcher() {
+    // The thread uses the mutex, so it's stopped before locking
+    stopThread();
+
     auto lock = mutex.asScopedLock();
     lock.lock();
 
@@ -106,6 +122,8 @@ void EspNowService::disableFromDispatcher() {
         return;
     }
 
+    transport = nullptr;
+
     if (esp_now_deinit() != ESP_OK) {
         TT_LOG_E(TAG, "esp_now_deinit() failed");
     }
@@ -130,19 +148,148 @@ void EspNowService::receiveCallback(const esp_now_recv_info_t* receiveInfo, cons
     service->onReceive(receiveInfo, data, length);
 }
 
+/** Called from the Wi-Fi task, which shouldn't wait for subscribers: the frame is handled by the worker thread */
 void EspNowService::onReceive(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length) {
-    auto lock = mutex.asScopedLock();
-    lock.lock();
-
     TT_LOG_D(TAG, "Received %d bytes", length);
 
-    for (const auto& item: subscriptions) {
-        item.onReceive(receiveInfo, data, length);
+    ReceivedFrame frame = {
+        .sourceAddress = {},
+        .destinationAddress = {},
+        .rxControl = *receiveInfo->rx_ctrl,
+        .data = std::vector<uint8_t>(data, data + length)
+    };
+    memcpy(frame.sourceAddress, receiveInfo->src_addr, ESP_NOW_ETH_ALEN);
+    memcpy(frame.destinationAddress, receiveInfo->des_addr, ESP_NOW_ETH_ALEN);
+
+    receiveMutex.lock();
+    bool accepted = receivedFrames.size() < MAX_RECEIVED_FRAMES;
+    if (accepted) {
+        receivedFrames.push_back(std::move(frame));
+    }
+    receiveMutex.unlock();
+
+    if (accepted) {
+        eventFlag.set(FlagReceive);
+    } else {
+        TT_LOG_W(TAG, "Receive queue full, dropped frame");
     }
 }
 
 // endregion Callbacks
 
+// region Thread
+
+void EspNowService::startThread() {
+    eventFlag.clear(FlagStop);
+    thread = std::make_unique<Thread>(
+        "espnow",
+        4096,
+        [this]() {
+            return this->threadMain();
+        }
+    );
+    thread->start();
+}
+
+void EspNowService::stopThread() {
+    if (thread != nullptr) {
+        eventFlag.set(FlagStop);
+        thread->join();
+        thread = nullptr;
+    }
+}
+
+void EspNowService::deliverFrame(const ReceivedFrame& frame) {
+    if (Transport::isTransportFrame(frame.data.data(), frame.data.size())) {
+        PeerAddress address;
+        memcpy(address.data(), frame.sourceAddress, ESP_NOW_ETH_ALEN);
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        transport->onFrame(address, frame.data.data(), frame.data.size(), getTime());
+    } else {
+        mutex.lock();
+        auto subscriptions_copy = subscriptions;
+        mutex.unlock();
+
+        // The receiver info refers to the copies in the frame
+        auto frame_copy = frame;
+        esp_now_recv_info_t receive_info = {
+            .src_addr = frame_copy.sourceAddress,
+            .des_addr = frame_copy.destinationAddress,
+            .rx_ctrl = &frame_copy.rxControl
+        };
+        for (const auto& item: subscriptions_copy) {
+            item.onReceive(&receive_info, frame_copy.data.data(), static_cast<int>(frame_copy.data.size()));
+        }
+    }
+}
+
+int32_t EspNowService::threadMain() {
+    std::vector<Transport::ReceivedMessage> messages;
+    std::vector<Transport::Completion> completions;
+    uint64_t next_poll_time = 0;
+
+    while (true) {
+        uint32_t timeout = portMAX_DELAY;
+        if (next_poll_time != UINT64_MAX) {
+            const auto time = getTime();
+            const auto micros = (next_poll_time > time) ? (next_poll_time - time) : 0;
+            // Round up, so the poll isn't too early
+            timeout = std::max<TickType_t>(1, kernel::millisToTicks((micros + 999) / 1000));
+        }
+
+        auto flags = eventFlag.wait(FlagReceive | FlagSend | FlagStop, EventFlag::WaitAny, timeout);
+        if ((flags & EventFlag::Error) == 0 && (flags & FlagStop) != 0) {
+            break;
+        }
+
+        receiveMutex.lock();
+        auto frames = std::move(receivedFrames);
+        receivedFrames.clear();
+        receiveMutex.unlock();
+
+        for (const auto& frame : frames) {
+            deliverFrame(frame);
+        }
+
+        mutex.lock();
+        next_poll_time = transport->poll(getTime());
+        transport->takeEvents(messages, completions);
+        auto subscriptions_copy = messageSubscriptions;
+        mutex.unlock();
+
+        // Outside the lock, so the callbacks can send
+        for (const auto& message : messages) {
+            for (const auto& item : subscriptions_copy) {
+                item.onReceive(message.address.data(), message.data.data(), message.data.size());
+            }
+        }
+        for (const auto& completion : completions) {
+            completion.callback(completion.success);
+        }
+    }
+
+    return 0;
+}
+
+SendResult EspNowService::EspNowLink::sendFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize) {
+    const auto result = esp_now_send(address.data(), data, dataSize);
+    switch (result) {
+        case ESP_OK:
+            return SendResult::Sent;
+        case ESP_ERR_ESPNOW_NO_MEM:
+            // The Wi-Fi buffers are full: the transport tries again later
+            return SendResult::Busy;
+        default:
+            // e.g. ESP_ERR_ESPNOW_NOT_FOUND when the address isn't a peer
+            TT_LOG_E(TAG, "Failed to send frame (%s)", esp_err_to_name(result));
+            return SendResult::Failed;
+    }
+}
+
+// endregion Thread
+
 bool EspNowService::isEnabled() const {
     auto lock = mutex.asScopedLock();
     lock.lock();
@@ -170,6 +317,24 @@ bool EspNowService::send(const uint8_t* address, const uint8_t* buffer, size_t b
     }
 }
 
+bool EspNowService::sendMessage(const uint8_t* address, const uint8_t* buffer, size_t bufferLength, SendCallback callback) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (!isEnabled() || transport == nullptr) {
+        return false;
+    }
+
+    PeerAddress peer_address;
+    memcpy(peer_address.data(), address, ESP_NOW_ETH_ALEN);
+    if (!transport->send(peer_address, buffer, bufferLength, std::move(callback))) {
+        return false;
+    }
+
+    eventFlag.set(FlagSend);
+    return true;
+}
+
 ReceiverSubscription EspNowService::subscribeReceiver(std::function<void(const esp_now_recv_info_t* receiveInfo, const uint8_t* data, int length)> onReceive) {
     auto lock = mutex.asScopedLock();
     lock.lock();
@@ -184,10 +349,25 @@ ReceiverSubscription EspNowService::subscribeReceiver(std::function<void(const e
     return id;
 }
 
+ReceiverSubscription EspNowService::subscribeMessageReceiver(MessageReceiver onReceive) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    auto id = lastSubscriptionId++;
+
+    messageSubscriptions.push_back(MessageSubscriptionData {
+        .id = id,
+        .onReceive = std::move(onReceive)
+    });
+
+    return id;
+}
+
 void EspNowService::unsubscribeReceiver(tt::service::espnow::ReceiverSubscription subscriptionId) {
     auto lock = mutex.asScopedLock();
     lock.lock();
     std::erase_if(subscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
+    std::erase_if(messageSubscriptions, [subscriptionId](auto& subscription) { return subscription.id == subscriptionId; });
 }
 
 std::shared_ptr<EspNowService> findService() {
@@ -198,7 +378,9 @@ std::shared_ptr<EspNowService> findService() {
 
 extern const ServiceManifest manifest = {
     .id = "EspNow",
-    .createService = create<EspNowService>
+    .createService = create<EspNowService>,
+    .dependencies = { "Wifi" },
+    .startPhase = StartPhase::Background
 };
 
 }
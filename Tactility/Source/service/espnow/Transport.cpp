@@ -0,0 +1,363 @@
+#include "Tactility/service/espnow/Transport.h"
+
+#include <Tactility/Log.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::service::espnow {
+
+constexpr auto* TAG = "EspNowTransport";
+
+/** The amount of completed message ids that are remembered per peer */
+constexpr size_t MAX_COMPLETED_IDS = 32;
+
+static bool isBroadcastAddress(const PeerAddress& address) {
+    return std::all_of(address.begin(), address.end(), [](uint8_t byte) { return byte == 0xFF; });
+}
+
+static void writeUint16(uint8_t* buffer, uint16_t value) {
+    buffer[0] = value & 0xFF;
+    buffer[1] = value >> 8;
+}
+
+static uint16_t readUint16(const uint8_t* buffer) {
+    return buffer[0] | (buffer[1] << 8);
+}
+
+static void writeUint32(uint8_t* buffer, uint32_t value) {
+    writeUint16(buffer, value & 0xFFFF);
+    writeUint16(buffer + 2, value >> 16);
+}
+
+static uint32_t readUint32(const uint8_t* buffer) {
+    return readUint16(buffer) | (static_cast<uint32_t>(readUint16(buffer + 2)) << 16);
+}
+
+static int findLowestMissing(uint32_t mask, uint8_t fragmentCount) {
+    for (int index = 0; index < fragmentCount; index++) {
+        if ((mask & (1U << index)) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+bool Transport::send(const PeerAddress& address, const uint8_t* data, size_t dataSize, SendCallback callback) {
+    if (dataSize > getMaxMessageSize()) {
+        TT_LOG_E(TAG, "Message of %zu bytes exceeds the maximum of %zu", dataSize, getMaxMessageSize());
+        return false;
+    }
+
+    if (outgoing.size() >= configuration.maxPendingMessages) {
+        TT_LOG_W(TAG, "Send queue full");
+        return false;
+    }
+
+    const auto payload_size = getFragmentPayloadSize();
+    const auto fragment_count = std::max<size_t>(1, (dataSize + payload_size - 1) / payload_size);
+    outgoing.push_back({
+        .address = address,
+        .id = peers[address].nextMessageId++,
+        .broadcast = isBroadcastAddress(address),
+        .data = std::vector<uint8_t>(data, data + dataSize),
+        .fragmentCount = static_cast<uint8_t>(fragment_count),
+        .callback = std::move(callback)
+    });
+    return true;
+}
+
+SendResult Transport::sendFragment(OutgoingMessage& message, uint8_t index) {
+    const auto payload_size = getFragmentPayloadSize();
+    const auto offset = index * payload_size;
+    const auto size = std::min(payload_size, message.data.size() - offset);
+
+    frameBuffer.resize(DATA_HEADER_SIZE + size);
+    auto* frame = frameBuffer.data();
+    frame[0] = FRAME_MAGIC;
+    frame[1] = static_cast<uint8_t>(message.broadcast ? FrameType::Broadcast : FrameType::Data);
+    writeUint16(frame + 2, message.id);
+    frame[4] = index;
+    frame[5] = message.fragmentCount;
+    memcpy(frame + DATA_HEADER_SIZE, message.data.data() + offset, size);
+
+    const auto result = link.sendFrame(message.address, frame, DATA_HEADER_SIZE + size);
+    if (result != SendResult::Sent) {
+        return result;
+    }
+
+    message.sentMask |= 1U << index;
+    statistics.dataFramesSent++;
+    if ((message.attemptedMask & (1U << index)) != 0) {
+        statistics.retransmittedFrames++;
+    }
+    message.attemptedMask |= 1U << index;
+    return SendResult::Sent;
+}
+
+SendResult Transport::sendAck(const PeerAddress& address, uint16_t id, uint8_t fragmentCount, uint32_t mask) {
+    uint8_t frame[ACK_SIZE];
+    frame[0] = FRAME_MAGIC;
+    frame[1] = static_cast<uint8_t>(FrameType::Ack);
+    writeUint16(frame + 2, id);
+    frame[4] = fragmentCount;
+    writeUint32(frame + 5, mask);
+    const auto result = link.sendFrame(address, frame, ACK_SIZE);
+    if (result == SendResult::Sent) {
+        statistics.acksSent++;
+    }
+    return result;
+}
+
+std::deque<Transport::OutgoingMessage>::iterator Transport::finish(std::deque<OutgoingMessage>::iterator message, bool success) {
+    if (success) {
+        statistics.messagesSent++;
+    } else {
+        statistics.messagesFailed++;
+    }
+
+    if (message->callback != nullptr) {
+        completions.push_back({ .callback = std::move(message->callback), .success = success });
+    }
+    return outgoing.erase(message);
+}
+
+void Transport::onFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize, uint64_t time) {
+    if (dataSize < 2 || data[0] != FRAME_MAGIC) {
+        statistics.invalidFrames++;
+        return;
+    }
+
+    switch (static_cast<FrameType>(data[1])) {
+        case FrameType::Data:
+            onData(address, data, dataSize, false, time);
+            break;
+        case FrameType::Broadcast:
+            onData(address, data, dataSize, true, time);
+            break;
+        case FrameType::Ack:
+            onAck(address, data, dataSize);
+            break;
+        default:
+            statistics.invalidFrames++;
+            break;
+    }
+}
+
+void Transport::onData(const PeerAddress& address, const uint8_t* data, size_t dataSize, bool broadcast, uint64_t time) {
+    const auto payload_size = getFragmentPayloadSize();
+    if (dataSize < DATA_HEADER_SIZE) {
+        statistics.invalidFrames++;
+        return;
+    }
+
+    const auto id = readUint16(data + 2);
+    const uint8_t index = data[4];
+    const uint8_t fragment_count = data[5];
+    const auto size = dataSize - DATA_HEADER_SIZE;
+    const bool is_last = (index + 1 == fragment_count);
+    // All fragments but the last one are full, so the offset follows from the index
+    if (fragment_count == 0 || fragment_count > MAX_FRAGMENTS || index >= fragment_count || (!is_last && size != payload_size)) {
+        statistics.invalidFrames++;
+        return;
+    }
+
+    auto& peer = peers[address];
+    const MessageKey key = { .id = id, .broadcast = broadcast };
+    auto completed = std::find_if(peer.completedIds.begin(), peer.completedIds.end(), [&key](const auto& item) { return item.first == key; });
+    if (completed != peer.completedIds.end()) {
+        // The acknowledgement got lost
+        statistics.duplicateFrames++;
+        if (!broadcast) {
+            sendAck(address, id, fragment_count, getFullMask(fragment_count));
+        }
+        return;
+    }
+
+    auto existing = peer.incoming.find(key);
+    if (existing == peer.incoming.end()) {
+        if (peer.incoming.size() >= configuration.maxPendingMessages) {
+            TT_LOG_W(TAG, "Too many incomplete messages");
+            return;
+        }
+        existing = peer.incoming.emplace(key, IncomingMessage {
+            .data = std::vector<uint8_t>(fragment_count * payload_size),
+            .fragmentCount = fragment_count,
+            .expireTime = 0
+        }).first;
+    }
+
+    auto& message = existing->second;
+    if (message.fragmentCount != fragment_count) {
+        statistics.invalidFrames++;
+        return;
+    }
+
+    message.expireTime = time + configuration.reassemblyTimeoutMicros;
+    if ((message.receivedMask & (1U << index)) != 0) {
+        statistics.duplicateFrames++;
+    } else {
+        memcpy(message.data.data() + index * payload_size, data + DATA_HEADER_SIZE, size);
+        message.receivedMask |= 1U << index;
+        if (is_last) {
+            message.lastFragmentSize = size;
+        }
+    }
+
+    if (message.receivedMask == getFullMask(fragment_count)) {
+        message.data.resize((fragment_count - 1) * payload_size + message.lastFragmentSize);
+        receivedMessages.push_back({ .address = address, .data = std::move(message.data) });
+        statistics.messagesReceived++;
+        peer.incoming.erase(existing);
+
+        peer.completedIds.emplace_back(key, time);
+        if (peer.completedIds.size() > MAX_COMPLETED_IDS) {
+            peer.completedIds.pop_front();
+        }
+
+        if (!broadcast) {
+            sendAck(address, id, fragment_count, getFullMask(fragment_count));
+        }
+    } else if (!broadcast) {
+        // Acknowledge when no more fragments arrive, so one acknowledgement covers them all
+        message.ackPending = true;
+        message.ackTime = time + configuration.ackDelayMicros;
+    }
+}
+
+void Transport::onAck(const PeerAddress& address, const uint8_t* data, size_t dataSize) {
+    if (dataSize < ACK_SIZE) {
+        statistics.invalidFrames++;
+        return;
+    }
+
+    const auto id = readUint16(data + 2);
+    const uint8_t fragment_count = data[4];
+    const auto mask = readUint32(data + 5);
+
+    auto message = std::find_if(outgoing.begin(), outgoing.end(), [&address, id](const auto& item) {
+        return item.id == id && item.address == address && !item.broadcast;
+    });
+    if (message == outgoing.end() || message->fragmentCount != fragment_count) {
+        // An acknowledgement of a retransmission of a message that already finished
+        statistics.duplicateFrames++;
+        return;
+    }
+
+    const auto acked_mask = message->ackedMask | (mask & getFullMask(fragment_count));
+    if (acked_mask != message->ackedMask) {
+        // Progress: the peer is still reachable
+        message->retransmits = 0;
+        message->ackedMask = acked_mask;
+    }
+    // Don't retransmit what was received in the meantime
+    message->sentMask |= message->ackedMask;
+    if (message->ackedMask == getFullMask(fragment_count)) {
+        finish(message, true);
+    }
+}
+
+uint64_t Transport::poll(uint64_t time) {
+    uint64_t next_time = UINT64_MAX;
+
+    // Retransmit the fragments that weren't acknowledged in time
+    for (auto message = outgoing.begin(); message != outgoing.end();) {
+        const auto full_mask = getFullMask(message->fragmentCount);
+        if (!message->broadcast && message->sentMask == full_mask && time >= message->retransmitTime) {
+            if (message->retransmits >= configuration.maxRetransmits) {
+                TT_LOG_W(TAG, "Message %u failed after %u retransmits", message->id, message->retransmits);
+                message = finish(message, false);
+                continue;
+            }
+            message->retransmits++;
+            message->sentMask = message->ackedMask;
+        }
+        ++message;
+    }
+
+    // A token bucket: the frames that weren't sent in the previous intervals can be sent now, up to the burst size
+    const uint64_t burst_time = static_cast<uint64_t>(configuration.frameIntervalMicros) * (configuration.maxBurstFrames - 1);
+    if (time > burst_time) {
+        nextFrameTime = std::max(nextFrameTime, time - burst_time);
+    }
+
+    auto message = outgoing.begin();
+    while (message != outgoing.end() && nextFrameTime <= time) {
+        const auto full_mask = getFullMask(message->fragmentCount);
+        const int index = findLowestMissing(message->sentMask, message->fragmentCount);
+        if (index < 0) {
+            ++message;
+            continue;
+        }
+
+        const auto result = sendFragment(*message, index);
+        if (result == SendResult::Failed) {
+            // Retrying won't help, and the message shouldn't hold back the ones after it
+            TT_LOG_W(TAG, "Message %u can't be sent", message->id);
+            message = finish(message, false);
+            continue;
+        }
+        if (result == SendResult::Busy) {
+            // Give the link an interval to free its buffers instead of trying again at every poll
+            nextFrameTime = std::max(nextFrameTime, time) + configuration.frameIntervalMicros;
+            break;
+        }
+        nextFrameTime += configuration.frameIntervalMicros;
+
+        if (message->sentMask == full_mask) {
+            if (message->broadcast) {
+                message = finish(message, true);
+            } else {
+                message->retransmitTime = time + configuration.retransmitTimeoutMicros;
+            }
+        }
+    }
+
+    for (const auto& item : outgoing) {
+        if (item.sentMask != getFullMask(item.fragmentCount)) {
+            next_time = std::min(next_time, std::max(nextFrameTime, time + 1));
+        } else if (!item.broadcast) {
+            next_time = std::min(next_time, item.retransmitTime);
+        }
+    }
+
+    // Send the acknowledgements that were delayed and forget old messages
+    for (auto& [address, peer] : peers) {
+        for (auto incoming = peer.incoming.begin(); incoming != peer.incoming.end();) {
+            auto& [key, message] = *incoming;
+            if (time >= message.expireTime) {
+                TT_LOG_W(TAG, "Discarded incomplete message %u", key.id);
+                incoming = peer.incoming.erase(incoming);
+                continue;
+            }
+            if (message.ackPending && time >= message.ackTime) {
+                if (sendAck(address, key.id, message.fragmentCount, message.receivedMask) == SendResult::Busy) {
+                    message.ackTime = time + configuration.ackDelayMicros;
+                } else {
+                    // When the sender can't be reached, it will retransmit and time out
+                    message.ackPending = false;
+                }
+            }
+            if (message.ackPending) {
+                next_time = std::min(next_time, message.ackTime);
+            }
+            next_time = std::min(next_time, message.expireTime);
+            ++incoming;
+        }
+
+        while (!peer.completedIds.empty() && time >= peer.completedIds.front().second + configuration.reassemblyTimeoutMicros) {
+            peer.completedIds.pop_front();
+        }
+    }
+
+    return next_time;
+}
+
+void Transport::takeEvents(std::vector<ReceivedMessage>& outMessages, std::vector<Completion>& outCompletions) {
+    outMessages = std::move(receivedMessages);
+    receivedMessages.clear();
+    outCompletions = std::move(completions);
+    completions.clear();
+}
+
+} // namespace tt::service::espnow
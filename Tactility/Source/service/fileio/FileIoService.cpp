@@ -0,0 +1,397 @@
+#include "Tactility/service/fileio/FileIoService.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/Log.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServiceRegistration.h>
+
+#include <cstring>
+#include <lvgl.h>
+
+namespace tt::service::fileio {
+
+constexpr auto* TAG = "FileIoService";
+extern const ServiceManifest manifest;
+
+FileIoService::FileIoService() :
+    // Give the display half a refresh period to continue rendering
+    busyBackoffTime(kernel::millisToTicks(LV_DEF_REFR_PERIOD / 2))
+{}
+
+bool FileIoService::onStart(ServiceContext& serviceContext) {
+    // Requests that were made before the start are handled immediately
+    eventFlag.clear(FlagStop);
+
+    thread = std::make_unique<Thread>(
+        "file_io",
+        4096,
+        [this]() {
+            return this->threadMain();
+        }
+    );
+    // Below the GUI and render threads
+    thread->setPriority(Thread::Priority::Normal);
+    thread->start();
+
+    return true;
+}
+
+void FileIoService::onStop(ServiceContext& serviceContext) {
+    if (thread != nullptr) {
+        // The thread handles the remaining requests before it exits
+        eventFlag.set(FlagStop);
+        thread->join();
+        thread = nullptr;
+    }
+}
+
+void FileIoService::enqueue(Request request) {
+    mutex.lock();
+    requests.push_back(std::move(request));
+    statistics.requests++;
+    mutex.unlock();
+
+    eventFlag.set(FlagRequest);
+}
+
+void FileIoService::complete(const std::shared_ptr<DispatcherThread>& dispatcher, std::function<void()> function) {
+    if (dispatcher != nullptr) {
+        if (!dispatcher->dispatch(std::move(function))) {
+            TT_LOG_W(TAG, "Failed to dispatch completion");
+        }
+    } else {
+        function();
+    }
+}
+
+int32_t FileIoService::threadMain() {
+    std::vector<Request> batch;
+    bool stopping = false;
+    while (!stopping) {
+        auto flags = eventFlag.wait(FlagRequest | FlagStop);
+        stopping = (flags & EventFlag::Error) == 0 && (flags & FlagStop) != 0;
+
+        while (true) {
+            mutex.lock();
+            batch.assign(std::make_move_iterator(requests.begin()), std::make_move_iterator(requests.end()));
+            requests.clear();
+            mutex.unlock();
+
+            if (batch.empty()) {
+                break;
+            }
+
+            size_t index = 0;
+            while (index < batch.size()) {
+                index += process(batch, index);
+            }
+            batch.clear();
+        }
+    }
+
+    return 0;
+}
+
+size_t FileIoService::process(std::vector<Request>& batch, size_t index) {
+    auto& request = batch[index];
+    size_t handled_count = 1;
+
+    // Count the requests after this one that can be handled together with this one
+    auto find_coalescable_count = [&batch, index, &request](RequestType type) {
+        size_t count = 0;
+        for (size_t i = index + 1; i < batch.size() && batch[i].type == type && batch[i].path == request.path; ++i) {
+            count++;
+        }
+        return count;
+    };
+
+    switch (request.type) {
+        case RequestType::Read: {
+            handled_count += find_coalescable_count(RequestType::Read);
+
+            auto data = std::make_shared<std::vector<uint8_t>>();
+            bool success = readFileChunked(request.path, *data);
+            for (size_t i = index; i < index + handled_count; ++i) {
+                auto& reader = batch[i];
+                complete(reader.dispatcher, [callback = std::move(reader.readCallback), success, data] {
+                    callback(success, success ? data : nullptr);
+                });
+            }
+            break;
+        }
+        case RequestType::Write:
+        case RequestType::Append: {
+            handled_count += find_coalescable_count(RequestType::Append);
+
+            std::vector<Data> parts;
+            parts.reserve(handled_count);
+            for (size_t i = index; i < index + handled_count; ++i) {
+                parts.push_back(batch[i].data);
+            }
+
+            bool success = writeFileChunked(request.path, parts, request.type == RequestType::Append);
+            for (size_t i = index; i < index + handled_count; ++i) {
+                auto& writer = batch[i];
+                if (writer.writeCallback != nullptr) {
+                    complete(writer.dispatcher, [callback = std::move(writer.writeCallback), success] {
+                        callback(success);
+                    });
+                }
+            }
+            break;
+        }
+        case RequestType::Stat: {
+            struct stat info = {};
+            bool success;
+            {
+                auto lock = file::getLock(request.path)->asScopedLock();
+                lock.lock();
+                success = ::stat(request.path.c_str(), &info) == 0;
+            }
+            complete(request.dispatcher, [callback = std::move(request.statCallback), success, info] {
+                callback(success, info);
+            });
+            break;
+        }
+        case RequestType::List: {
+            auto entries = std::make_shared<std::vector<dirent>>();
+            // Takes the lock by itself
+            bool success = file::scandir(request.path, *entries, file::direntFilterDotEntries, nullptr) >= 0;
+            complete(request.dispatcher, [callback = std::move(request.listCallback), success, entries] {
+                callback(success, *entries);
+            });
+            break;
+        }
+        case RequestType::Execute: {
+            bool success = request.job();
+            if (request.writeCallback != nullptr) {
+                complete(request.dispatcher, [callback = std::move(request.writeCallback), success] {
+                    callback(success);
+                });
+            }
+            break;
+        }
+    }
+
+    if (handled_count > 1) {
+        mutex.lock();
+        statistics.coalescedRequests += handled_count - 1;
+        mutex.unlock();
+    }
+
+    return handled_count;
+}
+
+bool FileIoService::lockChunk(const std::shared_ptr<Lock>& lock) {
+    if (lock->lock(0)) {
+        return false;
+    }
+
+    lock->lock(portMAX_DELAY);
+    mutex.lock();
+    statistics.busyLocks++;
+    mutex.unlock();
+    return true;
+}
+
+void FileIoService::unlockChunk(const std::shared_ptr<Lock>& lock, bool wasBusy) {
+    // Only the holder of the lock can be asked to yield it
+    const bool should_yield = lock->shouldYield();
+    lock->unlock();
+
+    mutex.lock();
+    statistics.chunks++;
+    if (should_yield) {
+        statistics.yields++;
+    }
+    auto backoff_time = busyBackoffTime;
+    mutex.unlock();
+
+    if (wasBusy || should_yield) {
+        // Others use the bus: let them continue before we take it again
+        kernel::delayTicks(backoff_time);
+    } else {
+        kernel::delayTicks(0); // Yield
+    }
+}
+
+bool FileIoService::readFileChunked(const std::string& path, std::vector<uint8_t>& output) {
+    auto lock = file::getLock(path);
+
+    bool was_busy = lockChunk(lock);
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), "rb"));
+    long file_size = (file != nullptr) ? file::getSize(file.get()) : -1;
+    unlockChunk(lock, was_busy);
+
+    if (file == nullptr || file_size < 0) {
+        TT_LOG_E(TAG, "Failed to open %s", path.c_str());
+        return false;
+    }
+
+    output.resize(file_size);
+    size_t offset = 0;
+    while (offset < output.size()) {
+        auto chunk_size = std::min(CHUNK_SIZE, output.size() - offset);
+        was_busy = lockChunk(lock);
+        auto bytes_read = fread(output.data() + offset, 1, chunk_size, file.get());
+        unlockChunk(lock, was_busy);
+
+        if (bytes_read != chunk_size) {
+            TT_LOG_E(TAG, "Failed to read %s", path.c_str());
+            return false;
+        }
+        offset += chunk_size;
+    }
+
+    lock->lock(portMAX_DELAY);
+    file = nullptr;
+    lock->unlock();
+    return true;
+}
+
+bool FileIoService::writeFileChunked(const std::string& path, const std::vector<Data>& parts, bool append) {
+    auto lock = file::getLock(path);
+
+    bool was_busy = lockChunk(lock);
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(path.c_str(), append ? "ab" : "wb"));
+    unlockChunk(lock, was_busy);
+
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", path.c_str());
+        return false;
+    }
+
+    // Fill chunks with the data of multiple parts, so small appends are written together
+    bool success = true;
+    // The thread stack is too small for the buffer
+    auto buffer = std::make_unique<uint8_t[]>(CHUNK_SIZE);
+    size_t buffer_length = 0;
+    auto write_buffer = [&] {
+        if (buffer_length == 0) {
+            return true;
+        }
+        bool was_busy = lockChunk(lock);
+        bool written = fwrite(buffer.get(), 1, buffer_length, file.get()) == buffer_length;
+        unlockChunk(lock, was_busy);
+        buffer_length = 0;
+        return written;
+    };
+
+    for (auto& part : parts) {
+        size_t offset = 0;
+        while (success && offset < part->size()) {
+            auto copy_size = std::min(CHUNK_SIZE - buffer_length, part->size() - offset);
+            memcpy(buffer.get() + buffer_length, part->data() + offset, copy_size);
+            buffer_length += copy_size;
+            offset += copy_size;
+            if (buffer_length == CHUNK_SIZE) {
+                success = write_buffer();
+            }
+        }
+    }
+
+    success = success && write_buffer();
+
+    lock->lock(portMAX_DELAY);
+    success = (fclose(file.release()) == 0) && success;
+    lock->unlock();
+
+    if (!success) {
+        TT_LOG_E(TAG, "Failed to write %s", path.c_str());
+    }
+
+    return success;
+}
+
+void FileIoService::readFile(const std::string& path, ReadCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(callback != nullptr);
+    enqueue({
+        .type = RequestType::Read,
+        .path = path,
+        .dispatcher = std::move(dispatcher),
+        .readCallback = std::move(callback)
+    });
+}
+
+void FileIoService::writeFile(const std::string& path, Data data, WriteCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(data != nullptr);
+    enqueue({
+        .type = RequestType::Write,
+        .path = path,
+        .data = std::move(data),
+        .dispatcher = std::move(dispatcher),
+        .writeCallback = std::move(callback)
+    });
+}
+
+void FileIoService::appendFile(const std::string& path, Data data, WriteCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(data != nullptr);
+    enqueue({
+        .type = RequestType::Append,
+        .path = path,
+        .data = std::move(data),
+        .dispatcher = std::move(dispatcher),
+        .writeCallback = std::move(callback)
+    });
+}
+
+void FileIoService::stat(const std::string& path, StatCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(callback != nullptr);
+    enqueue({
+        .type = RequestType::Stat,
+        .path = path,
+        .dispatcher = std::move(dispatcher),
+        .statCallback = std::move(callback)
+    });
+}
+
+void FileIoService::listDirectory(const std::string& path, ListCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(callback != nullptr);
+    enqueue({
+        .type = RequestType::List,
+        .path = path,
+        .dispatcher = std::move(dispatcher),
+        .listCallback = std::move(callback)
+    });
+}
+
+void FileIoService::execute(Job job, WriteCallback callback, std::shared_ptr<DispatcherThread> dispatcher) {
+    assert(job != nullptr);
+    enqueue({
+        .type = RequestType::Execute,
+        .job = std::move(job),
+        .dispatcher = std::move(dispatcher),
+        .writeCallback = std::move(callback)
+    });
+}
+
+void FileIoService::setBusyBackoffTime(TickType_t time) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    busyBackoffTime = time;
+}
+
+size_t FileIoService::getPendingRequestCount() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return requests.size();
+}
+
+FileIoService::Statistics FileIoService::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+std::shared_ptr<FileIoService> findFileIoService() {
+    auto service = findServiceById(manifest.id);
+    assert(service != nullptr);
+    return std::static_pointer_cast<FileIoService>(service);
+}
+
+extern const ServiceManifest manifest = {
+    .id = "FileIo",
+    .createService = create<FileIoService>
+};
+
+} // namespace tt::service::fileio
@@ -3,6 +3,8 @@
 #include <Tactility/service/ServicePaths.h>
 
 #include <cstring>
+#include <ctime>
+#include <format>
 #include <unistd.h>
 
 using tt::hal::gps::GpsDevice;
@@ -26,6 +28,22 @@ bool GpsService::getConfigurationFilePath(std::string& output) const {
     return true;
 }
 
+bool GpsService::getTrackFilePath(std::string& output) const {
+    if (paths == nullptr) {
+        TT_LOG_E(TAG, "Can't create track: service not started");
+        return false;
+    }
+
+    auto directory = paths->getUserDataPath("tracks");
+    if (!file::findOrCreateDirectory(directory, 0777)) {
+        TT_LOG_E(TAG, "Failed to find or create path %s", directory.c_str());
+        return false;
+    }
+
+    output = std::format("{}/track_{}.bin", directory, time(nullptr));
+    return true;
+}
+
 bool GpsService::getGpsConfigurations(std::vector<hal::gps::GpsConfiguration>& configurations) const {
     std::string path;
     if (!getConfigurationFilePath(path)) {
@@ -70,6 +70,10 @@ void GpsService::onStop(ServiceContext& serviceContext) {
     if (getState() == State::On) {
         stopReceiving();
     }
+
+    if (isRecording()) {
+        stopRecording();
+    }
 }
 
 bool GpsService::startGpsDevice(GpsDeviceRecord& record) {
@@ -191,10 +195,17 @@ void GpsService::stopReceiving() {
 }
 
 void GpsService::onGgaSentence(hal::Device::Id deviceId, const minmea_sentence_gga& gga) {
+    if (gga.fix_quality > 0 && gga.altitude_units == 'M') {
+        altitude = minmea_rescale(&gga.altitude, 10);
+    }
     TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, satellites: %d", deviceId, minmea_tocoord(&gga.latitude), minmea_tocoord(&gga.longitude), gga.satellites_tracked);
 }
 
 void GpsService::onRmcSentence(hal::Device::Id deviceId, const minmea_sentence_rmc& rmc) {
+    TrackPoint point;
+    if (trackRecorder != nullptr && createTrackPoint(rmc, altitude, point)) {
+        trackRecorder->addPoint(point);
+    }
     TT_LOG_D(TAG, "[device %lu] LAT %f LON %f, speed: %.2f", deviceId, minmea_tocoord(&rmc.latitude), minmea_tocoord(&rmc.longitude), minmea_tofloat(&rmc.speed));
 }
 
@@ -227,6 +238,56 @@ bool GpsService::getCoordinates(minmea_sentence_rmc& rmc) const {
     }
 }
 
+bool GpsService::startRecording() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (trackRecorder != nullptr) {
+        TT_LOG_W(TAG, "Already recording");
+        return true;
+    }
+
+    std::string path;
+    if (!getTrackFilePath(path)) {
+        return false;
+    }
+
+    auto recorder = std::make_unique<TrackRecorder>(path);
+    if (!recorder->start()) {
+        TT_LOG_E(TAG, "Failed to start recording");
+        return false;
+    }
+
+    trackRecorder = std::move(recorder);
+    return true;
+}
+
+void GpsService::stopRecording() {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    // Take ownership, so the GPS callbacks don't have to wait while the remaining points are written
+    auto recorder = std::move(trackRecorder);
+    lock.unlock();
+
+    if (recorder != nullptr) {
+        recorder->stop();
+    } else {
+        TT_LOG_W(TAG, "Not recording");
+    }
+}
+
+bool GpsService::isRecording() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return trackRecorder != nullptr;
+}
+
+std::string GpsService::getRecordingFilePath() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return (trackRecorder != nullptr) ? trackRecorder->getFilePath() : "";
+}
+
 std::shared_ptr<GpsService> findGpsService() {
     auto service = findServiceById(manifest.id);
     assert(service != nullptr);
@@ -0,0 +1,349 @@
+#include "Tactility/service/gps/GpsTrack.h"
+
+#include <Tactility/service/gps/GpsUtil.h>
+#include <Tactility/Log.h>
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <limits>
+
+namespace tt::service::gps {
+
+constexpr auto* TAG = "GpsTrack";
+
+template<typename DeltaType>
+static bool fitsDelta(int64_t delta) {
+    return delta >= std::numeric_limits<DeltaType>::min() && delta <= std::numeric_limits<DeltaType>::max();
+}
+
+static int32_t toFixedPointCoordinate(const minmea_float& value) {
+    return static_cast<int32_t>(std::lround(minmea_tocoord(&value) * 10000000.0));
+}
+
+bool createTrackPoint(const minmea_sentence_rmc& rmc, int32_t altitude, TrackPoint& point) {
+    if (!rmc.valid || !hal::gps::isValid(rmc.latitude) || !hal::gps::isValid(rmc.longitude)) {
+        return false;
+    }
+
+    timespec time;
+    if (minmea_gettime(&time, &rmc.date, &rmc.time) != 0 || time.tv_sec < 0) {
+        return false;
+    }
+
+    point = {
+        .time = static_cast<uint32_t>(time.tv_sec),
+        .latitude = toFixedPointCoordinate(rmc.latitude),
+        .longitude = toFixedPointCoordinate(rmc.longitude),
+        .altitude = altitude
+    };
+    return true;
+}
+
+void beginTrackChunk(TrackChunk& chunk, const TrackPoint& point) {
+    chunk = {
+        .start = point,
+        .deltaCount = 0,
+        .reserved = 0,
+        .deltas = {}
+    };
+}
+
+bool appendTrackChunk(TrackChunk& chunk, const TrackPoint& lastPoint, const TrackPoint& point) {
+    if (chunk.deltaCount >= TRACK_CHUNK_DELTA_COUNT) {
+        return false;
+    }
+
+    // Time must not go backwards, otherwise the chunks can't be searched
+    if (point.time < lastPoint.time) {
+        return false;
+    }
+
+    int64_t time_delta = static_cast<int64_t>(point.time) - lastPoint.time;
+    int64_t latitude_delta = static_cast<int64_t>(point.latitude) - lastPoint.latitude;
+    int64_t longitude_delta = static_cast<int64_t>(point.longitude) - lastPoint.longitude;
+    int64_t altitude_delta = static_cast<int64_t>(point.altitude) - lastPoint.altitude;
+    if (
+        !fitsDelta<uint16_t>(time_delta) ||
+        !fitsDelta<int16_t>(latitude_delta) ||
+        !fitsDelta<int16_t>(longitude_delta) ||
+        !fitsDelta<int16_t>(altitude_delta)
+    ) {
+        return false;
+    }
+
+    chunk.deltas[chunk.deltaCount++] = {
+        .time = static_cast<uint16_t>(time_delta),
+        .latitude = static_cast<int16_t>(latitude_delta),
+        .longitude = static_cast<int16_t>(longitude_delta),
+        .altitude = static_cast<int16_t>(altitude_delta)
+    };
+    return true;
+}
+
+// region TrackReader
+
+bool TrackReader::open() {
+    hasChunk = false;
+    hasPendingPoint = false;
+    pointIndex = 0;
+    if (!reader.open()) {
+        return false;
+    }
+
+    if (reader.getRecordVersion() != TRACK_RECORD_VERSION) {
+        TT_LOG_E(TAG, "Unsupported track version %lu", reader.getRecordVersion());
+        reader.close();
+        return false;
+    }
+
+    return true;
+}
+
+void TrackReader::close() {
+    hasChunk = false;
+    hasPendingPoint = false;
+    pointIndex = 0;
+    reader.close();
+}
+
+bool TrackReader::readChunk() {
+    hasChunk = reader.hasNext() && reader.readNext(&chunk);
+    if (hasChunk && chunk.deltaCount > TRACK_CHUNK_DELTA_COUNT) {
+        TT_LOG_E(TAG, "Corrupt chunk: %u deltas", chunk.deltaCount);
+        hasChunk = false;
+    }
+    pointIndex = 0;
+    return hasChunk;
+}
+
+bool TrackReader::readChunkAt(uint32_t chunkIndex) {
+    return reader.seek(chunkIndex) && readChunk();
+}
+
+bool TrackReader::seek(uint32_t time) {
+    hasPendingPoint = false;
+
+    // Find the last chunk that starts at or before the requested time
+    uint32_t low = 0;
+    uint32_t high = getChunkCount();
+    while (high - low > 1) {
+        uint32_t middle = low + (high - low) / 2;
+        if (!readChunkAt(middle)) {
+            return false;
+        }
+        if (chunk.start.time <= time) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (high == 0 || !readChunkAt(low)) {
+        return false;
+    }
+
+    // Skip the points before the requested time: they might continue in the next chunk
+    TrackPoint candidate;
+    while (readNext(candidate)) {
+        if (candidate.time >= time) {
+            // Return it again on the next read
+            pendingPoint = candidate;
+            hasPendingPoint = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TrackReader::hasNext() const {
+    return hasPendingPoint || (hasChunk && pointIndex < getTrackChunkPointCount(chunk)) || reader.hasNext();
+}
+
+bool TrackReader::readNext(TrackPoint& output) {
+    if (hasPendingPoint) {
+        hasPendingPoint = false;
+        output = pendingPoint;
+        return true;
+    }
+
+    if (!hasChunk || pointIndex >= getTrackChunkPointCount(chunk)) {
+        if (!readChunk()) {
+            return false;
+        }
+    }
+
+    if (pointIndex == 0) {
+        point = chunk.start;
+    } else {
+        auto& delta = chunk.deltas[pointIndex - 1];
+        point.time += delta.time;
+        point.latitude += delta.latitude;
+        point.longitude += delta.longitude;
+        point.altitude += delta.altitude;
+    }
+
+    pointIndex++;
+    output = point;
+    return true;
+}
+
+// endregion TrackReader
+
+// region Export
+
+/** Points that are read per file lock acquisition */
+constexpr size_t EXPORT_BATCH_SIZE = TRACK_CHUNK_DELTA_COUNT + 1;
+/** Amount of text that is buffered before writing it */
+constexpr size_t EXPORT_WRITE_SIZE = 2048;
+
+typedef std::function<void(std::string& output, const TrackPoint& point, bool isFirst)> PointFormatter;
+
+/** Formats a fixed-point value without relying on floating point formatting */
+static std::string formatFixedPoint(int32_t value, int32_t divider, int decimals) {
+    auto absolute_value = std::abs(static_cast<int64_t>(value));
+    char buffer[24];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%s%" PRId64 ".%0*" PRId64,
+        (value < 0) ? "-" : "",
+        absolute_value / divider,
+        decimals,
+        absolute_value % divider
+    );
+    return buffer;
+}
+
+static std::string formatCoordinate(int32_t value) { return formatFixedPoint(value, 10000000, 7); }
+
+static std::string formatAltitude(int32_t value) { return formatFixedPoint(value, 10, 1); }
+
+static bool writeExportText(const std::string& outputPath, FILE* file, std::string& text) {
+    if (text.empty()) {
+        return true;
+    }
+
+    auto lock = file::getLock(outputPath)->asScopedLock();
+    lock.lock();
+    bool result = fwrite(text.data(), 1, text.size(), file) == text.size();
+    text.clear();
+    return result;
+}
+
+static bool exportTrack(
+    const std::string& trackPath,
+    const std::string& outputPath,
+    const char* header,
+    const char* footer,
+    const PointFormatter& formatter
+) {
+    TrackReader reader(trackPath);
+    auto track_lock = file::getLock(trackPath)->asScopedLock();
+    track_lock.lock();
+    if (!reader.open()) {
+        TT_LOG_E(TAG, "Failed to open %s", trackPath.c_str());
+        return false;
+    }
+    track_lock.unlock();
+
+    auto output_lock = file::getLock(outputPath)->asScopedLock();
+    output_lock.lock();
+    auto file = std::unique_ptr<FILE, file::FileCloser>(fopen(outputPath.c_str(), "w"));
+    output_lock.unlock();
+    if (file == nullptr) {
+        TT_LOG_E(TAG, "Failed to open %s", outputPath.c_str());
+        return false;
+    }
+
+    std::string text = header;
+    TrackPoint points[EXPORT_BATCH_SIZE];
+    bool is_first = true;
+    bool has_more = true;
+    while (has_more) {
+        // Only hold the lock while reading, so the bus is released regularly
+        size_t point_count = 0;
+        track_lock.lock();
+        while (point_count < EXPORT_BATCH_SIZE && reader.readNext(points[point_count])) {
+            point_count++;
+        }
+        has_more = (point_count == EXPORT_BATCH_SIZE);
+        track_lock.unlock();
+
+        for (size_t i = 0; i < point_count; ++i) {
+            formatter(text, points[i], is_first);
+            is_first = false;
+        }
+
+        if (text.size() >= EXPORT_WRITE_SIZE && !writeExportText(outputPath, file.get(), text)) {
+            TT_LOG_E(TAG, "Failed to write to %s", outputPath.c_str());
+            return false;
+        }
+    }
+
+    text += footer;
+    if (!writeExportText(outputPath, file.get(), text)) {
+        TT_LOG_E(TAG, "Failed to write to %s", outputPath.c_str());
+        return false;
+    }
+
+    output_lock.lock();
+    file = nullptr;
+    output_lock.unlock();
+
+    track_lock.lock();
+    reader.close();
+    track_lock.unlock();
+
+    return true;
+}
+
+bool exportTrackToGpx(const std::string& trackPath, const std::string& outputPath) {
+    constexpr auto* header =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<gpx version=\"1.1\" creator=\"Tactility\" xmlns=\"http://www.topografix.com/GPX/1/1\">\n"
+        "<trk><trkseg>\n";
+    constexpr auto* footer = "</trkseg></trk>\n</gpx>\n";
+    return exportTrack(trackPath, outputPath, header, footer, [](std::string& output, const TrackPoint& point, bool) {
+        time_t time = point.time;
+        tm time_info;
+        gmtime_r(&time, &time_info);
+        char time_text[24];
+        strftime(time_text, sizeof(time_text), "%Y-%m-%dT%H:%M:%SZ", &time_info);
+
+        output += "<trkpt lat=\"";
+        output += formatCoordinate(point.latitude);
+        output += "\" lon=\"";
+        output += formatCoordinate(point.longitude);
+        output += "\"><ele>";
+        output += formatAltitude(point.altitude);
+        output += "</ele><time>";
+        output += time_text;
+        output += "</time></trkpt>\n";
+    });
+}
+
+bool exportTrackToGeoJson(const std::string& trackPath, const std::string& outputPath) {
+    constexpr auto* header = "{\"type\":\"Feature\",\"properties\":{},\"geometry\":{\"type\":\"LineString\",\"coordinates\":[\n";
+    constexpr auto* footer = "\n]}}\n";
+    return exportTrack(trackPath, outputPath, header, footer, [](std::string& output, const TrackPoint& point, bool isFirst) {
+        if (!isFirst) {
+            output += ",\n";
+        }
+        // GeoJSON positions are longitude first
+        output += "[";
+        output += formatCoordinate(point.longitude);
+        output += ",";
+        output += formatCoordinate(point.latitude);
+        output += ",";
+        output += formatAltitude(point.altitude);
+        output += "]";
+    });
+}
+
+// endregion Export
+
+} // namespace tt::service::gps
@@ -0,0 +1,162 @@
+#include "Tactility/service/gps/GpsTrackRecorder.h"
+
+#include <Tactility/Log.h>
+
+namespace tt::service::gps {
+
+constexpr auto* TAG = "TrackRecorder";
+
+TrackRecorder::~TrackRecorder() {
+    if (isStarted()) {
+        stop();
+    }
+}
+
+bool TrackRecorder::start() {
+    if (isStarted()) {
+        TT_LOG_W(TAG, "Already started");
+        return true;
+    }
+
+    auto new_writer = std::make_unique<file::ObjectFileWriter>(filePath, sizeof(TrackChunk), TRACK_RECORD_VERSION, false);
+    auto lock = file::getLock(filePath)->asScopedLock();
+    lock.lock();
+    if (!new_writer->open()) {
+        TT_LOG_E(TAG, "Failed to create %s", filePath.c_str());
+        return false;
+    }
+    lock.unlock();
+
+    writer = std::move(new_writer);
+    hasCurrentChunk = false;
+    pendingChunks.reserve(MAX_PENDING_CHUNKS);
+    writingChunks.reserve(MAX_PENDING_CHUNKS);
+    statistics = {};
+    eventFlag.clear(FlagFlush | FlagStop);
+
+    thread = std::make_unique<Thread>(
+        "gps_track",
+        4096,
+        [this]() {
+            return this->threadMain();
+        }
+    );
+    thread->setPriority(Thread::Priority::Low);
+    thread->start();
+
+    TT_LOG_I(TAG, "Recording to %s", filePath.c_str());
+    return true;
+}
+
+void TrackRecorder::stop() {
+    if (!isStarted()) {
+        TT_LOG_W(TAG, "Not started");
+        return;
+    }
+
+    mutex.lock();
+    if (hasCurrentChunk) {
+        queueCurrentChunk();
+        hasCurrentChunk = false;
+    }
+    mutex.unlock();
+
+    // The thread writes the pending chunks before it exits
+    eventFlag.set(FlagStop);
+    thread->join();
+    thread = nullptr;
+
+    auto lock = file::getLock(filePath)->asScopedLock();
+    lock.lock();
+    writer->close();
+    lock.unlock();
+    writer = nullptr;
+
+    auto final_statistics = getStatistics();
+    TT_LOG_I(TAG, "Recorded %lu points in %lu chunks (%lu dropped)", final_statistics.pointsRecorded, final_statistics.chunksWritten, final_statistics.pointsDropped);
+}
+
+void TrackRecorder::addPoint(const TrackPoint& point) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (!hasCurrentChunk) {
+        beginTrackChunk(currentChunk, point);
+        hasCurrentChunk = true;
+    } else if (point.time < lastPoint.time) {
+        TT_LOG_W(TAG, "Ignoring point: time went backwards");
+        return;
+    } else if (!appendTrackChunk(currentChunk, lastPoint, point)) {
+        queueCurrentChunk();
+        beginTrackChunk(currentChunk, point);
+    }
+
+    lastPoint = point;
+    statistics.pointsRecorded++;
+}
+
+/** Must be called while holding the mutex */
+void TrackRecorder::queueCurrentChunk() {
+    if (pendingChunks.size() < MAX_PENDING_CHUNKS) {
+        pendingChunks.push_back(currentChunk);
+        eventFlag.set(FlagFlush);
+    } else {
+        TT_LOG_W(TAG, "Writer can't keep up: dropping chunk");
+        statistics.pointsDropped += getTrackChunkPointCount(currentChunk);
+    }
+}
+
+void TrackRecorder::writePendingChunks() {
+    // Swapping keeps the memory of both vectors, so no allocations happen while recording
+    mutex.lock();
+    std::swap(writingChunks, pendingChunks);
+    mutex.unlock();
+
+    auto file_lock = file::getLock(filePath);
+    uint32_t chunks_written = 0;
+    uint32_t points_dropped = 0;
+    for (auto& chunk : writingChunks) {
+        // Lock per chunk, so others can use the bus in between
+        file_lock->lock(portMAX_DELAY);
+        bool written = writer->write(&chunk);
+        file_lock->unlock();
+
+        if (written) {
+            chunks_written++;
+        } else {
+            points_dropped += getTrackChunkPointCount(chunk);
+        }
+    }
+
+    // Checkpoint, so the chunks survive a power loss
+    if (!writingChunks.empty()) {
+        file_lock->lock(portMAX_DELAY);
+        writer->flush();
+        file_lock->unlock();
+    }
+
+    mutex.lock();
+    statistics.chunksWritten += chunks_written;
+    statistics.pointsDropped += points_dropped;
+    mutex.unlock();
+
+    writingChunks.clear();
+}
+
+int32_t TrackRecorder::threadMain() {
+    bool stopping = false;
+    while (!stopping) {
+        auto flags = eventFlag.wait(FlagFlush | FlagStop, EventFlag::WaitAny, flushInterval);
+        stopping = (flags & EventFlag::Error) == 0 && (flags & FlagStop) != 0;
+        writePendingChunks();
+    }
+    return 0;
+}
+
+TrackRecorder::Statistics TrackRecorder::getStatistics() const {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    return statistics;
+}
+
+} // namespace tt::service::gps
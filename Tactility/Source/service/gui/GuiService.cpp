@@ -248,7 +248,9 @@ std::shared_ptr<GuiService> findService() {
 
 extern const ServiceManifest manifest = {
     .id = "Gui",
-    .createService = create<GuiService>
+    .createService = create<GuiService>,
+    .dependencies = { "Loader" },
+    .startPhase = StartPhase::Gui
 };
 
 // endregion
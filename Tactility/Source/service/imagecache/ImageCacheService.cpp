@@ -0,0 +1,353 @@
+#include "Tactility/service/imagecache/ImageCache.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/lvgl/LvglSync.h>
+#include <Tactility/service/ServiceContext.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServiceRegistration.h>
+
+#include <lvgl.h>
+#include <src/core/lv_global.h>
+#include <src/draw/lv_draw_buf_private.h>
+#include <src/draw/lv_image_decoder_private.h>
+#include <src/misc/cache/lv_cache_private.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// The budget in kB, where 0 means that it depends on the availability of PSRAM
+#ifndef CONFIG_TT_IMAGE_CACHE_SIZE
+#define CONFIG_TT_IMAGE_CACHE_SIZE 0
+#endif
+
+namespace tt::service::imagecache {
+
+constexpr auto* TAG = "ImageCache";
+
+/** Icons are small, but the launcher and the app list show a lot of them */
+constexpr uint32_t DEFAULT_BUDGET = 96 * 1024;
+constexpr uint32_t DEFAULT_BUDGET_PSRAM = 1024 * 1024;
+/** LVGL looks up the image header for every layout, so it has a separate cache */
+constexpr uint32_t HEADER_CACHE_COUNT = 64;
+
+extern const ServiceManifest manifest;
+
+// region LVGL hooks
+
+struct DecoderRecord {
+    lv_image_decoder_t* decoder;
+    lv_image_decoder_open_f_t openFunction;
+};
+
+// The hooks are called by the LVGL task and the draw units
+static Mutex statisticsMutex;
+static Statistics statistics = {};
+// Only changed while the service starts and stops, with the LVGL lock held
+static std::vector<DecoderRecord> decoderRecords;
+static const lv_cache_class_t* imageCacheClass = nullptr;
+static lv_cache_class_t statisticsCacheClass;
+
+static uint32_t getTime() {
+    return static_cast<uint32_t>(kernel::getMicros());
+}
+
+/** Count the cache lookups: LVGL looks up an image in the cache before it opens it with a decoder */
+static lv_cache_entry_t* getCacheEntry(lv_cache_t* cache, const void* key, void* userData) {
+    auto* entry = imageCacheClass->get_cb(cache, key, userData);
+    statisticsMutex.lock();
+    if (entry != nullptr) {
+        statistics.hits++;
+    } else {
+        statistics.misses++;
+    }
+    statisticsMutex.unlock();
+    return entry;
+}
+
+static lv_result_t openImage(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc) {
+    auto record = std::ranges::find_if(decoderRecords, [decoder](const auto& item) {
+        return item.decoder == decoder;
+    });
+    if (record == decoderRecords.end()) {
+        return LV_RESULT_INVALID;
+    }
+
+    const auto start_time = getTime();
+    const auto result = record->openFunction(decoder, dsc);
+    const auto duration = getTime() - start_time;
+
+    if (result == LV_RESULT_OK) {
+        statisticsMutex.lock();
+        statistics.decodes++;
+        statistics.totalDecodeMicros += duration;
+        statistics.maxDecodeMicros = std::max(statistics.maxDecodeMicros, duration);
+        statisticsMutex.unlock();
+    }
+
+    return result;
+}
+
+#ifdef ESP_PLATFORM
+
+static lv_draw_buf_malloc_cb defaultImageMalloc = nullptr;
+
+/** Decoded images can be large, so they're placed in PSRAM, like the LVGL default it reserves space for the alignment */
+static void* psramImageMalloc(size_t size, lv_color_format_t colorFormat) {
+    auto* buffer = heap_caps_malloc(size + LV_DRAW_BUF_ALIGN - 1, MALLOC_CAP_SPIRAM);
+    return (buffer != nullptr) ? buffer : defaultImageMalloc(size, colorFormat);
+}
+
+#endif
+
+static bool hasPsram() {
+#ifdef ESP_PLATFORM
+    return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+#else
+    return false;
+#endif
+}
+
+static void installHooks() {
+    auto* image_cache = LV_GLOBAL_DEFAULT()->img_cache;
+    imageCacheClass = image_cache->clz;
+    statisticsCacheClass = *imageCacheClass;
+    statisticsCacheClass.get_cb = getCacheEntry;
+    image_cache->clz = &statisticsCacheClass;
+
+    auto* decoder = lv_image_decoder_get_next(nullptr);
+    while (decoder != nullptr) {
+        if (decoder->open_cb != nullptr) {
+            decoderRecords.push_back({ .decoder = decoder, .openFunction = decoder->open_cb });
+        }
+        decoder = lv_image_decoder_get_next(decoder);
+    }
+    for (const auto& record : decoderRecords) {
+        record.decoder->open_cb = openImage;
+    }
+
+#ifdef ESP_PLATFORM
+    if (hasPsram()) {
+        auto* handlers = lv_draw_buf_get_image_handlers();
+        defaultImageMalloc = handlers->buf_malloc_cb;
+        handlers->buf_malloc_cb = psramImageMalloc;
+    }
+#endif
+}
+
+static void uninstallHooks() {
+#ifdef ESP_PLATFORM
+    if (defaultImageMalloc != nullptr) {
+        lv_draw_buf_get_image_handlers()->buf_malloc_cb = defaultImageMalloc;
+        defaultImageMalloc = nullptr;
+    }
+#endif
+
+    for (const auto& record : decoderRecords) {
+        record.decoder->open_cb = record.openFunction;
+    }
+    decoderRecords.clear();
+
+    LV_GLOBAL_DEFAULT()->img_cache->clz = imageCacheClass;
+    imageCacheClass = nullptr;
+}
+
+// endregion LVGL hooks
+
+// region Service
+
+class ImageCacheService final : public Service {
+
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+    std::map<std::string, lv_image_decoder_dsc_t> pinnedImages;
+    uint32_t budget = 0;
+    uint32_t initialBudget = 0;
+    uint32_t initialHeaderCount = 0;
+
+public:
+
+    bool onStart(ServiceContext& serviceContext) override {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return false;
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        initialBudget = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, nullptr);
+        initialHeaderCount = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_header_cache, nullptr);
+
+        installHooks();
+        budget = getDefaultBudget();
+        lv_image_cache_resize(budget, true);
+        lv_image_header_cache_resize(HEADER_CACHE_COUNT, true);
+        lvgl::unlock();
+
+        TT_LOG_I(TAG, "Budget: %lu kB%s", budget / 1024UL, hasPsram() ? " (PSRAM)" : "");
+        return true;
+    }
+
+    void onStop(ServiceContext& serviceContext) override {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return;
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        for (auto& [path, dsc] : pinnedImages) {
+            lv_image_decoder_close(&dsc);
+        }
+        pinnedImages.clear();
+
+        lv_image_cache_resize(initialBudget, true);
+        lv_image_header_cache_resize(initialHeaderCount, true);
+        uninstallHooks();
+        lvgl::unlock();
+    }
+
+    void setBudget(uint32_t newBudget) {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return;
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+        budget = newBudget;
+        lv_image_cache_resize(budget, true);
+        lvgl::unlock();
+    }
+
+    bool pin(const std::string& path) {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return false;
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        bool pinned = pinnedImages.contains(path);
+        if (!pinned && budget > 0) {
+            // The key outlives the decoder session, so LVGL can refer to it
+            auto [entry, inserted] = pinnedImages.emplace(path, lv_image_decoder_dsc_t {});
+            auto& dsc = entry->second;
+            // An open decoder session keeps a reference to the cache entry, so the entry can't be evicted
+            const bool opened = lv_image_decoder_open(&dsc, entry->first.c_str(), nullptr) == LV_RESULT_OK;
+            pinned = opened && dsc.cache_entry != nullptr;
+            if (!pinned) {
+                if (opened) {
+                    // Images that aren't cached don't need decoding (e.g. the ones in the asset pack)
+                    lv_image_decoder_close(&dsc);
+                    pinned = true;
+                } else {
+                    TT_LOG_W(TAG, "Failed to pin %s", path.c_str());
+                }
+                pinnedImages.erase(entry);
+            }
+        }
+
+        lvgl::unlock();
+        return pinned;
+    }
+
+    void unpin(const std::string& path) {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return;
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        auto entry = pinnedImages.find(path);
+        if (entry != pinnedImages.end()) {
+            lv_image_decoder_close(&entry->second);
+            pinnedImages.erase(entry);
+        }
+
+        lvgl::unlock();
+    }
+
+    Statistics getStatistics() {
+        if (!lvgl::lock(portMAX_DELAY)) {
+            return {};
+        }
+
+        auto lock = mutex.asScopedLock();
+        lock.lock();
+
+        statisticsMutex.lock();
+        auto result = statistics;
+        statisticsMutex.unlock();
+
+        result.budget = budget;
+        result.size = lv_cache_get_size(LV_GLOBAL_DEFAULT()->img_cache, nullptr);
+        result.pinnedCount = pinnedImages.size();
+
+        lvgl::unlock();
+        return result;
+    }
+};
+
+// endregion Service
+
+// region Public API
+
+static std::shared_ptr<ImageCacheService> findService() {
+    return findServiceById<ImageCacheService>(manifest.id);
+}
+
+uint32_t getDefaultBudget() {
+    if (CONFIG_TT_IMAGE_CACHE_SIZE > 0) {
+        return CONFIG_TT_IMAGE_CACHE_SIZE * 1024;
+    } else if (hasPsram()) {
+        return DEFAULT_BUDGET_PSRAM;
+    } else {
+        return DEFAULT_BUDGET;
+    }
+}
+
+void setBudget(uint32_t budget) {
+    auto service = findService();
+    if (service != nullptr) {
+        service->setBudget(budget);
+    }
+}
+
+bool pin(const std::string& path) {
+    auto service = findService();
+    return service != nullptr && service->pin(path);
+}
+
+void unpin(const std::string& path) {
+    auto service = findService();
+    if (service != nullptr) {
+        service->unpin(path);
+    }
+}
+
+Statistics getStatistics() {
+    auto service = findService();
+    return (service != nullptr) ? service->getStatistics() : Statistics {};
+}
+
+void resetStatistics() {
+    statisticsMutex.lock();
+    statistics = {};
+    statisticsMutex.unlock();
+}
+
+// endregion Public API
+
+extern const ServiceManifest manifest = {
+    .id = "ImageCache",
+    .createService = create<ImageCacheService>,
+    .startPhase = StartPhase::Gui
+};
+
+}
@@ -42,7 +42,8 @@ public:
 
 extern const ServiceManifest manifest = {
     .id = "KeyboardInit",
-    .createService = create<KeyboardInitService>
+    .createService = create<KeyboardInitService>,
+    .startPhase = StartPhase::Gui
 };
 
 }
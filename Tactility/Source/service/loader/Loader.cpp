@@ -323,7 +323,8 @@ std::shared_ptr<LoaderService> _Nullable findLoaderService() {
 
 extern const ServiceManifest manifest = {
     .id = "Loader",
-    .createService = create<LoaderService>
+    .createService = create<LoaderService>,
+    .startPhase = StartPhase::Gui
 };
 
 
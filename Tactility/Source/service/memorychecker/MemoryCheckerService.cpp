@@ -87,7 +87,9 @@ void MemoryCheckerService::onTimerUpdate() {
 
 extern const ServiceManifest manifest = {
     .id = "MemoryChecker",
-    .createService = create<MemoryCheckerService>
+    .createService = create<MemoryCheckerService>,
+    .dependencies = { "Statusbar" },
+    .startPhase = StartPhase::Gui
 };
 
 }
@@ -18,7 +18,7 @@ std::shared_ptr<ScreenshotService> _Nullable optScreenshotService() {
     return service::findServiceById<ScreenshotService>(manifest.id);
 }
 
-void ScreenshotService::startApps(const std::string& path) {
+void ScreenshotService::startApps(const std::string& path, Format format) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(50 / portTICK_PERIOD_MS)) {
         TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
@@ -28,13 +28,13 @@ void ScreenshotService::startApps(const std::string& path) {
     if (task == nullptr || task->isFinished()) {
         task = std::make_unique<ScreenshotTask>();
         mode = Mode::Apps;
-        task->startApps(path);
+        task->startApps(path, format);
     } else {
         TT_LOG_W(TAG, "Screenshot task already running");
     }
 }
 
-void ScreenshotService::startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount) {
+void ScreenshotService::startTimed(const std::string& path, uint8_t delayInSeconds, uint8_t amount, Format format) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(50 / portTICK_PERIOD_MS)) {
         TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
@@ -44,7 +44,23 @@ void ScreenshotService::startTimed(const std::string& path, uint8_t delayInSecon
     if (task == nullptr || task->isFinished()) {
         task = std::make_unique<ScreenshotTask>();
         mode = Mode::Timed;
-        task->startTimed(path, delayInSeconds, amount);
+        task->startTimed(path, delayInSeconds, amount, format);
+    } else {
+        TT_LOG_W(TAG, "Screenshot task already running");
+    }
+}
+
+void ScreenshotService::startSequence(const std::string& path, uint32_t intervalMillis, uint32_t frameAmount) {
+    auto lock = mutex.asScopedLock();
+    if (!lock.lock(50 / portTICK_PERIOD_MS)) {
+        TT_LOG_W(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+        return;
+    }
+
+    if (task == nullptr || task->isFinished()) {
+        task = std::make_unique<ScreenshotTask>();
+        mode = Mode::Sequence;
+        task->startSequence(path, intervalMillis, frameAmount);
     } else {
         TT_LOG_W(TAG, "Screenshot task already running");
     }
@@ -95,7 +111,9 @@ bool ScreenshotService::isTaskStarted() {
 
 extern const ServiceManifest manifest = {
     .id = "Screenshot",
-    .createService = create<ScreenshotService>
+    .createService = create<ScreenshotService>,
+    .dependencies = { "Gui", "FileIo" },
+    .startPhase = StartPhase::Gui
 };
 
 } // namespace
@@ -0,0 +1,306 @@
+#include "Tactility/TactilityConfig.h"
+
+#if TT_FEATURE_SCREENSHOT_ENABLED
+
+#include "Tactility/service/screenshot/ScreenshotEncoder.h"
+
+#include <cstring>
+#include <lvgl.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+// LVGL's lodepng.h can't be included from C++ sources, because its C++ API is declared inside an extern "C" block
+extern "C" unsigned lodepng_encode24(unsigned char** out, size_t* outsize, const unsigned char* image, unsigned w, unsigned h);
+
+namespace tt::service::screenshot {
+
+struct Rgb {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+/** Expand to 8 bits per channel: the high bits are repeated in the low bits, so white stays white */
+static Rgb toRgb(uint16_t pixel) {
+    const uint8_t red = pixel >> 11;
+    const uint8_t green = (pixel >> 5) & 0x3F;
+    const uint8_t blue = pixel & 0x1F;
+    return {
+        .red = static_cast<uint8_t>((red << 3) | (red >> 2)),
+        .green = static_cast<uint8_t>((green << 2) | (green >> 4)),
+        .blue = static_cast<uint8_t>((blue << 3) | (blue >> 2))
+    };
+}
+
+static void appendUint16(std::vector<uint8_t>& output, uint16_t value) {
+    output.push_back(value & 0xFF);
+    output.push_back(value >> 8);
+}
+
+static void appendUint32(std::vector<uint8_t>& output, uint32_t value) {
+    output.push_back(value & 0xFF);
+    output.push_back((value >> 8) & 0xFF);
+    output.push_back((value >> 16) & 0xFF);
+    output.push_back(value >> 24);
+}
+
+static void appendUint32BigEndian(std::vector<uint8_t>& output, uint32_t value) {
+    output.push_back(value >> 24);
+    output.push_back((value >> 16) & 0xFF);
+    output.push_back((value >> 8) & 0xFF);
+    output.push_back(value & 0xFF);
+}
+
+static void appendPixels(const Frame& frame, const Area& area, std::vector<uint8_t>& output) {
+    const size_t row_size = area.width * sizeof(uint16_t);
+    size_t offset = output.size();
+    output.resize(offset + (row_size * area.height));
+    for (uint32_t y = area.y; y < area.y + area.height; y++) {
+        memcpy(output.data() + offset, frame.getRow(y) + area.x, row_size);
+        offset += row_size;
+    }
+}
+
+bool Frame::reserve(size_t size) {
+    if (size <= capacity) {
+        return true;
+    }
+
+    data.reset();
+    capacity = 0;
+#ifdef ESP_PLATFORM
+    auto* buffer = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM));
+    if (buffer == nullptr) {
+        buffer = static_cast<uint8_t*>(malloc(size));
+    }
+#else
+    auto* buffer = static_cast<uint8_t*>(malloc(size));
+#endif
+    if (buffer == nullptr) {
+        return false;
+    }
+
+    data.reset(buffer);
+    capacity = size;
+    return true;
+}
+
+const char* getFileExtension(Format format) {
+    switch (format) {
+        case Format::Png:
+            return "png";
+        case Format::Qoi:
+            return "qoi";
+        case Format::Raw:
+            return "raw";
+    }
+    return "";
+}
+
+bool encode(const Frame& frame, Format format, std::vector<uint8_t>& output) {
+    output.clear();
+    switch (format) {
+        case Format::Png:
+            return encodePng(frame, output);
+        case Format::Qoi:
+            return encodeQoi(frame, output);
+        case Format::Raw:
+            return encodeRaw(frame, output);
+    }
+    return false;
+}
+
+bool encodePng(const Frame& frame, std::vector<uint8_t>& output) {
+    const size_t rgb_size = frame.width * frame.height * 3;
+    auto rgb = std::unique_ptr<uint8_t[]>(new (std::nothrow) uint8_t[rgb_size]);
+    if (rgb == nullptr) {
+        return false;
+    }
+
+    uint8_t* target = rgb.get();
+    for (uint32_t y = 0; y < frame.height; y++) {
+        const uint16_t* row = frame.getRow(y);
+        for (uint32_t x = 0; x < frame.width; x++) {
+            const auto pixel = toRgb(row[x]);
+            *target++ = pixel.red;
+            *target++ = pixel.green;
+            *target++ = pixel.blue;
+        }
+    }
+
+    unsigned char* png = nullptr;
+    size_t png_size = 0;
+    if (lodepng_encode24(&png, &png_size, rgb.get(), frame.width, frame.height) != 0) {
+        lv_free(png);
+        return false;
+    }
+
+    output.assign(png, png + png_size);
+    lv_free(png);
+    return true;
+}
+
+/** See https://qoiformat.org/qoi-specification.pdf */
+bool encodeQoi(const Frame& frame, std::vector<uint8_t>& output) {
+    constexpr uint8_t QOI_OP_INDEX = 0x00;
+    constexpr uint8_t QOI_OP_DIFF = 0x40;
+    constexpr uint8_t QOI_OP_LUMA = 0x80;
+    constexpr uint8_t QOI_OP_RUN = 0xC0;
+    constexpr uint8_t QOI_OP_RGB = 0xFE;
+
+    // Worst case: every pixel is stored as QOI_OP_RGB
+    output.reserve(output.size() + 14 + (frame.width * frame.height * 4) + 8);
+    output.insert(output.end(), { 'q', 'o', 'i', 'f' });
+    appendUint32BigEndian(output, frame.width);
+    appendUint32BigEndian(output, frame.height);
+    output.push_back(3); // Channels: RGB
+    output.push_back(0); // Colorspace: sRGB
+
+    // Alpha is always 255, so it's a constant in the hash.
+    // The index stores RGBA values, because its initial entries are transparent black.
+    constexpr uint8_t alpha_hash = (255 * 11) % 64;
+    uint32_t index[64] = {};
+    Rgb previous = { 0, 0, 0 };
+    uint16_t previous_pixel = 0;
+    uint8_t run = 0;
+
+    for (uint32_t y = 0; y < frame.height; y++) {
+        const uint16_t* row = frame.getRow(y);
+        for (uint32_t x = 0; x < frame.width; x++) {
+            // Comparing the 565 values skips the expansion for the (very common) runs.
+            // The initial previous pixel is black, which is 0 in both formats.
+            if (row[x] == previous_pixel) {
+                run++;
+                if (run == 62) {
+                    output.push_back(QOI_OP_RUN | (run - 1));
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0) {
+                output.push_back(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+
+            const auto pixel = toRgb(row[x]);
+            previous_pixel = row[x];
+            const uint32_t rgba = (pixel.red << 24) | (pixel.green << 16) | (pixel.blue << 8) | 0xFF;
+            const uint8_t hash = ((pixel.red * 3) + (pixel.green * 5) + (pixel.blue * 7) + alpha_hash) % 64;
+            if (index[hash] == rgba) {
+                output.push_back(QOI_OP_INDEX | hash);
+            } else {
+                index[hash] = rgba;
+                const auto red_difference = static_cast<int8_t>(pixel.red - previous.red);
+                const auto green_difference = static_cast<int8_t>(pixel.green - previous.green);
+                const auto blue_difference = static_cast<int8_t>(pixel.blue - previous.blue);
+                const auto red_green_difference = static_cast<int8_t>(red_difference - green_difference);
+                const auto blue_green_difference = static_cast<int8_t>(blue_difference - green_difference);
+                if (red_difference >= -2 && red_difference <= 1 &&
+                    green_difference >= -2 && green_difference <= 1 &&
+                    blue_difference >= -2 && blue_difference <= 1) {
+                    output.push_back(QOI_OP_DIFF | ((red_difference + 2) << 4) | ((green_difference + 2) << 2) | (blue_difference + 2));
+                } else if (red_green_difference >= -8 && red_green_difference <= 7 &&
+                    green_difference >= -32 && green_difference <= 31 &&
+                    blue_green_difference >= -8 && blue_green_difference <= 7) {
+                    output.push_back(QOI_OP_LUMA | (green_difference + 32));
+                    output.push_back(((red_green_difference + 8) << 4) | (blue_green_difference + 8));
+                } else {
+                    output.push_back(QOI_OP_RGB);
+                    output.push_back(pixel.red);
+                    output.push_back(pixel.green);
+                    output.push_back(pixel.blue);
+                }
+            }
+            previous = pixel;
+        }
+    }
+
+    if (run > 0) {
+        output.push_back(QOI_OP_RUN | (run - 1));
+    }
+
+    output.insert(output.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+    return true;
+}
+
+bool encodeRaw(const Frame& frame, std::vector<uint8_t>& output) {
+    output.reserve(output.size() + 12 + (frame.width * frame.height * sizeof(uint16_t)));
+    output.insert(output.end(), std::begin(RAW_MAGIC), std::end(RAW_MAGIC));
+    appendUint16(output, frame.width);
+    appendUint16(output, frame.height);
+    appendUint32(output, 0);
+    appendPixels(frame, { 0, 0, static_cast<uint16_t>(frame.width), static_cast<uint16_t>(frame.height) }, output);
+    return true;
+}
+
+Area findChangedArea(const Frame& previous, const Frame& current) {
+    const Area full_area = { 0, 0, static_cast<uint16_t>(current.width), static_cast<uint16_t>(current.height) };
+    if (previous.width != current.width || previous.height != current.height || previous.getData() == nullptr) {
+        return full_area;
+    }
+
+    const size_t row_size = current.width * sizeof(uint16_t);
+    uint32_t top = 0;
+    while (top < current.height && memcmp(previous.getRow(top), current.getRow(top), row_size) == 0) {
+        top++;
+    }
+
+    if (top == current.height) {
+        return {};
+    }
+
+    uint32_t bottom = current.height - 1;
+    while (bottom > top && memcmp(previous.getRow(bottom), current.getRow(bottom), row_size) == 0) {
+        bottom--;
+    }
+
+    uint32_t left = current.width;
+    uint32_t right = 0;
+    for (uint32_t y = top; y <= bottom; y++) {
+        const uint16_t* previous_row = previous.getRow(y);
+        const uint16_t* current_row = current.getRow(y);
+        for (uint32_t x = 0; x < left; x++) {
+            if (previous_row[x] != current_row[x]) {
+                left = x;
+                break;
+            }
+        }
+        for (uint32_t x = current.width - 1; x > right; x--) {
+            if (previous_row[x] != current_row[x]) {
+                right = x;
+                break;
+            }
+        }
+    }
+
+    return {
+        .x = static_cast<uint16_t>(left),
+        .y = static_cast<uint16_t>(top),
+        .width = static_cast<uint16_t>(right - left + 1),
+        .height = static_cast<uint16_t>(bottom - top + 1)
+    };
+}
+
+void encodeSequenceHeader(uint32_t width, uint32_t height, uint32_t intervalMillis, std::vector<uint8_t>& output) {
+    output.insert(output.end(), std::begin(SEQUENCE_MAGIC), std::end(SEQUENCE_MAGIC));
+    appendUint16(output, width);
+    appendUint16(output, height);
+    appendUint32(output, intervalMillis);
+}
+
+void encodeSequenceFrame(const Frame& frame, const Area& area, uint32_t timeMillis, std::vector<uint8_t>& output) {
+    output.reserve(output.size() + 12 + (area.width * area.height * sizeof(uint16_t)));
+    appendUint32(output, timeMillis);
+    appendUint16(output, area.x);
+    appendUint16(output, area.y);
+    appendUint16(output, area.width);
+    appendUint16(output, area.height);
+    appendPixels(frame, area, output);
+}
+
+} // namespace
+
+#endif
@@ -5,12 +5,15 @@
 #include "Tactility/service/screenshot/ScreenshotTask.h"
 
 #include "Tactility/service/loader/Loader.h"
+#include "Tactility/lvgl/Lvgl.h"
 #include "Tactility/lvgl/LvglSync.h"
 
-#include <lv_screenshot.h>
 #include <Tactility/TactilityCore.h>
+#include <Tactility/service/fileio/FileIoService.h>
 
+#include <algorithm>
 #include <format>
+#include <lvgl.h>
 #include <Tactility/CpuAffinity.h>
 
 namespace tt::service::screenshot {
@@ -47,33 +50,211 @@ void ScreenshotTask::setFinished() {
     finished = true;
 }
 
-static void makeScreenshot(const std::string& filename) {
-    if (lvgl::lock(50 / portTICK_PERIOD_MS)) {
-        if (lv_screenshot_create(lv_scr_act(), LV_100ASK_SCREENSHOT_SV_PNG, filename.c_str())) {
+/** The path is an LVGL path (e.g. "A:/sdcard"), but the files are written with the C library */
+static std::string toFilePath(const std::string& path) {
+    const std::string prefix = lvgl::PATH_PREFIX;
+    if (!path.starts_with(prefix)) {
+        return path;
+    } else if (path.size() == prefix.size()) {
+        return ".";
+    } else {
+        return path.substr(prefix.size());
+    }
+}
+
+/**
+ * Render the active screen into the frame.
+ * This is the only part that holds the LVGL lock: encoding and writing happen afterwards.
+ */
+static bool capture(Frame& frame) {
+    if (!lvgl::lock(50 / portTICK_PERIOD_MS)) {
+        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+        return false;
+    }
+
+    bool success = false;
+    auto* screen = lv_screen_active();
+    const auto width = static_cast<uint32_t>(lv_obj_get_width(screen));
+    const auto height = static_cast<uint32_t>(lv_obj_get_height(screen));
+    const auto stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_RGB565);
+    lv_draw_buf_t draw_buffer;
+    if (!frame.reserve(stride * height)) {
+        TT_LOG_E(TAG, "Failed to allocate %lu bytes", stride * height);
+    } else if (lv_draw_buf_init(&draw_buffer, width, height, LV_COLOR_FORMAT_RGB565, stride, frame.getData(), frame.getCapacity()) != LV_RESULT_OK) {
+        TT_LOG_E(TAG, "Failed to init draw buffer");
+    } else {
+        lv_draw_buf_set_flag(&draw_buffer, LV_IMAGE_FLAGS_MODIFIABLE);
+        if (lv_snapshot_take_to_draw_buf(screen, LV_COLOR_FORMAT_RGB565, &draw_buffer) == LV_RESULT_OK) {
+            frame.width = draw_buffer.header.w;
+            frame.height = draw_buffer.header.h;
+            frame.stride = draw_buffer.header.stride;
+            success = true;
+        } else {
+            TT_LOG_E(TAG, "Failed to take snapshot");
+        }
+    }
+
+    lvgl::unlock();
+    return success;
+}
+
+bool ScreenshotTask::sleep(uint32_t millis) {
+    // Splitting up the delays makes it easier to stop the service
+    while (millis > 0 && !isInterrupted()) {
+        const auto delay = std::min<uint32_t>(millis, 100);
+        kernel::delayMillis(delay);
+        millis -= delay;
+    }
+    return !isInterrupted();
+}
+
+void ScreenshotTask::makeScreenshot(const std::string& filename) {
+    auto file_io = fileio::findFileIoService();
+    if (file_io->getPendingRequestCount() >= MAX_PENDING_WRITES) {
+        TT_LOG_W(TAG, "Skipped %s: storage is busy", filename.c_str());
+        return;
+    }
+
+    const auto capture_start = kernel::getMicros();
+    if (!capture(frame)) {
+        TT_LOG_E(TAG, "Screenshot not saved to %s", filename.c_str());
+        return;
+    }
+
+    const auto encode_start = kernel::getMicros();
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    if (!encode(frame, work.format, *data)) {
+        TT_LOG_E(TAG, "Failed to encode %s", filename.c_str());
+        return;
+    }
+
+    const auto encode_end = kernel::getMicros();
+    TT_LOG_I(TAG, "Captured %lux%lu in %ld ms, encoded %zu bytes in %ld ms",
+        frame.width,
+        frame.height,
+        (encode_start - capture_start) / 1000,
+        data->size(),
+        (encode_end - encode_start) / 1000
+    );
+
+    file_io->writeFile(filename, std::move(data), [filename](bool success) {
+        if (success) {
             TT_LOG_I(TAG, "Screenshot saved to %s", filename.c_str());
         } else {
             TT_LOG_E(TAG, "Screenshot not saved to %s", filename.c_str());
         }
-        lvgl::unlock();
-    } else {
-        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED_FMT, "LVGL");
+    });
+}
+
+void ScreenshotTask::recordSequence() {
+    auto file_io = fileio::findFileIoService();
+    const auto filename = std::format("{}/screenshot-sequence-{}.seq", toFilePath(work.path), kernel::getMillis());
+    const auto start_time = kernel::getMillis();
+    auto next_time = start_time;
+    uint32_t frames = 0;
+    uint32_t written_frames = 0;
+    uint32_t skipped_frames = 0;
+    uint32_t late_frames = 0;
+    long capture_time = 0;
+    uint32_t sequence_width = 0;
+    uint32_t sequence_height = 0;
+    previousFrame.width = 0;
+    previousFrame.height = 0;
+
+    TT_LOG_I(TAG, "Recording sequence to %s", filename.c_str());
+
+    while (!isInterrupted()) {
+        const auto capture_start = kernel::getMicros();
+        if (capture(frame)) {
+            const auto capture_end = kernel::getMicros();
+            capture_time += capture_end - capture_start;
+            frames++;
+
+            if (written_frames == 0) {
+                sequence_width = frame.width;
+                sequence_height = frame.height;
+            } else if (frame.width != sequence_width || frame.height != sequence_height) {
+                TT_LOG_W(TAG, "Screen size changed: stopping sequence");
+                break;
+            }
+
+            // Compared with the last written frame, so skipped frames are included in the next delta
+            const auto area = findChangedArea(previousFrame, frame);
+            if (area.isEmpty()) {
+                TT_LOG_D(TAG, "Frame %lu: captured in %ld us, no changes", frames, capture_end - capture_start);
+            } else if (file_io->getPendingRequestCount() >= MAX_PENDING_WRITES) {
+                skipped_frames++;
+                TT_LOG_D(TAG, "Frame %lu: skipped because storage is busy", frames);
+            } else {
+                auto data = std::make_shared<std::vector<uint8_t>>();
+                if (written_frames == 0) {
+                    encodeSequenceHeader(frame.width, frame.height, work.interval_millis, *data);
+                }
+                encodeSequenceFrame(frame, area, kernel::getMillis() - start_time, *data);
+                TT_LOG_D(TAG, "Frame %lu: captured in %ld us, encoded %ux%u at %u,%u in %ld us",
+                    frames,
+                    capture_end - capture_start,
+                    area.width,
+                    area.height,
+                    area.x,
+                    area.y,
+                    kernel::getMicros() - capture_end
+                );
+
+                auto callback = [filename](bool success) {
+                    if (!success) {
+                        TT_LOG_E(TAG, "Failed to write to %s", filename.c_str());
+                    }
+                };
+                if (written_frames == 0) {
+                    file_io->writeFile(filename, std::move(data), callback);
+                } else {
+                    file_io->appendFile(filename, std::move(data), callback);
+                }
+
+                written_frames++;
+                std::swap(frame, previousFrame);
+            }
+
+            if (work.frame_amount > 0 && frames >= work.frame_amount) {
+                break;
+            }
+        }
+
+        next_time += work.interval_millis;
+        const auto now = kernel::getMillis();
+        if (next_time > now) {
+            if (!sleep(next_time - now)) {
+                break;
+            }
+        } else {
+            // Don't try to catch up: that would capture multiple frames without any delay
+            late_frames++;
+            next_time = now;
+        }
     }
+
+    TT_LOG_I(TAG, "Sequence %s: %lu frames, %lu written, %lu skipped, %lu late, average capture time %ld ms",
+        filename.c_str(),
+        frames,
+        written_frames,
+        skipped_frames,
+        late_frames,
+        (frames > 0) ? (capture_time / frames / 1000) : 0
+    );
 }
 
 void ScreenshotTask::taskMain() {
     uint8_t screenshots_taken = 0;
     std::string last_app_id;
+    const auto file_path = toFilePath(work.path);
+    const auto* extension = getFileExtension(work.format);
 
     while (!isInterrupted()) {
         if (work.type == TASK_WORK_TYPE_DELAY) {
-            // Splitting up the delays makes it easier to stop the service
-            for (int i = 0; i < (work.delay_in_seconds * 10) && !isInterrupted(); ++i){
-                kernel::delayMillis(100);
-            }
-
-            if (!isInterrupted()) {
+            if (sleep(work.delay_in_seconds * 1000)) {
                 screenshots_taken++;
-                std::string filename = std::format("{}/screenshot-{}.png", work.path, screenshots_taken);
+                std::string filename = std::format("{}/screenshot-{}.{}", file_path, screenshots_taken, extension);
                 makeScreenshot(filename);
 
                 if (work.amount > 0 && screenshots_taken >= work.amount) {
@@ -87,12 +268,15 @@ void ScreenshotTask::taskMain() {
                 if (manifest.appId != last_app_id) {
                     kernel::delayMillis(100);
                     last_app_id = manifest.appId;
-                    auto filename = std::format("{}/screenshot-{}.png", work.path, manifest.appId);
+                    auto filename = std::format("{}/screenshot-{}.{}", file_path, manifest.appId, extension);
                     makeScreenshot(filename);
                 }
             }
             // Ensure the LVGL widgets are rendered as the app just started
             kernel::delayMillis(250);
+        } else if (work.type == TASK_WORK_TYPE_SEQUENCE) {
+            recordSequence();
+            break;
         }
     }
 
@@ -119,7 +303,7 @@ void ScreenshotTask::taskStart() {
     thread->start();
 }
 
-void ScreenshotTask::startApps(const std::string& path) {
+void ScreenshotTask::startApps(const std::string& path, Format format) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(50 / portTICK_PERIOD_MS)) {
         TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
@@ -129,6 +313,7 @@ void ScreenshotTask::startApps(const std::string& path) {
     if (thread == nullptr) {
         interrupted = false;
         work.type = TASK_WORK_TYPE_APPS;
+        work.format = format;
         work.path = path;
         taskStart();
     } else {
@@ -136,7 +321,7 @@ void ScreenshotTask::startApps(const std::string& path) {
     }
 }
 
-void ScreenshotTask::startTimed(const std::string& path, uint8_t delay_in_seconds, uint8_t amount) {
+void ScreenshotTask::startTimed(const std::string& path, uint8_t delay_in_seconds, uint8_t amount, Format format) {
     auto lock = mutex.asScopedLock();
     if (!lock.lock(50 / portTICK_PERIOD_MS)) {
         TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
@@ -148,6 +333,27 @@ void ScreenshotTask::startTimed(const std::string& path, uint8_t delay_in_second
         work.type = TASK_WORK_TYPE_DELAY;
         work.delay_in_seconds = delay_in_seconds;
         work.amount = amount;
+        work.format = format;
+        work.path = path;
+        taskStart();
+    } else {
+        TT_LOG_E(TAG, "Task was already running");
+    }
+}
+
+void ScreenshotTask::startSequence(const std::string& path, uint32_t intervalMillis, uint32_t frameAmount) {
+    auto lock = mutex.asScopedLock();
+    if (!lock.lock(50 / portTICK_PERIOD_MS)) {
+        TT_LOG_E(TAG, LOG_MESSAGE_MUTEX_LOCK_FAILED);
+        return;
+    }
+
+    if (thread == nullptr) {
+        interrupted = false;
+        work.type = TASK_WORK_TYPE_SEQUENCE;
+        work.interval_millis = intervalMillis;
+        work.frame_amount = frameAmount;
+        work.format = Format::Raw;
         work.path = path;
         taskStart();
     } else {
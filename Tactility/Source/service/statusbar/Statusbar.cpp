@@ -6,6 +6,7 @@
 #include <Tactility/lvgl/LvglSync.h>
 #include <Tactility/Mutex.h>
 #include <Tactility/service/gps/GpsService.h>
+#include <Tactility/service/imagecache/ImageCache.h>
 #include <Tactility/service/ServiceContext.h>
 #include <Tactility/service/ServicePaths.h>
 #include <Tactility/service/ServiceRegistration.h>
@@ -88,7 +89,7 @@ static const char* getSdCardStatusIcon(hal::sdcard::SdCardDevice::State state) {
     }
 }
 
-static _Nullable const char* getPowerStatusIcon() {
+static std::shared_ptr<hal::power::PowerDevice> _Nullable findPowerDevice() {
     // TODO: Support multiple power devices?
     std::shared_ptr<hal::power::PowerDevice> power;
     hal::findDevices<hal::power::PowerDevice>(hal::Device::Type::Power, [&power](const auto& device) {
@@ -98,7 +99,10 @@ static _Nullable const char* getPowerStatusIcon() {
         }
         return true;
     });
+    return power;
+}
 
+static _Nullable const char* getPowerStatusIcon(const std::shared_ptr<hal::power::PowerDevice>& power) {
     if (power == nullptr) {
         return nullptr;
     }
@@ -147,6 +151,9 @@ class StatusbarService final : public Service {
     const char* sdcard_last_icon = nullptr;
     int8_t power_icon_id;
     const char* power_last_icon = nullptr;
+    std::shared_ptr<hal::power::PowerDevice> power_device;
+    uint32_t power_device_epoch = 0;
+    bool power_device_resolved = false;
 
     std::unique_ptr<ServicePaths> paths;
 
@@ -158,13 +165,19 @@ class StatusbarService final : public Service {
         mutex.unlock();
     }
 
+    /** The statusbar icons change often, so they are pinned in the image cache */
+    void setIconImage(int8_t iconId, const char* icon) const {
+        auto icon_path = "A:" + paths->getAssetsPath(icon);
+        imagecache::pin(icon_path);
+        lvgl::statusbar_icon_set_image(iconId, icon_path);
+    }
+
     void updateGpsIcon() {
         auto gps_state = gps::findGpsService()->getState();
         bool show_icon = (gps_state == gps::State::OnPending) || (gps_state == gps::State::On);
         if (gps_last_state != show_icon) {
             if (show_icon) {
-                auto icon_path = "A:" + paths->getAssetsPath(STATUSBAR_ICON_GPS);
-                lvgl::statusbar_icon_set_image(gps_icon_id, icon_path);
+                setIconImage(gps_icon_id, STATUSBAR_ICON_GPS);
                 lvgl::statusbar_icon_set_visibility(gps_icon_id, true);
             } else {
                 lvgl::statusbar_icon_set_visibility(gps_icon_id, false);
@@ -179,8 +192,7 @@ class StatusbarService final : public Service {
         const char* desired_icon = getWifiStatusIcon(radio_state, is_secure);
         if (wifi_last_icon != desired_icon) {
             if (desired_icon != nullptr) {
-                auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                lvgl::statusbar_icon_set_image(wifi_icon_id, icon_path);
+                setIconImage(wifi_icon_id, desired_icon);
                 lvgl::statusbar_icon_set_visibility(wifi_icon_id, true);
             } else {
                 lvgl::statusbar_icon_set_visibility(wifi_icon_id, false);
@@ -190,11 +202,18 @@ class StatusbarService final : public Service {
     }
 
     void updatePowerStatusIcon() {
-        const char* desired_icon = getPowerStatusIcon();
+        // Only search the device registry again when devices were (de)registered
+        auto epoch = hal::getDeviceRegistryEpoch();
+        if (!power_device_resolved || power_device_epoch != epoch) {
+            power_device = findPowerDevice();
+            power_device_epoch = epoch;
+            power_device_resolved = true;
+        }
+
+        const char* desired_icon = getPowerStatusIcon(power_device);
         if (power_last_icon != desired_icon) {
             if (desired_icon != nullptr) {
-                auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                lvgl::statusbar_icon_set_image(power_icon_id, icon_path);
+                setIconImage(power_icon_id, desired_icon);
                 lvgl::statusbar_icon_set_visibility(power_icon_id, true);
             } else {
                 lvgl::statusbar_icon_set_visibility(power_icon_id, false);
@@ -212,8 +231,7 @@ class StatusbarService final : public Service {
             if (state != hal::sdcard::SdCardDevice::State::Timeout) {
                 auto* desired_icon = getSdCardStatusIcon(state);
                 if (sdcard_last_icon != desired_icon) {
-                    auto icon_path = "A:" + paths->getAssetsPath(desired_icon);
-                    lvgl::statusbar_icon_set_image(sdcard_icon_id, icon_path);
+                    setIconImage(sdcard_icon_id, desired_icon);
                     lvgl::statusbar_icon_set_visibility(sdcard_icon_id, true);
                     sdcard_last_icon = desired_icon;
                 }
@@ -285,7 +303,9 @@ public:
 
 extern const ServiceManifest manifest = {
     .id = "Statusbar",
-    .createService = create<StatusbarService>
+    .createService = create<StatusbarService>,
+    .dependencies = { "Gui", "ImageCache" },
+    .startPhase = StartPhase::Gui
 };
 
 // endregion service
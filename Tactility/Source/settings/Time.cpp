@@ -28,8 +28,11 @@ void initTimeZone() {
 
 void setTimeZone(const std::string& name, const std::string& code) {
     Preferences preferences(TIME_SETTINGS_NAMESPACE);
-    preferences.putString(TIMEZONE_PREFERENCES_KEY_NAME, name);
-    preferences.putString(TIMEZONE_PREFERENCES_KEY_CODE, code);
+    {
+        auto transaction = preferences.transaction();
+        preferences.putString(TIMEZONE_PREFERENCES_KEY_NAME, name);
+        preferences.putString(TIMEZONE_PREFERENCES_KEY_CODE, code);
+    }
 
 #ifdef ESP_PLATFORM
     setenv("TZ", code.c_str(), 1);
@@ -86,6 +86,21 @@ uint16_t tt_hal_display_driver_get_pixel_height(DisplayDriverHandle handle);
  */
 void tt_hal_display_driver_draw_bitmap(DisplayDriverHandle handle, int xStart, int yStart, int xEnd, int yEnd, const void* pixelData);
 
+/**
+ * Convert pixels to another color format, e.g. to the native color format of a display before drawing them.
+ * The RGB888 format stores blue, green and red bytes (LVGL order).
+ * Monochrome rows store 1 bit per pixel (most significant bit first, 1 is lit) and start at a new byte.
+ * Conversions to monochrome are dithered.
+ * @param[in] sourceFormat the color format of the source pixels
+ * @param[in] source the pixels to convert. The data is placed as "RowRowRowRow".
+ * @param[in] targetFormat the color format of the target pixels
+ * @param[out] target the buffer for the converted pixels. It can be the same as the source buffer when the target pixels aren't bigger than the source pixels.
+ * @param[in] width the amount of pixels in a row
+ * @param[in] height the amount of rows
+ * @return false when the conversion is not supported
+ */
+bool tt_hal_display_convert_pixels(ColorFormat sourceFormat, const void* source, ColorFormat targetFormat, void* target, uint32_t width, uint32_t height);
+
 #ifdef __cplusplus
 }
 #endif
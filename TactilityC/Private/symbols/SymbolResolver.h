@@ -0,0 +1,69 @@
+#pragma once
+
+#include <private/elf_symbol.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tt::c {
+
+/**
+ * Resolves symbol names to addresses for the ELF loader.
+ *
+ * All symbol tables are indexed once: the entries are sorted by the hash of their name,
+ * so a lookup is a binary search instead of a string comparison with every exported symbol.
+ * Apps often relocate the same symbol many times, so recently resolved symbols are cached.
+ *
+ * @warning Not thread-safe: ELF apps are loaded one at a time by the loader.
+ */
+class SymbolResolver final {
+
+public:
+
+    struct Statistics {
+        uint32_t lookups;
+        uint32_t cacheHits;
+        /** Lookups of symbols that don't exist */
+        uint32_t misses;
+        /** Total time spent on lookups in microseconds */
+        uint64_t lookupTime;
+    };
+
+private:
+
+    struct IndexEntry {
+        uint32_t hash;
+        const esp_elfsym* symbol;
+    };
+
+    static constexpr size_t CACHE_SIZE = 64;
+
+    std::vector<IndexEntry> index;
+    std::array<const IndexEntry*, CACHE_SIZE> cache = {};
+    Statistics statistics = {};
+
+    const IndexEntry* find(uint32_t hash, const char* name) const;
+
+public:
+
+    /** @param[in] tables a list of symbol tables that are terminated with ESP_ELFSYM_END */
+    explicit SymbolResolver(const std::vector<const esp_elfsym*>& tables);
+
+    /** @return the address of the symbol, or 0 when it doesn't exist */
+    uintptr_t resolve(const char* name);
+
+    size_t getSymbolCount() const { return index.size(); }
+
+    Statistics getStatistics() const { return statistics; }
+
+    void resetStatistics() { statistics = {}; }
+};
+
+#ifdef ESP_PLATFORM
+/** @return the resolver that is used for loading ELF apps */
+SymbolResolver& getSymbolResolver();
+#endif
+
+} // namespace
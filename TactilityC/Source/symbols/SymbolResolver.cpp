@@ -0,0 +1,68 @@
+#include <symbols/SymbolResolver.h>
+
+#include <Tactility/crypt/Hash.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tt::c {
+
+SymbolResolver::SymbolResolver(const std::vector<const esp_elfsym*>& tables) {
+    size_t symbol_count = 0;
+    for (const auto* table : tables) {
+        for (const auto* symbol = table; symbol->name != nullptr; symbol++) {
+            symbol_count++;
+        }
+    }
+
+    index.reserve(symbol_count);
+    for (const auto* table : tables) {
+        for (const auto* symbol = table; symbol->name != nullptr; symbol++) {
+            index.push_back({
+                .hash = crypt::djb2(symbol->name),
+                .symbol = symbol
+            });
+        }
+    }
+
+    // Stable, so the first table wins when multiple tables export the same name
+    std::ranges::stable_sort(index, {}, &IndexEntry::hash);
+}
+
+const SymbolResolver::IndexEntry* SymbolResolver::find(uint32_t hash, const char* name) const {
+    auto entry = std::ranges::lower_bound(index, hash, {}, &IndexEntry::hash);
+    // Different names can have the same hash
+    while (entry != index.end() && entry->hash == hash) {
+        if (strcmp(entry->symbol->name, name) == 0) {
+            return &(*entry);
+        }
+        entry++;
+    }
+    return nullptr;
+}
+
+uintptr_t SymbolResolver::resolve(const char* name) {
+    auto start_time = kernel::getMicros();
+    statistics.lookups++;
+
+    auto hash = crypt::djb2(name);
+    auto& cache_slot = cache[hash % CACHE_SIZE];
+    const IndexEntry* entry;
+    if (cache_slot != nullptr && cache_slot->hash == hash && strcmp(cache_slot->symbol->name, name) == 0) {
+        entry = cache_slot;
+        statistics.cacheHits++;
+    } else {
+        entry = find(hash, name);
+        if (entry != nullptr) {
+            cache_slot = entry;
+        } else {
+            statistics.misses++;
+        }
+    }
+
+    statistics.lookupTime += kernel::getMicros() - start_time;
+    return (entry != nullptr) ? reinterpret_cast<uintptr_t>(entry->symbol->sym) : 0;
+}
+
+} // namespace
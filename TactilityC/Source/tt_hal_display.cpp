@@ -4,6 +4,7 @@
 #include "Tactility/hal/Device.h"
 #include "Tactility/hal/display/DisplayDevice.h"
 #include "Tactility/hal/display/DisplayDriver.h"
+#include "Tactility/hal/display/PixelConversion.h"
 
 static ColorFormat toColorFormat(tt::hal::display::ColorFormat format) {
     switch (format) {
@@ -24,6 +25,31 @@ static ColorFormat toColorFormat(tt::hal::display::ColorFormat format) {
     }
 }
 
+static bool fromColorFormat(ColorFormat format, tt::hal::display::ColorFormat& result) {
+    switch (format) {
+        case COLOR_FORMAT_MONOCHROME:
+            result = tt::hal::display::ColorFormat::Monochrome;
+            return true;
+        case COLOR_FORMAT_BGR565:
+            result = tt::hal::display::ColorFormat::BGR565;
+            return true;
+        case COLOR_FORMAT_BGR565_SWAPPED:
+            result = tt::hal::display::ColorFormat::BGR565Swapped;
+            return true;
+        case COLOR_FORMAT_RGB565:
+            result = tt::hal::display::ColorFormat::RGB565;
+            return true;
+        case COLOR_FORMAT_RGB565_SWAPPED:
+            result = tt::hal::display::ColorFormat::RGB565Swapped;
+            return true;
+        case COLOR_FORMAT_RGB888:
+            result = tt::hal::display::ColorFormat::RGB888;
+            return true;
+        default:
+            return false;
+    }
+}
+
 struct DriverWrapper {
     std::shared_ptr<tt::hal::display::DisplayDriver> driver;
     DriverWrapper(std::shared_ptr<tt::hal::display::DisplayDriver> driver) : driver(driver) {}
@@ -85,4 +111,12 @@ void tt_hal_display_driver_draw_bitmap(DisplayDriverHandle handle, int xStart, i
     wrapper->driver->drawBitmap(xStart, yStart, xEnd, yEnd, pixelData);
 }
 
-}
\ No newline at end of file
+bool tt_hal_display_convert_pixels(ColorFormat sourceFormat, const void* source, ColorFormat targetFormat, void* target, uint32_t width, uint32_t height) {
+    tt::hal::display::ColorFormat source_format, target_format;
+    if (!fromColorFormat(sourceFormat, source_format) || !fromColorFormat(targetFormat, target_format)) {
+        return false;
+    }
+    return tt::hal::display::convertPixels(source_format, source, target_format, target, width, height);
+}
+
+}
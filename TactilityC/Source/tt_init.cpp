@@ -32,6 +32,7 @@
 #include "symbols/pthread.h"
 #include "symbols/stl.h"
 #include "symbols/cplusplus.h"
+#include "symbols/SymbolResolver.h"
 
 #include <cstring>
 #include <ctype.h>
@@ -226,6 +227,7 @@ const esp_elfsym main_symbols[] {
     ESP_ELFSYM_EXPORT(tt_gps_get_coordinates),
     ESP_ELFSYM_EXPORT(tt_hal_configuration_get_ui_scale),
     ESP_ELFSYM_EXPORT(tt_hal_device_find),
+    ESP_ELFSYM_EXPORT(tt_hal_display_convert_pixels),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_alloc),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_draw_bitmap),
     ESP_ELFSYM_EXPORT(tt_hal_display_driver_free),
@@ -600,19 +602,21 @@ const esp_elfsym main_symbols[] {
     ESP_ELFSYM_END
 };
 
-uintptr_t resolve_symbol(const esp_elfsym* source, const char* symbolName) {
-    const esp_elfsym* symbol_iterator = source;
-    while (symbol_iterator->name != nullptr) {
-        if (strcmp(symbol_iterator->name, symbolName) == 0) {
-            return reinterpret_cast<uintptr_t>(symbol_iterator->sym);
-        }
-        symbol_iterator++;
-    }
-    return 0;
+uintptr_t tt_symbol_resolver(const char* symbolName) {
+    return tt::c::getSymbolResolver().resolve(symbolName);
 }
 
-uintptr_t tt_symbol_resolver(const char* symbolName) {
-    static const std::vector all_symbols = {
+void tt_init_tactility_c() {
+    elf_set_symbol_resolver(tt_symbol_resolver);
+}
+
+} // extern "C"
+
+namespace tt::c {
+
+SymbolResolver& getSymbolResolver() {
+    // Indexed on first use, so it doesn't affect the boot time
+    static SymbolResolver resolver({
         main_symbols,
         gcc_soft_float_symbols,
         stl_symbols,
@@ -620,24 +624,12 @@ uintptr_t tt_symbol_resolver(const char* symbolName) {
         esp_event_symbols,
         esp_http_client_symbols,
         pthread_symbols,
-    };
-
-    for (const auto* symbols : all_symbols) {
-        const uintptr_t address = resolve_symbol(symbols, symbolName);
-        if (address != 0) {
-            return address;
-        }
-    }
-
-    return 0;
+    });
+    return resolver;
 }
 
-void tt_init_tactility_c() {
-    elf_set_symbol_resolver(tt_symbol_resolver);
 }
 
-} // extern "C"
-
 #else // Simulator
 
 extern "C" {
@@ -0,0 +1,93 @@
+/**
+ * @file InlineFunction.h
+ *
+ * InlineFunction is a move-only std::function alternative that stores its callable in a fixed-size inline buffer.
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tt {
+
+/**
+ * A type-erased void() callable that never allocates.
+ * Callables that don't fit in the inline storage are rejected at compile time.
+ * @tparam StorageSize the amount of bytes available for the callable and its captures
+ */
+template<size_t StorageSize>
+class InlineFunction final {
+
+    struct Operations {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to);
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Callable>
+    static constexpr Operations operationsFor = {
+        .invoke = [](void* storage) { (*static_cast<Callable*>(storage))(); },
+        .move = [](void* from, void* to) { new (to) Callable(std::move(*static_cast<Callable*>(from))); },
+        .destroy = [](void* storage) { static_cast<Callable*>(storage)->~Callable(); }
+    };
+
+    alignas(std::max_align_t) std::byte storage[StorageSize];
+    const Operations* operations = nullptr;
+
+public:
+
+    static constexpr size_t storageSize = StorageSize;
+
+    InlineFunction() = default;
+
+    template<typename Callable, typename Decayed = std::decay_t<Callable>>
+        requires(!std::is_same_v<Decayed, InlineFunction> && std::is_invocable_r_v<void, Decayed&>)
+    InlineFunction(Callable&& callable) {
+        static_assert(sizeof(Decayed) <= StorageSize, "Callable captures too much state for inline storage");
+        static_assert(alignof(Decayed) <= alignof(std::max_align_t), "Callable alignment is not supported");
+        static_assert(std::is_nothrow_move_constructible_v<Decayed>, "Callable must be nothrow move constructible");
+        new (storage) Decayed(std::forward<Callable>(callable));
+        operations = &operationsFor<Decayed>;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept {
+        if (other.operations != nullptr) {
+            other.operations->move(other.storage, storage);
+            operations = other.operations;
+            other.reset();
+        }
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.operations != nullptr) {
+                other.operations->move(other.storage, storage);
+                operations = other.operations;
+                other.reset();
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    /** Destroy the contained callable (if any) */
+    void reset() {
+        if (operations != nullptr) {
+            operations->destroy(storage);
+            operations = nullptr;
+        }
+    }
+
+    explicit operator bool() const { return operations != nullptr; }
+
+    void operator()() { operations->invoke(storage); }
+};
+
+} // namespace
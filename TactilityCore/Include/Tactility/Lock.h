@@ -22,6 +22,12 @@ public:
 
     virtual bool unlock() const = 0;
 
+    /**
+     * A cooperative yield point for the holder of the lock, e.g. between the chunks of a long transfer on a shared bus.
+     * @return true when the holder should release the lock for a while, so others can use it
+     */
+    virtual bool shouldYield() const { return false; }
+
     void withLock(TickType_t timeout, const std::function<void()>& onLockAcquired) const {
         if (lock(timeout)) {
             onLockAcquired();
@@ -90,6 +96,8 @@ public:
         }
         return ok;
     }
+
+    bool shouldYield() const override { return lockable.shouldYield(); }
 };
 
 }
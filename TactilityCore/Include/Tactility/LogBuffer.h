@@ -0,0 +1,92 @@
+#pragma once
+
+#include "LogCommon.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace tt {
+
+// Mutex.h includes Log.h, which includes this header
+class Mutex;
+
+/**
+ * A ring buffer with binary log records: a record contains the tag, the format string pointer and the raw arguments.
+ * Formatting happens when the buffer is drained, so it can be done on a low priority thread instead of the caller's thread.
+ *
+ * The tag and format must be string constants, because only their pointers are stored.
+ * String arguments are copied, because they might not outlive the call.
+ *
+ * Writers only hold a mutex while copying a record into the buffer. The reader doesn't block writers.
+ * The mutexes inherit the priority of a waiting task, so a preempted low priority task that holds one can finish.
+ * When the buffer is full, records are dropped and counted.
+ */
+class LogBuffer final {
+
+public:
+
+    struct Statistics {
+        uint32_t records;
+        uint32_t dropped;
+    };
+
+    typedef std::function<void(LogLevel level, uint64_t timestamp, const char* tag, const char* message)> Consumer;
+
+    /** The maximum size of the arguments of a single record: longer strings are truncated */
+    static constexpr size_t MAX_ARGUMENTS_SIZE = 256;
+
+private:
+
+    struct RecordHeader {
+        /** The size of the record including the header, or 0 to mark that the rest of the buffer is unused */
+        uint32_t size;
+        LogLevel level;
+        uint64_t timestamp;
+        const char* tag;
+        const char* format;
+    };
+
+    size_t capacity;
+    std::unique_ptr<uint8_t[]> buffer;
+    std::atomic<uint32_t> writeIndex = 0;
+    std::atomic<uint32_t> readIndex = 0;
+    std::unique_ptr<Mutex> writeMutex;
+    std::unique_ptr<Mutex> readMutex;
+    std::atomic<uint32_t> recordCount = 0;
+    std::atomic<uint32_t> droppedCount = 0;
+
+public:
+
+    /** @param[in] capacity the buffer size in bytes (a power of 2) */
+    explicit LogBuffer(size_t capacity = 16384);
+
+    ~LogBuffer();
+
+    LogBuffer(const LogBuffer&) = delete;
+    LogBuffer& operator=(const LogBuffer&) = delete;
+
+    /** @return false when the buffer is full and the record was dropped */
+    bool add(LogLevel level, uint64_t timestamp, const char* tag, const char* format, va_list args);
+
+    /**
+     * Format the records and remove them from the buffer.
+     * @param[in] consumer receives the formatted records in order
+     * @param[in] wait when another thread is draining: wait for it (true) or return immediately (false)
+     * @return the amount of records that were consumed
+     */
+    size_t drain(const Consumer& consumer, bool wait = false);
+
+    bool isEmpty() const { return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire); }
+
+    Statistics getStatistics() const {
+        return {
+            .records = recordCount.load(std::memory_order_relaxed),
+            .dropped = droppedCount.load(std::memory_order_relaxed)
+        };
+    }
+};
+
+} // namespace
@@ -11,4 +11,14 @@ enum class LogLevel : int {
     Verbose /*!< Bigger chunks of debugging information, or frequent messages which can potentially flood the output. */
 };
 
-}
\ No newline at end of file
+/**
+ * Set the maximum level of the log output of a tag at runtime.
+ * @param[in] tag the tag of the log messages (a string constant), or "*" to set the default level for all tags
+ * @param[in] level messages with a higher level are not logged
+ */
+void setLogLevel(const char* tag, LogLevel level);
+
+/** @return true when messages with the specified level and tag are logged */
+bool isLoggable(LogLevel level, const char* tag);
+
+}
@@ -3,17 +3,38 @@
 #ifdef ESP_PLATFORM
 
 #include <esp_log.h>
+#include "Tactility/LogBuffer.h"
 #include "Tactility/LogCommon.h"
 
+namespace tt {
+
+void log(LogLevel level, const char* tag, const char* format, ...);
+
+/**
+ * Start the task that writes the log output.
+ * From then on, log() only stores the message in a buffer and the formatting and writing happen on the log task.
+ * Errors are still written immediately, after the buffered messages.
+ * Messages of ESP-IDF itself are always written immediately, so they can appear before buffered messages.
+ */
+void startLogThread();
+
+/** Write all buffered log messages */
+void flushLog();
+
+LogBuffer::Statistics getLogStatistics();
+
+} // namespace
+
+// LOG_LOCAL_LEVEL removes the messages above the maximum level of the build, like ESP_LOGx() does
 #define TT_LOG_E(tag, format, ...) \
-    ESP_LOGE(tag, format, ##__VA_ARGS__)
+    do { if (LOG_LOCAL_LEVEL >= ESP_LOG_ERROR) tt::log(tt::LogLevel::Error, tag, format, ##__VA_ARGS__); } while (0)
 #define TT_LOG_W(tag, format, ...) \
-    ESP_LOGW(tag, format, ##__VA_ARGS__)
+    do { if (LOG_LOCAL_LEVEL >= ESP_LOG_WARN) tt::log(tt::LogLevel::Warning, tag, format, ##__VA_ARGS__); } while (0)
 #define TT_LOG_I(tag, format, ...) \
-    ESP_LOGI(tag, format, ##__VA_ARGS__)
+    do { if (LOG_LOCAL_LEVEL >= ESP_LOG_INFO) tt::log(tt::LogLevel::Info, tag, format, ##__VA_ARGS__); } while (0)
 #define TT_LOG_D(tag, format, ...) \
-    ESP_LOGD(tag, format, ##__VA_ARGS__)
+    do { if (LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG) tt::log(tt::LogLevel::Debug, tag, format, ##__VA_ARGS__); } while (0)
 #define TT_LOG_V(tag, format, ...) \
-    ESP_LOGV(tag, format, ##__VA_ARGS__)
+    do { if (LOG_LOCAL_LEVEL >= ESP_LOG_VERBOSE) tt::log(tt::LogLevel::Verbose, tag, format, ##__VA_ARGS__); } while (0)
 
 #endif // ESP_PLATFORM
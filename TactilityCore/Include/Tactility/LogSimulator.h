@@ -2,6 +2,7 @@
 
 #ifndef ESP_PLATFORM
 
+#include "LogBuffer.h"
 #include "LogCommon.h"
 
 #include <cstdarg>
@@ -11,6 +12,19 @@ namespace tt {
 
 void log(LogLevel level, const char* tag, const char* format, ...);
 
+/**
+ * Start the task that prints the log output.
+ * From then on, log() only stores the message in a buffer and the formatting and printing happen on the log task.
+ * Errors are still printed immediately, after the buffered messages.
+ * Call this before the scheduler is started.
+ */
+void startLogThread();
+
+/** Print all buffered log messages */
+void flushLog();
+
+LogBuffer::Statistics getLogStatistics();
+
 } // namespace
 
 #define TT_LOG_E(tag, format, ...) \
@@ -1,87 +1,161 @@
 #pragma once
 
+#include "DispatcherThread.h"
 #include "Mutex.h"
-#include <list>
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace tt {
 
-/** Publish and subscribe to messages in a thread-safe manner. */
+/**
+ * Publish and subscribe to messages in a thread-safe manner.
+ *
+ * Subscribers are kept in an immutable snapshot that is replaced (copy-on-write) when subscribing or unsubscribing.
+ * Publishing reads the current snapshot without taking the subscriptions lock, so a slow subscriber never blocks
+ * other publishers, and subscribers can (un)subscribe or publish again from within their callback.
+ * Each subscription has its own lock that is held while its callback runs: unsubscribing waits for it,
+ * and the callbacks of a single subscription never run concurrently.
+ */
 template<typename DataType>
 class PubSub final {
 
+public:
+
+    typedef std::function<void(const DataType&)> Callback;
+    typedef void* SubscriptionHandle;
+
+private:
+
+    struct SubscriptionState {
+        /** Held while the callback runs, recursive so the callback can unsubscribe itself */
+        Mutex mutex = Mutex(Mutex::Type::Recursive);
+        /** Cleared on unsubscribe, so in-flight publishes with an older snapshot skip this subscription */
+        bool active = true;
+    };
+
     struct Subscription {
         uint64_t id;
-        std::function<void(DataType)> callback;
+        Callback callback;
+        /** When set, the data is delivered on this thread instead of on the publisher's thread */
+        std::shared_ptr<DispatcherThread> dispatcherThread;
+        std::shared_ptr<SubscriptionState> state;
     };
 
-    typedef std::list<Subscription> Subscriptions;
+    typedef std::vector<Subscription> Subscriptions;
+
     uint64_t lastId = 0;
-    Subscriptions items;
+    std::atomic<std::shared_ptr<const Subscriptions>> snapshot = std::make_shared<const Subscriptions>();
+    /** Serializes writers only */
     Mutex mutex;
 
-public:
+    SubscriptionHandle addSubscription(Callback callback, std::shared_ptr<DispatcherThread> dispatcherThread) {
+        mutex.lock();
+        auto id = ++lastId;
+        auto new_snapshot = std::make_shared<Subscriptions>(*snapshot.load());
+        new_snapshot->push_back({
+            .id = id,
+            .callback = std::move(callback),
+            .dispatcherThread = std::move(dispatcherThread),
+            .state = std::make_shared<SubscriptionState>()
+        });
+        snapshot.store(std::move(new_snapshot));
+        mutex.unlock();
 
-    typedef void* SubscriptionHandle;
+        return reinterpret_cast<SubscriptionHandle>(id);
+    }
+
+    static void deliver(const Callback& callback, SubscriptionState& state, const DataType& data) {
+        state.mutex.lock();
+        if (state.active) {
+            callback(data);
+        }
+        state.mutex.unlock();
+    }
+
+public:
 
     PubSub() = default;
 
     ~PubSub() {
-        if (!items.empty()) {
-            TT_LOG_W("Loader", "Destroying PubSub with %d active subscriptions", items.size());
+        auto count = snapshot.load()->size();
+        if (count > 0) {
+            TT_LOG_W("PubSub", "Destroying PubSub with %zu active subscriptions", count);
         }
     }
 
     /** Start receiving messages at the specified handle (Threadsafe, Re-entrable)
+     * The callback is called on the publisher's thread.
      * @param[in] callback
      * @return subscription instance
      */
-    SubscriptionHandle subscribe(std::function<void(DataType)> callback) {
-        mutex.lock();
-        items.push_back({
-            .id = (++lastId),
-            .callback = std::move(callback)
-        });
-
-        mutex.unlock();
+    SubscriptionHandle subscribe(Callback callback) {
+        return addSubscription(std::move(callback), nullptr);
+    }
 
-        return reinterpret_cast<SubscriptionHandle>(lastId);
+    /** Start receiving messages at the specified handle (Threadsafe, Re-entrable)
+     * The data is copied and the callback is called on the specified thread, so the publisher never waits for it.
+     * @param[in] callback
+     * @param[in] dispatcherThread the thread to deliver the data on
+     * @return subscription instance
+     */
+    SubscriptionHandle subscribe(Callback callback, std::shared_ptr<DispatcherThread> dispatcherThread) {
+        assert(dispatcherThread != nullptr);
+        return addSubscription(std::move(callback), std::move(dispatcherThread));
     }
 
     /** Stop receiving messages at the specified handle (Threadsafe, Re-entrable.)
-     * No use of `tt_pubsub_subscription` allowed after call of this method
+     * No use of the subscription handle allowed after call of this method.
+     * Waits for a callback that is running on another thread, so the subscriber's data can be freed afterwards.
      * @param[in] subscription
      */
     void unsubscribe(SubscriptionHandle subscription) {
         assert(subscription);
 
         mutex.lock();
-        bool result = false;
+        std::shared_ptr<SubscriptionState> state;
         auto id = reinterpret_cast<uint64_t>(subscription);
-        for (auto it = items.begin(); it != items.end(); ++it) {
-            if (it->id == id) {
-                items.erase(it);
-                result = true;
-                break;
+        auto new_snapshot = std::make_shared<Subscriptions>();
+        auto current_snapshot = snapshot.load();
+        new_snapshot->reserve(current_snapshot->size());
+        for (auto& item : *current_snapshot) {
+            if (item.id == id) {
+                state = item.state;
+            } else {
+                new_snapshot->push_back(item);
             }
         }
-
+        snapshot.store(std::move(new_snapshot));
         mutex.unlock();
-        tt_check(result);
+
+        tt_check(state != nullptr);
+        // Don't hold the subscriptions lock while waiting: the running callback might (un)subscribe
+        state->mutex.lock();
+        state->active = false;
+        state->mutex.unlock();
     }
 
-    /** Publish something to all subscribers (Threadsafe, Re-entrable.)
+    /** Publish something to all subscribers (Threadsafe, Re-entrable, lock-free)
      * @param[in] data the data to publish
      */
-    void publish(DataType data) {
-        mutex.lock();
-
-        // Iterate over subscribers
-        for (auto& it : items) {
-            it.callback(data);
+    void publish(const DataType& data) {
+        // Keeps the snapshot alive while iterating, even when subscriptions change
+        auto current_snapshot = snapshot.load();
+
+        for (auto& item : *current_snapshot) {
+            if (item.dispatcherThread == nullptr) {
+                deliver(item.callback, *item.state, data);
+            } else {
+                item.dispatcherThread->dispatch([callback = item.callback, state = item.state, data] {
+                    deliver(callback, *state, data);
+                });
+            }
         }
-
-        mutex.unlock();
     }
+
+    /** @return the amount of active subscriptions */
+    size_t getSubscriptionCount() const { return snapshot.load()->size(); }
 };
 
 
@@ -0,0 +1,112 @@
+/**
+* @file RingDispatcher.h
+*
+* RingDispatcher is an allocation-free, lock-free code execution queue.
+*/
+#pragma once
+
+#include "EventFlag.h"
+#include "InlineFunction.h"
+
+#include <atomic>
+#include <memory>
+
+namespace tt {
+
+/**
+ * A bounded multi-producer single-consumer alternative to Dispatcher.
+ * Functions are stored inline in a fixed ring of slots, so dispatching never allocates or locks.
+ * Dispatching is safe from ISR context. Consuming must happen on a single thread.
+ */
+class RingDispatcher final {
+
+public:
+
+    /** The amount of bytes a dispatched function (including its captures) can occupy */
+    static constexpr size_t FUNCTION_STORAGE_SIZE = 32;
+
+    typedef InlineFunction<FUNCTION_STORAGE_SIZE> Function;
+
+    /** What dispatch() does when all slots are taken */
+    enum class OverflowPolicy {
+        /** Fail immediately */
+        Reject,
+        /** Wait for a free slot until the timeout passes (behaves like Reject in ISR context) */
+        Wait
+    };
+
+    struct Statistics {
+        uint32_t dispatched;
+        uint32_t consumed;
+        /** Amount of functions that were not queued because the ring was full */
+        uint32_t rejected;
+        /** The highest amount of queued functions that was observed */
+        uint32_t highWaterMark;
+    };
+
+private:
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Function function;
+    };
+
+    const size_t capacity;
+    const size_t mask;
+    const OverflowPolicy overflowPolicy;
+    const uint32_t maxBatchSize;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<size_t> enqueuePosition = 0;
+    alignas(64) std::atomic<size_t> dequeuePosition = 0;
+    std::atomic<uint32_t> dispatchedCount = 0;
+    std::atomic<uint32_t> consumedCount = 0;
+    std::atomic<uint32_t> rejectedCount = 0;
+    std::atomic<uint32_t> highWaterMark = 0;
+    uint32_t lastReportedRejectedCount = 0;
+    EventFlag eventFlag;
+
+    bool tryEnqueue(Function& function);
+
+    bool tryDequeue(Function& function);
+
+    void updateHighWaterMark(size_t position);
+
+public:
+
+    /**
+     * @param[in] capacity the amount of slots, rounded up to the next power of 2
+     * @param[in] overflowPolicy the behaviour when dispatching to a full ring
+     * @param[in] maxBatchSize the maximum amount of functions to execute during a single consume() call
+     */
+    explicit RingDispatcher(size_t capacity = 64, OverflowPolicy overflowPolicy = OverflowPolicy::Reject, uint32_t maxBatchSize = 32);
+
+    ~RingDispatcher() = default;
+
+    /**
+     * Queue a function to be consumed elsewhere.
+     * Can be called from ISR context.
+     * @param[in] function the function to execute elsewhere
+     * @param[in] timeout the maximum wait time for a free slot (only used by OverflowPolicy::Wait)
+     * @return true if the function was queued
+     */
+    bool dispatch(Function function, TickType_t timeout = portMAX_DELAY);
+
+    /**
+     * Consume up to the maximum batch size of dispatched functions.
+     * Must always be called from the same thread.
+     * @warning The timeout is only the wait time before consuming the message! It is not a limit to the total execution time when calling this method.
+     * @param[in] timeout the ticks to wait for a message
+     * @return the amount of messages that were consumed
+     */
+    uint32_t consume(TickType_t timeout = portMAX_DELAY);
+
+    /** @return the amount of slots */
+    size_t getCapacity() const { return capacity; }
+
+    /** @return the amount of functions that are currently queued */
+    size_t getCount() const;
+
+    Statistics getStatistics() const;
+};
+
+} // namespace
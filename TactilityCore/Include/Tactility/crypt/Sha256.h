@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <mbedtls/sha256.h>
+
+namespace tt::crypt {
+
+/**
+ * Calculates a SHA-256 digest incrementally, so data can be hashed while it is received.
+ */
+class Sha256 final {
+
+    mbedtls_sha256_context context;
+
+public:
+
+    Sha256();
+    ~Sha256();
+
+    Sha256(const Sha256&) = delete;
+    Sha256& operator=(const Sha256&) = delete;
+
+    /** Add data to the digest */
+    void update(const void* data, size_t length);
+
+    /**
+     * Finish the calculation. The instance can be re-used afterwards.
+     * @param[out] digest the 32 byte digest
+     */
+    void finish(uint8_t digest[32]);
+
+    /**
+     * Finish the calculation. The instance can be re-used afterwards.
+     * @return the digest as a lowercase hexadecimal string
+     */
+    std::string finishHex();
+};
+
+} // namespace
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace tt::file {
+
+/**
+ * A read-only archive with files and pre-decoded images, created by Buildscripts/asset-pack.py
+ *
+ * Layout (little-endian):
+ *  - header: "TTAP" magic, uint16 version, uint16 reserved, uint32 entry count, uint32 names offset
+ *  - index: the entries, sorted by the FNV-1a hash of their name
+ *  - names: the entry names without null terminators (e.g. "app/Launcher/assets/icon_apps.png")
+ *  - data: the entry data, aligned to 4 bytes
+ *
+ * Image entries start with an lv_image_header_t that is followed by the pixels.
+ * When an image is compressed, only the pixels are LZ4-compressed.
+ */
+class AssetPack final {
+
+public:
+
+    enum class EntryType : uint8_t {
+        File = 0,
+        /** An lv_image_header_t followed by the pixel data */
+        Image = 1
+    };
+
+    struct Entry {
+        EntryType type;
+        /** The data is compressed with the LZ4 block format */
+        bool compressed;
+        const uint8_t* data;
+        size_t size;
+        /** The size of the data after decompression, which equals the size of uncompressed data */
+        size_t originalSize;
+    };
+
+    /** Called when the pack is destroyed, e.g. to unmap the memory */
+    typedef std::function<void()> ReleaseFunction;
+
+private:
+
+    const uint8_t* data;
+    size_t size;
+    ReleaseFunction releaseFunction;
+    uint32_t entryCount = 0;
+    bool valid = false;
+
+public:
+
+    /**
+     * @param[in] data the pack data, which must stay available until the pack is destroyed
+     * @param[in] size the size of the data, which can be larger than the pack (e.g. a partition)
+     * @param[in] releaseFunction optional function that is called when the pack is destroyed
+     */
+    AssetPack(const uint8_t* data, size_t size, ReleaseFunction releaseFunction = nullptr);
+
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /** @return true when the data has a valid pack header */
+    bool isValid() const { return valid; }
+
+    uint32_t getEntryCount() const { return entryCount; }
+
+    /**
+     * @param[in] name the path of the entry, relative to the root of the pack
+     * @param[out] outEntry the entry that was found
+     * @return true when the entry was found
+     */
+    bool find(const std::string& name, Entry& outEntry) const;
+
+    /**
+     * Decompress LZ4 block data.
+     * @param[in] input the compressed data
+     * @param[in] inputSize the size of the compressed data
+     * @param[out] output the buffer for the decompressed data
+     * @param[in] outputSize the exact size of the decompressed data
+     * @return true when the data was decompressed and exactly fills the output buffer
+     */
+    static bool decompress(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize);
+};
+
+/**
+ * Serve the files inside a path from an asset pack, so readBinary(), readString(), readLines() and isFile() don't
+ * have to access the filesystem. Files that aren't in the pack are still read from the filesystem.
+ * @param[in] mountPath the path that the root of the pack represents (e.g. "/system")
+ * @param[in] pack the pack, or null to stop using a pack
+ */
+void setAssetPack(const std::string& mountPath, std::shared_ptr<AssetPack> pack);
+
+/**
+ * @param[in] path a path inside the mount path of the asset pack (e.g. "/system/timezones.csv")
+ * @param[out] outPack the pack that contains the entry, which keeps the entry data available
+ * @param[out] outEntry the entry that was found
+ * @return true when the entry was found
+ */
+bool findAsset(const std::string& path, std::shared_ptr<AssetPack>& outPack, AssetPack::Entry& outEntry);
+
+}
@@ -47,7 +47,7 @@ uint32_t Dispatcher::consume(TickType_t timeout) {
     do {
         if (mutex.lock(10)) {
             if (!queue.empty()) {
-                auto function = queue.front();
+                auto function = std::move(queue.front());
                 queue.pop();
                 consumed++;
                 processing = !queue.empty();
@@ -0,0 +1,585 @@
+#include "Tactility/LogBuffer.h"
+#include "Tactility/Mutex.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/types.h>
+
+namespace tt {
+
+// region Format specifications
+
+enum class ArgumentType {
+    /** No argument (e.g. "%%") */
+    None,
+    Signed,
+    Unsigned,
+    Double,
+    String,
+    Pointer,
+    /** "%n": the argument is consumed, but not used */
+    Ignored
+};
+
+enum class LengthModifier {
+    None,
+    Char,
+    Short,
+    Long,
+    LongLong,
+    Size,
+    Max,
+    PtrDiff,
+    LongDouble
+};
+
+struct FormatSpecification {
+    /** Flags, width and precision (without the '%') */
+    std::string prefix;
+    bool widthArgument;
+    bool precisionArgument;
+    /** The precision that is part of the prefix, or -1 when there is none */
+    int precision;
+    LengthModifier length;
+    char conversion;
+    ArgumentType type;
+};
+
+/** @return the position after the specification, or nullptr when the specification is invalid */
+static const char* parseSpecification(const char* input, FormatSpecification& specification) {
+    assert(*input == '%');
+    input++;
+
+    specification.prefix.clear();
+    specification.widthArgument = false;
+    specification.precisionArgument = false;
+    specification.precision = -1;
+    specification.length = LengthModifier::None;
+
+    while (*input != '\0' && strchr("-+ #0'", *input) != nullptr) {
+        specification.prefix += *input++;
+    }
+
+    if (*input == '*') {
+        specification.widthArgument = true;
+        input++;
+    } else {
+        while (*input >= '0' && *input <= '9') {
+            specification.prefix += *input++;
+        }
+    }
+
+    if (*input == '.') {
+        input++;
+        if (*input == '*') {
+            specification.precisionArgument = true;
+            input++;
+        } else {
+            specification.prefix += '.';
+            specification.precision = 0;
+            while (*input >= '0' && *input <= '9') {
+                specification.precision = specification.precision * 10 + (*input - '0');
+                specification.prefix += *input++;
+            }
+        }
+    }
+
+    switch (*input) {
+        case 'h':
+            input++;
+            if (*input == 'h') {
+                specification.length = LengthModifier::Char;
+                input++;
+            } else {
+                specification.length = LengthModifier::Short;
+            }
+            break;
+        case 'l':
+            input++;
+            if (*input == 'l') {
+                specification.length = LengthModifier::LongLong;
+                input++;
+            } else {
+                specification.length = LengthModifier::Long;
+            }
+            break;
+        case 'q':
+            specification.length = LengthModifier::LongLong;
+            input++;
+            break;
+        case 'z':
+            specification.length = LengthModifier::Size;
+            input++;
+            break;
+        case 'j':
+            specification.length = LengthModifier::Max;
+            input++;
+            break;
+        case 't':
+            specification.length = LengthModifier::PtrDiff;
+            input++;
+            break;
+        case 'L':
+            specification.length = LengthModifier::LongDouble;
+            input++;
+            break;
+        default:
+            break;
+    }
+
+    specification.conversion = *input;
+    switch (specification.conversion) {
+        case '%':
+            specification.type = ArgumentType::None;
+            break;
+        case 'd':
+        case 'i':
+        case 'c':
+            specification.type = ArgumentType::Signed;
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            specification.type = ArgumentType::Unsigned;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            specification.type = ArgumentType::Double;
+            break;
+        case 's':
+            specification.type = ArgumentType::String;
+            break;
+        case 'p':
+            specification.type = ArgumentType::Pointer;
+            break;
+        case 'n':
+            specification.type = ArgumentType::Ignored;
+            break;
+        default:
+            return nullptr;
+    }
+
+    return input + 1;
+}
+
+// endregion
+
+// region Encoding
+
+class ArgumentWriter {
+
+    uint8_t* data;
+    size_t capacity;
+    size_t length = 0;
+
+public:
+
+    ArgumentWriter(uint8_t* data, size_t capacity) : data(data), capacity(capacity) {}
+
+    template <typename T>
+    bool write(T value) {
+        if (length + sizeof(T) > capacity) {
+            return false;
+        }
+        memcpy(data + length, &value, sizeof(T));
+        length += sizeof(T);
+        return true;
+    }
+
+    /**
+     * Writes the length and the characters, truncated when there is not enough space
+     * @param[in] value the string, which doesn't have to be null-terminated when it's longer than maxLength
+     * @param[in] maxLength the maximum amount of characters to read (e.g. the precision of "%.*s")
+     */
+    bool writeString(const char* value, size_t maxLength = SIZE_MAX) {
+        if (length + sizeof(uint16_t) > capacity) {
+            return false;
+        }
+        auto string_length = std::min(strnlen(value, maxLength), capacity - length - sizeof(uint16_t));
+        write(static_cast<uint16_t>(string_length));
+        memcpy(data + length, value, string_length);
+        length += string_length;
+        return true;
+    }
+
+    size_t getLength() const { return length; }
+};
+
+static int64_t readSigned(LengthModifier length, va_list& args) {
+    switch (length) {
+        case LengthModifier::Long:
+            return va_arg(args, long);
+        case LengthModifier::LongLong:
+            return va_arg(args, long long);
+        case LengthModifier::Size:
+            return va_arg(args, ssize_t);
+        case LengthModifier::Max:
+            return va_arg(args, intmax_t);
+        case LengthModifier::PtrDiff:
+            return va_arg(args, ptrdiff_t);
+        default:
+            // char and short are promoted to int
+            return va_arg(args, int);
+    }
+}
+
+static uint64_t readUnsigned(LengthModifier length, va_list& args) {
+    switch (length) {
+        case LengthModifier::Long:
+            return va_arg(args, unsigned long);
+        case LengthModifier::LongLong:
+            return va_arg(args, unsigned long long);
+        case LengthModifier::Size:
+            return va_arg(args, size_t);
+        case LengthModifier::Max:
+            return va_arg(args, uintmax_t);
+        case LengthModifier::PtrDiff:
+            return va_arg(args, ptrdiff_t);
+        default:
+            return va_arg(args, unsigned int);
+    }
+}
+
+/** Copy the arguments to the output, in the order of the format specifications */
+static size_t encodeArguments(const char* format, va_list args, uint8_t* output, size_t capacity) {
+    ArgumentWriter writer(output, capacity);
+    FormatSpecification specification;
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    const char* position = strchr(format, '%');
+    while (position != nullptr) {
+        position = parseSpecification(position, specification);
+        if (position == nullptr) {
+            break;
+        }
+
+        if (specification.widthArgument && !writer.write<int64_t>(va_arg(args_copy, int))) {
+            break;
+        }
+
+        int precision = specification.precision;
+        if (specification.precisionArgument) {
+            precision = va_arg(args_copy, int);
+            if (!writer.write<int64_t>(precision)) {
+                break;
+            }
+        }
+
+        bool written = true;
+        switch (specification.type) {
+            case ArgumentType::None:
+                break;
+            case ArgumentType::Signed:
+                written = writer.write<int64_t>(readSigned(specification.length, args_copy));
+                break;
+            case ArgumentType::Unsigned:
+                written = writer.write<uint64_t>(readUnsigned(specification.length, args_copy));
+                break;
+            case ArgumentType::Double:
+                if (specification.length == LengthModifier::LongDouble) {
+                    written = writer.write<double>(static_cast<double>(va_arg(args_copy, long double)));
+                } else {
+                    written = writer.write<double>(va_arg(args_copy, double));
+                }
+                break;
+            case ArgumentType::String:
+                if (specification.length == LengthModifier::Long) {
+                    va_arg(args_copy, wchar_t*);
+                    written = writer.writeString("(wide string)");
+                } else {
+                    const char* value = va_arg(args_copy, const char*);
+                    // A negative precision is ignored, like printf() does
+                    const size_t max_length = (precision >= 0) ? static_cast<size_t>(precision) : SIZE_MAX;
+                    written = writer.writeString(value != nullptr ? value : "(null)", max_length);
+                }
+                break;
+            case ArgumentType::Pointer:
+                written = writer.write<const void*>(va_arg(args_copy, const void*));
+                break;
+            case ArgumentType::Ignored:
+                va_arg(args_copy, void*);
+                break;
+        }
+
+        if (!written) {
+            break;
+        }
+
+        position = strchr(position, '%');
+    }
+
+    va_end(args_copy);
+    return writer.getLength();
+}
+
+// endregion
+
+// region Formatting
+
+class ArgumentReader {
+
+    const uint8_t* data;
+    size_t length;
+    size_t position = 0;
+
+public:
+
+    ArgumentReader(const uint8_t* data, size_t length) : data(data), length(length) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (position + sizeof(T) > length) {
+            return false;
+        }
+        memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint16_t string_length;
+        if (!read(string_length) || position + string_length > length) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data + position), string_length);
+        position += string_length;
+        return true;
+    }
+};
+
+template <typename T>
+static void appendFormatted(std::string& output, const std::string& specification, T value) {
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), specification.c_str(), value);
+    if (length < 0) {
+        return;
+    }
+
+    if (static_cast<size_t>(length) < sizeof(buffer)) {
+        output.append(buffer, length);
+    } else {
+        auto offset = output.size();
+        output.resize(offset + length + 1);
+        snprintf(output.data() + offset, length + 1, specification.c_str(), value);
+        output.resize(offset + length);
+    }
+}
+
+/** Format the message like printf() would, with the arguments that were stored by encodeArguments() */
+static void formatMessage(const char* format, const uint8_t* arguments, size_t argumentsLength, std::string& output) {
+    ArgumentReader reader(arguments, argumentsLength);
+    FormatSpecification specification;
+    std::string printf_specification;
+    std::string string_value;
+
+    const char* position = format;
+    while (*position != '\0') {
+        const char* next = strchr(position, '%');
+        if (next == nullptr) {
+            output.append(position);
+            return;
+        }
+
+        output.append(position, next - position);
+        const char* specification_end = parseSpecification(next, specification);
+        if (specification_end == nullptr) {
+            // Print invalid specifications as they are
+            output.append(next);
+            return;
+        }
+
+        printf_specification = "%" + specification.prefix;
+        int64_t width;
+        if (specification.widthArgument) {
+            if (!reader.read(width)) {
+                output.append(next);
+                return;
+            }
+            printf_specification += std::to_string(width);
+        }
+
+        int64_t precision;
+        if (specification.precisionArgument) {
+            if (!reader.read(precision)) {
+                output.append(next);
+                return;
+            }
+            // A negative precision is ignored
+            if (precision >= 0) {
+                printf_specification += "." + std::to_string(precision);
+            }
+        }
+
+        bool has_value = true;
+        switch (specification.type) {
+            case ArgumentType::None:
+                output += '%';
+                break;
+            case ArgumentType::Signed: {
+                int64_t value;
+                has_value = reader.read(value);
+                if (has_value) {
+                    if (specification.conversion == 'c') {
+                        appendFormatted(output, printf_specification + 'c', static_cast<int>(value));
+                    } else {
+                        appendFormatted(output, printf_specification + "lld", static_cast<long long>(value));
+                    }
+                }
+                break;
+            }
+            case ArgumentType::Unsigned: {
+                uint64_t value;
+                has_value = reader.read(value);
+                if (has_value) {
+                    appendFormatted(output, printf_specification + "ll" + specification.conversion, static_cast<unsigned long long>(value));
+                }
+                break;
+            }
+            case ArgumentType::Double: {
+                double value;
+                has_value = reader.read(value);
+                if (has_value) {
+                    appendFormatted(output, printf_specification + specification.conversion, value);
+                }
+                break;
+            }
+            case ArgumentType::String:
+                has_value = reader.readString(string_value);
+                if (has_value) {
+                    if (printf_specification.size() == 1) {
+                        output += string_value;
+                    } else {
+                        appendFormatted(output, printf_specification + 's', string_value.c_str());
+                    }
+                }
+                break;
+            case ArgumentType::Pointer: {
+                const void* value;
+                has_value = reader.read(value);
+                if (has_value) {
+                    appendFormatted(output, printf_specification + 'p', value);
+                }
+                break;
+            }
+            case ArgumentType::Ignored:
+                break;
+        }
+
+        if (!has_value) {
+            // The arguments didn't fit in the record
+            output.append(next);
+            return;
+        }
+
+        position = specification_end;
+    }
+}
+
+// endregion
+
+static constexpr uint32_t alignRecordSize(size_t size) {
+    return static_cast<uint32_t>((size + 7U) & ~static_cast<size_t>(7U));
+}
+
+LogBuffer::LogBuffer(size_t capacity) :
+    capacity(capacity),
+    buffer(std::make_unique<uint8_t[]>(capacity)),
+    writeMutex(std::make_unique<Mutex>()),
+    readMutex(std::make_unique<Mutex>())
+{
+    assert((capacity & (capacity - 1)) == 0);
+    assert(capacity >= alignRecordSize(sizeof(RecordHeader) + MAX_ARGUMENTS_SIZE));
+}
+
+LogBuffer::~LogBuffer() = default;
+
+bool LogBuffer::add(LogLevel level, uint64_t timestamp, const char* tag, const char* format, va_list args) {
+    // Encode outside the lock
+    uint8_t arguments[MAX_ARGUMENTS_SIZE];
+    auto arguments_length = encodeArguments(format, args, arguments, sizeof(arguments));
+    auto record_size = alignRecordSize(sizeof(RecordHeader) + arguments_length);
+
+    RecordHeader header = {
+        .size = record_size,
+        .level = level,
+        .timestamp = timestamp,
+        .tag = tag,
+        .format = format
+    };
+
+    writeMutex->lock(portMAX_DELAY);
+
+    auto write_index = writeIndex.load(std::memory_order_relaxed);
+    auto read_index = readIndex.load(std::memory_order_acquire);
+    auto offset = write_index & (capacity - 1);
+    auto contiguous = capacity - offset;
+    // Records don't wrap around: skip the end of the buffer when the record doesn't fit
+    auto required = (contiguous < record_size) ? contiguous + record_size : record_size;
+    if (capacity - (write_index - read_index) < required) {
+        writeMutex->unlock();
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (contiguous < record_size) {
+        uint32_t wrap_marker = 0;
+        memcpy(buffer.get() + offset, &wrap_marker, sizeof(wrap_marker));
+        write_index += contiguous;
+        offset = 0;
+    }
+
+    memcpy(buffer.get() + offset, &header, sizeof(RecordHeader));
+    memcpy(buffer.get() + offset + sizeof(RecordHeader), arguments, arguments_length);
+    writeIndex.store(write_index + record_size, std::memory_order_release);
+
+    writeMutex->unlock();
+    recordCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t LogBuffer::drain(const Consumer& consumer, bool wait) {
+    if (!readMutex->lock(wait ? portMAX_DELAY : 0)) {
+        return 0;
+    }
+
+    size_t count = 0;
+    std::string message;
+    auto read_index = readIndex.load(std::memory_order_relaxed);
+    auto write_index = writeIndex.load(std::memory_order_acquire);
+    while (read_index != write_index) {
+        auto offset = read_index & (capacity - 1);
+        RecordHeader header;
+        memcpy(&header.size, buffer.get() + offset, sizeof(header.size));
+        if (header.size == 0) {
+            read_index += capacity - offset;
+        } else {
+            memcpy(&header, buffer.get() + offset, sizeof(RecordHeader));
+            message.clear();
+            formatMessage(header.format, buffer.get() + offset + sizeof(RecordHeader), header.size - sizeof(RecordHeader), message);
+            consumer(header.level, header.timestamp, header.tag, message.c_str());
+            read_index += header.size;
+            count++;
+        }
+
+        // Release the space for writers
+        readIndex.store(read_index, std::memory_order_release);
+        write_index = writeIndex.load(std::memory_order_acquire);
+    }
+
+    readMutex->unlock();
+    return count;
+}
+
+} // namespace
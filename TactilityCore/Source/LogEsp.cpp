@@ -0,0 +1,143 @@
+#ifdef ESP_PLATFORM
+
+#include "Tactility/Log.h"
+#include "Tactility/CoreDefines.h"
+#include "Tactility/Thread.h"
+#include "Tactility/kernel/Kernel.h"
+
+#include <atomic>
+#include <cassert>
+#include <format>
+#include <string>
+
+namespace tt {
+
+constexpr TickType_t LOG_TASK_INTERVAL = pdMS_TO_TICKS(10);
+
+static LogBuffer logBuffer(8192);
+static std::atomic<bool> logTaskRunning = false;
+
+static esp_log_level_t toEspLogLevel(LogLevel level) {
+    // ESP_LOG_NONE is the first ESP-IDF level
+    return static_cast<esp_log_level_t>(static_cast<int>(level) + 1);
+}
+
+static char toPrefix(LogLevel level) {
+    using enum LogLevel;
+    switch (level) {
+        case Error:
+            return 'E';
+        case Warning:
+            return 'W';
+        case Info:
+            return 'I';
+        case Debug:
+            return 'D';
+        case Verbose:
+            return 'V';
+        default:
+            return ' ';
+    }
+}
+
+static const char* toColour(LogLevel level) {
+    using enum LogLevel;
+    switch (level) {
+        case Error:
+            return LOG_COLOR_E;
+        case Warning:
+            return LOG_COLOR_W;
+        case Info:
+            return LOG_COLOR_I;
+        case Debug:
+            return LOG_COLOR_D;
+        case Verbose:
+            return LOG_COLOR_V;
+        default:
+            return "";
+    }
+}
+
+void setLogLevel(const char* tag, LogLevel level) {
+    esp_log_level_set(tag, toEspLogLevel(level));
+}
+
+bool isLoggable(LogLevel level, const char* tag) {
+    return esp_log_level_get(tag) >= toEspLogLevel(level);
+}
+
+/** Write a record in the format of ESP_LOGx() */
+static void writeRecord(LogLevel level, uint64_t timestamp, const char* tag, const char* message) {
+    esp_log_write(
+        toEspLogLevel(level),
+        tag,
+        "%s%c (%lu) %s: %s" LOG_RESET_COLOR "\n",
+        toColour(level),
+        toPrefix(level),
+        static_cast<unsigned long>(timestamp),
+        tag,
+        message
+    );
+}
+
+void flushLog() {
+    logBuffer.drain(writeRecord, true);
+}
+
+LogBuffer::Statistics getLogStatistics() {
+    return logBuffer.getStatistics();
+}
+
+static void logTask(TT_UNUSED void* parameter) {
+    logTaskRunning = true;
+    while (true) {
+        logBuffer.drain(writeRecord);
+        vTaskDelay(LOG_TASK_INTERVAL);
+    }
+}
+
+void startLogThread() {
+    BaseType_t task_result = xTaskCreate(
+        logTask,
+        "log",
+        4096,
+        nullptr,
+        static_cast<UBaseType_t>(Thread::Priority::Lower),
+        nullptr
+    );
+    assert(task_result == pdTRUE);
+}
+
+void log(LogLevel level, const char* tag, const char* format, ...) {
+    if (!isLoggable(level, tag)) {
+        return;
+    }
+
+    // The buffer uses mutexes, which can't be used in an ISR
+    const bool is_isr = kernel::isIsr();
+    if (logTaskRunning && level != LogLevel::Error && !is_isr) {
+        va_list args;
+        va_start(args, format);
+        logBuffer.add(level, esp_log_timestamp(), tag, format, args);
+        va_end(args);
+        return;
+    }
+
+    // Keep the order of the output
+    if (logTaskRunning && !is_isr) {
+        logBuffer.drain(writeRecord, true);
+    }
+
+    auto line = std::format("{}{} ({}) {}: ", toColour(level), toPrefix(level), esp_log_timestamp(), tag);
+    line.append(format);
+    line.append(LOG_RESET_COLOR "\n");
+
+    va_list args;
+    va_start(args, format);
+    esp_log_writev(toEspLogLevel(level), tag, line.c_str(), args);
+    va_end(args);
+}
+
+} // namespace
+
+#endif // ESP_PLATFORM
@@ -1,14 +1,38 @@
 #ifndef ESP_PLATFORM
 
 #include "Tactility/Log.h"
+#include "Tactility/CoreDefines.h"
+#include "Tactility/Mutex.h"
+#include "Tactility/Thread.h"
 
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <sys/time.h>
 
 namespace tt {
 
+constexpr size_t MAX_TAG_LEVELS = 32;
+constexpr TickType_t LOG_TASK_INTERVAL = pdMS_TO_TICKS(10);
+
+struct TagLevel {
+    const char* tag;
+    std::atomic<LogLevel> level;
+};
+
+static std::atomic<LogLevel> defaultLevel = LogLevel::Verbose;
+static std::array<TagLevel, MAX_TAG_LEVELS> tagLevels;
+// Entries are only added, so readers don't need the lock
+static std::atomic<size_t> tagLevelCount = 0;
+static Mutex tagLevelMutex;
+
+static LogBuffer logBuffer;
+static std::atomic<bool> logTaskRunning = false;
+
 static char toPrefix(LogLevel level) {
     using enum LogLevel;
     switch (level) {
@@ -71,7 +95,101 @@ static uint64_t getLogTimestamp() {
     return now - base;
 }
 
+static TagLevel* findTagLevel(const char* tag) {
+    auto count = tagLevelCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (tagLevels[i].tag == tag || strcmp(tagLevels[i].tag, tag) == 0) {
+            return &tagLevels[i];
+        }
+    }
+    return nullptr;
+}
+
+void setLogLevel(const char* tag, LogLevel level) {
+    if (strcmp(tag, "*") == 0) {
+        defaultLevel = level;
+        return;
+    }
+
+    auto lock = tagLevelMutex.asScopedLock();
+    lock.lock();
+
+    auto* tag_level = findTagLevel(tag);
+    if (tag_level != nullptr) {
+        tag_level->level = level;
+    } else {
+        auto count = tagLevelCount.load(std::memory_order_relaxed);
+        if (count < MAX_TAG_LEVELS) {
+            tagLevels[count].tag = tag;
+            tagLevels[count].level = level;
+            tagLevelCount.store(count + 1, std::memory_order_release);
+        }
+    }
+}
+
+bool isLoggable(LogLevel level, const char* tag) {
+    if (tagLevelCount.load(std::memory_order_relaxed) != 0) {
+        auto* tag_level = findTagLevel(tag);
+        if (tag_level != nullptr) {
+            return level <= tag_level->level.load(std::memory_order_relaxed);
+        }
+    }
+    return level <= defaultLevel.load(std::memory_order_relaxed);
+}
+
+static void printRecord(LogLevel level, uint64_t timestamp, const char* tag, const char* message) {
+    printf("%llu [%s%c\033[0m] [%s] %s%s\033[0m\n", static_cast<unsigned long long>(timestamp), toTagColour(level), toPrefix(level), tag, toMessageColour(level), message);
+}
+
+void flushLog() {
+    logBuffer.drain(printRecord, true);
+    fflush(stdout);
+}
+
+LogBuffer::Statistics getLogStatistics() {
+    return logBuffer.getStatistics();
+}
+
+static void logTask(TT_UNUSED void* parameter) {
+    logTaskRunning = true;
+    while (true) {
+        if (logBuffer.drain(printRecord) > 0) {
+            fflush(stdout);
+        }
+        vTaskDelay(LOG_TASK_INTERVAL);
+    }
+}
+
+void startLogThread() {
+    BaseType_t task_result = xTaskCreate(
+        logTask,
+        "log",
+        4096,
+        nullptr,
+        static_cast<UBaseType_t>(Thread::Priority::Lower),
+        nullptr
+    );
+    assert(task_result == pdTRUE);
+}
+
 void log(LogLevel level, const char* tag, const char* format, ...) {
+    if (!isLoggable(level, tag)) {
+        return;
+    }
+
+    if (logTaskRunning && level != LogLevel::Error) {
+        va_list args;
+        va_start(args, format);
+        logBuffer.add(level, getLogTimestamp(), tag, format, args);
+        va_end(args);
+        return;
+    }
+
+    // Keep the order of the output
+    if (logTaskRunning) {
+        logBuffer.drain(printRecord, true);
+    }
+
     std::stringstream buffer;
     buffer << getLogTimestamp() << " [" << toTagColour(level) << toPrefix(level) << "\033[0m" << "] [" << tag << "] " << toMessageColour(level) << format  << "\033[0m\n";
 
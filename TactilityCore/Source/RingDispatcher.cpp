@@ -0,0 +1,140 @@
+#include "Tactility/RingDispatcher.h"
+
+#include "Tactility/Check.h"
+#include "Tactility/Log.h"
+#include "Tactility/kernel/Kernel.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace tt {
+
+#define TAG "ring_dispatcher"
+#define WAIT_FLAG ((EventBits_t)1U)
+
+RingDispatcher::RingDispatcher(size_t capacity, OverflowPolicy overflowPolicy, uint32_t maxBatchSize) :
+    capacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+    mask(this->capacity - 1),
+    overflowPolicy(overflowPolicy),
+    maxBatchSize(maxBatchSize),
+    slots(std::make_unique<Slot[]>(this->capacity))
+{
+    tt_check(maxBatchSize > 0);
+    for (size_t i = 0; i < this->capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void RingDispatcher::updateHighWaterMark(size_t position) {
+    auto count = static_cast<uint32_t>(position + 1 - dequeuePosition.load(std::memory_order_relaxed));
+    auto current = highWaterMark.load(std::memory_order_relaxed);
+    while (count > current && !highWaterMark.compare_exchange_weak(current, count, std::memory_order_relaxed)) {}
+}
+
+bool RingDispatcher::tryEnqueue(Function& function) {
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        auto& slot = slots[position & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.function = std::move(function);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                updateHighWaterMark(position);
+                return true;
+            }
+        } else if (difference < 0) {
+            // Full
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool RingDispatcher::tryDequeue(Function& function) {
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    auto& slot = slots[position & mask];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != position + 1) {
+        // Empty, or a producer hasn't finished writing the slot yet
+        return false;
+    }
+
+    function = std::move(slot.function);
+    dequeuePosition.store(position + 1, std::memory_order_relaxed);
+    slot.sequence.store(position + capacity, std::memory_order_release);
+    return true;
+}
+
+bool RingDispatcher::dispatch(Function function, TickType_t timeout) {
+    assert(function);
+
+    bool queued = tryEnqueue(function);
+    if (!queued && overflowPolicy == OverflowPolicy::Wait && !kernel::isIsr()) {
+        const TickType_t start_time = kernel::getTicks();
+        while (!queued && (kernel::getTicks() - start_time) < timeout) {
+            kernel::delayTicks(1);
+            queued = tryEnqueue(function);
+        }
+    }
+
+    if (queued) {
+        dispatchedCount.fetch_add(1, std::memory_order_relaxed);
+        eventFlag.set(WAIT_FLAG);
+    } else {
+        // Not logging here, as we might be in ISR context: it is reported by the consumer instead
+        rejectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return queued;
+}
+
+uint32_t RingDispatcher::consume(TickType_t timeout) {
+    // Wait for signal
+    uint32_t result = eventFlag.wait(WAIT_FLAG, EventFlag::WaitAny, timeout);
+    if (result & EventFlag::Error) {
+        return 0;
+    }
+
+    eventFlag.clear(WAIT_FLAG);
+
+    auto rejected = rejectedCount.load(std::memory_order_relaxed);
+    if (rejected != lastReportedRejectedCount) {
+        TT_LOG_W(TAG, "Backpressure: %lu functions rejected (capacity %zu)", (unsigned long)(rejected - lastReportedRejectedCount), capacity);
+        lastReportedRejectedCount = rejected;
+    }
+
+    uint32_t consumed = 0;
+    Function function;
+    while (consumed < maxBatchSize && tryDequeue(function)) {
+        function();
+        function.reset();
+        consumed++;
+    }
+
+    consumedCount.fetch_add(consumed, std::memory_order_relaxed);
+
+    // When the batch limit was hit, make sure the next consume() call doesn't wait
+    if (getCount() > 0) {
+        eventFlag.set(WAIT_FLAG);
+    }
+
+    return consumed;
+}
+
+size_t RingDispatcher::getCount() const {
+    return enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition.load(std::memory_order_relaxed);
+}
+
+RingDispatcher::Statistics RingDispatcher::getStatistics() const {
+    return {
+        .dispatched = dispatchedCount.load(std::memory_order_relaxed),
+        .consumed = consumedCount.load(std::memory_order_relaxed),
+        .rejected = rejectedCount.load(std::memory_order_relaxed),
+        .highWaterMark = highWaterMark.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace
@@ -0,0 +1,37 @@
+#include "Tactility/crypt/Sha256.h"
+
+namespace tt::crypt {
+
+Sha256::Sha256() {
+    mbedtls_sha256_init(&context);
+    mbedtls_sha256_starts(&context, 0);
+}
+
+Sha256::~Sha256() {
+    mbedtls_sha256_free(&context);
+}
+
+void Sha256::update(const void* data, size_t length) {
+    mbedtls_sha256_update(&context, static_cast<const unsigned char*>(data), length);
+}
+
+void Sha256::finish(uint8_t digest[32]) {
+    mbedtls_sha256_finish(&context, digest);
+    mbedtls_sha256_starts(&context, 0);
+}
+
+std::string Sha256::finishHex() {
+    constexpr auto* HEX_CHARACTERS = "0123456789abcdef";
+    uint8_t digest[32];
+    finish(digest);
+
+    std::string result;
+    result.reserve(64);
+    for (auto byte : digest) {
+        result += HEX_CHARACTERS[byte >> 4];
+        result += HEX_CHARACTERS[byte & 0x0F];
+    }
+    return result;
+}
+
+} // namespace
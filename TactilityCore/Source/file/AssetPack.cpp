@@ -0,0 +1,251 @@
+#include "Tactility/file/AssetPack.h"
+
+#include <Tactility/Log.h>
+#include <Tactility/Mutex.h>
+
+#include <cstring>
+
+namespace tt::file {
+
+constexpr auto* TAG = "AssetPack";
+
+constexpr char MAGIC[] = { 'T', 'T', 'A', 'P' };
+constexpr uint16_t VERSION = 1;
+constexpr uint8_t ENTRY_FLAG_LZ4 = 0x01;
+constexpr size_t LZ4_MIN_MATCH = 4;
+
+struct Header {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t entryCount;
+    uint32_t namesOffset;
+};
+
+struct IndexEntry {
+    uint32_t hash;
+    uint32_t nameOffset;
+    uint16_t nameLength;
+    uint8_t type;
+    uint8_t flags;
+    uint32_t dataOffset;
+    uint32_t size;
+    uint32_t originalSize;
+};
+
+static_assert(sizeof(Header) == 16);
+static_assert(sizeof(IndexEntry) == 24);
+
+static uint32_t getHash(const std::string& name) {
+    uint32_t hash = 0x811C9DC5;
+    for (const char character : name) {
+        hash = (hash ^ static_cast<uint8_t>(character)) * 0x01000193;
+    }
+    return hash;
+}
+
+AssetPack::AssetPack(const uint8_t* data, size_t size, ReleaseFunction releaseFunction) :
+    data(data),
+    size(size),
+    releaseFunction(std::move(releaseFunction)) {
+    Header header;
+    if (data == nullptr || size < sizeof(Header)) {
+        return;
+    }
+
+    memcpy(&header, data, sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return;
+    }
+
+    if (header.version != VERSION) {
+        TT_LOG_E(TAG, "Unsupported version %u", header.version);
+        return;
+    }
+
+    if (header.entryCount > (size - sizeof(Header)) / sizeof(IndexEntry)) {
+        TT_LOG_E(TAG, "Index is out of bounds");
+        return;
+    }
+
+    entryCount = header.entryCount;
+    valid = true;
+}
+
+AssetPack::~AssetPack() {
+    if (releaseFunction != nullptr) {
+        releaseFunction();
+    }
+}
+
+bool AssetPack::find(const std::string& name, Entry& outEntry) const {
+    if (!valid) {
+        return false;
+    }
+
+    const auto hash = getHash(name);
+    const auto* index = data + sizeof(Header);
+    const auto read_entry = [index](uint32_t position, IndexEntry& entry) {
+        memcpy(&entry, index + position * sizeof(IndexEntry), sizeof(IndexEntry));
+    };
+
+    // Binary search for the first entry with the hash
+    uint32_t low = 0;
+    uint32_t high = entryCount;
+    IndexEntry entry;
+    while (low < high) {
+        const uint32_t middle = low + (high - low) / 2;
+        read_entry(middle, entry);
+        if (entry.hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // Names with the same hash are stored next to each other
+    for (uint32_t position = low; position < entryCount; position++) {
+        read_entry(position, entry);
+        if (entry.hash != hash) {
+            break;
+        }
+
+        if (entry.nameOffset > size || entry.nameLength > size - entry.nameOffset) {
+            TT_LOG_E(TAG, "Name is out of bounds");
+            return false;
+        }
+
+        if (entry.nameLength != name.length() || memcmp(data + entry.nameOffset, name.data(), name.length()) != 0) {
+            continue;
+        }
+
+        if (entry.dataOffset > size || entry.size > size - entry.dataOffset) {
+            TT_LOG_E(TAG, "Data of %s is out of bounds", name.c_str());
+            return false;
+        }
+
+        const bool compressed = (entry.flags & ENTRY_FLAG_LZ4) != 0;
+        if (!compressed && entry.size != entry.originalSize) {
+            TT_LOG_E(TAG, "Size of %s doesn't match its original size", name.c_str());
+            return false;
+        }
+
+        outEntry = {
+            .type = static_cast<EntryType>(entry.type),
+            .compressed = compressed,
+            .data = data + entry.dataOffset,
+            .size = entry.size,
+            .originalSize = entry.originalSize
+        };
+        return true;
+    }
+
+    return false;
+}
+
+/** Read the extra bytes of a literal or match length */
+static bool readLength(const uint8_t* input, size_t inputSize, size_t& inputOffset, size_t& length) {
+    uint8_t value;
+    do {
+        if (inputOffset >= inputSize) {
+            return false;
+        }
+        value = input[inputOffset++];
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+bool AssetPack::decompress(const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize) {
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+
+    while (input_offset < inputSize) {
+        const uint8_t token = input[input_offset++];
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !readLength(input, inputSize, input_offset, literal_length)) {
+            return false;
+        }
+
+        if (literal_length > inputSize - input_offset || literal_length > outputSize - output_offset) {
+            return false;
+        }
+
+        memcpy(output + output_offset, input + input_offset, literal_length);
+        input_offset += literal_length;
+        output_offset += literal_length;
+
+        // The last sequence only has literals
+        if (input_offset == inputSize) {
+            break;
+        }
+
+        if (inputSize - input_offset < 2) {
+            return false;
+        }
+
+        const size_t offset = input[input_offset] | (input[input_offset + 1] << 8);
+        input_offset += 2;
+        if (offset == 0 || offset > output_offset) {
+            return false;
+        }
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15 && !readLength(input, inputSize, input_offset, match_length)) {
+            return false;
+        }
+        match_length += LZ4_MIN_MATCH;
+
+        if (match_length > outputSize - output_offset) {
+            return false;
+        }
+
+        // A match can overlap with the output that it creates, so it's copied byte by byte
+        const uint8_t* match = output + output_offset - offset;
+        for (size_t i = 0; i < match_length; i++) {
+            output[output_offset + i] = match[i];
+        }
+        output_offset += match_length;
+    }
+
+    return output_offset == outputSize;
+}
+
+// region Mounting
+
+static Mutex mutex;
+static std::string assetPackMountPath;
+static std::shared_ptr<AssetPack> assetPack;
+
+void setAssetPack(const std::string& mountPath, std::shared_ptr<AssetPack> pack) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+    assetPackMountPath = mountPath;
+    assetPack = std::move(pack);
+}
+
+bool findAsset(const std::string& path, std::shared_ptr<AssetPack>& outPack, AssetPack::Entry& outEntry) {
+    auto lock = mutex.asScopedLock();
+    lock.lock();
+
+    if (assetPack == nullptr) {
+        return false;
+    }
+
+    const auto prefix_length = assetPackMountPath.length();
+    if (path.length() <= prefix_length + 1 || !path.starts_with(assetPackMountPath) || path[prefix_length] != '/') {
+        return false;
+    }
+
+    if (!assetPack->find(path.substr(prefix_length + 1), outEntry)) {
+        return false;
+    }
+
+    outPack = assetPack;
+    return true;
+}
+
+// endregion Mounting
+
+}
@@ -1,4 +1,5 @@
 #include "Tactility/file/File.h"
+#include "Tactility/file/AssetPack.h"
 
 #include <cstring>
 #include <fstream>
@@ -143,12 +144,47 @@ long getSize(FILE* file) {
     return file_size;
 }
 
+/** Read a file from the asset pack.
+ * @param[in] filepath
+ * @param[out] outData the file data, or null when the file is in the pack but couldn't be read
+ * @param[out] outSize the amount of bytes that were read, excluding the sizePadding
+ * @param[in] sizePadding optional padding to add at the end of the output data (the values are not set)
+ * @return false when the file isn't in the asset pack
+ */
+static bool readAsset(const std::string& filepath, std::unique_ptr<uint8_t[]>& outData, size_t& outSize, size_t sizePadding = 0) {
+    std::shared_ptr<AssetPack> pack;
+    AssetPack::Entry entry;
+    if (!findAsset(filepath, pack, entry) || entry.type != AssetPack::EntryType::File) {
+        return false;
+    }
+
+    outSize = 0;
+    outData = std::make_unique<uint8_t[]>(entry.originalSize + sizePadding);
+    if (entry.compressed) {
+        if (!AssetPack::decompress(entry.data, entry.size, outData.get(), entry.originalSize)) {
+            TT_LOG_E(TAG, "Failed to decompress %s", filepath.c_str());
+            outData = nullptr;
+            return true;
+        }
+    } else {
+        memcpy(outData.get(), entry.data, entry.size);
+    }
+
+    outSize = entry.originalSize;
+    return true;
+}
+
 /** Read a file.
  * @param[in] filepath
  * @param[out] outSize the amount of bytes that were read, excluding the sizePadding
  * @param[in] sizePadding optional padding to add at the end of the output data (the values are not set)
  */
 static std::unique_ptr<uint8_t[]> readBinaryInternal(const std::string& filepath, size_t& outSize, size_t sizePadding = 0) {
+    std::unique_ptr<uint8_t[]> asset_data;
+    if (readAsset(filepath, asset_data, outSize, sizePadding)) {
+        return asset_data;
+    }
+
     FILE* file = fopen(filepath.c_str(), "rb");
 
     if (file == nullptr) {
@@ -308,7 +344,7 @@ bool deleteRecursively(const std::string& path) {
 
     if (isDirectory(path)) {
         std::vector<dirent> entries;
-        if (scandir(path, entries) < 0) {
+        if (scandir(path, entries, direntFilterDotEntries) < 0) {
             TT_LOG_E(TAG, "Failed to scan directory %s", path.c_str());
             return false;
         }
@@ -346,6 +382,12 @@ bool deleteDirectory(const std::string& path) {
 }
 
 bool isFile(const std::string& path) {
+    std::shared_ptr<AssetPack> pack;
+    AssetPack::Entry entry;
+    if (findAsset(path, pack, entry)) {
+        return true;
+    }
+
     auto lock = getLock(path)->asScopedLock();
     lock.lock();
     return access(path.c_str(), F_OK) == 0;
@@ -358,7 +400,56 @@ bool isDirectory(const std::string& path) {
     return stat(path.c_str(), &stat_result) == 0 && S_ISDIR(stat_result.st_mode);
 }
 
+static void publishLine(char* line, bool stripNewLine, const std::function<void(const char* line)>& callback) {
+    // Strip newline
+    if (stripNewLine) {
+        size_t line_length = strlen(line);
+        if (line_length > 0 && line[line_length - 1] == '\n') {
+            line[line_length - 1] = '\0';
+        }
+    }
+    // Publish
+    callback(line);
+}
+
+/** Splits the data like fgets() does */
+static void readLinesFromData(const uint8_t* data, size_t size, bool stripNewLine, const std::function<void(const char* line)>& callback) {
+    char line[1024];
+    size_t line_length = 0;
+    for (size_t i = 0; i < size; i++) {
+        line[line_length++] = static_cast<char>(data[i]);
+        if (data[i] == '\n' || line_length == sizeof(line) - 1) {
+            line[line_length] = '\0';
+            publishLine(line, stripNewLine, callback);
+            line_length = 0;
+        }
+    }
+
+    if (line_length > 0) {
+        line[line_length] = '\0';
+        publishLine(line, stripNewLine, callback);
+    }
+}
+
 bool readLines(const std::string& filePath, bool stripNewLine, std::function<void(const char* line)> callback) {
+    std::shared_ptr<AssetPack> pack;
+    AssetPack::Entry entry;
+    if (findAsset(filePath, pack, entry) && entry.type == AssetPack::EntryType::File) {
+        if (!entry.compressed) {
+            // The pack keeps the data available
+            readLinesFromData(entry.data, entry.size, stripNewLine, callback);
+            return true;
+        }
+
+        std::unique_ptr<uint8_t[]> asset_data;
+        size_t asset_size;
+        if (!readAsset(filePath, asset_data, asset_size) || asset_data == nullptr) {
+            return false;
+        }
+        readLinesFromData(asset_data.get(), asset_size, stripNewLine, callback);
+        return true;
+    }
+
     auto lock = getLock(filePath)->asScopedLock();
     lock.lock();
 
@@ -370,15 +461,7 @@ bool readLines(const std::string& filePath, bool stripNewLine, std::function<voi
     char line[1024];
 
     while (fgets(line, sizeof(line), file) != nullptr) {
-        // Strip newline
-        if (stripNewLine) {
-            size_t line_length = strlen(line);
-            if (line_length > 0 && line[line_length - 1] == '\n') {
-                line[line_length - 1] = '\0';
-            }
-        }
-        // Publish
-        callback(line);
+        publishLine(line, stripNewLine, callback);
     }
 
     bool success = feof(file);
@@ -0,0 +1,325 @@
+#include "doctest.h"
+#include <Tactility/service/espnow/Transport.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+using namespace tt::service::espnow;
+
+constexpr PeerAddress ADDRESS_A = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+constexpr PeerAddress ADDRESS_B = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+/** An address that the simulated link can't send to */
+constexpr PeerAddress UNKNOWN_ADDRESS = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x03 };
+constexpr PeerAddress BROADCAST_ADDRESS = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+/** Two transports on a simulated radio with latency and random frame loss, driven by a simulated clock */
+class SimulatedNetwork {
+
+    struct Frame {
+        uint64_t deliveryTime;
+        size_t receiver;
+        std::vector<uint8_t> data;
+    };
+
+    class Endpoint final : public TransportLink {
+
+        SimulatedNetwork& network;
+        size_t index;
+
+    public:
+
+        Endpoint(SimulatedNetwork& network, size_t index) : network(network), index(index) {}
+
+        SendResult sendFrame(const PeerAddress& address, const uint8_t* data, size_t dataSize) override {
+            if (address == UNKNOWN_ADDRESS || network.unknownPeers[index]) {
+                return SendResult::Failed;
+            }
+            if (network.busyFrames > 0) {
+                network.busyFrames--;
+                return SendResult::Busy;
+            }
+            network.transmit(index, data, dataSize);
+            return SendResult::Sent;
+        }
+    };
+
+    std::mt19937 random = std::mt19937(1234);
+    std::vector<Frame> frames;
+    std::unique_ptr<Endpoint> endpoints[2];
+
+    void transmit(size_t sender, const uint8_t* data, size_t dataSize) {
+        framesSent++;
+        if (std::uniform_int_distribution<uint32_t>(0, 99)(random) < lossPercent) {
+            return;
+        }
+        frames.push_back({ .deliveryTime = time + latencyMicros, .receiver = 1 - sender, .data = std::vector<uint8_t>(data, data + dataSize) });
+    }
+
+public:
+
+    uint64_t time = 0;
+    uint32_t latencyMicros = 1000;
+    uint32_t lossPercent = 0;
+    uint32_t framesSent = 0;
+    /** The amount of frames that the links don't accept before they accept frames again */
+    uint32_t busyFrames = 0;
+    /** When set, the endpoint can't send to the other endpoint */
+    bool unknownPeers[2] = { false, false };
+    std::unique_ptr<Transport> transports[2];
+    std::vector<std::vector<uint8_t>> received[2];
+    std::vector<bool> completions;
+
+    explicit SimulatedNetwork(const Transport::Configuration& configuration = {}) {
+        for (size_t i = 0; i < 2; i++) {
+            endpoints[i] = std::make_unique<Endpoint>(*this, i);
+            transports[i] = std::make_unique<Transport>(*endpoints[i], configuration);
+        }
+    }
+
+    bool send(size_t sender, const std::vector<uint8_t>& data, const PeerAddress& address = ADDRESS_B) {
+        return transports[sender]->send(address, data.data(), data.size(), [this](bool success) {
+            completions.push_back(success);
+        });
+    }
+
+    /** Run until there's nothing left to do */
+    void run() {
+        const PeerAddress addresses[2] = { ADDRESS_A, ADDRESS_B };
+        while (true) {
+            uint64_t next_time = UINT64_MAX;
+            for (size_t i = 0; i < 2; i++) {
+                next_time = std::min(next_time, transports[i]->poll(time));
+
+                std::vector<Transport::ReceivedMessage> messages;
+                std::vector<Transport::Completion> finished;
+                transports[i]->takeEvents(messages, finished);
+                for (auto& message : messages) {
+                    CHECK_EQ(message.address, addresses[1 - i]);
+                    received[i].push_back(std::move(message.data));
+                }
+                for (auto& completion : finished) {
+                    completion.callback(completion.success);
+                }
+            }
+
+            for (const auto& frame : frames) {
+                next_time = std::min(next_time, frame.deliveryTime);
+            }
+            if (next_time == UINT64_MAX) {
+                break;
+            }
+
+            time = std::max(next_time, time + 1);
+            auto due_end = std::stable_partition(frames.begin(), frames.end(), [this](const Frame& frame) { return frame.deliveryTime <= time; });
+            std::vector<Frame> due(std::make_move_iterator(frames.begin()), std::make_move_iterator(due_end));
+            frames.erase(frames.begin(), due_end);
+            for (const auto& frame : due) {
+                transports[frame.receiver]->onFrame(addresses[1 - frame.receiver], frame.data.data(), frame.data.size(), time);
+            }
+        }
+    }
+};
+
+static std::vector<uint8_t> createMessage(size_t size) {
+    std::vector<uint8_t> message(size);
+    for (size_t i = 0; i < size; i++) {
+        message[i] = static_cast<uint8_t>(i * 7 + size);
+    }
+    return message;
+}
+
+TEST_CASE("Transport delivers a small message") {
+    SimulatedNetwork network;
+    auto message = createMessage(10);
+    CHECK(network.send(0, message));
+    network.run();
+
+    REQUIRE_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.received[1][0], message);
+    CHECK_EQ(network.completions, std::vector<bool> { true });
+    CHECK_EQ(network.transports[0]->getStatistics().dataFramesSent, 1);
+    CHECK_EQ(network.transports[1]->getStatistics().acksSent, 1);
+}
+
+TEST_CASE("Transport fragments and reassembles a large message") {
+    SimulatedNetwork network;
+    auto message = createMessage(5000);
+    CHECK(network.send(0, message));
+    network.run();
+
+    REQUIRE_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.received[1][0], message);
+    CHECK_EQ(network.completions, std::vector<bool> { true });
+    CHECK_EQ(network.transports[0]->getStatistics().dataFramesSent, 21);
+    // The receiver acknowledges the complete message once
+    CHECK_EQ(network.transports[1]->getStatistics().acksSent, 1);
+}
+
+TEST_CASE("Transport retransmits lost fragments") {
+    SimulatedNetwork network;
+    network.lossPercent = 20;
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t size : { 1, 300, 2000, 5000, 7000 }) {
+        messages.push_back(createMessage(size));
+        CHECK(network.send(0, messages.back()));
+    }
+    network.run();
+
+    // Each message is delivered once, in the order of completion
+    auto& received = network.received[1];
+    std::sort(received.begin(), received.end(), [](const auto& left, const auto& right) { return left.size() < right.size(); });
+    CHECK_EQ(received, messages);
+    CHECK_EQ(network.completions, std::vector<bool>(messages.size(), true));
+    CHECK_GT(network.transports[0]->getStatistics().retransmittedFrames, 0);
+}
+
+TEST_CASE("Transport fails when the peer doesn't acknowledge") {
+    Transport::Configuration configuration;
+    configuration.maxRetransmits = 3;
+    SimulatedNetwork network(configuration);
+    network.lossPercent = 100;
+    CHECK(network.send(0, createMessage(600)));
+    network.run();
+
+    CHECK_EQ(network.completions, std::vector<bool> { false });
+    // 3 fragments, sent once and retransmitted 3 times
+    CHECK_EQ(network.transports[0]->getStatistics().dataFramesSent, 12);
+    CHECK_EQ(network.transports[0]->getStatistics().messagesFailed, 1);
+}
+
+TEST_CASE("Transport bounds the send queue and the message size") {
+    Transport::Configuration configuration;
+    configuration.maxPendingMessages = 2;
+    SimulatedNetwork network(configuration);
+    CHECK(network.send(0, createMessage(10)));
+    CHECK(network.send(0, createMessage(10)));
+    CHECK_FALSE(network.send(0, createMessage(10)));
+    CHECK_FALSE(network.send(0, createMessage(network.transports[0]->getMaxMessageSize() + 1)));
+    network.run();
+    CHECK_EQ(network.received[1].size(), 2);
+    CHECK(network.send(0, createMessage(network.transports[0]->getMaxMessageSize())));
+}
+
+TEST_CASE("Transport paces data frames") {
+    Transport::Configuration configuration;
+    configuration.frameIntervalMicros = 2000;
+    configuration.maxBurstFrames = 4;
+    SimulatedNetwork network(configuration);
+    network.time = 1000000;
+    const auto start_time = network.time;
+    CHECK(network.send(0, createMessage(244 * 10)));
+    network.run();
+
+    REQUIRE_EQ(network.received[1].size(), 1);
+    // The first 4 frames are a burst and the other 6 follow the interval, plus the latency of the last frame and the acknowledgement
+    CHECK_EQ(network.time - start_time, 6 * 2000 + 2 * network.latencyMicros);
+}
+
+TEST_CASE("Transport sends broadcasts once") {
+    SimulatedNetwork network;
+    auto message = createMessage(600);
+    CHECK(network.send(0, message, BROADCAST_ADDRESS));
+    network.run();
+
+    REQUIRE_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.received[1][0], message);
+    CHECK_EQ(network.completions, std::vector<bool> { true });
+    CHECK_EQ(network.transports[0]->getStatistics().dataFramesSent, 3);
+    CHECK_EQ(network.transports[1]->getStatistics().acksSent, 0);
+}
+
+TEST_CASE("Transport keeps broadcasts and messages with the same id apart") {
+    SimulatedNetwork network;
+    // Both messages get id 0, because broadcasts and messages to a peer are numbered separately
+    auto broadcast = createMessage(600);
+    auto message = createMessage(10);
+    auto next_broadcast = createMessage(20);
+    CHECK(network.send(0, broadcast, BROADCAST_ADDRESS));
+    CHECK(network.send(0, message));
+    CHECK(network.send(0, next_broadcast, BROADCAST_ADDRESS));
+    network.run();
+
+    REQUIRE_EQ(network.received[1].size(), 3);
+    CHECK_EQ(network.received[1][0], broadcast);
+    CHECK_EQ(network.received[1][1], message);
+    CHECK_EQ(network.received[1][2], next_broadcast);
+    CHECK_EQ(network.completions, std::vector<bool> { true, true, true });
+    CHECK_EQ(network.transports[1]->getStatistics().duplicateFrames, 0);
+    CHECK_EQ(network.transports[1]->getStatistics().invalidFrames, 0);
+}
+
+TEST_CASE("Transport fails a message that the link can't send without holding back the next one") {
+    SimulatedNetwork network;
+    CHECK(network.send(0, createMessage(10), UNKNOWN_ADDRESS));
+    CHECK(network.send(0, createMessage(20)));
+    network.run();
+
+    CHECK_EQ(network.completions, std::vector<bool> { false, true });
+    REQUIRE_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.received[1][0], createMessage(20));
+    CHECK_EQ(network.transports[0]->getStatistics().messagesFailed, 1);
+}
+
+TEST_CASE("Transport sends again when the link is busy") {
+    SimulatedNetwork network;
+    network.busyFrames = 3;
+    CHECK(network.send(0, createMessage(600)));
+    network.run();
+
+    CHECK_EQ(network.completions, std::vector<bool> { true });
+    REQUIRE_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.received[1][0], createMessage(600));
+    CHECK_EQ(network.transports[0]->getStatistics().retransmittedFrames, 0);
+}
+
+TEST_CASE("Transport stops acknowledging a sender that it can't send to") {
+    Transport::Configuration configuration;
+    configuration.maxRetransmits = 2;
+    SimulatedNetwork network(configuration);
+    network.unknownPeers[1] = true;
+    CHECK(network.send(0, createMessage(10)));
+    network.run();
+
+    // The message arrives, but the sender doesn't hear about it
+    CHECK_EQ(network.received[1].size(), 1);
+    CHECK_EQ(network.completions, std::vector<bool> { false });
+    CHECK_EQ(network.transports[1]->getStatistics().acksSent, 0);
+}
+
+TEST_CASE("Transport ignores invalid frames") {
+    SimulatedNetwork network;
+    const uint8_t text[] = { 'h', 'i' };
+    const uint8_t truncated[] = { Transport::FRAME_MAGIC, 1, 0 };
+    const uint8_t wrong_count[] = { Transport::FRAME_MAGIC, 1, 0, 0, 3, 2, 0 };
+    CHECK_FALSE(Transport::isTransportFrame(text, sizeof(text)));
+    network.transports[1]->onFrame(ADDRESS_A, text, sizeof(text), 0);
+    network.transports[1]->onFrame(ADDRESS_A, truncated, sizeof(truncated), 0);
+    network.transports[1]->onFrame(ADDRESS_A, wrong_count, sizeof(wrong_count), 0);
+    network.run();
+    CHECK_EQ(network.transports[1]->getStatistics().invalidFrames, 3);
+    CHECK(network.received[1].empty());
+}
+
+/** Telemetry of 1 kB messages in both directions on a link that loses frames */
+TEST_CASE("Transport loss benchmark") {
+    for (uint32_t loss : { 0, 10, 30 }) {
+        SimulatedNetwork network;
+        network.lossPercent = loss;
+        constexpr int MESSAGE_COUNT = 50;
+        int sent = 0;
+        while (sent < MESSAGE_COUNT) {
+            // Send as much as the queues allow, then let the network catch up
+            while (sent < MESSAGE_COUNT && network.send(sent % 2, createMessage(1000), (sent % 2 == 0) ? ADDRESS_B : ADDRESS_A)) {
+                sent++;
+            }
+            network.run();
+        }
+
+        const auto delivered = network.received[0].size() + network.received[1].size();
+        const auto failed = std::count(network.completions.begin(), network.completions.end(), false);
+        MESSAGE("Loss ", loss, "%: delivered ", delivered, "/", MESSAGE_COUNT, ", ", network.framesSent, " frames, ", network.time / 1000, " ms");
+        CHECK_EQ(delivered, MESSAGE_COUNT);
+        CHECK_EQ(failed, 0);
+    }
+}
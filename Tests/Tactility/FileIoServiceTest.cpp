@@ -0,0 +1,188 @@
+#include "../TactilityCore/TestFile.h"
+#include "doctest.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/service/ServiceContext.h>
+#include <Tactility/service/ServiceManifest.h>
+#include <Tactility/service/ServicePaths.h>
+#include <Tactility/service/fileio/FileIoService.h>
+
+#include <cstring>
+
+using namespace tt;
+using tt::service::fileio::FileIoService;
+
+class TestServiceContext final : public service::ServiceContext {
+
+    service::ServiceManifest manifest = { .id = "FileIoTest" };
+
+public:
+
+    const service::ServiceManifest& getManifest() const override { return manifest; }
+
+    std::unique_ptr<service::ServicePaths> getPaths() const override { return nullptr; }
+};
+
+static FileIoService::Data createData(const char* text) {
+    return std::make_shared<std::vector<uint8_t>>(text, text + strlen(text));
+}
+
+static std::string toString(const FileIoService::Data& data) {
+    return (data != nullptr) ? std::string(data->begin(), data->end()) : std::string();
+}
+
+/**
+ * Requests that are made before the service is started are all processed in a single batch.
+ * Stopping the service waits for the processing to finish.
+ */
+TEST_CASE("FileIoService coalesces a write and appends to the same file") {
+    TestFile file("fileio.tmp");
+    TestServiceContext context;
+    FileIoService service;
+    service.setBusyBackoffTime(0);
+
+    int successes = 0;
+    auto on_written = [&successes](bool success) { successes += success ? 1 : 0; };
+    service.writeFile(file.getPath(), createData("abc"), on_written);
+    service.appendFile(file.getPath(), createData("def"), on_written);
+    service.appendFile(file.getPath(), createData("ghi"), on_written);
+    CHECK_EQ(service.getPendingRequestCount(), 3);
+
+    CHECK_EQ(service.onStart(context), true);
+    service.onStop(context);
+
+    CHECK_EQ(successes, 3);
+    auto content = file::readString(file.getPath());
+    REQUIRE_NE(content, nullptr);
+    CHECK_EQ(std::string(reinterpret_cast<const char*>(content.get())), "abcdefghi");
+
+    auto statistics = service.getStatistics();
+    CHECK_EQ(statistics.requests, 3);
+    CHECK_EQ(statistics.coalescedRequests, 2);
+}
+
+TEST_CASE("FileIoService coalesces reads of the same file") {
+    TestFile file("fileio.tmp");
+    file.writeData("content");
+    TestServiceContext context;
+    FileIoService service;
+    service.setBusyBackoffTime(0);
+
+    FileIoService::Data first_data;
+    FileIoService::Data second_data;
+    service.readFile(file.getPath(), [&first_data](bool success, auto data) { first_data = data; });
+    service.readFile(file.getPath(), [&second_data](bool success, auto data) { second_data = data; });
+
+    CHECK_EQ(service.onStart(context), true);
+    service.onStop(context);
+
+    CHECK_EQ(toString(first_data), "content");
+    // Coalesced reads share their data
+    CHECK_EQ(first_data, second_data);
+    CHECK_EQ(service.getStatistics().coalescedRequests, 1);
+}
+
+TEST_CASE("FileIoService transfers large files in chunks") {
+    TestFile file("fileio.tmp");
+    TestServiceContext context;
+    FileIoService service;
+    service.setBusyBackoffTime(0);
+
+    auto data = std::make_shared<std::vector<uint8_t>>(FileIoService::CHUNK_SIZE * 2 + 100);
+    for (size_t i = 0; i < data->size(); ++i) {
+        (*data)[i] = static_cast<uint8_t>(i);
+    }
+
+    bool write_success = false;
+    FileIoService::Data read_data;
+    service.writeFile(file.getPath(), data, [&write_success](bool success) { write_success = success; });
+    service.readFile(file.getPath(), [&read_data](bool success, auto data) { read_data = data; });
+
+    CHECK_EQ(service.onStart(context), true);
+    service.onStop(context);
+
+    CHECK_EQ(write_success, true);
+    REQUIRE_NE(read_data, nullptr);
+    CHECK_EQ(*read_data, *data);
+    // Opening, 3 chunks for writing, 3 chunks for reading
+    CHECK_EQ(service.getStatistics().chunks, 8);
+}
+
+/** A file lock that is always wanted by someone else, like an SD card bus that is shared with a display */
+class YieldingLock final : public Lock {
+
+    Mutex mutex;
+
+public:
+
+    bool lock(TickType_t timeout) const override { return mutex.lock(timeout); }
+
+    bool unlock() const override { return mutex.unlock(); }
+
+    bool shouldYield() const override { return true; }
+};
+
+TEST_CASE("FileIoService backs off when the file lock asks to be yielded") {
+    TestFile file("fileio.tmp");
+    TestServiceContext context;
+    FileIoService service;
+    service.setBusyBackoffTime(0);
+    file::setFindLockFunction([](const std::string&) { return std::make_shared<YieldingLock>(); });
+
+    bool write_success = false;
+    auto data = std::make_shared<std::vector<uint8_t>>(FileIoService::CHUNK_SIZE + 100);
+    service.writeFile(file.getPath(), data, [&write_success](bool success) { write_success = success; });
+
+    CHECK_EQ(service.onStart(context), true);
+    service.onStop(context);
+    file::setFindLockFunction(nullptr);
+
+    CHECK_EQ(write_success, true);
+    // Opening and 2 chunks for writing
+    CHECK_EQ(service.getStatistics().chunks, 3);
+    CHECK_EQ(service.getStatistics().yields, 3);
+}
+
+TEST_CASE("FileIoService reports failures") {
+    TestServiceContext context;
+    FileIoService service;
+
+    bool read_success = true;
+    bool stat_success = true;
+    bool list_success = true;
+    service.readFile("does_not_exist.tmp", [&read_success](bool success, auto data) { read_success = success; });
+    service.stat("does_not_exist.tmp", [&stat_success](bool success, auto& info) { stat_success = success; });
+    service.listDirectory("does_not_exist", [&list_success](bool success, auto& entries) { list_success = success; });
+
+    CHECK_EQ(service.onStart(context), true);
+    service.onStop(context);
+
+    CHECK_EQ(read_success, false);
+    CHECK_EQ(stat_success, false);
+    CHECK_EQ(list_success, false);
+}
+
+TEST_CASE("FileIoService can stat files and execute jobs") {
+    TestFile file("fileio.tmp");
+    file.writeData("12345");
+    TestServiceContext context;
+    FileIoService service;
+
+    CHECK_EQ(service.onStart(context), true);
+
+    off_t size = 0;
+    bool job_executed = false;
+    bool job_success = false;
+    service.stat(file.getPath(), [&size](bool success, auto& info) { size = info.st_size; });
+    service.execute([&job_executed] {
+        job_executed = true;
+        return true;
+    }, [&job_success](bool success) { job_success = success; });
+
+    service.onStop(context);
+
+    CHECK_EQ(size, 5);
+    CHECK_EQ(job_executed, true);
+    CHECK_EQ(job_success, true);
+    CHECK_EQ(service.getPendingRequestCount(), 0);
+}
@@ -0,0 +1,120 @@
+#include "doctest.h"
+#include <Tactility/hal/gpio/ButtonStateMachine.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace tt::hal::gpio;
+
+struct SyntheticEdge {
+    uint64_t time;
+    bool level;
+};
+
+/** Presses at random moments, with random hold times and 2 to 6 bounces per edge */
+static std::vector<SyntheticEdge> createEdges(uint32_t pressCount, uint64_t duration) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<uint64_t> press_distribution(0, duration - 2000000);
+    std::uniform_int_distribution<uint64_t> hold_distribution(50000, 900000);
+    std::uniform_int_distribution<int> bounce_distribution(2, 6);
+
+    std::vector<uint64_t> press_times;
+    for (uint32_t i = 0; i < pressCount; i++) {
+        press_times.push_back(press_distribution(random));
+    }
+    std::sort(press_times.begin(), press_times.end());
+
+    std::vector<SyntheticEdge> edges;
+    uint64_t previous_release = 0;
+    for (auto press_time : press_times) {
+        press_time = std::max(press_time, previous_release + 100000);
+        const auto release_time = press_time + hold_distribution(random);
+        for (auto [time, level] : { std::pair { press_time, true }, std::pair { release_time, false } }) {
+            const int bounces = bounce_distribution(random);
+            for (int bounce = 0; bounce < bounces; bounce++) {
+                edges.push_back({ time + bounce * 400, level });
+                edges.push_back({ time + bounce * 400 + 150, !level });
+            }
+            edges.push_back({ time + bounces * 400, level });
+        }
+        previous_release = release_time;
+    }
+    return edges;
+}
+
+/**
+ * Process the edges like the GpioInput thread does: wake up for every edge and for the deadlines in between.
+ * @return the amount of wakeups
+ */
+static uint32_t replay(const std::vector<SyntheticEdge>& edges, const ButtonStateMachine::EventCallback& callback) {
+    ButtonStateMachine stateMachine;
+    uint32_t wakeups = 0;
+    for (const auto& edge : edges) {
+        while (stateMachine.getNextDeadline() <= edge.time) {
+            wakeups++;
+            stateMachine.update(stateMachine.getNextDeadline(), callback);
+        }
+        wakeups++;
+        stateMachine.onEdge(edge.level, edge.time);
+        stateMachine.update(edge.time, callback);
+    }
+    while (stateMachine.getNextDeadline() != ButtonStateMachine::NO_DEADLINE) {
+        wakeups++;
+        stateMachine.update(stateMachine.getNextDeadline(), callback);
+    }
+    return wakeups;
+}
+
+/** A minute with 30 button presses: polling every 5 ms versus waking up for edges and deadlines */
+TEST_CASE("GpioInput wakeup benchmark") {
+    constexpr uint64_t DURATION = 60000000;
+    constexpr uint32_t POLL_INTERVAL = 5000;
+    const auto edges = createEdges(30, DURATION);
+
+    // Polling: sample the level at a fixed interval, like ButtonControl used to do
+    ButtonStateMachine polled({ .debounceMicros = 0 });
+    uint32_t polled_events = 0;
+    uint32_t poll_wakeups = 0;
+    size_t edge_index = 0;
+    bool level = false;
+    for (uint64_t time = 0; time < DURATION; time += POLL_INTERVAL) {
+        poll_wakeups++;
+        while (edge_index < edges.size() && edges[edge_index].time <= time) {
+            level = edges[edge_index].level;
+            edge_index++;
+        }
+        polled.onEdge(level, time);
+        polled.update(time, [&polled_events](ButtonEvent event) {
+            if (event == ButtonEvent::ShortPress || event == ButtonEvent::LongPress) {
+                polled_events++;
+            }
+        });
+    }
+
+    // Interrupts: wake up for every edge and for the deadlines of the state machine
+    uint32_t interrupt_events = 0;
+    const auto interrupt_wakeups = replay(edges, [&interrupt_events](ButtonEvent event) {
+        if (event == ButtonEvent::ShortPress || event == ButtonEvent::LongPress) {
+            interrupt_events++;
+        }
+    });
+
+    MESSAGE("Polling: ", poll_wakeups, " wakeups, ", polled_events, " presses");
+    MESSAGE("Interrupts: ", interrupt_wakeups, " wakeups for ", edges.size(), " edges, ", interrupt_events, " presses");
+    CHECK_EQ(interrupt_events, 30);
+    CHECK_LT(interrupt_wakeups * 10, poll_wakeups);
+}
+
+TEST_CASE("ButtonStateMachine throughput benchmark") {
+    const auto edges = createEdges(2000, 3600000000ULL);
+    uint32_t events = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    replay(edges, [&events](ButtonEvent) { events++; });
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    MESSAGE(edges.size(), " edges in ", nanos / 1000, " us (", nanos / edges.size(), " ns per edge)");
+    CHECK_EQ(events, 2000 * 3);
+}
@@ -0,0 +1,183 @@
+#include "doctest.h"
+#include <Tactility/hal/gpio/ButtonStateMachine.h>
+#include <Tactility/hal/gpio/GpioEdgeQueue.h>
+
+#include <thread>
+#include <vector>
+
+using namespace tt::hal::gpio;
+
+/** Feeds edges to a state machine and calls update() at the deadlines, like the GpioInput thread does */
+class ButtonSimulation {
+
+    ButtonStateMachine stateMachine;
+    uint64_t time = 0;
+
+    void update() {
+        stateMachine.update(time, [this](ButtonEvent event) {
+            events.push_back(event);
+            eventTimes.push_back(time);
+        });
+    }
+
+public:
+
+    std::vector<ButtonEvent> events;
+    std::vector<uint64_t> eventTimes;
+    uint32_t wakeups = 0;
+
+    explicit ButtonSimulation(const ButtonConfiguration& configuration = {}) : stateMachine(configuration) {}
+
+    /** Advance to the specified time, waking up at every deadline on the way */
+    void runUntil(uint64_t endTime) {
+        while (stateMachine.getNextDeadline() <= endTime) {
+            time = stateMachine.getNextDeadline();
+            wakeups++;
+            update();
+        }
+        time = endTime;
+    }
+
+    void edge(uint64_t edgeTime, bool level) {
+        runUntil(edgeTime);
+        stateMachine.onEdge(level, edgeTime);
+        wakeups++;
+        update();
+    }
+
+    /** A press with contact bounce on both edges */
+    void bouncyPress(uint64_t pressTime, uint64_t releaseTime) {
+        for (uint64_t offset : { 0, 300, 700 }) {
+            edge(pressTime + offset, true);
+            edge(pressTime + offset + 100, false);
+        }
+        edge(pressTime + 1000, true);
+        for (uint64_t offset : { 0, 500 }) {
+            edge(releaseTime + offset, false);
+            edge(releaseTime + offset + 200, true);
+        }
+        edge(releaseTime + 1000, false);
+    }
+
+    bool isPressed() const { return stateMachine.isPressed(); }
+};
+
+TEST_CASE("ButtonStateMachine reports a short press") {
+    ButtonSimulation simulation;
+    simulation.edge(1000, true);
+    simulation.edge(101000, false);
+    simulation.runUntil(1000000);
+
+    CHECK_EQ(simulation.events, std::vector { ButtonEvent::Pressed, ButtonEvent::Released, ButtonEvent::ShortPress });
+    // Events happen when the level has been stable for the debounce time
+    CHECK_EQ(simulation.eventTimes[0], 21000);
+    CHECK_EQ(simulation.eventTimes[1], 121000);
+}
+
+TEST_CASE("ButtonStateMachine ignores contact bounce") {
+    ButtonSimulation simulation;
+    simulation.bouncyPress(10000, 200000);
+    simulation.runUntil(1000000);
+    CHECK_EQ(simulation.events, std::vector { ButtonEvent::Pressed, ButtonEvent::Released, ButtonEvent::ShortPress });
+}
+
+TEST_CASE("ButtonStateMachine ignores glitches that are shorter than the debounce time") {
+    ButtonSimulation simulation;
+    simulation.edge(10000, true);
+    simulation.edge(15000, false);
+    simulation.runUntil(1000000);
+    CHECK(simulation.events.empty());
+    CHECK_FALSE(simulation.isPressed());
+}
+
+TEST_CASE("ButtonStateMachine reports a long press while the button is held") {
+    ButtonSimulation simulation;
+    simulation.edge(0, true);
+    simulation.runUntil(700000);
+    CHECK_EQ(simulation.events, std::vector { ButtonEvent::Pressed, ButtonEvent::LongPress });
+    // The hold time starts at the first edge, not when the bounces settled
+    CHECK_EQ(simulation.eventTimes[1], 500000);
+
+    simulation.edge(800000, false);
+    simulation.runUntil(1000000);
+    // No short press after a long press
+    CHECK_EQ(simulation.events, std::vector { ButtonEvent::Pressed, ButtonEvent::LongPress, ButtonEvent::Released });
+}
+
+TEST_CASE("ButtonStateMachine repeats while the button is held") {
+    ButtonSimulation simulation({ .longPressMicros = 0, .repeatDelayMicros = 400000, .repeatIntervalMicros = 100000 });
+    simulation.edge(0, true);
+    simulation.runUntil(750000);
+    simulation.edge(750000, false);
+    simulation.runUntil(1000000);
+
+    CHECK_EQ(simulation.events, std::vector {
+        ButtonEvent::Pressed,
+        ButtonEvent::Repeat,
+        ButtonEvent::Repeat,
+        ButtonEvent::Repeat,
+        ButtonEvent::Repeat,
+        ButtonEvent::Released
+    });
+    CHECK_EQ(simulation.eventTimes[1], 400000);
+    CHECK_EQ(simulation.eventTimes[4], 700000);
+}
+
+TEST_CASE("ButtonStateMachine supports active low buttons") {
+    ButtonSimulation simulation({ .activeLevel = false });
+    simulation.edge(0, false);
+    simulation.edge(100000, true);
+    simulation.runUntil(1000000);
+    CHECK_EQ(simulation.events, std::vector { ButtonEvent::Pressed, ButtonEvent::Released, ButtonEvent::ShortPress });
+}
+
+TEST_CASE("ButtonStateMachine doesn't need updates while idle") {
+    ButtonSimulation simulation;
+    simulation.bouncyPress(10000, 200000);
+    simulation.runUntil(1000000);
+    const auto wakeups = simulation.wakeups;
+    simulation.runUntil(60000000);
+    CHECK_EQ(simulation.wakeups, wakeups);
+}
+
+TEST_CASE("GpioEdgeQueue keeps the order and drops edges when full") {
+    GpioEdgeQueue queue;
+    for (uint32_t i = 0; i < GpioEdgeQueue::CAPACITY - 1; i++) {
+        CHECK(queue.push({ .input = i, .level = (i % 2) == 0, .time = i }));
+    }
+    CHECK_FALSE(queue.push({ .input = 0, .level = true, .time = 0 }));
+    CHECK_EQ(queue.getDroppedCount(), 1);
+
+    GpioEdge edge;
+    for (uint32_t i = 0; i < GpioEdgeQueue::CAPACITY - 1; i++) {
+        REQUIRE(queue.pop(edge));
+        CHECK_EQ(edge.input, i);
+        CHECK_EQ(edge.time, i);
+    }
+    CHECK_FALSE(queue.pop(edge));
+}
+
+TEST_CASE("GpioEdgeQueue passes edges between threads") {
+    GpioEdgeQueue queue;
+    constexpr uint32_t EDGE_COUNT = 100000;
+    std::thread producer([&queue] {
+        for (uint32_t i = 0; i < EDGE_COUNT; i++) {
+            while (!queue.push({ .input = 0, .level = (i % 2) == 0, .time = i })) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    GpioEdge edge;
+    while (expected < EDGE_COUNT) {
+        if (queue.pop(edge)) {
+            CHECK_EQ(edge.time, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CHECK_EQ(expected, EDGE_COUNT);
+}
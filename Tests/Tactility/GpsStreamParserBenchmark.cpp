@@ -0,0 +1,82 @@
+#include "doctest.h"
+#include <Tactility/hal/gps/StreamParser.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+using namespace tt;
+using namespace tt::hal::gps;
+
+constexpr auto* REPLAY_FILE = "gps_replay.tmp";
+constexpr int REPLAY_EPOCH_COUNT = 2000;
+
+/** One second of output of a typical receiver at 1 Hz */
+static const char* const RECORDED_EPOCH[] = {
+    "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*49\r\n",
+    "$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*18\r\n",
+    "$GNGGA,092725.00,4717.11399,N,00833.91590,E,1,08,1.01,499.6,M,48.0,M,,*45\r\n",
+    "$GNGSA,A,3,23,29,07,08,09,18,26,,,,,,1.94,1.18,1.54*19\r\n",
+    "$GPGSV,3,1,10,23,38,230,44,29,71,156,47,07,29,116,41,08,09,081,36*7F\r\n",
+    "$GPGSV,3,2,10,10,07,189,,05,05,220,,09,34,274,42,18,25,309,44*72\r\n",
+    "$GPGSV,3,3,10,26,82,187,47,28,43,056,46*77\r\n",
+    "$GNZDA,082710.00,16,09,2002,00,00*7A\r\n"
+};
+
+class CountingListener final : public StreamParserListener {
+
+public:
+
+    uint32_t fixCount = 0;
+
+    void onGga(const minmea_sentence_gga& gga) override {
+        if (gga.fix_quality > 0) {
+            fixCount++;
+        }
+    }
+};
+
+static bool writeReplayFile() {
+    auto* file = fopen(REPLAY_FILE, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < REPLAY_EPOCH_COUNT; ++i) {
+        for (const auto* sentence : RECORDED_EPOCH) {
+            fputs(sentence, file);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+TEST_CASE("StreamParser replay benchmark") {
+    REQUIRE(writeReplayFile());
+
+    auto* file = fopen(REPLAY_FILE, "r");
+    REQUIRE_NE(file, nullptr);
+
+    CountingListener listener;
+    StreamParser parser(listener);
+    // Read in chunks that are similar to what the GPS thread receives from the UART
+    uint8_t buffer[128];
+    size_t bytes_read;
+    auto start_time = kernel::getMicros();
+    while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        parser.feed(buffer, bytes_read);
+    }
+    auto duration = kernel::getMicros() - start_time;
+    fclose(file);
+    remove(REPLAY_FILE);
+
+    auto statistics = parser.getStatistics();
+    CHECK_EQ(statistics.nmeaSentences, REPLAY_EPOCH_COUNT * std::size(RECORDED_EPOCH));
+    CHECK_EQ(statistics.checksumErrors, 0);
+    CHECK_EQ(listener.fixCount, REPLAY_EPOCH_COUNT);
+
+    auto safe_duration = std::max<uint64_t>(duration, 1);
+    MESSAGE("Replayed ", statistics.nmeaSentences, " sentences in ", duration, " us: ",
+        (statistics.nmeaSentences * 1000000ULL) / safe_duration, " sentences/s, ",
+        duration / listener.fixCount, " us per fix");
+}
@@ -0,0 +1,209 @@
+#include "doctest.h"
+#include <Tactility/hal/gps/StreamParser.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace tt::hal::gps;
+
+/** Adds the '$', the checksum and the line ending to the sentence body */
+static std::string createSentence(const std::string& body) {
+    uint8_t checksum = 0;
+    for (char character : body) {
+        checksum ^= static_cast<uint8_t>(character);
+    }
+    char suffix[6];
+    snprintf(suffix, sizeof(suffix), "*%02X\r\n", checksum);
+    return "$" + body + suffix;
+}
+
+static std::vector<uint8_t> createUbxFrame(uint8_t classId, uint8_t messageId, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> frame = {
+        0xB5,
+        0x62,
+        classId,
+        messageId,
+        static_cast<uint8_t>(payload.size() & 0xFF),
+        static_cast<uint8_t>(payload.size() >> 8)
+    };
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    uint8_t checksum_a = 0;
+    uint8_t checksum_b = 0;
+    for (size_t i = 2; i < frame.size(); ++i) {
+        checksum_a += frame[i];
+        checksum_b += checksum_a;
+    }
+    frame.push_back(checksum_a);
+    frame.push_back(checksum_b);
+    return frame;
+}
+
+class RecordingListener final : public StreamParserListener {
+
+public:
+
+    std::vector<std::string> sentences;
+    std::vector<std::vector<uint8_t>> ubxPayloads;
+    int rmcCount = 0;
+    int ggaCount = 0;
+    int gsaCount = 0;
+    int gsvCount = 0;
+    int vtgCount = 0;
+    int zdaCount = 0;
+    minmea_sentence_gga lastGga = {};
+
+    void onRmc(const minmea_sentence_rmc& rmc) override { rmcCount++; }
+    void onGga(const minmea_sentence_gga& gga) override { ggaCount++; lastGga = gga; }
+    void onGsa(const minmea_sentence_gsa& gsa) override { gsaCount++; }
+    void onGsv(const minmea_sentence_gsv& gsv) override { gsvCount++; }
+    void onVtg(const minmea_sentence_vtg& vtg) override { vtgCount++; }
+    void onZda(const minmea_sentence_zda& zda) override { zdaCount++; }
+
+    void onNmeaSentence(std::string_view sentence) override {
+        sentences.emplace_back(sentence);
+    }
+
+    void onUbxFrame(uint8_t classId, uint8_t messageId, const uint8_t* payload, uint16_t payloadLength) override {
+        std::vector<uint8_t> data = { classId, messageId };
+        data.insert(data.end(), payload, payload + payloadLength);
+        ubxPayloads.push_back(data);
+    }
+};
+
+static void feed(StreamParser& parser, const std::string& data) {
+    parser.feed(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+static void feed(StreamParser& parser, const std::vector<uint8_t>& data) {
+    parser.feed(data.data(), data.size());
+}
+
+constexpr auto* GGA_BODY = "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,";
+
+TEST_CASE("StreamParser should parse a sentence with a checksum") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    feed(parser, createSentence(GGA_BODY));
+
+    CHECK_EQ(listener.ggaCount, 1);
+    CHECK_EQ(listener.lastGga.fix_quality, 1);
+    CHECK_EQ(listener.lastGga.satellites_tracked, 8);
+    REQUIRE_EQ(listener.sentences.size(), 1);
+    // The line ending is not part of the sentence
+    auto expected_sentence = createSentence(GGA_BODY);
+    expected_sentence.resize(expected_sentence.size() - 2);
+    CHECK_EQ(listener.sentences[0], expected_sentence);
+    CHECK_EQ(parser.getStatistics().nmeaSentences, 1);
+}
+
+TEST_CASE("StreamParser should parse a sentence without a checksum") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    feed(parser, std::string("$") + GGA_BODY + "\r\n");
+
+    CHECK_EQ(listener.ggaCount, 1);
+    CHECK_EQ(parser.getStatistics().checksumErrors, 0);
+}
+
+TEST_CASE("StreamParser should reject a sentence with an invalid checksum") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    auto sentence = createSentence(GGA_BODY);
+    // Corrupt a digit of the time
+    sentence[8] = (sentence[8] == '0') ? '1' : '0';
+    feed(parser, sentence);
+
+    CHECK_EQ(listener.ggaCount, 0);
+    CHECK(listener.sentences.empty());
+    CHECK_EQ(parser.getStatistics().checksumErrors, 1);
+}
+
+TEST_CASE("StreamParser should dispatch all supported sentence types") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    feed(parser, createSentence("GPRMC,081836,A,3751.65,S,14507.36,E,000.0,360.0,130998,011.3,E"));
+    feed(parser, createSentence(GGA_BODY));
+    feed(parser, createSentence("GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1"));
+    feed(parser, createSentence("GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45"));
+    feed(parser, createSentence("GPVTG,054.7,T,034.4,M,005.5,N,010.2,K"));
+    feed(parser, createSentence("GPZDA,201530.00,04,07,2002,00,00"));
+    feed(parser, createSentence("GPTXT,01,01,02,ANTSTATUS=OK"));
+
+    CHECK_EQ(listener.rmcCount, 1);
+    CHECK_EQ(listener.ggaCount, 1);
+    CHECK_EQ(listener.gsaCount, 1);
+    CHECK_EQ(listener.gsvCount, 1);
+    CHECK_EQ(listener.vtgCount, 1);
+    CHECK_EQ(listener.zdaCount, 1);
+    // Unsupported sentences are still forwarded as text
+    CHECK_EQ(listener.sentences.size(), 7);
+}
+
+TEST_CASE("StreamParser should parse UBX frames") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    // UBX-ACK-ACK for UBX-CFG-PRT
+    feed(parser, createUbxFrame(0x05, 0x01, { 0x06, 0x00 }));
+    // Empty poll request
+    feed(parser, createUbxFrame(0x0A, 0x04, {}));
+
+    REQUIRE_EQ(listener.ubxPayloads.size(), 2);
+    CHECK_EQ(listener.ubxPayloads[0], std::vector<uint8_t> { 0x05, 0x01, 0x06, 0x00 });
+    CHECK_EQ(listener.ubxPayloads[1], std::vector<uint8_t> { 0x0A, 0x04 });
+    CHECK_EQ(parser.getStatistics().ubxFrames, 2);
+}
+
+TEST_CASE("StreamParser should reject UBX frames with an invalid checksum") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    auto frame = createUbxFrame(0x05, 0x01, { 0x06, 0x00 });
+    frame.back() ^= 0xFF;
+    feed(parser, frame);
+
+    CHECK(listener.ubxPayloads.empty());
+    CHECK_EQ(parser.getStatistics().checksumErrors, 1);
+}
+
+TEST_CASE("StreamParser should demultiplex an interleaved stream with garbage") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    std::vector<uint8_t> stream = { 0x00, 0xFF, 'x', '\n' };
+    auto append = [&stream](const auto& data) {
+        stream.insert(stream.end(), data.begin(), data.end());
+    };
+    append(createSentence(GGA_BODY));
+    append(createUbxFrame(0x05, 0x00, { 0x06, 0x24 }));
+    // Truncated sentence, followed by a complete one
+    append(std::string("$GPGGA,1235"));
+    append(createSentence(GGA_BODY));
+    append(createUbxFrame(0x05, 0x01, { 0x06, 0x24 }));
+
+    // Byte by byte, like it would arrive from the UART
+    for (auto byte : stream) {
+        parser.feed(byte);
+    }
+
+    CHECK_EQ(listener.ggaCount, 2);
+    REQUIRE_EQ(listener.ubxPayloads.size(), 2);
+    CHECK_EQ(listener.ubxPayloads[0][1], 0x00);
+    CHECK_EQ(listener.ubxPayloads[1][1], 0x01);
+}
+
+TEST_CASE("StreamParser should recover from sentences that are too long") {
+    RecordingListener listener;
+    StreamParser parser(listener);
+
+    feed(parser, "$GPTXT," + std::string(MINMEA_MAX_SENTENCE_LENGTH, 'A') + "\r\n");
+    feed(parser, createSentence(GGA_BODY));
+
+    CHECK_EQ(parser.getStatistics().overflows, 1);
+    CHECK_EQ(listener.ggaCount, 1);
+}
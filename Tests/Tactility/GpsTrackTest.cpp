@@ -0,0 +1,165 @@
+#include "doctest.h"
+#include <Tactility/file/File.h>
+#include <Tactility/service/gps/GpsTrack.h>
+#include <Tactility/service/gps/GpsTrackRecorder.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace tt;
+using namespace tt::service::gps;
+
+constexpr auto* TRACK_FILE = "track.tmp";
+constexpr auto* EXPORT_FILE = "track_export.tmp";
+
+static TrackPoint createPoint(uint32_t index) {
+    return {
+        .time = 1700000000 + index,
+        .latitude = 521234567 + static_cast<int32_t>(index) * 15,
+        .longitude = 48765432 - static_cast<int32_t>(index) * 10,
+        .altitude = 120 + static_cast<int32_t>(index % 5)
+    };
+}
+
+static bool isEqual(const TrackPoint& left, const TrackPoint& right) {
+    return left.time == right.time &&
+        left.latitude == right.latitude &&
+        left.longitude == right.longitude &&
+        left.altitude == right.altitude;
+}
+
+/** Record the points like the GPS service does */
+static void recordTrack(const std::vector<TrackPoint>& points) {
+    TrackRecorder recorder(TRACK_FILE, kernel::millisToTicks(10));
+    REQUIRE(recorder.start());
+    for (auto& point : points) {
+        recorder.addPoint(point);
+    }
+    recorder.stop();
+
+    auto statistics = recorder.getStatistics();
+    CHECK_EQ(statistics.pointsRecorded, points.size());
+    CHECK_EQ(statistics.pointsDropped, 0);
+}
+
+TEST_CASE("appendTrackChunk should store small differences as deltas") {
+    TrackChunk chunk;
+    auto first = createPoint(0);
+    beginTrackChunk(chunk, first);
+
+    auto second = createPoint(1);
+    CHECK(appendTrackChunk(chunk, first, second));
+    CHECK_EQ(getTrackChunkPointCount(chunk), 2);
+    CHECK_EQ(chunk.deltas[0].time, 1);
+    CHECK_EQ(chunk.deltas[0].latitude, 15);
+    CHECK_EQ(chunk.deltas[0].longitude, -10);
+}
+
+TEST_CASE("appendTrackChunk should reject points that don't fit") {
+    TrackChunk chunk;
+    auto first = createPoint(0);
+    beginTrackChunk(chunk, first);
+
+    auto far_away = first;
+    far_away.latitude += 40000;
+    CHECK_FALSE(appendTrackChunk(chunk, first, far_away));
+
+    auto in_the_past = first;
+    in_the_past.time -= 1;
+    CHECK_FALSE(appendTrackChunk(chunk, first, in_the_past));
+
+    auto last = first;
+    for (uint32_t i = 1; i <= TRACK_CHUNK_DELTA_COUNT; ++i) {
+        auto next = createPoint(i);
+        CHECK(appendTrackChunk(chunk, last, next));
+        last = next;
+    }
+    CHECK_FALSE(appendTrackChunk(chunk, last, createPoint(TRACK_CHUNK_DELTA_COUNT + 1)));
+}
+
+TEST_CASE("TrackRecorder output should be readable by TrackReader") {
+    std::vector<TrackPoint> points;
+    for (uint32_t i = 0; i < 100; ++i) {
+        points.push_back(createPoint(i));
+    }
+    // A jump that can't be stored as a delta
+    auto jump = createPoint(100);
+    jump.longitude += 1000000;
+    points.push_back(jump);
+
+    recordTrack(points);
+
+    TrackReader reader(TRACK_FILE);
+    REQUIRE(reader.open());
+    CHECK_EQ(reader.getChunkCount(), 5);
+    std::vector<TrackPoint> points_read;
+    TrackPoint point;
+    while (reader.readNext(point)) {
+        points_read.push_back(point);
+    }
+    CHECK_FALSE(reader.hasNext());
+    reader.close();
+
+    REQUIRE_EQ(points_read.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        CHECK(isEqual(points[i], points_read[i]));
+    }
+
+    remove(TRACK_FILE);
+}
+
+TEST_CASE("TrackReader should seek by time") {
+    std::vector<TrackPoint> points;
+    for (uint32_t i = 0; i < 200; ++i) {
+        // Skip a few seconds, so not every time has a point
+        points.push_back(createPoint(i * 3));
+    }
+    recordTrack(points);
+
+    TrackReader reader(TRACK_FILE);
+    REQUIRE(reader.open());
+
+    TrackPoint point;
+    // Exact match in a later chunk
+    REQUIRE(reader.seek(points[150].time));
+    REQUIRE(reader.readNext(point));
+    CHECK(isEqual(point, points[150]));
+    REQUIRE(reader.readNext(point));
+    CHECK(isEqual(point, points[151]));
+
+    // In between points
+    REQUIRE(reader.seek(points[40].time + 1));
+    REQUIRE(reader.readNext(point));
+    CHECK(isEqual(point, points[41]));
+
+    // Before the start
+    REQUIRE(reader.seek(0));
+    REQUIRE(reader.readNext(point));
+    CHECK(isEqual(point, points[0]));
+
+    // After the end
+    CHECK_FALSE(reader.seek(points.back().time + 1));
+
+    reader.close();
+    remove(TRACK_FILE);
+}
+
+TEST_CASE("Tracks should be exportable to GPX and GeoJSON") {
+    recordTrack({ createPoint(0), createPoint(1) });
+
+    REQUIRE(exportTrackToGpx(TRACK_FILE, EXPORT_FILE));
+    auto gpx = file::readString(EXPORT_FILE);
+    REQUIRE_NE(gpx, nullptr);
+    std::string gpx_text = reinterpret_cast<const char*>(gpx.get());
+    CHECK_NE(gpx_text.find("<trkpt lat=\"52.1234567\" lon=\"4.8765432\"><ele>12.0</ele><time>2023-11-14T22:13:20Z</time></trkpt>"), std::string::npos);
+    CHECK_NE(gpx_text.find("</gpx>"), std::string::npos);
+
+    REQUIRE(exportTrackToGeoJson(TRACK_FILE, EXPORT_FILE));
+    auto geojson = file::readString(EXPORT_FILE);
+    REQUIRE_NE(geojson, nullptr);
+    std::string geojson_text = reinterpret_cast<const char*>(geojson.get());
+    CHECK_NE(geojson_text.find("[4.8765432,52.1234567,12.0],\n[4.8765422,52.1234582,12.1]"), std::string::npos);
+
+    remove(EXPORT_FILE);
+    remove(TRACK_FILE);
+}
@@ -0,0 +1,79 @@
+#include "doctest.h"
+#include <Tactility/hal/Device.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/Mutex.h>
+
+using namespace tt;
+
+constexpr int BENCHMARK_DEVICE_COUNT = 64;
+constexpr int BENCHMARK_LOOKUP_COUNT = 2000;
+
+class BenchmarkDevice final : public hal::Device {
+
+    Type type;
+
+public:
+
+    explicit BenchmarkDevice(Type type) : type(type) {}
+
+    Type getType() const override { return type; }
+    std::string getName() const override { return "BenchmarkDevice" + std::to_string(getId()); }
+    std::string getDescription() const override { return ""; }
+};
+
+/** The lookup as it was implemented before the registry kept a snapshot with per-type buckets */
+class LinearDeviceRegistry {
+
+    std::vector<std::shared_ptr<hal::Device>> devices;
+    Mutex mutex = Mutex(Mutex::Type::Recursive);
+
+public:
+
+    void add(const std::shared_ptr<hal::Device>& device) { devices.push_back(device); }
+
+    std::vector<std::shared_ptr<hal::Device>> findDevices(hal::Device::Type type) {
+        auto scoped_mutex = mutex.asScopedLock();
+        scoped_mutex.lock();
+        auto devices_view = devices | std::views::filter([type](auto& device) {
+            return device->getType() == type;
+        });
+        return { devices_view.begin(), devices_view.end() };
+    }
+};
+
+TEST_CASE("device registry benchmark: linear filter vs snapshot buckets") {
+    LinearDeviceRegistry linear_registry;
+    std::vector<std::shared_ptr<hal::Device>> devices;
+    for (int i = 0; i < BENCHMARK_DEVICE_COUNT; i++) {
+        auto type = static_cast<hal::Device::Type>(i % hal::DEVICE_TYPE_COUNT);
+        auto device = std::make_shared<BenchmarkDevice>(type);
+        devices.push_back(device);
+        linear_registry.add(device);
+        hal::registerDevice(device);
+    }
+
+    size_t linear_found = 0;
+    auto linear_start_time = kernel::getMicros();
+    for (int i = 0; i < BENCHMARK_LOOKUP_COUNT; i++) {
+        linear_found += linear_registry.findDevices(hal::Device::Type::Power).size();
+    }
+    auto linear_time = kernel::getMicros() - linear_start_time;
+
+    size_t snapshot_found = 0;
+    auto snapshot_start_time = kernel::getMicros();
+    for (int i = 0; i < BENCHMARK_LOOKUP_COUNT; i++) {
+        hal::findDevices<hal::Device>(hal::Device::Type::Power, [&snapshot_found](const auto&) {
+            snapshot_found++;
+            return true;
+        });
+    }
+    auto snapshot_time = kernel::getMicros() - snapshot_start_time;
+
+    for (auto& device : devices) {
+        hal::deregisterDevice(device);
+    }
+
+    CHECK_EQ(linear_found, snapshot_found);
+    MESSAGE("Linear lookup: ", linear_time * 1000 / BENCHMARK_LOOKUP_COUNT, " ns per lookup");
+    MESSAGE("Snapshot lookup: ", snapshot_time * 1000 / BENCHMARK_LOOKUP_COUNT, " ns per lookup");
+}
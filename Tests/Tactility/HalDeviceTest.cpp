@@ -96,3 +96,48 @@ TEST_CASE("find device by type") {
     CHECK_NE(found_device, nullptr);
     CHECK_EQ(found_device->getId(), device->getId());
 }
+
+TEST_CASE("registry epoch changes when devices are registered and deregistered") {
+    auto device = std::make_shared<TestDevice>();
+    auto initial_epoch = hal::getDeviceRegistryEpoch();
+
+    hal::registerDevice(device);
+    auto registered_epoch = hal::getDeviceRegistryEpoch();
+    CHECK_NE(registered_epoch, initial_epoch);
+
+    hal::deregisterDevice(device);
+    CHECK_NE(hal::getDeviceRegistryEpoch(), registered_epoch);
+}
+
+TEST_CASE("registry snapshot is not affected by later changes") {
+    auto device = std::make_shared<TestDevice>(hal::Device::Type::Gps, "GpsMock", "");
+    auto snapshot_before = hal::getDeviceRegistrySnapshot();
+    DeviceAutoRegistration auto_registration(device);
+
+    CHECK_EQ(snapshot_before->findDevice(device->getId()), nullptr);
+    CHECK_NE(hal::getDeviceRegistrySnapshot()->findDevice(device->getId()), nullptr);
+    CHECK_EQ(hal::getDeviceRegistrySnapshot()->getDevices(hal::Device::Type::Gps).size(), snapshot_before->getDevices(hal::Device::Type::Gps).size() + 1);
+}
+
+TEST_CASE("registry publishes registration events") {
+    auto device = std::make_shared<TestDevice>();
+    int registered_count = 0;
+    int deregistered_count = 0;
+
+    auto subscription = hal::getDeviceRegistryPubsub()->subscribe([&](const auto& event) {
+        if (event.device->getId() == device->getId()) {
+            if (event.type == hal::DeviceRegistryEvent::Type::Registered) {
+                registered_count++;
+            } else {
+                deregistered_count++;
+            }
+        }
+    });
+
+    hal::registerDevice(device);
+    hal::deregisterDevice(device);
+    hal::getDeviceRegistryPubsub()->unsubscribe(subscription);
+
+    CHECK_EQ(registered_count, 1);
+    CHECK_EQ(deregistered_count, 1);
+}
@@ -0,0 +1,68 @@
+#include "doctest.h"
+#include <Tactility/hal/i2c/I2cMockBackend.h>
+#include <Tactility/hal/i2c/I2cQueue.h>
+
+using namespace tt::hal::i2c;
+
+constexpr uint8_t GAUGE_ADDRESS = 0x55;
+constexpr uint8_t EXPANDER_ADDRESS = 0x58;
+
+/** The approximate time that the legacy ESP-IDF driver needs to build and start a command link */
+constexpr uint32_t TRANSFER_OVERHEAD_MICROS = 30;
+
+/**
+ * A battery gauge that reads 8 registers of 16 bits, and an IO expander that writes 8 configuration registers.
+ * The drivers used to do this with a transfer per register.
+ */
+TEST_CASE("I2c register access benchmark") {
+    auto bus = std::make_shared<I2cMockBackend>(400000, TRANSFER_OVERHEAD_MICROS);
+    bus->addDevice(GAUGE_ADDRESS);
+    bus->addDevice(EXPANDER_ADDRESS);
+    I2cQueue queue(bus);
+    std::vector<uint8_t> read_data;
+
+    constexpr uint8_t REGISTER_COUNT = 8;
+    constexpr uint8_t FIRST_REGISTER = 0x08;
+
+    for (uint8_t i = 0; i < REGISTER_COUNT; i++) {
+        queue.execute(I2cTransaction(GAUGE_ADDRESS).readRegisters(FIRST_REGISTER + i * 2, 2), read_data);
+        queue.execute(I2cTransaction(EXPANDER_ADDRESS).writeRegister8(FIRST_REGISTER + i, i), read_data);
+    }
+    auto single = bus->getStatistics();
+    bus->resetStatistics();
+
+    uint8_t values[REGISTER_COUNT];
+    for (uint8_t i = 0; i < REGISTER_COUNT; i++) {
+        values[i] = i;
+    }
+    queue.execute(I2cTransaction(GAUGE_ADDRESS).readRegisters(FIRST_REGISTER, REGISTER_COUNT * 2), read_data);
+    queue.execute(I2cTransaction(EXPANDER_ADDRESS).writeRegisters(FIRST_REGISTER, values, REGISTER_COUNT), read_data);
+    auto burst = bus->getStatistics();
+
+    MESSAGE("Per register: ", single.transfers, " transfers, ", single.bytes, " bytes, ", single.busTimeMicros, " us");
+    MESSAGE("Burst: ", burst.transfers, " transfers, ", burst.bytes, " bytes, ", burst.busTimeMicros, " us");
+    CHECK_EQ(burst.transfers, 2);
+    CHECK_LT(burst.busTimeMicros * 2, single.busTimeMicros);
+}
+
+/** A touch read that is submitted while a gauge has queued reads doesn't wait for them */
+TEST_CASE("I2c priority latency benchmark") {
+    constexpr uint8_t TOUCH_ADDRESS = 0x38;
+    auto bus = std::make_shared<I2cMockBackend>(400000, TRANSFER_OVERHEAD_MICROS);
+    bus->addDevice(GAUGE_ADDRESS);
+    bus->addDevice(TOUCH_ADDRESS);
+    I2cQueue queue(bus);
+
+    constexpr int GAUGE_READS = 8;
+    for (int i = 0; i < GAUGE_READS; i++) {
+        queue.submit(I2cTransaction(GAUGE_ADDRESS).readRegisters(0x08, 2), I2cQueue::Priority::Low);
+    }
+    uint64_t touch_bus_time = 0;
+    queue.submit(I2cTransaction(TOUCH_ADDRESS).readRegisters(0x02, 5), I2cQueue::Priority::High, [&bus, &touch_bus_time](bool, const std::vector<uint8_t>&) {
+        touch_bus_time = bus->getStatistics().busTimeMicros;
+    });
+    queue.processPending();
+
+    MESSAGE("Touch read completed after ", touch_bus_time, " us of bus time, instead of ", bus->getStatistics().busTimeMicros, " us");
+    CHECK_EQ(bus->getTransferLog().front(), TOUCH_ADDRESS);
+}
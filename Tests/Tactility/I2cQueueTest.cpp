@@ -0,0 +1,127 @@
+#include "doctest.h"
+#include <Tactility/hal/i2c/I2cMockBackend.h>
+#include <Tactility/hal/i2c/I2cQueue.h>
+
+#include <atomic>
+
+using namespace tt::hal::i2c;
+
+constexpr uint8_t TOUCH_ADDRESS = 0x38;
+constexpr uint8_t GAUGE_ADDRESS = 0x55;
+constexpr uint8_t KEYBOARD_ADDRESS = 0x34;
+
+static std::shared_ptr<I2cMockBackend> createBus() {
+    auto bus = std::make_shared<I2cMockBackend>();
+    bus->addDevice(TOUCH_ADDRESS);
+    bus->addDevice(GAUGE_ADDRESS);
+    bus->addDevice(KEYBOARD_ADDRESS);
+    return bus;
+}
+
+TEST_CASE("I2cQueue executes pending transactions by priority") {
+    auto bus = createBus();
+    I2cQueue queue(bus);
+
+    std::vector<uint8_t> completed;
+    auto on_complete = [&completed](uint8_t address) {
+        return [&completed, address](bool success, const std::vector<uint8_t>&) {
+            CHECK(success);
+            completed.push_back(address);
+        };
+    };
+
+    CHECK(queue.submit(I2cTransaction(GAUGE_ADDRESS).readRegisters(0x08, 2), I2cQueue::Priority::Low, on_complete(GAUGE_ADDRESS)));
+    CHECK(queue.submit(I2cTransaction(KEYBOARD_ADDRESS).readRegisters(0x04, 1), I2cQueue::Priority::Normal, on_complete(KEYBOARD_ADDRESS)));
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).readRegisters(0x02, 5), I2cQueue::Priority::High, on_complete(TOUCH_ADDRESS)));
+    CHECK(queue.submit(I2cTransaction(GAUGE_ADDRESS).readRegisters(0x0A, 2), I2cQueue::Priority::Low, on_complete(GAUGE_ADDRESS)));
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).readRegisters(0x02, 5), I2cQueue::Priority::High, on_complete(TOUCH_ADDRESS)));
+    CHECK_EQ(queue.getPendingCount(), 5);
+    CHECK(bus->getTransferLog().empty());
+
+    CHECK_EQ(queue.processPending(), 5);
+    CHECK_EQ(queue.getPendingCount(), 0);
+    const std::vector<uint8_t> expected = { TOUCH_ADDRESS, TOUCH_ADDRESS, KEYBOARD_ADDRESS, GAUGE_ADDRESS, GAUGE_ADDRESS };
+    CHECK_EQ(completed, expected);
+    CHECK_EQ(bus->getTransferLog(), expected);
+}
+
+TEST_CASE("I2cQueue rejects transactions when it is full") {
+    I2cQueue queue(createBus(), 2);
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).read(1)));
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).read(1)));
+    CHECK_FALSE(queue.submit(I2cTransaction(TOUCH_ADDRESS).read(1)));
+    CHECK_EQ(queue.processPending(), 2);
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).read(1)));
+}
+
+TEST_CASE("I2cTransaction burst reads and write batches") {
+    auto bus = createBus();
+    I2cQueue queue(bus);
+
+    const uint8_t values[] = { 1, 2, 3, 4 };
+    auto transaction = I2cTransaction(KEYBOARD_ADDRESS)
+        .writeRegisters(0x10, values, sizeof(values))
+        .writeRegister8(0x20, 0xAA)
+        .writeRegister8(0x30, 0xBB)
+        .readRegisters(0x11, 3)
+        .readRegisters(0x30, 1);
+    CHECK_EQ(transaction.getReadSize(), 4);
+
+    std::vector<uint8_t> read_data;
+    REQUIRE(queue.execute(transaction, read_data));
+    CHECK_EQ(read_data, std::vector<uint8_t> { 2, 3, 4, 0xBB });
+    CHECK_EQ(bus->getRegister(KEYBOARD_ADDRESS, 0x20), 0xAA);
+    CHECK_EQ(bus->getStatistics().transfers, 5);
+}
+
+TEST_CASE("I2cQueue stops a transaction at the first failure") {
+    auto bus = createBus();
+    I2cQueue queue(bus);
+
+    bool callback_success = true;
+    queue.submit(I2cTransaction(0x77).writeRegister8(0x01, 1).writeRegister8(0x02, 2), I2cQueue::Priority::Normal, [&callback_success](bool success, const std::vector<uint8_t>&) {
+        callback_success = success;
+    });
+    queue.processPending();
+    CHECK_FALSE(callback_success);
+    CHECK_EQ(bus->getStatistics().transfers, 1);
+
+    auto statistics = queue.getStatistics();
+    CHECK_EQ(statistics[0x77].transactions, 1);
+    CHECK_EQ(statistics[0x77].failures, 1);
+}
+
+TEST_CASE("I2cQueue records statistics per device") {
+    I2cQueue queue(createBus());
+    std::vector<uint8_t> read_data;
+    for (int i = 0; i < 3; i++) {
+        queue.execute(I2cTransaction(TOUCH_ADDRESS).readRegisters(0x02, 5), read_data);
+    }
+    queue.submit(I2cTransaction(GAUGE_ADDRESS).readRegisters(0x08, 2));
+    queue.processPending();
+
+    auto statistics = queue.getStatistics();
+    CHECK_EQ(statistics.size(), 2);
+    CHECK_EQ(statistics[TOUCH_ADDRESS].transactions, 3);
+    CHECK_EQ(statistics[TOUCH_ADDRESS].failures, 0);
+    CHECK_EQ(statistics[GAUGE_ADDRESS].transactions, 1);
+
+    queue.resetStatistics();
+    CHECK(queue.getStatistics().empty());
+}
+
+TEST_CASE("I2cQueue thread completes submitted transactions") {
+    auto bus = createBus();
+    bus->setRegister(TOUCH_ADDRESS, 0x03, 42);
+    I2cQueue queue(bus);
+    queue.start();
+
+    std::atomic<int> result = -1;
+    CHECK(queue.submit(I2cTransaction(TOUCH_ADDRESS).readRegisters(0x03, 1), I2cQueue::Priority::High, [&result](bool success, const std::vector<uint8_t>& readData) {
+        result = success ? readData[0] : 0;
+    }));
+
+    // Stopping executes the pending transactions first
+    queue.stop();
+    CHECK_EQ(result, 42);
+}
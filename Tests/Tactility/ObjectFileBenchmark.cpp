@@ -0,0 +1,145 @@
+#include "doctest.h"
+#include <Tactility/file/ObjectFile.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace tt;
+using tt::file::ObjectFileReader;
+using tt::file::ObjectFileWriter;
+
+constexpr uint32_t BENCHMARK_RECORD_COUNT = 100000;
+constexpr uint32_t BENCHMARK_BATCH_SIZE = 256;
+
+struct BenchmarkRecord {
+    uint32_t time;
+    int32_t latitude;
+    int32_t longitude;
+    int32_t altitude;
+};
+
+/**
+ * The benchmark files are written to the current directory.
+ * Set OBJECT_FILE_BENCHMARK_PATH to compare with other storage (e.g. a tmpfs or a throttled FUSE mount).
+ */
+static std::string getBenchmarkPath(const char* fileName) {
+    auto* directory = getenv("OBJECT_FILE_BENCHMARK_PATH");
+    return (directory != nullptr) ? std::string(directory) + "/" + fileName : fileName;
+}
+
+/** Writes like the version 1 implementation: a write per record and the header on close */
+static bool writeVersion1File(const std::string& path) {
+    auto* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    uint32_t file_header[] = { 0x13371337, 1 };
+    fwrite(file_header, sizeof(file_header), 1, file);
+    uint32_t content_header[] = { 1, sizeof(BenchmarkRecord), 0 };
+    fseek(file, sizeof(content_header), SEEK_CUR);
+
+    for (uint32_t i = 0; i < BENCHMARK_RECORD_COUNT; ++i) {
+        BenchmarkRecord record = { .time = i, .latitude = 0, .longitude = 0, .altitude = 0 };
+        fwrite(&record, sizeof(BenchmarkRecord), 1, file);
+    }
+
+    content_header[2] = BENCHMARK_RECORD_COUNT;
+    fseek(file, sizeof(file_header), SEEK_SET);
+    fwrite(content_header, sizeof(content_header), 1, file);
+    fclose(file);
+    return true;
+}
+
+static bool writeVersion2File(const std::string& path) {
+    ObjectFileWriter writer(path, sizeof(BenchmarkRecord), 1, false);
+    if (!writer.open()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < BENCHMARK_RECORD_COUNT; ++i) {
+        BenchmarkRecord record = { .time = i, .latitude = 0, .longitude = 0, .altitude = 0 };
+        if (!writer.write(&record)) {
+            return false;
+        }
+    }
+
+    writer.close();
+    return true;
+}
+
+static uint32_t readOneByOne(const std::string& path) {
+    ObjectFileReader reader(path, sizeof(BenchmarkRecord));
+    if (!reader.open()) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    BenchmarkRecord record;
+    while (reader.readNext(&record)) {
+        count++;
+    }
+    reader.close();
+    return count;
+}
+
+static uint32_t readBatched(const std::string& path) {
+    ObjectFileReader reader(path, sizeof(BenchmarkRecord));
+    if (!reader.open()) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    auto records = std::make_unique<BenchmarkRecord[]>(BENCHMARK_BATCH_SIZE);
+    uint32_t batch_count;
+    while ((batch_count = reader.readMany(records.get(), BENCHMARK_BATCH_SIZE)) > 0) {
+        count += batch_count;
+    }
+    reader.close();
+    return count;
+}
+
+TEST_CASE("ObjectFile benchmark") {
+    auto v1_path = getBenchmarkPath("objectfile_v1.tmp");
+    auto v2_path = getBenchmarkPath("objectfile_v2.tmp");
+
+    auto start_time = kernel::getMicros();
+    REQUIRE(writeVersion1File(v1_path));
+    auto v1_write_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    REQUIRE(writeVersion2File(v2_path));
+    auto v2_write_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    CHECK_EQ(readOneByOne(v1_path), BENCHMARK_RECORD_COUNT);
+    auto v1_read_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    CHECK_EQ(readBatched(v2_path), BENCHMARK_RECORD_COUNT);
+    auto v2_read_duration = kernel::getMicros() - start_time;
+
+    // Look up records in random places of the file
+    ObjectFileReader reader(v2_path, sizeof(BenchmarkRecord));
+    REQUIRE(reader.open());
+    start_time = kernel::getMicros();
+    BenchmarkRecord record;
+    uint32_t index = 0;
+    for (int i = 0; i < 1000; ++i) {
+        index = (index + 7919) % BENCHMARK_RECORD_COUNT;
+        REQUIRE(reader.seek(index));
+        REQUIRE(reader.readNext(&record));
+        CHECK_EQ(record.time, index);
+    }
+    auto seek_duration = kernel::getMicros() - start_time;
+    reader.close();
+
+    MESSAGE("Writing ", BENCHMARK_RECORD_COUNT, " records: v1 took ", v1_write_duration, " us, v2 took ", v2_write_duration, " us");
+    MESSAGE("Reading ", BENCHMARK_RECORD_COUNT, " records: v1 took ", v1_read_duration, " us, v2 (batched) took ", v2_read_duration, " us");
+    MESSAGE("1000 seeks and reads took ", seek_duration, " us");
+
+    remove(v1_path.c_str());
+    remove(v2_path.c_str());
+}
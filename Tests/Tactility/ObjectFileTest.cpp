@@ -63,3 +63,145 @@ TEST_CASE("Appending records to a file") {
 
     remove(TEMP_FILE);
 }
+
+TEST_CASE("Appending records to a file with a partially filled write buffer") {
+    remove(TEMP_FILE);
+
+    constexpr uint32_t record_count = 3000;
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < record_count; ++i) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+    CHECK_EQ(appender.getRecordCount(), record_count);
+    TestStruct appended_record = { .value = record_count };
+    CHECK_EQ(appender.write(&appended_record), true);
+    appender.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    REQUIRE_EQ(reader.getRecordCount(), record_count + 1);
+    TestStruct record_in;
+    for (uint32_t i = 0; i <= record_count; ++i) {
+        CHECK_EQ(reader.readNext(&record_in), true);
+        CHECK_EQ(record_in.value, i);
+    }
+    CHECK_EQ(reader.hasNext(), false);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Flushed records should be readable before the writer is closed") {
+    remove(TEMP_FILE);
+
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false);
+    CHECK_EQ(writer.open(), true);
+
+    // Empty files are valid
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 0);
+    reader.close();
+
+    TestStruct record_out = { .value = 0xAAAAAAAA };
+    CHECK_EQ(writer.write(&record_out), true);
+    CHECK_EQ(writer.flush(), true);
+    // Not flushed: lost when the power fails
+    CHECK_EQ(writer.write(&record_out), true);
+
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 1);
+    reader.close();
+
+    writer.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Appending to an empty file should make it readable before the writer is closed") {
+    remove(TEMP_FILE);
+    fclose(fopen(TEMP_FILE, "wb"));
+
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    CHECK_EQ(reader.getRecordCount(), 0);
+    reader.close();
+
+    appender.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Reading records after seeking and in batches") {
+    remove(TEMP_FILE);
+
+    constexpr uint32_t record_count = 100;
+    ObjectFileWriter writer = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, false);
+    CHECK_EQ(writer.open(), true);
+    for (uint32_t i = 0; i < record_count; ++i) {
+        TestStruct record = { .value = i };
+        CHECK_EQ(writer.write(&record), true);
+    }
+    writer.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+
+    TestStruct records_in[16];
+    CHECK_EQ(reader.seek(90), true);
+    CHECK_EQ(reader.readMany(records_in, 16), 10);
+    CHECK_EQ(records_in[0].value, 90);
+    CHECK_EQ(records_in[9].value, 99);
+    CHECK_EQ(reader.hasNext(), false);
+
+    CHECK_EQ(reader.seek(5), true);
+    CHECK_EQ(reader.readMany(records_in, 16), 16);
+    CHECK_EQ(records_in[0].value, 5);
+    CHECK_EQ(records_in[15].value, 20);
+
+    CHECK_EQ(reader.seek(record_count + 1), false);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
+
+TEST_CASE("Reading and appending to a version 1 file") {
+    remove(TEMP_FILE);
+
+    // Header and records as they were written by version 1
+    uint32_t v1_file[] = {
+        0x13371337, 1, // File header: identifier, version
+        1, sizeof(TestStruct), 2, // Content header: record version, record size, record count
+        0xAAAAAAAA, 0xBBBBBBBB // Records
+    };
+    auto* file = fopen(TEMP_FILE, "wb");
+    REQUIRE_NE(file, nullptr);
+    CHECK_EQ(fwrite(v1_file, sizeof(v1_file), 1, file), 1);
+    fclose(file);
+
+    ObjectFileWriter appender = ObjectFileWriter(TEMP_FILE, sizeof(TestStruct), 1, true);
+    CHECK_EQ(appender.open(), true);
+    TestStruct record_out = { .value = 0xCCCCCCCC };
+    CHECK_EQ(appender.write(&record_out), true);
+    appender.close();
+
+    ObjectFileReader reader = ObjectFileReader(TEMP_FILE, sizeof(TestStruct));
+    CHECK_EQ(reader.open(), true);
+    TestStruct records_in[3];
+    CHECK_EQ(reader.readMany(records_in, 3), 3);
+    CHECK_EQ(records_in[0].value, 0xAAAAAAAA);
+    CHECK_EQ(records_in[1].value, 0xBBBBBBBB);
+    CHECK_EQ(records_in[2].value, 0xCCCCCCCC);
+    reader.close();
+
+    remove(TEMP_FILE);
+}
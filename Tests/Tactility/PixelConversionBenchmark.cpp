@@ -0,0 +1,53 @@
+#include "doctest.h"
+#include <Tactility/hal/display/PixelConversion.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace tt;
+using namespace tt::hal::display;
+
+constexpr uint32_t BENCHMARK_WIDTH = 320;
+constexpr uint32_t BENCHMARK_HEIGHT = 480;
+constexpr int BENCHMARK_ROUNDS = 20;
+
+template <typename Function>
+static double getMegapixelsPerSecond(Function function) {
+    auto start_time = kernel::getMicros();
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+        function();
+    }
+    auto duration = kernel::getMicros() - start_time;
+    // Pixels per microsecond is megapixels per second
+    return static_cast<double>(BENCHMARK_WIDTH) * BENCHMARK_HEIGHT * BENCHMARK_ROUNDS / static_cast<double>(std::max(duration, 1L));
+}
+
+TEST_CASE("pixel conversion benchmark") {
+    std::vector<uint8_t> source(BENCHMARK_WIDTH * BENCHMARK_HEIGHT * 3);
+    std::vector<uint8_t> target(BENCHMARK_WIDTH * BENCHMARK_HEIGHT * 3);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = static_cast<uint8_t>(i);
+    }
+
+    auto convert = [&](ColorFormat sourceFormat, ColorFormat targetFormat) {
+        return getMegapixelsPerSecond([&] {
+            convertPixels(sourceFormat, source.data(), targetFormat, target.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT);
+        });
+    };
+
+    auto rotate = [&](ColorFormat format, Rotation rotation) {
+        return getMegapixelsPerSecond([&] {
+            rotatePixels(format, source.data(), target.data(), BENCHMARK_WIDTH, BENCHMARK_HEIGHT, rotation);
+        });
+    };
+
+    MESSAGE("RGB565 to RGB565Swapped: ", convert(ColorFormat::RGB565, ColorFormat::RGB565Swapped), " MP/s");
+    MESSAGE("RGB565 to BGR565Swapped: ", convert(ColorFormat::RGB565, ColorFormat::BGR565Swapped), " MP/s");
+    MESSAGE("RGB888 to RGB565: ", convert(ColorFormat::RGB888, ColorFormat::RGB565), " MP/s");
+    MESSAGE("RGB565 to RGB888: ", convert(ColorFormat::RGB565, ColorFormat::RGB888), " MP/s");
+    MESSAGE("RGB565 to Monochrome: ", convert(ColorFormat::RGB565, ColorFormat::Monochrome), " MP/s");
+    MESSAGE("RGB565 rotation by 90: ", rotate(ColorFormat::RGB565, Rotation::Clockwise90), " MP/s");
+    MESSAGE("RGB565 rotation by 180: ", rotate(ColorFormat::RGB565, Rotation::Clockwise180), " MP/s");
+    MESSAGE("RGB888 rotation by 270: ", rotate(ColorFormat::RGB888, Rotation::Clockwise270), " MP/s");
+}
@@ -0,0 +1,150 @@
+#include "doctest.h"
+#include <Tactility/hal/display/PixelConversion.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace tt::hal::display;
+
+static uint16_t toRgb565(uint8_t red, uint8_t green, uint8_t blue) {
+    return static_cast<uint16_t>(((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3));
+}
+
+static uint16_t swapBytes(uint16_t value) {
+    return static_cast<uint16_t>((value << 8) | (value >> 8));
+}
+
+TEST_CASE("convertPixels converts between all 565 formats") {
+    // An odd amount of pixels, so the single-pixel tail is also used
+    const std::vector<uint16_t> rgb = { toRgb565(255, 0, 0), toRgb565(0, 255, 0), toRgb565(0, 0, 255), toRgb565(16, 128, 200), toRgb565(1, 2, 3) };
+    std::vector<uint16_t> bgr;
+    for (auto pixel : rgb) {
+        bgr.push_back(static_cast<uint16_t>((pixel & 0x07E0) | (pixel >> 11) | ((pixel & 0x1F) << 11)));
+    }
+    std::vector<uint16_t> rgb_swapped;
+    std::vector<uint16_t> bgr_swapped;
+    for (size_t i = 0; i < rgb.size(); i++) {
+        rgb_swapped.push_back(swapBytes(rgb[i]));
+        bgr_swapped.push_back(swapBytes(bgr[i]));
+    }
+
+    const std::pair<ColorFormat, const std::vector<uint16_t>*> formats[] = {
+        { ColorFormat::RGB565, &rgb },
+        { ColorFormat::BGR565, &bgr },
+        { ColorFormat::RGB565Swapped, &rgb_swapped },
+        { ColorFormat::BGR565Swapped, &bgr_swapped }
+    };
+
+    for (const auto& [source_format, source] : formats) {
+        for (const auto& [target_format, expected] : formats) {
+            std::vector<uint16_t> target(source->size());
+            CHECK(convertPixels(source_format, source->data(), target_format, target.data(), source->size(), 1));
+            CHECK_EQ(target, *expected);
+        }
+    }
+}
+
+TEST_CASE("convertPixels converts between RGB888 and 565") {
+    // LVGL order: blue, green, red
+    const uint8_t rgb888[] = { 0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x00 };
+    uint16_t rgb565[3];
+    CHECK(convertPixels(ColorFormat::RGB888, rgb888, ColorFormat::RGB565, rgb565, 3, 1));
+    CHECK_EQ(rgb565[0], 0xF800);
+    CHECK_EQ(rgb565[1], 0x07E0);
+    CHECK_EQ(rgb565[2], 0x001F);
+
+    uint8_t converted[9];
+    CHECK(convertPixels(ColorFormat::RGB565, rgb565, ColorFormat::RGB888, converted, 3, 1));
+    CHECK_EQ(memcmp(converted, rgb888, sizeof(rgb888)), 0);
+}
+
+TEST_CASE("convertPixels dithers to monochrome") {
+    constexpr uint32_t width = 10;
+    constexpr uint32_t height = 4;
+    std::vector<uint16_t> white(width * height, 0xFFFF);
+    std::vector<uint16_t> black(width * height, 0x0000);
+    std::vector<uint16_t> gray(width * height, toRgb565(128, 128, 128));
+    const auto row_size = getRowSize(ColorFormat::Monochrome, width);
+    CHECK_EQ(row_size, 2);
+
+    std::vector<uint8_t> monochrome(row_size * height);
+    CHECK(convertPixels(ColorFormat::RGB565, white.data(), ColorFormat::Monochrome, monochrome.data(), width, height));
+    for (uint32_t row = 0; row < height; row++) {
+        CHECK_EQ(monochrome[row * row_size], 0xFF);
+        // Unused bits in the last byte of a row are cleared
+        CHECK_EQ(monochrome[row * row_size + 1], 0xC0);
+    }
+
+    CHECK(convertPixels(ColorFormat::RGB565, black.data(), ColorFormat::Monochrome, monochrome.data(), width, height));
+    CHECK_EQ(monochrome, std::vector<uint8_t>(row_size * height, 0x00));
+
+    // Half of the pixels of a 4x4 dithering pattern are lit for 50% gray
+    CHECK(convertPixels(ColorFormat::RGB565, gray.data(), ColorFormat::Monochrome, monochrome.data(), width, height));
+    int lit = 0;
+    for (uint32_t row = 0; row < height; row++) {
+        lit += __builtin_popcount(monochrome[row * row_size] & 0xF0);
+    }
+    CHECK_EQ(lit, 8);
+
+    // Back to color
+    std::vector<uint16_t> restored(width * height);
+    CHECK(convertPixels(ColorFormat::Monochrome, monochrome.data(), ColorFormat::RGB565, restored.data(), width, height));
+    CHECK_EQ(restored[0], (monochrome[0] & 0x80) ? 0xFFFF : 0x0000);
+}
+
+TEST_CASE("convertPixels converts to monochrome in-place") {
+    constexpr uint32_t width = 10;
+    constexpr uint32_t height = 4;
+    // A different pattern on every row
+    std::vector<uint16_t> source(width * height);
+    for (uint32_t i = 0; i < source.size(); i++) {
+        source[i] = ((i * 7) % 3 == 0) ? 0xFFFF : 0x0000;
+    }
+
+    const auto row_size = getRowSize(ColorFormat::Monochrome, width);
+    std::vector<uint8_t> expected(row_size * height);
+    CHECK(convertPixels(ColorFormat::RGB565, source.data(), ColorFormat::Monochrome, expected.data(), width, height));
+
+    CHECK(convertPixels(ColorFormat::RGB565, source.data(), ColorFormat::Monochrome, source.data(), width, height));
+    CHECK_EQ(memcmp(source.data(), expected.data(), expected.size()), 0);
+}
+
+TEST_CASE("rotatePixels rotates clockwise") {
+    // 3x2 pixels:
+    // 1 2 3
+    // 4 5 6
+    const uint16_t source[] = { 1, 2, 3, 4, 5, 6 };
+    uint16_t target[6];
+
+    CHECK(rotatePixels(ColorFormat::RGB565, source, target, 3, 2, Rotation::Clockwise90));
+    const uint16_t expected_90[] = { 4, 1, 5, 2, 6, 3 };
+    CHECK_EQ(memcmp(target, expected_90, sizeof(target)), 0);
+
+    CHECK(rotatePixels(ColorFormat::RGB565, source, target, 3, 2, Rotation::Clockwise180));
+    const uint16_t expected_180[] = { 6, 5, 4, 3, 2, 1 };
+    CHECK_EQ(memcmp(target, expected_180, sizeof(target)), 0);
+
+    CHECK(rotatePixels(ColorFormat::RGB565, source, target, 3, 2, Rotation::Clockwise270));
+    const uint16_t expected_270[] = { 3, 6, 2, 5, 1, 4 };
+    CHECK_EQ(memcmp(target, expected_270, sizeof(target)), 0);
+
+    CHECK_FALSE(rotatePixels(ColorFormat::Monochrome, source, target, 3, 2, Rotation::Clockwise90));
+}
+
+TEST_CASE("rotatePixels handles images that are larger than a tile") {
+    constexpr uint32_t width = 37;
+    constexpr uint32_t height = 21;
+    std::vector<uint8_t> source(width * height * 3);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    // 4 rotations of 90 degrees result in the original image
+    std::vector<uint8_t> first(source.size());
+    std::vector<uint8_t> second(source.size());
+    CHECK(rotatePixels(ColorFormat::RGB888, source.data(), first.data(), width, height, Rotation::Clockwise90));
+    CHECK(rotatePixels(ColorFormat::RGB888, first.data(), second.data(), height, width, Rotation::Clockwise90));
+    CHECK(rotatePixels(ColorFormat::RGB888, second.data(), first.data(), width, height, Rotation::Clockwise90));
+    CHECK(rotatePixels(ColorFormat::RGB888, first.data(), second.data(), height, width, Rotation::Clockwise90));
+    CHECK_EQ(second, source);
+}
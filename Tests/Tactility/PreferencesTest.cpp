@@ -0,0 +1,172 @@
+#include "doctest.h"
+#include <Tactility/Preferences.h>
+#include <Tactility/PreferencesBackend.h>
+#include <Tactility/file/File.h>
+
+using namespace tt;
+
+constexpr auto* TEST_DIRECTORY = "preferences_test";
+
+/** Starts with an empty directory and an empty cache, and removes the directory afterwards */
+class PreferencesTestDirectory {
+
+public:
+
+    PreferencesTestDirectory() {
+        file::deleteRecursively(TEST_DIRECTORY);
+        setPreferencesDirectory(TEST_DIRECTORY);
+        Preferences::resetStatistics();
+    }
+
+    ~PreferencesTestDirectory() {
+        file::deleteRecursively(TEST_DIRECTORY);
+    }
+};
+
+TEST_CASE("Preferences stores all types") {
+    PreferencesTestDirectory directory;
+    Preferences preferences("test");
+
+    CHECK_FALSE(preferences.hasBool("bool"));
+    preferences.putBool("bool", true);
+    preferences.putInt32("int32", -123456);
+    preferences.putInt64("int64", 1234567890123LL);
+    preferences.putString("string", "multi\nline \\ text ");
+
+    bool bool_value = false;
+    int32_t int32_value = 0;
+    int64_t int64_value = 0;
+    std::string string_value;
+    CHECK(preferences.optBool("bool", bool_value));
+    CHECK(preferences.optInt32("int32", int32_value));
+    CHECK(preferences.optInt64("int64", int64_value));
+    CHECK(preferences.optString("string", string_value));
+    CHECK_EQ(bool_value, true);
+    CHECK_EQ(int32_value, -123456);
+    CHECK_EQ(int64_value, 1234567890123LL);
+    CHECK_EQ(string_value, "multi\nline \\ text ");
+
+    // Values have a type
+    CHECK_FALSE(preferences.hasInt32("bool"));
+}
+
+TEST_CASE("Preferences persist in a file") {
+    PreferencesTestDirectory directory;
+    Preferences("test").putString("string", "multi\nline \\ text ");
+    Preferences("test").putInt64("int64", -5);
+    Preferences("other").putInt32("int32", 7);
+
+    // Reopen the namespaces, so the values are read from the files
+    resetPreferencesCache();
+
+    std::string string_value;
+    int64_t int64_value = 0;
+    int32_t int32_value = 0;
+    CHECK(Preferences("test").optString("string", string_value));
+    CHECK(Preferences("test").optInt64("int64", int64_value));
+    CHECK(Preferences("other").optInt32("int32", int32_value));
+    CHECK_EQ(string_value, "multi\nline \\ text ");
+    CHECK_EQ(int64_value, -5);
+    CHECK_EQ(int32_value, 7);
+    CHECK_FALSE(Preferences("other").hasString("string"));
+}
+
+TEST_CASE("Preferences skip writes of unchanged values") {
+    PreferencesTestDirectory directory;
+    Preferences preferences("test");
+    preferences.putInt32("value", 1);
+    preferences.putInt32("value", 1);
+    preferences.putInt32("value", 2);
+
+    auto statistics = Preferences::getStatistics();
+    CHECK_EQ(statistics.writes, 2);
+    CHECK_EQ(statistics.skippedWrites, 1);
+    CHECK_EQ(statistics.commits, 2);
+}
+
+TEST_CASE("Preferences read from the cache") {
+    PreferencesTestDirectory directory;
+    Preferences("test").putInt32("value", 1);
+    int32_t value;
+    for (int i = 0; i < 10; i++) {
+        CHECK(Preferences("test").optInt32("value", value));
+    }
+
+    auto statistics = Preferences::getStatistics();
+    CHECK_EQ(statistics.reads, 10);
+    CHECK_EQ(statistics.cacheHits, 10);
+}
+
+TEST_CASE("Preferences transactions commit once") {
+    PreferencesTestDirectory directory;
+    Preferences preferences("test");
+    {
+        auto transaction = preferences.transaction();
+        preferences.putString("name", "Europe/Amsterdam");
+        {
+            // Nested transactions, possibly from other instances, are part of the outer transaction
+            Preferences other_instance("test");
+            auto nested_transaction = other_instance.transaction();
+            other_instance.putInt32("count", 1);
+            other_instance.putInt32("count", 2);
+        }
+        CHECK_EQ(Preferences::getStatistics().commits, 0);
+
+        // Values are readable before they are committed
+        int32_t count = 0;
+        CHECK(preferences.optInt32("count", count));
+        CHECK_EQ(count, 2);
+    }
+
+    auto statistics = Preferences::getStatistics();
+    CHECK_EQ(statistics.commits, 1);
+    CHECK_EQ(statistics.writes, 2);
+
+    resetPreferencesCache();
+    std::string name;
+    CHECK(preferences.optString("name", name));
+    CHECK_EQ(name, "Europe/Amsterdam");
+}
+
+/**
+ * A settings screen that stores a dozen values when it's closed, and is opened and closed a couple of times.
+ * This used to result in a commit for every value.
+ */
+TEST_CASE("Preferences settings workload commits") {
+    PreferencesTestDirectory directory;
+    constexpr int SETTINGS_COUNT = 12;
+    constexpr int SAVE_COUNT = 5;
+    Preferences preferences("settings");
+
+    for (int save = 0; save < SAVE_COUNT; save++) {
+        // Only the first setting changes after the first save
+        auto transaction = preferences.transaction();
+        for (int i = 0; i < SETTINGS_COUNT; i++) {
+            preferences.putInt32("setting" + std::to_string(i), (i == 0) ? save : i);
+        }
+    }
+
+    auto statistics = Preferences::getStatistics();
+    MESSAGE("Commits: ", statistics.commits, ", writes: ", statistics.writes, ", skipped writes: ", statistics.skippedWrites);
+    CHECK_EQ(statistics.commits, SAVE_COUNT);
+    CHECK_EQ(statistics.writes, SETTINGS_COUNT + SAVE_COUNT - 1);
+}
+
+TEST_CASE("Preferences retry values that failed to persist") {
+    PreferencesTestDirectory directory;
+    Preferences preferences("test");
+
+    // The namespace file can't be written when a directory has its name
+    auto file_path = std::string(TEST_DIRECTORY) + "/test.properties";
+    REQUIRE(file::findOrCreateDirectory(file_path, 0777));
+    CHECK_FALSE(preferences.putInt32("value", 1));
+
+    REQUIRE(file::deleteRecursively(file_path));
+    CHECK(preferences.putInt32("value", 1));
+    CHECK_EQ(Preferences::getStatistics().skippedWrites, 0);
+
+    resetPreferencesCache();
+    int32_t value = 0;
+    CHECK(preferences.optInt32("value", value));
+    CHECK_EQ(value, 1);
+}
@@ -0,0 +1,176 @@
+#include "doctest.h"
+#include <Tactility/service/screenshot/ScreenshotEncoder.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace tt::service::screenshot;
+
+static uint16_t toRgb565(uint8_t red, uint8_t green, uint8_t blue) {
+    return static_cast<uint16_t>(((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3));
+}
+
+static void createFrame(Frame& frame, uint32_t width, uint32_t height, const std::vector<uint16_t>& pixels) {
+    // Rows have padding, to verify that the stride is respected
+    frame.width = width;
+    frame.height = height;
+    frame.stride = (width + 3) * sizeof(uint16_t);
+    REQUIRE(frame.reserve(frame.stride * height));
+    memset(frame.getData(), 0xAB, frame.stride * height);
+    for (uint32_t y = 0; y < height; y++) {
+        memcpy(frame.getData() + (y * frame.stride), &pixels[y * width], width * sizeof(uint16_t));
+    }
+}
+
+/** A minimal decoder for RGB images, following the QOI specification */
+static std::vector<uint8_t> decodeQoi(const std::vector<uint8_t>& data, uint32_t& width, uint32_t& height) {
+    width = (data[4] << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+    height = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
+    std::vector<uint8_t> pixels;
+    uint8_t index[64][4] = {};
+    uint8_t pixel[4] = { 0, 0, 0, 255 };
+    size_t position = 14;
+    while (pixels.size() < width * height * 3) {
+        const uint8_t byte = data[position++];
+        int run = 1;
+        if (byte == 0xFE) {
+            pixel[0] = data[position++];
+            pixel[1] = data[position++];
+            pixel[2] = data[position++];
+        } else if ((byte & 0xC0) == 0x00) {
+            memcpy(pixel, index[byte], 4);
+        } else if ((byte & 0xC0) == 0x40) {
+            pixel[0] += ((byte >> 4) & 0x03) - 2;
+            pixel[1] += ((byte >> 2) & 0x03) - 2;
+            pixel[2] += (byte & 0x03) - 2;
+        } else if ((byte & 0xC0) == 0x80) {
+            const int green_difference = (byte & 0x3F) - 32;
+            const uint8_t next = data[position++];
+            pixel[0] += green_difference - 8 + ((next >> 4) & 0x0F);
+            pixel[1] += green_difference;
+            pixel[2] += green_difference - 8 + (next & 0x0F);
+        } else {
+            run = (byte & 0x3F) + 1;
+        }
+        memcpy(index[((pixel[0] * 3) + (pixel[1] * 5) + (pixel[2] * 7) + (pixel[3] * 11)) % 64], pixel, 4);
+        for (int i = 0; i < run; i++) {
+            pixels.insert(pixels.end(), { pixel[0], pixel[1], pixel[2] });
+        }
+    }
+    // End marker
+    CHECK_EQ(data.size(), position + 8);
+    CHECK_EQ(data.back(), 1);
+    return pixels;
+}
+
+TEST_CASE("encodeQoi output can be decoded") {
+    constexpr uint32_t width = 70;
+    constexpr uint32_t height = 5;
+    std::vector<uint16_t> pixels;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (y == 0) {
+                pixels.push_back(0); // A run of black that is longer than the maximum run length
+            } else if (y == 1) {
+                pixels.push_back(toRgb565(x * 3, x * 3, x * 3)); // Small differences
+            } else if (y == 2) {
+                pixels.push_back(toRgb565(x * 3, 100 + x, 200 - x)); // Luma differences
+            } else if (y == 3) {
+                pixels.push_back(toRgb565(x * 37, x * 91, x * 13)); // Random colors
+            } else {
+                pixels.push_back(toRgb565(255, 255, 255) * (x % 2)); // Colors from the index, including black
+            }
+        }
+    }
+    Frame frame;
+    createFrame(frame, width, height, pixels);
+
+    std::vector<uint8_t> output;
+    CHECK(encode(frame, Format::Qoi, output));
+    CHECK_EQ(memcmp(output.data(), "qoif", 4), 0);
+    CHECK_EQ(output[12], 3);
+
+    uint32_t decoded_width, decoded_height;
+    auto decoded = decodeQoi(output, decoded_width, decoded_height);
+    CHECK_EQ(decoded_width, width);
+    CHECK_EQ(decoded_height, height);
+    REQUIRE_EQ(decoded.size(), width * height * 3);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        // The expanded 8-bit channels map back to the same 565 value
+        CAPTURE(i);
+        CHECK_EQ(toRgb565(decoded[i * 3], decoded[i * 3 + 1], decoded[i * 3 + 2]), pixels[i]);
+    }
+    // White must be fully white after expansion
+    CHECK_EQ(decoded[(4 * width + 1) * 3], 255);
+}
+
+TEST_CASE("encodeRaw writes a header and the pixels without padding") {
+    const std::vector<uint16_t> pixels = { 1, 2, 3, 4, 5, 6 };
+    Frame frame;
+    createFrame(frame, 3, 2, pixels);
+
+    std::vector<uint8_t> output;
+    CHECK(encode(frame, Format::Raw, output));
+    REQUIRE_EQ(output.size(), 12 + (pixels.size() * 2));
+    CHECK_EQ(memcmp(output.data(), RAW_MAGIC, 4), 0);
+    CHECK_EQ(output[4], 3);
+    CHECK_EQ(output[6], 2);
+    CHECK_EQ(memcmp(output.data() + 12, pixels.data(), pixels.size() * 2), 0);
+}
+
+TEST_CASE("findChangedArea returns the bounding box of the changes") {
+    std::vector<uint16_t> pixels(8 * 6, 0x1234);
+    Frame previous;
+    createFrame(previous, 8, 6, pixels);
+
+    Frame current;
+    createFrame(current, 8, 6, pixels);
+    CHECK(findChangedArea(previous, current).isEmpty());
+
+    pixels[(1 * 8) + 5] = 0;
+    pixels[(3 * 8) + 2] = 0;
+    createFrame(current, 8, 6, pixels);
+    auto area = findChangedArea(previous, current);
+    CHECK_EQ(area.x, 2);
+    CHECK_EQ(area.y, 1);
+    CHECK_EQ(area.width, 4);
+    CHECK_EQ(area.height, 3);
+
+    // The edges of the screen
+    pixels[0] = 0;
+    pixels[(6 * 8) - 1] = 0;
+    createFrame(current, 8, 6, pixels);
+    area = findChangedArea(previous, current);
+    CHECK_EQ(area.x, 0);
+    CHECK_EQ(area.y, 0);
+    CHECK_EQ(area.width, 8);
+    CHECK_EQ(area.height, 6);
+
+    // A different size (e.g. the first frame of a sequence) returns the full area
+    Frame empty;
+    area = findChangedArea(empty, current);
+    CHECK_EQ(area.width, 8);
+    CHECK_EQ(area.height, 6);
+}
+
+TEST_CASE("encodeSequenceFrame stores only the changed area") {
+    std::vector<uint16_t> pixels(4 * 4);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = i;
+    }
+    Frame frame;
+    createFrame(frame, 4, 4, pixels);
+
+    std::vector<uint8_t> output;
+    encodeSequenceHeader(4, 4, 100, output);
+    CHECK_EQ(output.size(), 12);
+    CHECK_EQ(memcmp(output.data(), SEQUENCE_MAGIC, 4), 0);
+    CHECK_EQ(output[8], 100);
+
+    encodeSequenceFrame(frame, { .x = 1, .y = 2, .width = 2, .height = 2 }, 500, output);
+    REQUIRE_EQ(output.size(), 12 + 12 + 8);
+    CHECK_EQ(output[12], 500 & 0xFF);
+    CHECK_EQ(output[13], 500 >> 8);
+    const uint16_t expected[] = { 9, 10, 13, 14 };
+    CHECK_EQ(memcmp(output.data() + 24, expected, sizeof(expected)), 0);
+}
@@ -0,0 +1,198 @@
+#include "doctest.h"
+#include <Tactility/Mutex.h>
+#include <Tactility/kernel/Kernel.h>
+#include <Tactility/service/ServiceStartup.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+using namespace tt;
+using namespace tt::service;
+
+typedef std::vector<std::shared_ptr<const ServiceManifest>> ManifestList;
+
+static std::shared_ptr<const ServiceManifest> createManifest(const std::string& id, std::vector<std::string> dependencies = {}) {
+    return std::make_shared<const ServiceManifest>(ServiceManifest {
+        .id = id,
+        .dependencies = std::move(dependencies)
+    });
+}
+
+/** Starts services by waiting, so the test can verify which services start at the same time */
+class FakeServices {
+
+    Mutex mutex;
+    std::set<std::string> started;
+    size_t runningCount = 0;
+
+public:
+
+    std::map<std::string, uint32_t> startMillis;
+    std::set<std::string> failing;
+    std::vector<std::string> dependencyErrors;
+    std::map<std::string, std::vector<std::string>> dependencies;
+    size_t maxRunningCount = 0;
+
+    bool start(const std::string& id) {
+        mutex.lock();
+        for (const auto& dependency : dependencies[id]) {
+            if (!started.contains(dependency)) {
+                dependencyErrors.push_back(id);
+            }
+        }
+        runningCount++;
+        maxRunningCount = std::max(maxRunningCount, runningCount);
+        mutex.unlock();
+
+        kernel::delayMillis(startMillis[id]);
+
+        mutex.lock();
+        runningCount--;
+        bool success = !failing.contains(id);
+        if (success) {
+            started.insert(id);
+        }
+        mutex.unlock();
+        return success;
+    }
+
+    StartServiceFunction function() {
+        return [this](const std::string& id) { return start(id); };
+    }
+
+    ManifestList createManifests(const std::map<std::string, std::vector<std::string>>& graph, uint32_t millis) {
+        ManifestList manifests;
+        for (const auto& [id, service_dependencies] : graph) {
+            manifests.push_back(createManifest(id, service_dependencies));
+            dependencies[id] = service_dependencies;
+            startMillis[id] = millis;
+        }
+        return manifests;
+    }
+};
+
+static const ServiceStartRecord* findRecord(const std::vector<ServiceStartRecord>& records, const std::string& id) {
+    auto iterator = std::find_if(records.begin(), records.end(), [&id](const auto& record) { return record.id == id; });
+    return iterator != records.end() ? &*iterator : nullptr;
+}
+
+TEST_CASE("startServices starts dependencies first") {
+    FakeServices services;
+    auto manifests = services.createManifests({
+        { "a", {} },
+        { "b", { "a" } },
+        { "c", { "a" } },
+        { "d", { "b", "c" } },
+        { "e", {} }
+    }, 10);
+
+    std::vector<ServiceStartRecord> records;
+    CHECK(startServices(manifests, 3, records, services.function()));
+
+    CHECK_EQ(records.size(), 5);
+    CHECK(services.dependencyErrors.empty());
+    CHECK(std::all_of(records.begin(), records.end(), [](const auto& record) { return record.success; }));
+    CHECK_GE(findRecord(records, "d")->startTime, findRecord(records, "b")->endTime);
+    CHECK_GE(findRecord(records, "d")->startTime, findRecord(records, "c")->endTime);
+}
+
+TEST_CASE("startServices limits the amount of services that start at the same time") {
+    FakeServices services;
+    auto manifests = services.createManifests({
+        { "a", {} },
+        { "b", {} },
+        { "c", {} },
+        { "d", {} },
+        { "e", {} },
+        { "f", {} }
+    }, 20);
+
+    std::vector<ServiceStartRecord> records;
+    const auto start_time = kernel::getMicros();
+    CHECK(startServices(manifests, 2, records, services.function()));
+    const auto duration = kernel::getMicros() - start_time;
+
+    CHECK_EQ(services.maxRunningCount, 2);
+    // 3 rounds of 2 services instead of 6 sequential starts
+    CHECK_GE(duration, 3 * 20000);
+    CHECK_LT(duration, 6 * 20000);
+}
+
+TEST_CASE("startServices accepts dependencies outside of the list that are running") {
+    FakeServices services;
+    ManifestList manifests = { createManifest("a", { "Started earlier" }) };
+    std::vector<ServiceStartRecord> records;
+    auto is_started = [](const std::string& id) { return id == "Started earlier"; };
+    CHECK(startServices(manifests, 1, records, services.function(), is_started));
+    REQUIRE_EQ(records.size(), 1);
+    CHECK(records[0].success);
+}
+
+TEST_CASE("startServices doesn't start services when a dependency outside of the list isn't running") {
+    FakeServices services;
+    ManifestList manifests = {
+        createManifest("a", { "Not started" }),
+        createManifest("b", { "a" }),
+        createManifest("c")
+    };
+    std::vector<ServiceStartRecord> records;
+    auto is_started = [](const std::string& id) { return false; };
+    CHECK_FALSE(startServices(manifests, 1, records, services.function(), is_started));
+    REQUIRE_EQ(records.size(), 3);
+    CHECK_FALSE(findRecord(records, "a")->success);
+    CHECK_FALSE(findRecord(records, "b")->success);
+    CHECK(findRecord(records, "c")->success);
+}
+
+TEST_CASE("startServices doesn't start services when a dependency fails") {
+    FakeServices services;
+    auto manifests = services.createManifests({
+        { "a", {} },
+        { "b", { "a" } },
+        { "c", { "b" } },
+        { "d", {} }
+    }, 1);
+    services.failing = { "a" };
+
+    std::vector<ServiceStartRecord> records;
+    CHECK_FALSE(startServices(manifests, 2, records, services.function()));
+
+    REQUIRE_EQ(records.size(), 4);
+    CHECK_FALSE(findRecord(records, "a")->success);
+    CHECK_FALSE(findRecord(records, "b")->success);
+    CHECK_FALSE(findRecord(records, "c")->success);
+    CHECK(findRecord(records, "d")->success);
+    // Services with a failed dependency are never started
+    CHECK_EQ(findRecord(records, "c")->startTime, findRecord(records, "c")->endTime);
+}
+
+TEST_CASE("startServices fails services with circular dependencies") {
+    FakeServices services;
+    auto manifests = services.createManifests({
+        { "a", {} },
+        { "b", { "c" } },
+        { "c", { "b" } }
+    }, 1);
+
+    std::vector<ServiceStartRecord> records;
+    CHECK_FALSE(startServices(manifests, 2, records, services.function()));
+
+    REQUIRE_EQ(records.size(), 3);
+    CHECK(findRecord(records, "a")->success);
+    CHECK_FALSE(findRecord(records, "b")->success);
+    CHECK_FALSE(findRecord(records, "c")->success);
+}
+
+TEST_CASE("formatBootTimeline writes CSV") {
+    std::vector<ServiceStartRecord> records = {
+        { .id = "FileIo", .phase = StartPhase::System, .startTime = 1000, .endTime = 1500, .success = true },
+        { .id = "Gui", .phase = StartPhase::Gui, .startTime = 2000, .endTime = 4000, .success = false }
+    };
+    CHECK_EQ(
+        formatBootTimeline(records),
+        "id,phase,start_us,end_us,duration_us,success\n"
+        "FileIo,System,1000,1500,500,1\n"
+        "Gui,Gui,2000,4000,2000,0\n"
+    );
+}
@@ -0,0 +1,48 @@
+#include "doctest.h"
+#include <Tactility/hal/spi/SpiArbitration.h>
+
+using namespace tt::hal::spi;
+
+TEST_CASE("SpiArbitration gives the bus to the highest priority first") {
+    SpiArbitration arbitration(8000);
+    arbitration.addWaiter(BusPriority::Storage);
+    arbitration.addWaiter(BusPriority::Render);
+
+    CHECK_FALSE(arbitration.canAcquire(BusPriority::Storage));
+    CHECK(arbitration.canAcquire(BusPriority::Render));
+
+    arbitration.removeWaiter(BusPriority::Render);
+    arbitration.onAcquired(BusPriority::Render, 0);
+    CHECK_FALSE(arbitration.canAcquire(BusPriority::Storage));
+    CHECK_FALSE(arbitration.canAcquire(BusPriority::Render));
+
+    arbitration.onReleased(1000);
+    CHECK(arbitration.canAcquire(BusPriority::Storage));
+}
+
+TEST_CASE("SpiArbitration asks the holder to yield for a higher priority") {
+    SpiArbitration arbitration(8000);
+    arbitration.onAcquired(BusPriority::Input, 0);
+    arbitration.addWaiter(BusPriority::Storage);
+    CHECK_FALSE(arbitration.shouldYield(100));
+
+    arbitration.addWaiter(BusPriority::Render);
+    CHECK(arbitration.shouldYield(100));
+}
+
+TEST_CASE("SpiArbitration asks the holder to yield when the hold budget is used") {
+    SpiArbitration arbitration(8000);
+    arbitration.onAcquired(BusPriority::Storage, 1000);
+    CHECK_FALSE(arbitration.shouldYield(8999));
+    CHECK(arbitration.shouldYield(9000));
+    CHECK_EQ(arbitration.onReleased(10000), 9000);
+    CHECK_FALSE(arbitration.shouldYield(20000));
+}
+
+TEST_CASE("SpiArbitration handles a wrapping clock") {
+    SpiArbitration arbitration(8000);
+    arbitration.onAcquired(BusPriority::Storage, UINT32_MAX - 1000);
+    CHECK_EQ(arbitration.getHoldTime(2000), 3001);
+    CHECK_FALSE(arbitration.shouldYield(2000));
+    CHECK(arbitration.shouldYield(7000));
+}
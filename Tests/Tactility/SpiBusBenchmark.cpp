@@ -0,0 +1,115 @@
+#include "doctest.h"
+#include <Tactility/hal/spi/SpiArbitration.h>
+
+#include <algorithm>
+
+using namespace tt::hal::spi;
+
+constexpr uint32_t FRAME_PERIOD_MICROS = 16667;
+/** A full frame of 320x240 RGB565 at 40 MHz */
+constexpr uint32_t FLUSH_MICROS = 4000;
+/** A 4 kB SD card block at 20 MHz, including the command overhead */
+constexpr uint32_t CHUNK_MICROS = 2000;
+/** The delay of SpiArbiter::yield(), so users of the bus that aren't known to the arbiter can take it */
+constexpr uint32_t YIELD_GAP_MICROS = 1000;
+
+struct BusSimulationResult {
+    uint32_t frames = 0;
+    uint32_t maxFrameLatency = 0;
+    uint64_t totalFrameLatency = 0;
+    uint64_t storageEndTime = 0;
+    uint32_t yields = 0;
+};
+
+/**
+ * Replays a display that flushes every frame period, while an SD card copies a file of chunkCount chunks.
+ * Without arbitration, the SD card holds the bus for the whole file, like a copy under the bus lock used to do.
+ * With arbitration, it yields the bus at chunk boundaries when SpiArbitration asks for it.
+ */
+static BusSimulationResult simulate(bool arbitrated, uint32_t chunkCount, uint64_t duration) {
+    SpiArbitration arbitration(8000);
+    BusSimulationResult result;
+    uint64_t time = 0;
+    uint64_t next_frame_time = 0;
+    uint64_t frame_ready_time = 0;
+    bool frame_waiting = false;
+    uint64_t storage_resume_time = 0;
+    bool storage_holds = false;
+    uint32_t chunks_left = chunkCount;
+
+    auto update_frame = [&] {
+        if (!frame_waiting && time >= next_frame_time) {
+            frame_waiting = true;
+            frame_ready_time = next_frame_time;
+            next_frame_time += FRAME_PERIOD_MICROS;
+            arbitration.addWaiter(BusPriority::Render);
+        }
+    };
+
+    while (time < duration) {
+        update_frame();
+
+        if (storage_holds) {
+            time += CHUNK_MICROS;
+            chunks_left--;
+            update_frame();
+            if (chunks_left == 0) {
+                arbitration.onReleased(time);
+                storage_holds = false;
+                result.storageEndTime = time;
+            } else if (arbitrated && arbitration.shouldYield(time)) {
+                arbitration.onReleased(time);
+                storage_holds = false;
+                storage_resume_time = time + YIELD_GAP_MICROS;
+                result.yields++;
+            }
+        } else if (frame_waiting && arbitration.canAcquire(BusPriority::Render)) {
+            arbitration.removeWaiter(BusPriority::Render);
+            arbitration.onAcquired(BusPriority::Render, time);
+            const auto latency = static_cast<uint32_t>(time - frame_ready_time);
+            result.frames++;
+            result.totalFrameLatency += latency;
+            result.maxFrameLatency = std::max(result.maxFrameLatency, latency);
+            time += FLUSH_MICROS;
+            arbitration.onReleased(time);
+            frame_waiting = false;
+        } else if (chunks_left > 0 && time >= storage_resume_time && arbitration.canAcquire(BusPriority::Storage)) {
+            arbitration.onAcquired(BusPriority::Storage, time);
+            storage_holds = true;
+        } else {
+            // Idle until the next frame or until the storage continues
+            uint64_t next_time = next_frame_time;
+            if (chunks_left > 0 && storage_resume_time > time) {
+                next_time = std::min(next_time, storage_resume_time);
+            }
+            time = std::max(next_time, time + 1);
+        }
+    }
+
+    return result;
+}
+
+/** Copy a 1 MB file while the display renders at 60 fps */
+TEST_CASE("SPI bus frame jitter benchmark") {
+    constexpr uint32_t CHUNK_COUNT = 256;
+    constexpr uint64_t DURATION = 2000000;
+    const auto legacy = simulate(false, CHUNK_COUNT, DURATION);
+    const auto arbitrated = simulate(true, CHUNK_COUNT, DURATION);
+
+    MESSAGE(
+        "Without arbitration: ", legacy.frames, " frames, max latency ", legacy.maxFrameLatency, " us, mean ",
+        legacy.totalFrameLatency / legacy.frames, " us, copy done at ", legacy.storageEndTime / 1000, " ms"
+    );
+    MESSAGE(
+        "With arbitration: ", arbitrated.frames, " frames, max latency ", arbitrated.maxFrameLatency, " us, mean ",
+        arbitrated.totalFrameLatency / arbitrated.frames, " us, copy done at ", arbitrated.storageEndTime / 1000, " ms, ",
+        arbitrated.yields, " yields"
+    );
+
+    // A frame waits for at most one chunk, instead of the whole file
+    CHECK_LE(arbitrated.maxFrameLatency, CHUNK_MICROS);
+    CHECK_GT(legacy.maxFrameLatency, 10 * FRAME_PERIOD_MICROS);
+    // The copy still finishes, but it shares the bus with the display
+    CHECK_GT(arbitrated.storageEndTime, 0);
+    CHECK_LT(arbitrated.storageEndTime, legacy.storageEndTime * 2);
+}
@@ -0,0 +1,145 @@
+#include "doctest.h"
+
+#include <Tactility/file/File.h>
+#include <Tactility/file/TarStream.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tt;
+using tt::file::TarStreamExtractor;
+
+constexpr auto* DESTINATION_PATH = "tarstream_test";
+
+static void appendTarEntry(std::vector<uint8_t>& archive, const std::string& path, char type, const std::string& content = "") {
+    uint8_t header[512] = {};
+    memcpy(header, path.c_str(), std::min<size_t>(path.size(), 100));
+    snprintf(reinterpret_cast<char*>(header + 100), 8, "%07o", 0644);
+    snprintf(reinterpret_cast<char*>(header + 124), 12, "%011o", static_cast<unsigned int>(content.size()));
+    header[156] = type;
+    memcpy(header + 257, "ustar\00000", 8);
+    memset(header + 148, ' ', 8);
+
+    unsigned int checksum = 0;
+    for (auto byte : header) {
+        checksum += byte;
+    }
+    snprintf(reinterpret_cast<char*>(header + 148), 8, "%06o", checksum);
+
+    archive.insert(archive.end(), header, header + sizeof(header));
+    archive.insert(archive.end(), content.begin(), content.end());
+    archive.resize((archive.size() + 511) / 512 * 512);
+}
+
+static void appendTarEnd(std::vector<uint8_t>& archive) {
+    archive.resize(archive.size() + 1024);
+}
+
+/** Feed the archive in parts with varying sizes, like a network stream would */
+static bool extract(TarStreamExtractor& extractor, const std::vector<uint8_t>& archive) {
+    size_t offset = 0;
+    size_t part_size = 1;
+    while (offset < archive.size()) {
+        auto length = std::min(part_size, archive.size() - offset);
+        if (!extractor.write(archive.data() + offset, length)) {
+            return false;
+        }
+        offset += length;
+        part_size = (part_size * 7 + 3) % 1500 + 1;
+    }
+    return extractor.finish();
+}
+
+static std::string readFile(const std::string& path) {
+    auto data = file::readString(path);
+    return (data != nullptr) ? std::string(reinterpret_cast<const char*>(data.get())) : std::string();
+}
+
+TEST_CASE("TarStreamExtractor extracts files and directories") {
+    file::deleteRecursively(DESTINATION_PATH);
+    REQUIRE(file::findOrCreateDirectory(DESTINATION_PATH, 0777));
+
+    std::string large_content;
+    for (int i = 0; i < 5000; ++i) {
+        large_content += static_cast<char>('a' + (i % 26));
+    }
+
+    std::vector<uint8_t> archive;
+    appendTarEntry(archive, "./", '5');
+    appendTarEntry(archive, "./manifest.properties", '0', "[app]\nid=one.tactility.test\n");
+    appendTarEntry(archive, "./assets/", '5');
+    appendTarEntry(archive, "./assets/large.txt", '0', large_content);
+    appendTarEntry(archive, "./assets/empty.txt", '0');
+    // Parent directory without an entry of its own
+    appendTarEntry(archive, "./data/nested/file.txt", '0', "nested");
+    appendTarEnd(archive);
+
+    // A small buffer makes sure that files are written in multiple blocks
+    TarStreamExtractor extractor(DESTINATION_PATH, 1024);
+    CHECK_EQ(extract(extractor, archive), true);
+    CHECK_EQ(extractor.getEntryCount(), 5);
+
+    CHECK_EQ(readFile(std::string(DESTINATION_PATH) + "/manifest.properties"), "[app]\nid=one.tactility.test\n");
+    CHECK_EQ(readFile(std::string(DESTINATION_PATH) + "/assets/large.txt"), large_content);
+    CHECK_EQ(file::isFile(std::string(DESTINATION_PATH) + "/assets/empty.txt"), true);
+    CHECK_EQ(readFile(std::string(DESTINATION_PATH) + "/data/nested/file.txt"), "nested");
+
+    file::deleteRecursively(DESTINATION_PATH);
+}
+
+TEST_CASE("TarStreamExtractor supports GNU long names") {
+    file::deleteRecursively(DESTINATION_PATH);
+    REQUIRE(file::findOrCreateDirectory(DESTINATION_PATH, 0777));
+
+    std::string long_name = "directory/" + std::string(120, 'x') + ".txt";
+    std::vector<uint8_t> archive;
+    appendTarEntry(archive, "././@LongLink", 'L', long_name + '\0');
+    appendTarEntry(archive, long_name.substr(0, 100), '0', "long");
+    appendTarEnd(archive);
+
+    TarStreamExtractor extractor(DESTINATION_PATH);
+    CHECK_EQ(extract(extractor, archive), true);
+    CHECK_EQ(readFile(std::string(DESTINATION_PATH) + "/" + long_name), "long");
+
+    file::deleteRecursively(DESTINATION_PATH);
+}
+
+TEST_CASE("TarStreamExtractor rejects paths outside of the destination") {
+    file::deleteRecursively(DESTINATION_PATH);
+    REQUIRE(file::findOrCreateDirectory(DESTINATION_PATH, 0777));
+
+    std::vector<uint8_t> archive;
+    appendTarEntry(archive, "../escaped.txt", '0', "escaped");
+    appendTarEnd(archive);
+
+    TarStreamExtractor extractor(DESTINATION_PATH);
+    CHECK_EQ(extract(extractor, archive), false);
+    CHECK_EQ(file::isFile("escaped.txt"), false);
+
+    file::deleteRecursively(DESTINATION_PATH);
+}
+
+TEST_CASE("TarStreamExtractor rejects corrupt and incomplete archives") {
+    file::deleteRecursively(DESTINATION_PATH);
+    REQUIRE(file::findOrCreateDirectory(DESTINATION_PATH, 0777));
+
+    std::vector<uint8_t> archive;
+    appendTarEntry(archive, "file.txt", '0', std::string(2000, 'a'));
+    appendTarEnd(archive);
+
+    SUBCASE("Corrupt header") {
+        auto corrupt_archive = archive;
+        corrupt_archive[0] = 'F';
+        TarStreamExtractor extractor(DESTINATION_PATH);
+        CHECK_EQ(extract(extractor, corrupt_archive), false);
+    }
+
+    SUBCASE("Truncated data") {
+        auto truncated_archive = std::vector<uint8_t>(archive.begin(), archive.begin() + 1000);
+        TarStreamExtractor extractor(DESTINATION_PATH);
+        CHECK_EQ(extract(extractor, truncated_archive), false);
+    }
+
+    file::deleteRecursively(DESTINATION_PATH);
+}
@@ -0,0 +1,82 @@
+#include "doctest.h"
+#include <Tactility/app/timezone/TimeZoneIndex.h>
+#include <Tactility/StringUtils.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdio>
+#include <string>
+
+using namespace tt;
+using namespace tt::app::timezone;
+
+static std::string getTimeZonesPath() {
+    std::string path = __FILE__;
+    return path.substr(0, path.rfind('/')) + "/../../Data/system/timezones.csv";
+}
+
+/** The search of the original TimeZone app: read and parse the file for every query */
+static size_t searchFile(const std::string& path, const std::string& filter) {
+    auto* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return 0;
+    }
+    char line[96];
+    size_t count = 0;
+    while (fgets(line, 96, file)) {
+        std::string input = line;
+        std::string partial_strip = input.substr(1, input.size() - 3);
+        auto first_end_quote = partial_strip.find('"');
+        if (first_end_quote != std::string::npos) {
+            auto name = partial_strip.substr(0, first_end_quote);
+            if (string::lowercase(name).find(filter) != std::string::npos) {
+                count++;
+            }
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+TEST_CASE("timezone search benchmark") {
+    const auto path = getTimeZonesPath();
+    TimeZoneIndex index;
+    REQUIRE(index.load(path));
+
+    // Typing "europe/amsterdam", removing it and typing "new_york"
+    std::vector<std::string> queries;
+    const std::string words[] = { "europe/amsterdam", "new_york" };
+    for (const auto& word : words) {
+        for (size_t length = 1; length <= word.size(); length++) {
+            queries.push_back(word.substr(0, length));
+        }
+        for (size_t length = word.size() - 1; length > 0; length--) {
+            queries.push_back(word.substr(0, length));
+        }
+    }
+
+    constexpr int ROUNDS = 20;
+
+    auto file_start = kernel::getMicros();
+    size_t file_results = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (const auto& query : queries) {
+            file_results += searchFile(path, query);
+        }
+    }
+    auto file_time = kernel::getMicros() - file_start;
+
+    auto index_start = kernel::getMicros();
+    size_t index_results = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        TimeZoneSearch search(index);
+        for (const auto& query : queries) {
+            search.setQuery(query);
+            index_results += search.getResults().size();
+        }
+    }
+    auto index_time = kernel::getMicros() - index_start;
+
+    const auto keystrokes = static_cast<double>(queries.size() * ROUNDS);
+    MESSAGE("Per keystroke: file ", file_time / keystrokes, " us, index ", index_time / keystrokes, " us");
+    CHECK_EQ(file_results, index_results);
+}
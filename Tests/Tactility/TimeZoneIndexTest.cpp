@@ -0,0 +1,75 @@
+#include "doctest.h"
+#include <Tactility/app/timezone/TimeZoneIndex.h>
+
+using namespace tt::app::timezone;
+
+constexpr auto* TEST_CSV =
+    "\"Europe/Amsterdam\",\"CET-1CEST,M3.5.0,M10.5.0/3\"\n"
+    "\"America/New_York\",\"EST5EDT,M3.2.0,M11.1.0\"\r\n"
+    "invalid line\n"
+    "\n"
+    "\"Africa/Abidjan\",\"GMT0\"\n"
+    "\"Europe/Berlin\",\"CET-1CEST,M3.5.0,M10.5.0/3\"";
+
+static std::vector<std::string> getNames(const TimeZoneIndex& index, const std::vector<uint16_t>& results) {
+    std::vector<std::string> names;
+    for (auto result : results) {
+        names.emplace_back(index.getName(result));
+    }
+    return names;
+}
+
+TEST_CASE("TimeZoneIndex parses and sorts entries") {
+    TimeZoneIndex index;
+    REQUIRE(index.parse(TEST_CSV));
+    REQUIRE_EQ(index.getCount(), 4);
+    CHECK_EQ(std::string(index.getName(0)), "Africa/Abidjan");
+    CHECK_EQ(std::string(index.getCode(0)), "GMT0");
+    CHECK_EQ(std::string(index.getName(1)), "America/New_York");
+    CHECK_EQ(std::string(index.getCode(1)), "EST5EDT,M3.2.0,M11.1.0");
+    CHECK_EQ(std::string(index.getName(3)), "Europe/Berlin");
+}
+
+TEST_CASE("TimeZoneIndex search is case insensitive and finds each entry once") {
+    TimeZoneIndex index;
+    REQUIRE(index.parse(TEST_CSV));
+    std::vector<uint16_t> results;
+
+    index.search("", results);
+    CHECK_EQ(results.size(), 4);
+
+    // "e" occurs multiple times in most names
+    index.search("e", results);
+    CHECK_EQ(getNames(index, results), std::vector<std::string> { "America/New_York", "Europe/Amsterdam", "Europe/Berlin" });
+
+    index.search("europe/", results);
+    CHECK_EQ(getNames(index, results), std::vector<std::string> { "Europe/Amsterdam", "Europe/Berlin" });
+
+    // Matches don't span multiple names
+    index.search("jana", results);
+    CHECK(results.empty());
+
+    index.search("jan", results);
+    CHECK_EQ(getNames(index, results), std::vector<std::string> { "Africa/Abidjan" });
+}
+
+TEST_CASE("TimeZoneSearch refines and resets results") {
+    TimeZoneIndex index;
+    REQUIRE(index.parse(TEST_CSV));
+    TimeZoneSearch search(index);
+    CHECK_EQ(search.getResults().size(), 4);
+
+    CHECK(search.setQuery("E"));
+    CHECK_EQ(search.getResults().size(), 3);
+    CHECK(search.setQuery("Eu"));
+    CHECK_EQ(search.getResults().size(), 2);
+    CHECK_FALSE(search.setQuery("Eur"));
+    CHECK(search.setQuery("Eur/"));
+    CHECK(search.getResults().empty());
+
+    // Removing characters searches again
+    CHECK(search.setQuery("Ber"));
+    CHECK_EQ(getNames(index, search.getResults()), std::vector<std::string> { "Europe/Berlin" });
+    CHECK(search.setQuery(""));
+    CHECK_EQ(search.getResults().size(), 4);
+}
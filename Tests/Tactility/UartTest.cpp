@@ -0,0 +1,96 @@
+#include "doctest.h"
+#include <Tactility/hal/uart/UartPosix.h>
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace tt::hal;
+
+/** A pseudo-terminal pair: the UART opens the slave side while the test writes to the master side */
+class PseudoTerminal {
+
+    int master = -1;
+
+public:
+
+    PseudoTerminal() {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master != -1) {
+            grantpt(master);
+            unlockpt(master);
+        }
+    }
+
+    ~PseudoTerminal() {
+        if (master != -1) {
+            close(master);
+        }
+    }
+
+    bool isValid() const { return master != -1; }
+
+    std::string getSlaveName() const { return ptsname(master); }
+
+    void write(const std::string& data) const {
+        CHECK_EQ(::write(master, data.c_str(), data.size()), data.size());
+    }
+};
+
+TEST_CASE("uart readLine returns complete lines from a pty") {
+    PseudoTerminal terminal;
+    REQUIRE(terminal.isValid());
+    uart::Configuration configuration = { .name = terminal.getSlaveName(), .baudRate = 115200 };
+    uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+
+    terminal.write("$GPRMC,1\n$GPGGA,2\n$GP");
+
+    CHECK_EQ(uart.readLine(100), "$GPRMC,1\n");
+    CHECK_EQ(uart.readLine(100), "$GPGGA,2\n");
+    // Partial frame stays buffered
+    CHECK_EQ(uart.readLine(10), "");
+
+    terminal.write("VTG,3\n");
+    CHECK_EQ(uart.readLine(100), "$GPVTG,3\n");
+
+    auto statistics = uart.getReceiveStatistics();
+    CHECK_EQ(statistics.bytesReceived, 27);
+    CHECK_EQ(statistics.framesReceived, 3);
+    CHECK_EQ(statistics.overruns, 0);
+
+    uart.stop();
+}
+
+TEST_CASE("uart readFrame discards frames that don't fit in the receive buffer") {
+    PseudoTerminal terminal;
+    REQUIRE(terminal.isValid());
+    uart::Configuration configuration = { .name = terminal.getSlaveName(), .baudRate = 115200 };
+    uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+    uart.setReceiveBufferSize(8);
+
+    terminal.write("0123456789ABCDEF;ok;");
+
+    CHECK_EQ(uart.readFrame(';', 100), "ok;");
+    CHECK_EQ(uart.getReceiveStatistics().overruns, 2);
+
+    uart.stop();
+}
+
+TEST_CASE("uart readUntil copies a null-terminated line") {
+    PseudoTerminal terminal;
+    REQUIRE(terminal.isValid());
+    uart::Configuration configuration = { .name = terminal.getSlaveName(), .baudRate = 115200 };
+    uart::UartPosix uart(configuration);
+    REQUIRE(uart.start());
+
+    terminal.write("hello\n");
+
+    char buffer[16];
+    auto size = uart.readUntil(reinterpret_cast<std::byte*>(buffer), sizeof(buffer), '\n', 100);
+    CHECK_EQ(size, 5);
+    CHECK_EQ(std::string(buffer), "hello\n");
+
+    uart.stop();
+}
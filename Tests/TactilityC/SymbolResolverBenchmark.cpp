@@ -0,0 +1,115 @@
+#include "doctest.h"
+#include <symbols/SymbolResolver.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tt;
+using tt::c::SymbolResolver;
+
+/** The amount of symbols in each of the TactilityC tables, in the same order as the resolver uses them */
+constexpr size_t BENCHMARK_TABLE_SIZES[] = { 540, 40, 30, 30, 10, 20, 10 };
+constexpr size_t BENCHMARK_LOOKUP_COUNT = 20000;
+
+/** The resolver implementation before the index was added */
+static uintptr_t resolveLinear(const std::vector<const esp_elfsym*>& tables, const char* symbolName) {
+    for (const auto* symbols : tables) {
+        for (const auto* symbol = symbols; symbol->name != nullptr; symbol++) {
+            if (strcmp(symbol->name, symbolName) == 0) {
+                return reinterpret_cast<uintptr_t>(symbol->sym);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Symbol names of a real app can be replayed by setting SYMBOL_BENCHMARK_PATH to a file with one name per line.
+ * These can be exported with: readelf --relocs --wide app.elf | awk '{print $5}'
+ * Otherwise, names with a similar prefix structure as the LVGL and Tactility exports are generated.
+ */
+static std::vector<std::string> loadLookupNames(const std::vector<std::string>& exportedNames) {
+    std::vector<std::string> result;
+    auto* path = getenv("SYMBOL_BENCHMARK_PATH");
+    if (path != nullptr) {
+        std::ifstream stream(path);
+        std::string line;
+        while (std::getline(stream, line)) {
+            if (!line.empty()) {
+                result.push_back(line);
+            }
+        }
+        return result;
+    }
+
+    // Apps relocate a few symbols very often, and most symbols only a couple of times
+    uint32_t random = 12345;
+    for (size_t i = 0; i < BENCHMARK_LOOKUP_COUNT; ++i) {
+        random = random * 1103515245 + 12345;
+        auto value = (random >> 8) % 1000;
+        if (value < 10) {
+            result.push_back("unknown_symbol_" + std::to_string(value));
+        } else if (value < 500) {
+            result.push_back(exportedNames[value % 32]);
+        } else {
+            result.push_back(exportedNames[(random >> 4) % exportedNames.size()]);
+        }
+    }
+    return result;
+}
+
+TEST_CASE("SymbolResolver benchmark") {
+    std::vector<std::string> names;
+    for (size_t table = 0; table < std::size(BENCHMARK_TABLE_SIZES); ++table) {
+        for (size_t i = 0; i < BENCHMARK_TABLE_SIZES[table]; ++i) {
+            names.push_back("lv_obj_table" + std::to_string(table) + "_function_" + std::to_string(i));
+        }
+    }
+
+    std::vector<std::vector<esp_elfsym>> symbol_tables;
+    size_t name_index = 0;
+    for (auto table_size : BENCHMARK_TABLE_SIZES) {
+        auto& symbols = symbol_tables.emplace_back();
+        for (size_t i = 0; i < table_size; ++i) {
+            symbols.push_back({ names[name_index].c_str(), reinterpret_cast<const void*>(name_index + 1) });
+            name_index++;
+        }
+        symbols.push_back(ESP_ELFSYM_END);
+    }
+
+    std::vector<const esp_elfsym*> tables;
+    for (auto& symbols : symbol_tables) {
+        tables.push_back(symbols.data());
+    }
+
+    auto lookup_names = loadLookupNames(names);
+    REQUIRE_FALSE(lookup_names.empty());
+
+    auto start_time = kernel::getMicros();
+    uintptr_t linear_checksum = 0;
+    for (auto& name : lookup_names) {
+        linear_checksum += resolveLinear(tables, name.c_str());
+    }
+    auto linear_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    SymbolResolver resolver(tables);
+    auto index_duration = kernel::getMicros() - start_time;
+
+    start_time = kernel::getMicros();
+    uintptr_t resolver_checksum = 0;
+    for (auto& name : lookup_names) {
+        resolver_checksum += resolver.resolve(name.c_str());
+    }
+    auto resolver_duration = kernel::getMicros() - start_time;
+
+    CHECK_EQ(resolver_checksum, linear_checksum);
+
+    auto statistics = resolver.getStatistics();
+    MESSAGE(lookup_names.size(), " lookups in ", resolver.getSymbolCount(), " symbols: linear took ", linear_duration, " us, indexed took ", resolver_duration, " us (+", index_duration, " us for indexing)");
+    MESSAGE("Cache hits: ", statistics.cacheHits, ", misses: ", statistics.misses);
+}
@@ -0,0 +1,88 @@
+#include "doctest.h"
+#include <symbols/SymbolResolver.h>
+
+#include <string>
+#include <vector>
+
+using tt::c::SymbolResolver;
+
+extern "C" {
+
+static int first_function() { return 1; }
+static int second_function() { return 2; }
+static int third_function() { return 3; }
+static int duplicate_function() { return 4; }
+
+}
+
+static const esp_elfsym first_symbols[] = {
+    ESP_ELFSYM_EXPORT(first_function),
+    ESP_ELFSYM_EXPORT(second_function),
+    ESP_ELFSYM_END
+};
+
+static const esp_elfsym second_symbols[] = {
+    ESP_ELFSYM_EXPORT(third_function),
+    { "first_function", (void*)&duplicate_function },
+    ESP_ELFSYM_END
+};
+
+static const esp_elfsym empty_symbols[] = {
+    ESP_ELFSYM_END
+};
+
+TEST_CASE("SymbolResolver resolves symbols from all tables") {
+    SymbolResolver resolver({ first_symbols, empty_symbols, second_symbols });
+    CHECK_EQ(resolver.getSymbolCount(), 4);
+    CHECK_EQ(resolver.resolve("second_function"), reinterpret_cast<uintptr_t>(&second_function));
+    CHECK_EQ(resolver.resolve("third_function"), reinterpret_cast<uintptr_t>(&third_function));
+}
+
+TEST_CASE("SymbolResolver prefers the first table when a symbol is exported twice") {
+    SymbolResolver resolver({ first_symbols, second_symbols });
+    CHECK_EQ(resolver.resolve("first_function"), reinterpret_cast<uintptr_t>(&first_function));
+
+    SymbolResolver reversed_resolver({ second_symbols, first_symbols });
+    CHECK_EQ(reversed_resolver.resolve("first_function"), reinterpret_cast<uintptr_t>(&duplicate_function));
+}
+
+TEST_CASE("SymbolResolver returns 0 for unknown symbols") {
+    SymbolResolver resolver({ first_symbols, second_symbols });
+    CHECK_EQ(resolver.resolve("unknown_function"), 0);
+    CHECK_EQ(resolver.resolve(""), 0);
+    CHECK_EQ(resolver.resolve("first_functio"), 0);
+}
+
+TEST_CASE("SymbolResolver keeps statistics") {
+    SymbolResolver resolver({ first_symbols, second_symbols });
+    resolver.resolve("first_function");
+    resolver.resolve("first_function");
+    resolver.resolve("third_function");
+    resolver.resolve("unknown_function");
+
+    auto statistics = resolver.getStatistics();
+    CHECK_EQ(statistics.lookups, 4);
+    CHECK_EQ(statistics.cacheHits, 1);
+    CHECK_EQ(statistics.misses, 1);
+
+    resolver.resetStatistics();
+    CHECK_EQ(resolver.getStatistics().lookups, 0);
+}
+
+TEST_CASE("SymbolResolver resolves all symbols of a large table") {
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) {
+        names.push_back("symbol_" + std::to_string(i));
+    }
+
+    std::vector<esp_elfsym> symbols;
+    for (size_t i = 0; i < names.size(); ++i) {
+        symbols.push_back({ names[i].c_str(), reinterpret_cast<const void*>(i + 1) });
+    }
+    symbols.push_back(ESP_ELFSYM_END);
+
+    SymbolResolver resolver({ symbols.data() });
+    for (size_t i = 0; i < names.size(); ++i) {
+        CHECK_EQ(resolver.resolve(names[i].c_str()), i + 1);
+    }
+}
@@ -0,0 +1,202 @@
+#include "doctest.h"
+#include <Tactility/file/AssetPack.h>
+#include <Tactility/file/File.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+struct TestAsset {
+    std::string name;
+    std::vector<uint8_t> data;
+    file::AssetPack::EntryType type = file::AssetPack::EntryType::File;
+    bool compressed = false;
+    size_t originalSize = 0;
+};
+
+static uint32_t getHash(const std::string& name) {
+    uint32_t hash = 0x811C9DC5;
+    for (const char character : name) {
+        hash = (hash ^ static_cast<uint8_t>(character)) * 0x01000193;
+    }
+    return hash;
+}
+
+static void append(std::vector<uint8_t>& output, uint32_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        output.push_back((value >> (i * 8)) & 0xFF);
+    }
+}
+
+static void align(std::vector<uint8_t>& output) {
+    while (output.size() % 4 != 0) {
+        output.push_back(0);
+    }
+}
+
+/** Creates a pack like Buildscripts/asset-pack.py does */
+static std::vector<uint8_t> createPack(std::vector<TestAsset> assets) {
+    std::ranges::sort(assets, [](const auto& left, const auto& right) {
+        return getHash(left.name) < getHash(right.name);
+    });
+
+    const uint32_t names_offset = 16 + 24 * assets.size();
+    std::vector<uint8_t> names;
+    for (const auto& asset : assets) {
+        names.insert(names.end(), asset.name.begin(), asset.name.end());
+    }
+
+    uint32_t data_offset = (names_offset + names.size() + 3) & ~3;
+    std::vector<uint8_t> pack = { 'T', 'T', 'A', 'P' };
+    append(pack, 1, 2);
+    append(pack, 0, 2);
+    append(pack, assets.size(), 4);
+    append(pack, names_offset, 4);
+
+    uint32_t name_offset = names_offset;
+    for (const auto& asset : assets) {
+        append(pack, getHash(asset.name), 4);
+        append(pack, name_offset, 4);
+        append(pack, asset.name.length(), 2);
+        append(pack, static_cast<uint8_t>(asset.type), 1);
+        append(pack, asset.compressed ? 1 : 0, 1);
+        append(pack, data_offset, 4);
+        append(pack, asset.data.size(), 4);
+        append(pack, (asset.originalSize != 0) ? asset.originalSize : asset.data.size(), 4);
+        name_offset += asset.name.length();
+        data_offset += (asset.data.size() + 3) & ~3;
+    }
+
+    pack.insert(pack.end(), names.begin(), names.end());
+    align(pack);
+    for (const auto& asset : assets) {
+        pack.insert(pack.end(), asset.data.begin(), asset.data.end());
+        align(pack);
+    }
+
+    return pack;
+}
+
+static std::vector<uint8_t> toData(const std::string& text) {
+    return { text.begin(), text.end() };
+}
+
+// "abc" followed by a match of 9 bytes at offset 3 and the last literal "d"
+static const std::vector<uint8_t> compressedData = { 0x35, 'a', 'b', 'c', 0x03, 0x00, 0x10, 'd' };
+static const std::string decompressedText = "abcabcabcabcd";
+
+TEST_CASE("AssetPack finds entries by name") {
+    auto data = createPack({
+        { .name = "timezones.csv", .data = toData("Europe/Amsterdam,CET-1CEST,M3.5.0,M10.5.0/3\n") },
+        { .name = "app/Launcher/assets/icon_apps.png", .data = { 0x19, 0x10 }, .type = file::AssetPack::EntryType::Image }
+    });
+    file::AssetPack pack(data.data(), data.size());
+    CHECK_EQ(pack.isValid(), true);
+    CHECK_EQ(pack.getEntryCount(), 2);
+
+    file::AssetPack::Entry entry;
+    CHECK_EQ(pack.find("timezones.csv", entry), true);
+    CHECK_EQ(entry.type, file::AssetPack::EntryType::File);
+    CHECK_EQ(entry.compressed, false);
+    CHECK_EQ(std::string(reinterpret_cast<const char*>(entry.data), entry.size), "Europe/Amsterdam,CET-1CEST,M3.5.0,M10.5.0/3\n");
+
+    CHECK_EQ(pack.find("app/Launcher/assets/icon_apps.png", entry), true);
+    CHECK_EQ(entry.type, file::AssetPack::EntryType::Image);
+    CHECK_EQ(entry.size, 2);
+    CHECK_EQ(entry.data[0], 0x19);
+}
+
+TEST_CASE("AssetPack doesn't find missing entries") {
+    auto data = createPack({
+        { .name = "timezones.csv", .data = toData("UTC") }
+    });
+    file::AssetPack pack(data.data(), data.size());
+
+    file::AssetPack::Entry entry;
+    CHECK_EQ(pack.find("timezones", entry), false);
+    CHECK_EQ(pack.find("timezones.csv2", entry), false);
+    CHECK_EQ(pack.find("", entry), false);
+}
+
+TEST_CASE("AssetPack rejects invalid data") {
+    auto data = createPack({
+        { .name = "timezones.csv", .data = toData("UTC") }
+    });
+    data[0] = 'X';
+    file::AssetPack pack(data.data(), data.size());
+    CHECK_EQ(pack.isValid(), false);
+
+    file::AssetPack::Entry entry;
+    CHECK_EQ(pack.find("timezones.csv", entry), false);
+
+    file::AssetPack truncated_pack(data.data(), 8);
+    CHECK_EQ(truncated_pack.isValid(), false);
+}
+
+TEST_CASE("AssetPack rejects uncompressed entries with a different original size") {
+    auto data = createPack({
+        { .name = "timezones.csv", .data = toData("UTC"), .originalSize = 64 }
+    });
+    file::AssetPack pack(data.data(), data.size());
+    CHECK_EQ(pack.isValid(), true);
+
+    file::AssetPack::Entry entry;
+    CHECK_EQ(pack.find("timezones.csv", entry), false);
+}
+
+TEST_CASE("AssetPack calls the release function when it is destroyed") {
+    auto data = createPack({});
+    bool released = false;
+    {
+        file::AssetPack pack(data.data(), data.size(), [&released] { released = true; });
+        CHECK_EQ(pack.isValid(), true);
+        CHECK_EQ(released, false);
+    }
+    CHECK_EQ(released, true);
+}
+
+TEST_CASE("AssetPack decompresses LZ4 data") {
+    std::vector<uint8_t> output(decompressedText.length());
+    CHECK_EQ(file::AssetPack::decompress(compressedData.data(), compressedData.size(), output.data(), output.size()), true);
+    CHECK_EQ(std::string(output.begin(), output.end()), decompressedText);
+}
+
+TEST_CASE("AssetPack rejects invalid LZ4 data") {
+    std::vector<uint8_t> output(decompressedText.length());
+    // Output buffer too small
+    CHECK_EQ(file::AssetPack::decompress(compressedData.data(), compressedData.size(), output.data(), output.size() - 1), false);
+    // Truncated input
+    CHECK_EQ(file::AssetPack::decompress(compressedData.data(), 5, output.data(), output.size()), false);
+    // Match offset before the start of the output
+    std::vector<uint8_t> invalid_offset = compressedData;
+    invalid_offset[4] = 0x04;
+    CHECK_EQ(file::AssetPack::decompress(invalid_offset.data(), invalid_offset.size(), output.data(), output.size()), false);
+}
+
+TEST_CASE("File functions read from the asset pack") {
+    auto data = createPack({
+        { .name = "lines.txt", .data = toData("first\nsecond\n") },
+        { .name = "compressed.txt", .data = compressedData, .compressed = true, .originalSize = decompressedText.length() }
+    });
+    file::setAssetPack("/assetpacktest", std::make_shared<file::AssetPack>(data.data(), data.size()));
+
+    CHECK_EQ(file::isFile("/assetpacktest/lines.txt"), true);
+    CHECK_EQ(file::isFile("/assetpacktest/missing.txt"), false);
+
+    auto text = file::readString("/assetpacktest/compressed.txt");
+    CHECK_NE(text, nullptr);
+    CHECK_EQ(std::string(reinterpret_cast<const char*>(text.get())), decompressedText);
+
+    std::vector<std::string> lines;
+    CHECK_EQ(file::readLines("/assetpacktest/lines.txt", true, [&lines](const char* line) {
+        lines.push_back(line);
+    }), true);
+    CHECK_EQ(lines.size(), 2);
+    CHECK_EQ(lines[0], "first");
+    CHECK_EQ(lines[1], "second");
+
+    file::setAssetPack("", nullptr);
+    CHECK_EQ(file::isFile("/assetpacktest/lines.txt"), false);
+}
@@ -0,0 +1,39 @@
+#include "doctest.h"
+#include <Tactility/TactilityCore.h>
+#include <Tactility/Dispatcher.h>
+#include <Tactility/RingDispatcher.h>
+
+using namespace tt;
+
+constexpr int BENCHMARK_ROUNDS = 200;
+constexpr int BENCHMARK_BATCH_SIZE = 64;
+
+template<typename DispatcherType>
+static long benchmarkDispatcher(DispatcherType& dispatcher, int& counter) {
+    auto start_time = kernel::getMicros();
+    for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for (int i = 0; i < BENCHMARK_BATCH_SIZE; i++) {
+            dispatcher.dispatch([&counter]() { counter++; });
+        }
+        while (dispatcher.consume(0) > 0) {}
+    }
+    return kernel::getMicros() - start_time;
+}
+
+TEST_CASE("dispatcher benchmark: Dispatcher vs RingDispatcher") {
+    constexpr int expected_count = BENCHMARK_ROUNDS * BENCHMARK_BATCH_SIZE;
+
+    int dispatcher_counter = 0;
+    Dispatcher dispatcher;
+    auto dispatcher_time = benchmarkDispatcher(dispatcher, dispatcher_counter);
+    CHECK_EQ(dispatcher_counter, expected_count);
+
+    int ring_counter = 0;
+    RingDispatcher ring_dispatcher(BENCHMARK_BATCH_SIZE);
+    auto ring_time = benchmarkDispatcher(ring_dispatcher, ring_counter);
+    CHECK_EQ(ring_counter, expected_count);
+    CHECK_EQ(ring_dispatcher.getStatistics().rejected, 0);
+
+    MESSAGE("Dispatcher: ", dispatcher_time * 1000 / expected_count, " ns per function");
+    MESSAGE("RingDispatcher: ", ring_time * 1000 / expected_count, " ns per function");
+}
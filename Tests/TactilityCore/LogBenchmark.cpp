@@ -0,0 +1,60 @@
+#include "doctest.h"
+#include <Tactility/LogBuffer.h>
+#include <Tactility/kernel/Kernel.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace tt;
+
+constexpr int BENCHMARK_MESSAGE_COUNT = 2000;
+
+/** The formatting that the simulator did on the caller's thread, before the LogBuffer was introduced */
+static void logDirectly(FILE* output, const char* tag, const char* format, ...) {
+    std::stringstream buffer;
+    buffer << kernel::getMicros() << " [" << "\033[32m" << 'I' << "\033[0m" << "] [" << tag << "] " << "\033[0m" << format << "\033[0m\n";
+    va_list args;
+    va_start(args, format);
+    vfprintf(output, buffer.str().c_str(), args);
+    va_end(args);
+}
+
+static void logDeferred(LogBuffer& buffer, const char* tag, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    buffer.add(LogLevel::Info, kernel::getMicros(), tag, format, args);
+    va_end(args);
+}
+
+TEST_CASE("log benchmark: direct formatting vs LogBuffer") {
+    FILE* output = fopen("/dev/null", "w");
+    REQUIRE_NE(output, nullptr);
+
+    auto start_time = kernel::getMicros();
+    for (int i = 0; i < BENCHMARK_MESSAGE_COUNT; i++) {
+        logDirectly(output, "benchmark", "message %d of %s: %f", i, "benchmark", 1.5);
+    }
+    auto direct_time = kernel::getMicros() - start_time;
+
+    // Large enough to not drop messages
+    LogBuffer buffer(256 * 1024);
+    start_time = kernel::getMicros();
+    for (int i = 0; i < BENCHMARK_MESSAGE_COUNT; i++) {
+        logDeferred(buffer, "benchmark", "message %d of %s: %f", i, "benchmark", 1.5);
+    }
+    auto deferred_time = kernel::getMicros() - start_time;
+    CHECK_EQ(buffer.getStatistics().dropped, 0);
+
+    start_time = kernel::getMicros();
+    auto drained = buffer.drain([output](LogLevel, uint64_t timestamp, const char* tag, const char* message) {
+        fprintf(output, "%llu [I] [%s] %s\n", static_cast<unsigned long long>(timestamp), tag, message);
+    });
+    auto drain_time = kernel::getMicros() - start_time;
+    CHECK_EQ(drained, BENCHMARK_MESSAGE_COUNT);
+
+    fclose(output);
+
+    MESSAGE("Direct: ", direct_time * 1000 / BENCHMARK_MESSAGE_COUNT, " ns per message");
+    MESSAGE("LogBuffer: ", deferred_time * 1000 / BENCHMARK_MESSAGE_COUNT, " ns per message (caller)");
+    MESSAGE("LogBuffer: ", drain_time * 1000 / BENCHMARK_MESSAGE_COUNT, " ns per message (log thread)");
+}
@@ -0,0 +1,154 @@
+#include "doctest.h"
+#include <Tactility/LogBuffer.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tt;
+
+struct Record {
+    LogLevel level;
+    uint64_t timestamp;
+    std::string tag;
+    std::string message;
+};
+
+static bool addRecord(LogBuffer& buffer, LogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    bool result = buffer.add(level, 123, "test", format, args);
+    va_end(args);
+    return result;
+}
+
+static std::string formatLikePrintf(const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    return message;
+}
+
+static std::vector<Record> drainRecords(LogBuffer& buffer) {
+    std::vector<Record> records;
+    buffer.drain([&records](LogLevel level, uint64_t timestamp, const char* tag, const char* message) {
+        records.push_back({ level, timestamp, tag, message });
+    });
+    return records;
+}
+
+#define CHECK_FORMAT(format, ...) \
+    do { \
+        LogBuffer buffer(1024); \
+        CHECK(addRecord(buffer, LogLevel::Info, format, ##__VA_ARGS__)); \
+        auto records = drainRecords(buffer); \
+        REQUIRE_EQ(records.size(), 1); \
+        CHECK_EQ(records[0].message, formatLikePrintf(format, ##__VA_ARGS__)); \
+    } while (0)
+
+TEST_CASE("LogBuffer formats messages like printf") {
+    CHECK_FORMAT("no arguments");
+    CHECK_FORMAT("percent %% sign");
+    CHECK_FORMAT("int %d, negative %i, padded %05d, left %-4d|", 42, -7, 12, 3);
+    CHECK_FORMAT("char %c, short %hd, signed char %hhd", 'x', (short)-300, (signed char)-5);
+    CHECK_FORMAT("unsigned %u, hex %x, HEX %#X, octal %o", 4000000000U, 0xbeefU, 0xcafeU, 8U);
+    CHECK_FORMAT("long %ld, long long %lld, unsigned long long %llu", -123456789L, -1234567890123LL, 18446744073709551615ULL);
+    CHECK_FORMAT("size %zu, ptrdiff %td, intmax %jd", (size_t)77, (ptrdiff_t)-5, (intmax_t)99);
+    CHECK_FORMAT("float %f, precision %.2f, exponent %e, shortest %g", 1.5, 3.14159, 12345.678, 0.0001);
+    CHECK_FORMAT("long double %Lf", 2.5L);
+    CHECK_FORMAT("string %s, padded %8s, precision %.3s|", "hello", "pad", "truncated");
+    CHECK_FORMAT("null %s", (const char*)nullptr);
+    CHECK_FORMAT("pointer %p", (void*)0x1234);
+    CHECK_FORMAT("width %*d, precision %.*f", 6, 42, 3, 1.23456);
+}
+
+TEST_CASE("LogBuffer keeps the record metadata") {
+    LogBuffer buffer(1024);
+    CHECK(addRecord(buffer, LogLevel::Warning, "message"));
+    auto records = drainRecords(buffer);
+    REQUIRE_EQ(records.size(), 1);
+    CHECK_EQ(records[0].level, LogLevel::Warning);
+    CHECK_EQ(records[0].timestamp, 123);
+    CHECK_EQ(records[0].tag, "test");
+    CHECK(buffer.isEmpty());
+}
+
+TEST_CASE("LogBuffer copies string arguments") {
+    LogBuffer buffer(1024);
+    char text[16];
+    strcpy(text, "original");
+    CHECK(addRecord(buffer, LogLevel::Info, "%s", text));
+    strcpy(text, "changed");
+    auto records = drainRecords(buffer);
+    REQUIRE_EQ(records.size(), 1);
+    CHECK_EQ(records[0].message, "original");
+}
+
+TEST_CASE("LogBuffer only reads strings up to their precision") {
+    // Not null-terminated, like a received buffer
+    const char text[] = { 'a', 'b', 'c', 'd' };
+    CHECK_FORMAT("%.*s|%.2s|%.*s", 3, text, text, -1, "negative");
+}
+
+TEST_CASE("LogBuffer truncates long string arguments") {
+    LogBuffer buffer(1024);
+    std::string text(LogBuffer::MAX_ARGUMENTS_SIZE * 2, 'a');
+    CHECK(addRecord(buffer, LogLevel::Info, "%s", text.c_str()));
+    auto records = drainRecords(buffer);
+    REQUIRE_EQ(records.size(), 1);
+    CHECK_LT(records[0].message.size(), LogBuffer::MAX_ARGUMENTS_SIZE);
+    CHECK_EQ(records[0].message, std::string(records[0].message.size(), 'a'));
+}
+
+TEST_CASE("LogBuffer drops records when it is full") {
+    LogBuffer buffer(1024);
+    int added = 0;
+    while (addRecord(buffer, LogLevel::Info, "record %d", added)) {
+        added++;
+    }
+    CHECK_GT(added, 0);
+    CHECK_FALSE(addRecord(buffer, LogLevel::Info, "record %d", added));
+
+    auto statistics = buffer.getStatistics();
+    CHECK_EQ(statistics.records, added);
+    CHECK_EQ(statistics.dropped, 2);
+
+    auto records = drainRecords(buffer);
+    REQUIRE_EQ(records.size(), added);
+    CHECK_EQ(records.back().message, "record " + std::to_string(added - 1));
+
+    // There is space again after draining
+    CHECK(addRecord(buffer, LogLevel::Info, "after drain"));
+}
+
+TEST_CASE("LogBuffer keeps records in order when they wrap around the end of the buffer") {
+    LogBuffer buffer(1024);
+    int next_record = 0;
+    int next_expected = 0;
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 7; i++) {
+            CHECK(addRecord(buffer, LogLevel::Info, "record %d with %s", next_record, "some text"));
+            next_record++;
+        }
+        for (const auto& record : drainRecords(buffer)) {
+            CHECK_EQ(record.message, "record " + std::to_string(next_expected) + " with some text");
+            next_expected++;
+        }
+    }
+    CHECK_EQ(next_expected, next_record);
+    CHECK_EQ(buffer.getStatistics().dropped, 0);
+}
+
+TEST_CASE("log levels can be set per tag") {
+    setLogLevel("LogLevelTest", LogLevel::Warning);
+    CHECK(isLoggable(LogLevel::Error, "LogLevelTest"));
+    CHECK(isLoggable(LogLevel::Warning, "LogLevelTest"));
+    CHECK_FALSE(isLoggable(LogLevel::Info, "LogLevelTest"));
+    // Other tags use the default level
+    CHECK(isLoggable(LogLevel::Verbose, "OtherLogLevelTest"));
+
+    setLogLevel("LogLevelTest", LogLevel::Verbose);
+    CHECK(isLoggable(LogLevel::Verbose, "LogLevelTest"));
+}
@@ -33,3 +33,86 @@ TEST_CASE("PubSub unsubscribed subscription does not receive published data") {
 
     CHECK_EQ(value, 0);
 }
+
+TEST_CASE("PubSub subscription can unsubscribe itself while receiving data") {
+    PubSub<int> pubsub;
+    int counter = 0;
+    PubSub<int>::SubscriptionHandle subscription = nullptr;
+
+    subscription = pubsub.subscribe([&](auto) {
+        counter++;
+        pubsub.unsubscribe(subscription);
+    });
+    pubsub.publish(1);
+    pubsub.publish(2);
+
+    CHECK_EQ(counter, 1);
+    CHECK_EQ(pubsub.getSubscriptionCount(), 0);
+}
+
+TEST_CASE("PubSub subscription can publish again while receiving data") {
+    PubSub<int> pubsub;
+    int sum = 0;
+
+    auto subscription = pubsub.subscribe([&](auto value) {
+        sum += value;
+        if (value > 1) {
+            pubsub.publish(value - 1);
+        }
+    });
+    pubsub.publish(3);
+
+    CHECK_EQ(sum, 6);
+    pubsub.unsubscribe(subscription);
+}
+
+TEST_CASE("PubSub queued subscription receives data on its dispatcher thread") {
+    PubSub<int> pubsub;
+    auto dispatcher_thread = std::make_shared<DispatcherThread>("pubsub_test");
+    dispatcher_thread->start();
+    int value = 0;
+    ThreadId receiving_thread = nullptr;
+
+    auto subscription = pubsub.subscribe([&](auto newValue) {
+        value = newValue;
+        receiving_thread = Thread::getCurrent() != nullptr ? Thread::getCurrent()->getId() : nullptr;
+    }, dispatcher_thread);
+    pubsub.publish(1);
+
+    kernel::delayTicks(10);
+
+    CHECK_EQ(value, 1);
+    CHECK_NE(receiving_thread, nullptr);
+    pubsub.unsubscribe(subscription);
+    dispatcher_thread->stop();
+}
+
+TEST_CASE("PubSub unsubscribe waits for a callback that is running on another thread") {
+    PubSub<int> pubsub;
+    std::atomic<bool> started = false;
+    std::atomic<bool> finished = false;
+
+    auto subscription = pubsub.subscribe([&](auto) {
+        started = true;
+        kernel::delayMillis(20);
+        finished = true;
+    });
+
+    Thread thread = Thread(
+        "publisher",
+        1024,
+        [&pubsub]() {
+            pubsub.publish(1);
+            return 0;
+        }
+    );
+    thread.start();
+
+    while (!started) {
+        kernel::delayMillis(1);
+    }
+    pubsub.unsubscribe(subscription);
+
+    CHECK_EQ(finished.load(), true);
+    thread.join();
+}
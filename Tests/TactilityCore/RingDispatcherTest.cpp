@@ -0,0 +1,88 @@
+#include "doctest.h"
+#include <Tactility/TactilityCore.h>
+#include <Tactility/RingDispatcher.h>
+
+using namespace tt;
+
+TEST_CASE("ring dispatcher should not call callback if consume isn't called") {
+    int counter = 0;
+    RingDispatcher dispatcher;
+    dispatcher.dispatch([&counter]() { counter++; });
+    kernel::delayTicks(10);
+
+    CHECK_EQ(counter, 0);
+}
+
+TEST_CASE("ring dispatcher should destroy unconsumed functions") {
+    auto context = std::make_shared<uint32_t>();
+    auto* dispatcher = new RingDispatcher();
+    dispatcher->dispatch([context]() { /* NO-OP */ });
+    CHECK_EQ(context.use_count(), 2);
+    delete dispatcher;
+    CHECK_EQ(context.use_count(), 1);
+}
+
+TEST_CASE("ring dispatcher should call callbacks in order when consume is called") {
+    std::vector<int> values;
+    RingDispatcher dispatcher;
+
+    dispatcher.dispatch([&values]() { values.push_back(1); });
+    dispatcher.dispatch([&values]() { values.push_back(2); });
+    CHECK_EQ(dispatcher.consume(100), 2);
+
+    REQUIRE_EQ(values.size(), 2);
+    CHECK_EQ(values[0], 1);
+    CHECK_EQ(values[1], 2);
+}
+
+TEST_CASE("ring dispatcher capacity should be rounded up to a power of 2") {
+    RingDispatcher dispatcher(5);
+    CHECK_EQ(dispatcher.getCapacity(), 8);
+}
+
+TEST_CASE("ring dispatcher should reject functions when full") {
+    RingDispatcher dispatcher(4, RingDispatcher::OverflowPolicy::Reject);
+    for (int i = 0; i < 4; i++) {
+        CHECK(dispatcher.dispatch([]() {}));
+    }
+    CHECK_FALSE(dispatcher.dispatch([]() {}));
+
+    auto statistics = dispatcher.getStatistics();
+    CHECK_EQ(statistics.dispatched, 4);
+    CHECK_EQ(statistics.rejected, 1);
+    CHECK_EQ(statistics.highWaterMark, 4);
+}
+
+TEST_CASE("ring dispatcher with wait policy should time out when full") {
+    RingDispatcher dispatcher(2, RingDispatcher::OverflowPolicy::Wait);
+    CHECK(dispatcher.dispatch([]() {}));
+    CHECK(dispatcher.dispatch([]() {}));
+    CHECK_FALSE(dispatcher.dispatch([]() {}, 5));
+}
+
+TEST_CASE("ring dispatcher should consume in batches") {
+    int counter = 0;
+    RingDispatcher dispatcher(16, RingDispatcher::OverflowPolicy::Reject, 3);
+    for (int i = 0; i < 5; i++) {
+        dispatcher.dispatch([&counter]() { counter++; });
+    }
+
+    CHECK_EQ(dispatcher.consume(100), 3);
+    CHECK_EQ(counter, 3);
+    // Remaining work must not wait for a new dispatch
+    CHECK_EQ(dispatcher.consume(0), 2);
+    CHECK_EQ(counter, 5);
+    CHECK_EQ(dispatcher.getStatistics().consumed, 5);
+}
+
+TEST_CASE("ring dispatcher slots should be reusable after wrapping around") {
+    int counter = 0;
+    RingDispatcher dispatcher(4);
+    for (int i = 0; i < 10; i++) {
+        CHECK(dispatcher.dispatch([&counter]() { counter++; }));
+        CHECK(dispatcher.dispatch([&counter]() { counter++; }));
+        dispatcher.consume(100);
+    }
+    CHECK_EQ(counter, 20);
+    CHECK_EQ(dispatcher.getCount(), 0);
+}
@@ -0,0 +1,24 @@
+#include "doctest.h"
+#include <Tactility/crypt/Sha256.h>
+
+#include <cstring>
+
+using tt::crypt::Sha256;
+
+TEST_CASE("Sha256 calculates the digest of empty data") {
+    Sha256 sha256;
+    CHECK_EQ(sha256.finishHex(), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+TEST_CASE("Sha256 calculates the same digest for data that is added in parts") {
+    const char* text = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    Sha256 sha256;
+    for (size_t i = 0; i < strlen(text); i += 5) {
+        sha256.update(text + i, std::min<size_t>(5, strlen(text) - i));
+    }
+    CHECK_EQ(sha256.finishHex(), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // The instance is re-usable after finishing
+    sha256.update("abc", 3);
+    CHECK_EQ(sha256.finishHex(), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
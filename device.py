@@ -178,6 +178,14 @@ def write_lvgl_variables(output_file, device_properties: ConfigParser):
         output_file.write("CONFIG_LV_THEME_MONO=y\n")
     else:
         exit_with_error(f"Unknown theme: {theme}")
+    draw_unit_count = get_property_or_none(device_properties, "lvgl", "drawUnitCount")
+    if draw_unit_count is not None and not draw_unit_count.isdigit():
+        exit_with_error(f"Invalid drawUnitCount: {draw_unit_count}")
+    if draw_unit_count is not None and int(draw_unit_count) > 1:
+        # Multiple draw units render in parallel: they need the OS abstraction that Tactility implements
+        output_file.write("CONFIG_LV_OS_CUSTOM=y\n")
+        output_file.write("CONFIG_LV_OS_CUSTOM_INCLUDE=\"Tactility/lvgl/LvglOs.h\"\n")
+        output_file.write(f"CONFIG_LV_DRAW_SW_DRAW_UNIT_CNT={draw_unit_count}\n")
 
 def write_iram_fix(output_file, device_properties: ConfigParser):
     idf_target = get_property_or_exit(device_properties, "hardware", "target")
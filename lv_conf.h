@@ -81,10 +81,19 @@
  * - LV_OS_RTTHREAD
  * - LV_OS_WINDOWS
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+/*Set with the TACTILITY_LVGL_DRAW_UNIT_COUNT CMake option: multiple draw units need an operating system*/
+#ifndef TT_LVGL_DRAW_UNIT_COUNT
+    #define TT_LVGL_DRAW_UNIT_COUNT 1
+#endif
+
+#if TT_LVGL_DRAW_UNIT_COUNT > 1
+    #define LV_USE_OS   LV_OS_CUSTOM
+#else
+    #define LV_USE_OS   LV_OS_NONE
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
-    #define LV_OS_CUSTOM_INCLUDE <stdint.h>
+    #define LV_OS_CUSTOM_INCLUDE <Tactility/lvgl/LvglOs.h>
 #endif
 
 /*========================
@@ -102,7 +111,7 @@
     /* Set the number of draw unit.
      * > 1 requires an operating system enabled in `LV_USE_OS`
      * > 1 means multiply threads will render the screen in parallel */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    TT_LVGL_DRAW_UNIT_COUNT
 
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0